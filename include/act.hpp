@@ -20,9 +20,9 @@ namespace leabra{
 
     // OptThreshParams provides optimization thresholds for faster processing
     struct OptThreshParams: params::StylerObject {
-        float Send; // don't send activation when act <= send -- greatly speeds processing
-        float Delta; // don't send activation changes until they exceed this threshold: only for when LeabraNetwork::send_delta is on!
-        OptThreshParams(float Send = 0.1, float Delta = 0.005);
+        Real Send; // don't send activation when act <= send -- greatly speeds processing
+        Real Delta; // don't send activation changes until they exceed this threshold: only for when LeabraNetwork::send_delta is on!
+        OptThreshParams(Real Send = 0.1, Real Delta = 0.005);
 
         void Defaults();
         void Update();
@@ -31,7 +31,7 @@ namespace leabra{
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~OptThreshParams() = default;
     };
@@ -39,11 +39,11 @@ namespace leabra{
     // ActInitParams are initial values for key network state variables.
     // Initialized at start of trial with Init_Acts or DecayState.
     struct ActInitParams: params::StylerObject {
-        float Decay; // proportion to decay activation state toward initial values at start of every trial
-        float Vm; // initial membrane potential -- see e_rev.l for the resting potential (typically .3) -- often works better to have a somewhat elevated initial membrane potential relative to that
-        float Act; // initial activation value -- typically 0
-        float Ge; // baseline level of excitatory conductance (net input) -- Ge is initialized to this value, and it is added in as a constant background level of excitatory input -- captures all the other inputs not represented in the model, and intrinsic excitability, etc
-        ActInitParams(float Decay = 1, float Vm = 0.4, float Act = 0, float Ge = 0);
+        Real Decay; // proportion to decay activation state toward initial values at start of every trial
+        Real Vm; // initial membrane potential -- see e_rev.l for the resting potential (typically .3) -- often works better to have a somewhat elevated initial membrane potential relative to that
+        Real Act; // initial activation value -- typically 0
+        Real Ge; // baseline level of excitatory conductance (net input) -- Ge is initialized to this value, and it is added in as a constant background level of excitatory input -- captures all the other inputs not represented in the model, and intrinsic excitability, etc
+        ActInitParams(Real Decay = 1, Real Vm = 0.4, Real Act = 0, Real Ge = 0);
 
         void Defaults();
         void Update();
@@ -52,24 +52,24 @@ namespace leabra{
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~ActInitParams() = default;
     };
 
     // DtParams are time and rate constants for temporal derivatives in Leabra (Vm, net input)
     struct DtParams: params::StylerObject {
-        float Integ;
-        float VmTau;
-        float GTau;
-        float AvgTau;
-        float VmDt;
-        float GDt;
-        float AvgDt;
-
-        DtParams(float Integ = 1, float VmTau = 3.3, float AvgTau = 200);
+        Real Integ;
+        Real VmTau;
+        Real GTau;
+        Real AvgTau;
+        Real VmDt;
+        Real GDt;
+        Real AvgDt;
+
+        DtParams(Real Integ = 1, Real VmTau = 3.3, Real AvgTau = 200);
         void Update();
-        void GFromRaw(float geRaw, float &ge);
+        void GFromRaw(Real geRaw, Real &ge);
 
         void Defaults();
 
@@ -77,7 +77,7 @@ namespace leabra{
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~DtParams() = default;
     };
@@ -85,13 +85,13 @@ namespace leabra{
     // ClampParams are for specifying how external inputs are clamped onto network activation values
     struct ClampParams: params::StylerObject {
         bool Hard; // whether to hard clamp inputs where activation is directly set to external input value (Act = Ext) or do soft clamping where Ext is added into Ge excitatory current (Ge += Gain * Ext)
-        minmax::F32 Range; // range of external input activation values allowed -- Max is .95 by default due to saturating nature of rate code activation function
-        float Gain; // soft clamp gain factor (Ge += Gain * Ext)
+        minmax::MinMax<Real> Range; // range of external input activation values allowed -- Max is .95 by default due to saturating nature of rate code activation function
+        Real Gain; // soft clamp gain factor (Ge += Gain * Ext)
         bool Avg; // compute soft clamp as the average of current and target netins, not the sum -- prevents some of the main effect problems associated with adding external inputs
-        float AvgGain; // gain factor for averaging the Ge -- clamp value Ext contributes with AvgGain and current Ge as (1-AvgGain)
+        Real AvgGain; // gain factor for averaging the Ge -- clamp value Ext contributes with AvgGain and current Ge as (1-AvgGain)
 
-        ClampParams(bool Hard = true, float RangeMax = 0.95, float Gain = 0.2, bool Avg = false, float AvgGain = 0.2);
-        float AvgGe(float ext, float ge);
+        ClampParams(bool Hard = true, Real RangeMax = 0.95, Real Gain = 0.2, bool Avg = false, Real AvgGain = 0.2);
+        Real AvgGe(Real ext, Real ge);
 
         void Defaults();
         void Update();
@@ -100,39 +100,39 @@ namespace leabra{
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~ClampParams() = default;
     };
 
     struct WtInitParams: rands::Dist {
-        // float Mean;
-        // float Var;
-        // std::uniform_real_distribution<float> Type;
+        // Real Mean;
+        // Real Var;
+        // std::uniform_real_distribution<Real> Type;
         bool Sym;
 
-        WtInitParams(float mean = 0.5, float var = 0.25, float par=1, rands::RandDists type=rands::Uniform);
+        WtInitParams(Real mean = 0.5, Real var = 0.25, Real par=1, rands::RandDists type=rands::Uniform);
 
         void Defaults();
     };
 
     struct WtScaleParams: params::StylerObject{
-        float Abs; // absolute scaling, which is not subject to normalization: directly multiplies weight values
-        float Rel; // relative scaling that shifts balance between different pathways -- this is subject to normalization across all other pathways into unit
+        Real Abs; // absolute scaling, which is not subject to normalization: directly multiplies weight values
+        Real Rel; // relative scaling that shifts balance between different pathways -- this is subject to normalization across all other pathways into unit
 
-        WtScaleParams(float abs = 1, float rel = 1);
+        WtScaleParams(Real abs = 1, Real rel = 1);
 
         void Defaults();
         void Update();
 
-        float SLayActScale(float savg, float snu, float ncon);
-        float FullScale(float savg, float snu, float ncon);
+        Real SLayActScale(Real savg, Real snu, Real ncon);
+        Real FullScale(Real savg, Real snu, Real ncon);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~WtScaleParams() = default;
     };
@@ -162,7 +162,7 @@ namespace leabra{
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
     };
 
 
@@ -179,7 +179,7 @@ namespace leabra{
         chans::Chans Erev; // reversal potentials for each channel
         ClampParams Clamp; // // how external inputs drive neural activations
         ActNoiseParams Noise; // how, where, when, and how much noise to add to activations
-        minmax::F32 VmRange; // range for Vm membrane potential -- [0, 2.0] by default
+        minmax::MinMax<Real> VmRange; // range for Vm membrane potential -- [0, 2.0] by default
         knadapt::Params KNa; // sodium-gated potassium channel adaptation parameters -- activates an inhibitory leak-like current as a function of neural activity (firing = Na influx) at three different time-scales (M-type = fast, Slick = medium, Slack = slow)
         chans::Chans ErevSubThr; // Erev - Act.Thr for each channel -- used in computing GeThrFmG among others
         chans::Chans ThrSubErev; // Act.Thr - Erev for each channel -- used in computing GeThrFmG among others
@@ -189,17 +189,17 @@ namespace leabra{
         void Update();
 
         void InitGInc(Neuron &nrn);
-        void DecayState(Neuron &nrn, float decay);
+        void DecayState(Neuron &nrn, Real decay);
         void InitActs(Neuron &nrn);
         void InitActQs(Neuron &nrn);
 
         //Cycle
-        void GeFromRaw(Neuron &nrn, float geRaw);
-        void GiFromRaw(Neuron &nrn, float giRaw);
-        float InetFromG(float vm, float ge, float gi, float gk);
+        void GeFromRaw(Neuron &nrn, Real geRaw);
+        void GiFromRaw(Neuron &nrn, Real giRaw);
+        Real InetFromG(Real vm, Real ge, Real gi, Real gk);
         void VmFromG(Neuron &nrn);
-        float GeThrFromG(Neuron &nrn);
-        float GeThrFromGnoK(Neuron &nrn);
+        Real GeThrFromG(Neuron &nrn);
+        Real GeThrFromGnoK(Neuron &nrn);
         void ActFromG(Neuron &nrn);
         bool HasHardClamp(Neuron &nrn);
         void HardClamp(Neuron &nrn);
@@ -208,7 +208,7 @@ namespace leabra{
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~ActParams() = default;
     };
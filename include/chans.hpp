@@ -1,5 +1,6 @@
 #pragma once
 #include "params.hpp"
+#include "real.hpp"
 /*
 Package chans provides standard neural conductance channels for computing
 a point-neuron approximation based on the standard equivalent RC circuit
@@ -11,21 +12,21 @@ namespace chans {
 
     // Chans are ion channels used in computing point-neuron activation function
     struct Chans: params::StylerObject {
-        float E; // excitatory sodium (Na) AMPA channels activated by synaptic glutamate
-        float L; // constant leak (potassium, K+) channels -- determines resting potential (typically higher than resting potential of K)
-        float I; // inhibitory chloride (Cl-) channels activated by synaptic GABA
-        float K; // gated / active potassium channels -- typically hyperpolarizing relative to leak / rest
+        Real E; // excitatory sodium (Na) AMPA channels activated by synaptic glutamate
+        Real L; // constant leak (potassium, K+) channels -- determines resting potential (typically higher than resting potential of K)
+        Real I; // inhibitory chloride (Cl-) channels activated by synaptic GABA
+        Real K; // gated / active potassium channels -- typically hyperpolarizing relative to leak / rest
 
-        Chans(float e, float l, float i, float k);
-        void SetAll(float e, float l, float i, float k);
-        void SetFromOtherMinus(Chans oth, float minus);
-        void SetFromMinusOther(float minus, Chans oth);
+        Chans(Real e, Real l, Real i, Real k);
+        void SetAll(Real e, Real l, Real i, Real k);
+        void SetFromOtherMinus(Chans oth, Real minus);
+        void SetFromMinusOther(Real minus, Chans oth);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~Chans() = default;
     };
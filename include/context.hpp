@@ -1,4 +1,5 @@
 #pragma once
+#include <pybind11/pybind11.h>
 #include "time.hpp"
 
 namespace leabra {
@@ -24,6 +25,28 @@ namespace leabra {
         Debug
     };
     
+    // SettleParams has parameters for ending each quarter of settling
+    // early, once the activations of all the layers have stopped changing
+    // (see Network.ActDelMax and Context.Settled).
+    struct SettleParams {
+        // end quarters early once settled
+        bool On = false;
+
+        // only end quarters early when not training (Mode != Train),
+        // so that learning always sees the full quarters
+        bool TestOnly = true;
+
+        // tolerance on the max |ActDel| over all the layers, below which
+        // a cycle counts as settled
+        float Tol = 0.001;
+
+        // number of consecutive settled cycles that ends a quarter
+        int K = 5;
+
+        // minimum number of cycles to run in each quarter
+        int MinCyc = 10;
+    };
+
     struct Context {
         // accumulated amount of time the network has been running,
         // in simulation-time (not real world time), in seconds.
@@ -58,6 +81,25 @@ namespace leabra {
         // current evaluation mode, e.g., Train, Test, etc
         Modes Mode;
 
+        // if true, the model is being run in a testing mode, so no weight
+        // changes or other associated computations are needed.
+        // this flag should only affect learning-related behavior.
+        bool Testing;
+
+        // ending quarters early once settled
+        SettleParams Settle;
+
+        // Cycle at the start of the current quarter.
+        int QuarterCycSt;
+
+        // number of cycles actually run in each quarter of the current
+        // alpha-cycle, set as each quarter ends (QuarterInc): CycPerQtr,
+        // unless the quarter Settled early.
+        int QuarterCycles[4];
+
+        // number of consecutive settled cycles in the current quarter.
+        int SettledCyc;
+
         Context(float timePerCyc = 0.001, int cycPerQtr = 25);
 
         void Reset();
@@ -65,7 +107,10 @@ namespace leabra {
         void CycleInc();
         void QuarterInc();
         int QuarterCycle();
+        bool Settled(float actDelMax);
     };
     
     
 } // namespace leabra
+
+void pybind_LeabraContext(pybind11::module_ &m);
@@ -3,6 +3,8 @@
 #include <map>
 #include <vector>
 #include <any>
+#include <mutex>
+#include <atomic>
 
 #include "params.hpp"
 #include "math.hpp"
@@ -11,6 +13,7 @@
 #include "relpos.hpp"
 #include "path.hpp"
 #include "strings.hpp"
+#include "weights.hpp"
 
 // TODO CHECK IF ANY OF THESE TYPES NEED CONSTRUCTORS TO INTIIALIZE DATA
 
@@ -18,6 +21,86 @@ namespace emer {
     struct Layer;
     struct Path;
 
+    // ParamTarget is one layer or path written by a CompiledParams, with the
+    // range of its writes in CompiledParams.Writes.
+    struct ParamTarget {
+        Layer *Lay; // target layer, or nullptr if the target is a path
+        Path *Pt; // target path, or nullptr if the target is a layer
+        int WtSt; // starting index of the writes for this target
+        int WtN; // number of writes for this target
+    };
+
+    // CompiledParams is a params Sheet that has been resolved against the layers and
+    // paths of a built network: selector matching, path lookup and value parsing are
+    // done once, leaving a flat list of typed writes per target followed by the
+    // UpdateParams call each target needs. Apply replays them in the same order
+    // that Network.ApplyParams would set them.
+    // The compiled writes hold field addresses, so it must be recompiled if the
+    // network is rebuilt or the sheet changes.
+    struct CompiledParams {
+        std::vector<params::ParamWrite> Writes;
+        std::vector<ParamTarget> Targets;
+
+        void Apply();
+    };
+
+
+    // ParamChange is a single param change queued for a running network:
+    // a Sel selector (.Class, #Name or Type), a full param path including
+    // the target type (e.g., Layer.Inhib.Layer.Gi), and the value to set.
+    struct ParamChange {
+        std::string Sel;
+        std::string Path;
+        std::string Value;
+    };
+
+    // ParamQueue is a double-buffered channel of param changes for a running network.
+    // Writers Push changes from any thread into the Pending buffer, under the mutex.
+    // The simulation thread calls Swap at defined boundaries to take all of the
+    // pending changes at once into Active. When nothing is pending, Swap is
+    // a single atomic load, so the simulation never waits on writers.
+    struct ParamQueue {
+        std::mutex Mu; // guards Pending
+        std::atomic<bool> HasPending; // set when Pending has changes not yet swapped
+        std::vector<ParamChange> Pending; // changes pushed by writers
+        std::vector<ParamChange> Active; // changes being applied, only used by the simulation thread
+
+        ParamQueue(): HasPending(false) {};
+
+        void Push(std::string sel, std::string path, std::string value);
+        bool Swap();
+    };
+
+    struct Network;
+
+    // SelIndexGen is the generation of the names and classes of all layers and
+    // paths, and of the lists of layers and their recv paths. It is incremented
+    // by their SetName, SetClass and AddClass methods, and as layers and paths
+    // are added to a network, so a SelIndex can tell that it is out of date
+    // without visiting them.
+    extern uint64_t SelIndexGen;
+
+    // SelIndex maps param selectors to the layers and paths of a network that they
+    // match: #Name for each name, .Class for each of the space-separated classes in
+    // StyleClass (which includes the TypeName), and the StyleType (Layer or Path).
+    // Matching a Sel is then a single map lookup, instead of a string match
+    // against every object. Objs are in ApplyParams order: each layer followed
+    // by its recv paths. The SelIndexGen is recorded when built, and
+    // Network.SelMatchIndex rebuilds the index whenever it has changed since.
+    struct SelIndex {
+        std::vector<params::StylerObject*> Objs; // layers and paths, in ApplyParams order
+        std::vector<int> LayerObj; // index in Objs of each layer
+        std::vector<std::string> Types; // StyleType of each object
+        uint64_t Gen = 0; // SelIndexGen when built, 0 if never built
+        std::map<std::string, std::vector<int>> Sels; // selector -> indexes in Objs that it matches, in order
+
+        void Build(Network &net);
+        bool Valid();
+        const std::vector<int> &Match(const std::string &sel);
+        std::vector<std::vector<int>> SheetMatches(params::Sheet &pars);
+        bool ApplyObj(params::Sheet &pars, const std::vector<int> &sels, int oi, bool setMsg);
+        bool CompileObj(params::Sheet &pars, const std::vector<int> &sels, int oi, std::vector<params::ParamWrite> &writes);
+    };
 
     // NetworkBase defines the basic data for a neural network,
     // used for managing the structural elements of a network,
@@ -56,6 +139,14 @@ namespace emer {
         // Set this to get a different set of weights.
         int RandSeed;
 
+        // param changes queued from other threads, applied at the
+        // next boundary -- see QueueParam and ApplyQueuedParams.
+        ParamQueue ParamUpdates;
+
+        // index of the layers and paths matched by each param selector
+        // -- use SelMatchIndex to get an up-to-date version.
+        SelIndex SelIdx;
+
         Network(std::string name, std::string weightsFile = "", int randSeed = 0);
 
         void UpdateLayerMaps();
@@ -71,6 +162,17 @@ namespace emer {
         //Params
         bool ApplyParams(params::Sheet& pars, bool setMsg);
         bool ApplyParams(params::Sets& pars, bool setMsg, std::string name="Base");
+        CompiledParams CompileParams(params::Sheet& pars);
+        CompiledParams CompileParams(params::Sets& pars, std::string name="Base");
+        SelIndex &SelMatchIndex();
+        void SelMatchCount(params::Sheet& pars);
+        void QueueParam(std::string sel, std::string path, std::string value);
+        bool ApplyQueuedParams();
+        // Weights
+        void WriteWeightsJSON(std::ostream &w);
+        void ReadWeightsJSON(std::istream &r);
+        void SaveWeightsJSON(std::string fileName);
+        void OpenWeightsJSON(std::string fileName);
         // std::string NonDefaultParams();
         // void SaveAllParams(fstream file);
         // void SaveNonDefaultParams(fstream file);
@@ -126,6 +228,7 @@ namespace emer {
         // Class is for applying parameter styles across multiple layers
         // that all get the same parameters.  This can be space separated
         // with multple classes.
+        // Set it, and Name, with SetClass and SetName (see SelIndexGen).
         std::string Class; // string
 
         // Info contains descriptive information about the layer.
@@ -192,6 +295,8 @@ namespace emer {
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
+        void SetName(std::string name);
+        void SetClass(std::string cls);
 
         std::string Label();
         bool Is2D();
@@ -306,11 +411,11 @@ namespace emer {
 
         // WriteWeightsJSON writes the weights from this layer from the
         // receiver-side perspective in a JSON text format.
-        // void WriteWeightsJSON(std::ifstream jsonFile, int depth);
+        virtual void WriteWeightsJSON(std::ostream &w, int depth) = 0;
 
-        // SetWeights sets the weights for this layer from weights.Layer
-        // decoded values
-        // void SetWeights(weights::Layer lw);
+        // SetWeightsMetaData sets the layer-level state saved in the
+        // MetaData of a JSON weights file.
+        virtual void SetWeightsMetaData(std::map<std::string, std::string> &md) = 0;
     };
 
     // PathBase defines the basic shared data for a pathway
@@ -327,6 +432,7 @@ namespace emer {
         // Class is for applying parameter styles across multiple paths
         // that all get the same parameters.  This can be space separated
         // with multple classes.
+        // Set it, and Name, with SetClass and SetName (see SelIndexGen).
         std::string Class;
 
         // Info contains descriptive information about the pathway.
@@ -352,6 +458,8 @@ namespace emer {
         std::string StyleClass();
         std::string StyleName();
         std::string Label();
+        void SetName(std::string name);
+        void SetClass(std::string cls);
 
         // std::string AddClass(std::string cls);
         // template <typename... Args>
@@ -434,11 +542,15 @@ namespace emer {
 
         // WriteWeightsJSON writes the weights from this pathway
         // from the receiver-side perspective in a JSON text format.
-        // virtual void WriteWeightsJSON(std::ifstream jsonFile, int depth);
+        virtual void WriteWeightsJSON(std::ostream &w, int depth) = 0;
+
+        // SetWeightsMetaData sets the pathway-level state saved in the
+        // MetaData of a JSON weights file.
+        virtual void SetWeightsMetaData(std::map<std::string, std::string> &md) = 0;
 
-        // SetWeights sets the weights for this pathway from weights.Path
-        // decoded values
-        // virtual void SetWeights(weights::Layer lw);
+        // SetRecvWeights sets the weights from sending units si
+        // to receiving unit ri, as read from a JSON weights file.
+        virtual void SetRecvWeights(int ri, std::vector<int> &si, std::vector<float> &wt) = 0;
     };
 
 } // namespace emer
\ No newline at end of file
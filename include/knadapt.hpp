@@ -15,26 +15,27 @@ This package supports both spiking and rate-coded activations.
 */
 #pragma once
 #include "params.hpp"
+#include "real.hpp"
 
 namespace knadapt {
     struct Chan: params::StylerObject {
         bool On; // if On, use this component of K-Na adaptation
-        float Rise; // Rise rate of fast time-scale adaptation as function of Na concentration -- directly multiplies -- 1/rise = tau for rise rate
-        float Max; // Maximum potential conductance of fast K channels -- divide nA biological value by 10 for the normalized units here
-        float Tau; // time constant in cycles for decay of adaptation, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life)
-        float Dt; // 1/Tau rate constant
-        Chan(bool on=true, float rise = 0.01, float max=0.1, float tau=100);
+        Real Rise; // Rise rate of fast time-scale adaptation as function of Na concentration -- directly multiplies -- 1/rise = tau for rise rate
+        Real Max; // Maximum potential conductance of fast K channels -- divide nA biological value by 10 for the normalized units here
+        Real Tau; // time constant in cycles for decay of adaptation, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life)
+        Real Dt; // 1/Tau rate constant
+        Chan(bool on=true, Real rise = 0.01, Real max=0.1, Real tau=100);
 
         void Update(){Dt = 1/Tau;};
         void Defaults();
-        void GcFmSpike(float* gKNa, bool spike);
-        void GcFmRate(float* gKNa, float act);
+        void GcFmSpike(Real* gKNa, bool spike);
+        void GcFmRate(Real* gKNa, Real act);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~Chan() = default;
     };
@@ -44,24 +45,24 @@ namespace knadapt {
     // M-type (fast), Slick (medium), and Slack (slow)
     struct Params: params::StylerObject {
         bool On; // if On, apply K-Na adaptation
-        float Rate; // extra multiplier for rate-coded activations on rise factors -- adjust to match discrete spiking
+        Real Rate; // extra multiplier for rate-coded activations on rise factors -- adjust to match discrete spiking
         Chan Fast; // fast time-scale adaptation
         Chan Med; // medium time-scale adaptation
         Chan Slow; // slow time-scale adaptation
 
-        Params(){Defaults();InitParamMaps();};
-        Params(bool on = true, float rate = 0.8);
+        Params(){Defaults();};
+        Params(bool on = true, Real rate = 0.8);
         
         void Defaults();
         void Update();
-        void GcFromSpike(float* gKNaF, float* gKNaM, float* gKNaS, bool spike);
-        void GcFromRate(float* gKNaF, float* gKNaM, float* gKNaS, float act);
+        void GcFromSpike(Real* gKNaF, Real* gKNaM, Real* gKNaS, bool spike);
+        void GcFromRate(Real* gKNaF, Real* gKNaM, Real* gKNaS, Real act);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~Params() = default;
     };
@@ -38,6 +38,7 @@ namespace leabra {
         std::vector<Neuron> Neurons;
         std::vector<Pool> Pools;
         CosDiffStats CosDiff;
+        Real ActDelMax; // max |ActDel| over the neurons in the last cycle (see ActFromG), for Context.Settled
 
         Layer(std::string name, int index = 0, Network* net = nullptr);
         
@@ -52,8 +53,8 @@ namespace leabra {
         void BuildPools(int nu);
         void BuildPaths();
         void Build();
-        // void WriteWeightsJSON(std::ifstream jsonFile, int depth);
-        // void SetWeights(weights::Layer lw);
+        void WriteWeightsJSON(std::ostream &w, int depth);
+        void SetWeightsMetaData(std::map<std::string, std::string> &md);
         // std::tuple<int,int> VarRange(std::string varName); // VarRange returns the min / max values for given variable
 
         void InitWeights();
@@ -93,6 +94,7 @@ namespace leabra {
         void InhibFromPool(Context* ctx);
         void ActFromG(Context* ctx);
         void AvgMaxAct(Context* ctx);
+        void Cycle(Context* ctx);
         void CyclePost(Context* ctx);
         // Quarter
         void QuarterFinal(Context* ctx);
@@ -101,14 +103,19 @@ namespace leabra {
         void CosDiffFromActs();
         bool IsTarget();
         // Learning
-        void DWt();
+        void DWt(bool batch = false);
+        void DWtFromBatch();
         void WtFromDWt();
-        void WtBalFromWt();
+        int WtBalFromWt(bool check = false);
         void LrateMult(float mult);
         // Threading / Reports
         std::tuple<int, int, int> CostEst();
+        MemReport MemoryReport();
+        // Checkpoints
+        void WriteCheckpoint(weights::CkptWriter &ck);
+        void ReadCheckpoint(weights::CkptFile &ck);
         // Stats
-        std::tuple<int, int> MSE(float tol = 0.5);
+        std::tuple<float, float> MSE(float tol = 0.5);
         float SSE(float tol = 0.5);
         // Lesion
         void UnLesionNeurons();
@@ -123,7 +130,7 @@ namespace leabra {
         int NumSendPaths();
         emer::Path* SendPath(int idx);
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
     };
 
 };
@@ -1,5 +1,8 @@
 #pragma once
 #include <vector>
+#include <algorithm>
+#include <span>
+#include <memory>
 #include <fstream>
 #include <pybind11/pybind11.h>
 #include "emer.hpp"
@@ -7,6 +10,7 @@
 #include "time.hpp"
 #include "fffb.hpp"
 #include "params.hpp"
+#include "weights.hpp"
 
 namespace leabra {
 
@@ -14,13 +18,13 @@ namespace leabra {
     // to produce a proportional additional contribution to Gi
     struct SelfInhibParams: params::StylerObject {
         bool On; // enable neuron self-inhibition
-        float Gi; // [def: 0.4] strength of individual neuron self feedback inhibition -- can produce proportional activation behavior in individual units for specialized cases (e.g., scalar val or BG units), but not so good for typical hidden layers
-        float Tau; // [def: 1.4] time constant in cycles, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life) for integrating unit self feedback inhibitory values -- prevents oscillations that otherwise occur -- relatively rapid 1.4 typically works, but may need to go longer if oscillations are a problem
-        float Dt; // rate = 1 / tau
+        Real Gi; // [def: 0.4] strength of individual neuron self feedback inhibition -- can produce proportional activation behavior in individual units for specialized cases (e.g., scalar val or BG units), but not so good for typical hidden layers
+        Real Tau; // [def: 1.4] time constant in cycles, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life) for integrating unit self feedback inhibitory values -- prevents oscillations that otherwise occur -- relatively rapid 1.4 typically works, but may need to go longer if oscillations are a problem
+        Real Dt; // rate = 1 / tau
 
-        SelfInhibParams(bool on=false, float gi=0.4, float tau=1.4):On(on),Gi(gi),Tau(tau){Update();InitParamMaps();};
+        SelfInhibParams(bool on=false, Real gi=0.4, Real tau=1.4):On(on),Gi(gi),Tau(tau){Update();};
         
-        void Inhib(float &self, float act);
+        void Inhib(Real &self, Real act);
         void Update(){Dt = 1/Tau;};
         void Defaults(){On=false; Gi=0.4; Tau=1.4; Update();};
 
@@ -28,7 +32,7 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~SelfInhibParams() = default;
     };
@@ -38,19 +42,19 @@ namespace leabra {
     // Also specifies time constant for updating average
     // and for the target value for adapting inhibition in inhib_adapt.
     struct ActAvgParams: params::StylerObject {
-        float Init;
+        Real Init;
         bool Fixed;
         bool UseExtAct;
         bool UseFirst;
-        float Tau;
-        float Adjust;
-        float Dt;
+        Real Tau;
+        Real Adjust;
+        Real Dt;
 
-        ActAvgParams(float init=0.15, bool fixed=false, bool useExtAct=false, bool useFirst=true, float tau=100, float adjust=1):Init(init),Fixed(fixed),UseExtAct(useExtAct),UseFirst(useFirst),Tau(tau),Adjust(adjust){Update();InitParamMaps();};
+        ActAvgParams(Real init=0.15, bool fixed=false, bool useExtAct=false, bool useFirst=true, Real tau=100, Real adjust=1):Init(init),Fixed(fixed),UseExtAct(useExtAct),UseFirst(useFirst),Tau(tau),Adjust(adjust){Update();};
 
-        float EffInit();
-        void AvgFromAct(float &avg, float act);
-        void EffFromAvg(float &eff, float avg);
+        Real EffInit();
+        void AvgFromAct(Real &avg, Real act);
+        void EffFromAvg(Real &eff, Real avg);
 
         void Update(){Dt = 1/Tau;};
         void Defaults(){Init=0.15, Fixed=false; UseExtAct=false; UseFirst=true; Tau=100; Adjust=1; Update();};
@@ -59,7 +63,7 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~ActAvgParams() = default;
     };
@@ -74,7 +78,7 @@ namespace leabra {
         SelfInhibParams Self; // neuron self-inhibition parameters -- can be beneficial for producing more graded, linear response -- not typically used in cortical networks
         ActAvgParams ActAvg; // running-average activation computation values -- for overall estimates of layer activation levels, used in netinput scaling
 
-        InhibParams():Layer(),Pool(),Self(),ActAvg(){InitParamMaps();};
+        InhibParams():Layer(),Pool(),Self(),ActAvg(){};
 
         void Update();
         void Defaults();
@@ -83,7 +87,7 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~InhibParams() = default;
     };
@@ -117,26 +121,43 @@ namespace leabra {
     // There is one of these for each Recv Neuron participating in the pathway.
     struct WtBalRecvPath: params::StylerObject {
         // average of effective weight values that exceed WtBal.AvgThr across given Recv Neuron's connections for given Path
-        float Avg;
+        Real Avg;
 
         // overall weight balance factor that drives changes in WbInc vs. WbDec via a sigmoidal function -- this is the net strength of weight balance changes
-        float Fact;
+        Real Fact;
 
         // weight balance increment factor -- extra multiplier to add to weight increases to maintain overall weight balance
-        float Inc;
+        Real Inc;
 
         // weight balance decrement factor -- extra multiplier to add to weight decreases to maintain overall weight balance
-        float Dec;
+        Real Dec;
 
-        WtBalRecvPath(){Avg = 0; Fact = 0; Inc = 1; Dec = 1;InitParamMaps();};
+        // running sum and number of the weights that are >= WtBal.AvgThr, kept up to date by
+        // WtFromDWt while Path.WbSums is set. The sum is in double so that it stays exact.
+        double SumWt;
+        int SumN;
 
-        void Init(){Avg = 0;Fact = 0;Inc = 1;Dec = 1;};
+        WtBalRecvPath(){Avg = 0; Fact = 0; Inc = 1; Dec = 1; SumWt = 0; SumN = 0;};
+
+        void Init(){Avg = 0;Fact = 0;Inc = 1;Dec = 1;SumWt = 0;SumN = 0;};
+
+        // SumFromWt updates SumWt and SumN for a weight that changed from owt to wt.
+        void SumFromWt(Real owt, Real wt, Real thr) {
+            if (owt >= thr) {
+                SumWt -= owt;
+                SumN--;
+            }
+            if (wt >= thr) {
+                SumWt += wt;
+                SumN++;
+            }
+        };
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~WtBalRecvPath() = default;
     };
@@ -212,6 +233,66 @@ namespace leabra {
         PTPredLayer
     };
 
+    // WtQuants are the formats in which a Frozen pathway can store its
+    // weights (see Path.Freeze).
+    enum WtQuants {
+        // Real values, as trained (32 bit floats, or 64 bit with PRECISION=double)
+        WtF32,
+
+        // bfloat16: the top 16 bits of the float, rounded to nearest even
+        WtBF16,
+
+        // int8, times a scale for each receiving unit, or for the whole
+        // pathway, mapping the largest weight to 127
+        WtInt8
+    };
+
+    // MemReport is an accounting of the memory held by network state, in bytes,
+    // broken down by category. It is returned by MemoryReport on the Network,
+    // Layer and Path.
+    struct MemReport {
+        // synaptic state on pathways: Syns, GInc and WbRecv
+        size_t SynapseState = 0;
+
+        // connectivity index lists on pathways: RConN, RConIndexSt, RConIndex,
+        // RSynIndex, SConN, SConIndexSt, SConIndex
+        size_t ConIndexes = 0;
+
+        // neuron and pool state on layers
+        size_t NeuronState = 0;
+
+        // heap held by the per-type param registries (see params::ParamRegistry).
+        // These are shared by all objects, so only the Network report includes them.
+        size_t ParamMaps = 0;
+
+        // connectivity tables generated by Pattern.Connect during Build.
+        // These are transient (freed once the index lists are set), but they
+        // set the peak memory reached while building.
+        size_t PatternTables = 0;
+
+        void Add(const MemReport &mr);
+        size_t Resident();
+        size_t Total();
+        std::map<std::string, size_t> Map();
+    };
+
+    // PruneReport reports the synapses removed by Path.Prune, summed over
+    // the pathways pruned, with the memory freed and the time it took.
+    struct PruneReport {
+        int Paths = 0; // pathways pruned
+        int Before = 0; // synapses before pruning
+        int After = 0; // synapses remaining
+        size_t BytesBefore = 0; // resident bytes of the pathways before pruning (see MemReport)
+        size_t BytesAfter = 0; // and after
+        double Msec = 0; // time spent pruning
+
+        void Add(const PruneReport &pr);
+        int Pruned();
+        size_t BytesSaved();
+        float SynFrac();
+        std::string String();
+    };
+
     struct Layer;
     struct Path: emer::Path {
         // sending layer for this pathway.
@@ -235,45 +316,118 @@ namespace leabra {
 
         // synaptic state values, ordered by the sending layer
         // units which owns them -- one-to-one with SConIndex array.
+        // Empty if this pathway is Tied to another (see TiedTo), and only
+        // the kernel of synapses if Shared (see Kernel).
         std::vector<Synapse> Syns;
 
+        // share one set of synapses with the reciprocal pathway (Send and
+        // Recv reversed), instead of each having its own copy that is only
+        // made symmetric by InitWtSym. Must be set on both pathways, which
+        // must share their connection indexes (see Conns). The pathway from
+        // the lower to the higher layer owns the synapses, and the other
+        // uses them through the reciprocal index mapping: the raw DWt of
+        // both directions are summed, and the owner applies its Norm,
+        // Momentum and Lrate to the sum once (see Network.Dwt) and then
+        // WtFromDWt. Takes effect at the next InitWeights.
+        bool Tied;
+
+        // for a Tied pathway that does not own its synapses, the pathway
+        // that does, and the index in its Syns of each synapse of this
+        // pathway, in send order.
+        Path *TiedTo;
+        std::span<const int> TiedSynIndex;
+
+        // share one kernel of synapses among all of the receiving pools,
+        // indexed by position in the receptive field, instead of each pool
+        // having its own -- a convolution. Requires a paths.PoolTile
+        // pattern. The DWt of all the pools using each kernel synapse is
+        // averaged into its DWt. Takes effect at the next InitWeights.
+        bool Shared;
+
+        // for a Shared pathway, the layout of the kernel in Syns
+        std::shared_ptr<const paths::PoolKernel> Kernel;
+
+        // per kernel synapse DWt sums and counts, for DWt when Shared
+        std::vector<Real> kernelDWt;
+        std::vector<int> kernelDWtN;
+
         // scaling factor for integrating synaptic input conductances (G's).
         // computed in AlphaCycInit, incorporates running-average activity levels.
-        float GScale;
+        Real GScale;
 
         // local per-recv unit increment accumulator for synaptic
         // conductance from sending units. goes to either GeRaw or GiRaw
         // on neuron depending on pathway type.
-        std::vector<float>  GInc;
+        std::vector<Real> GInc;
+
+        // SendGDelta has added to GInc since the last RecvGInc, which
+        // otherwise has nothing to do.
+        bool GIncSent;
+
+        // flags for each block of GIncBlock recv units that SendGDelta may
+        // have added to since the last RecvGInc, which only visits those.
+        std::vector<char> GIncBlks;
+        static constexpr int GIncBlock = 64;
+
+        // the recv units of each sending unit are in increasing order in
+        // SConIndex, so SendGDelta only marks the GIncBlks from its first to
+        // its last, else all of them.
+        bool SConSorted;
 
         // weight balance state variables for this pathway, one per recv neuron.
         std::vector<WtBalRecvPath> WbRecv;
 
+        // the WbRecv SumWt and SumN are up to date, for WtBal.AvgThr = WbSumThr,
+        // so WtBalFromWt does not need to go through all of the synapses.
+        // Anything setting weights other than WtFromDWt clears this.
+        bool WbSums;
+        Real WbSumThr;
+
+        // connection indexes built for this pathway: the R* and S* index
+        // lists below are views of these, which are shared with other
+        // pathways of the same pattern and shapes, and with the reciprocal
+        // pathway when ConnsTransposed is set -- see paths.ConnIndexes.
+        std::shared_ptr<const paths::ConnIndexes> Conns;
+
+        // this pathway views Conns transposed, as the reciprocal of the
+        // pathway that they were built for.
+        bool ConnsTransposed;
+
+        // Conns are the full connectivity of the Pattern, as Build got them
+        // from paths.DefaultConnCache (or transposed from the reciprocal),
+        // not pruned ones private to this pathway (see Prune).
+        bool ConnsBuilt;
+
+        // number of the network's pathways viewing Conns, this one included,
+        // among which MemoryReport splits their bytes -- counted by
+        // Network.CountConnsViews at Build and Prune.
+        int ConnsViews;
+
         // number of recv connections for each neuron in the receiving layer,
         // as a flat list.
-        std::vector<int> RConN;
+        std::span<const int> RConN;
 
         // average and maximum number of recv connections in the receiving layer.
         minmax::AvgMax32 RConNAvgMax;
 
         // starting index into ConIndex list for each neuron in
         // receiving layer; list incremented by ConN.
-        std::vector<int> RConIndexSt;
+        std::span<const int> RConIndexSt;
 
         // index of other neuron on sending side of pathway,
         // ordered by the receiving layer's order of units as the
         // outer loop (each start is in ConIndexSt),
         // and then by the sending layer's units within that.
-        std::vector<int> RConIndex;
+        std::span<const int> RConIndex;
 
         // index of synaptic state values for each recv unit x connection,
         // for the receiver pathway which does not own the synapses,
         // and instead indexes into sender-ordered list.
-        std::vector<int> RSynIndex;
+        std::span<const int> RSynIndex;
 
         // number of sending connections for each neuron in the
         // sending layer, as a flat list.
-        std::vector<int> SConN;
+        std::span<const int> SConN;
 
         // average and maximum number of sending connections
         // in the sending layer.
@@ -281,13 +435,63 @@ namespace leabra {
 
         // starting index into ConIndex list for each neuron in
         // sending layer; list incremented by ConN.
-        std::vector<int> SConIndexSt;
+        std::span<const int> SConIndexSt;
 
         // index of other neuron on receiving side of pathway,
         // ordered by the sending layer's order of units as the
         // outer loop (each start is in ConIndexSt), and then
         // by the sending layer's units within that.
-        std::vector<int> SConIndex;
+        std::span<const int> SConIndex;
+
+        // bytes of the connectivity tables that Pattern.Connect produced
+        // during the last Build (0 if the indexes came from the
+        // paths.DefaultConnCache) -- see MemReport.PatternTables.
+        size_t PatternBytes;
+
+        // resident bytes of this pathway at their peak during its last
+        // InitWeights, including the old synapses still held while Share or
+        // Unshare copy them -- see Network.InitWeightsMemHWM.
+        size_t InitWeightsPeak;
+
+        // flags for each sending neuron whose synapses may have changed
+        // since the last incremental checkpoint -- see Checkpointer.
+        std::vector<char> CkptDirty;
+
+        // the rows of Syns given DWt since the last WtFromDWt, each listed
+        // once, so that WtFromDWt only visits those: the synapses of a
+        // sending neuron, or a row of kernel synapses if Shared -- see DWtRow.
+        std::vector<int> DWtRows;
+
+        // flags for the rows in DWtRows
+        std::vector<char> DWtRowMark;
+
+        // this pathway is for inference only: Freeze replaced Syns and the
+        // other learning state with FrozenWt, and learning on it throws.
+        bool Frozen;
+
+        // for a Frozen pathway, the weight of each synapse, in send order,
+        // or of each kernel synapse if Shared.
+        std::vector<Real> FrozenWt;
+
+        // FrozenWt is premultiplied by GScale, as it was when frozen, and
+        // SendGDelta no longer applies GScale.
+        bool FrozenGScale;
+
+        // format of the weights of a Frozen pathway: in FrozenWt if WtF32,
+        // else in FrozenBF16 or FrozenInt8, in the same order.
+        WtQuants FrozenQuant;
+        std::vector<uint16_t> FrozenBF16;
+        std::vector<int8_t> FrozenInt8;
+
+        // for WtInt8, the scale of the weights to each receiving unit,
+        // applied to GInc in RecvGInc, or just one for the whole pathway,
+        // applied to each delta in SendGDelta.
+        std::vector<float> FrozenQScale;
+
+        // the receiving units of each sending unit of this Frozen pathway
+        // are a contiguous range, in order, so SendGDelta adds to a
+        // contiguous span of GInc (e.g., paths.Full).
+        bool FrozenDense;
 
         // TODO:: FINISH initializer
         Path(std::string name = "", std::string cls="");
@@ -295,44 +499,83 @@ namespace leabra {
         void UpdateParams();
         void Defaults();
         int NumSyns();
+
+        // Syn returns synapse i (in send order), which is in TiedTo if Tied,
+        // and in the Kernel if Shared.
+        Synapse &Syn(int i) {
+            if (TiedTo != nullptr) {
+                return TiedTo->Syns[TiedSynIndex[i]];
+            }
+            return Kernel != nullptr ? Syns[Kernel->SynIndex[i]] : Syns[i];
+        };
+        // DWtRow adds row to DWtRows, if it is not there already.
+        void DWtRow(int row) {
+            if (!DWtRowMark[row]) {
+                DWtRowMark[row] = 1;
+                DWtRows.push_back(row);
+            }
+        };
+        void DWtRowsAll();
+        bool Tie(Path &owner);
+        void Untie();
+        Path *TiedBy();
+        bool Share();
+        void Unshare();
         
         // maybe optional...
         int SynIndex(int sidx, int ridx);
         // float SynValue(std::string varNm, int sidx, int ridx);
         // void SetSynValue(std::string varNm, int sidx, int ridx, float val);
 
-        // void WriteWeightsJSON(std::string fileName, int depth);
-        // void WriteWeightsJSON(std::ofstream file, int depth);
-
-        // void SetWeights(std::string fileName);
-        // void SetWeights(std::ifstream file);
+        void WriteWeightsJSON(std::ostream &w, int depth);
+        void SetWeightsMetaData(std::map<std::string, std::string> &md);
+        void SetRecvWeights(int ri, std::vector<int> &si, std::vector<float> &wt);
 
         void Connect(Layer* slay, Layer* rlay, paths::Pattern *pat, PathTypes typ);
         // void Validate(bool logmsg);
         void Build();
-        int SetNIndexSt(std::vector<int> &n, minmax::AvgMax32 &avgmax, std::vector<int> &idxst, tensor::Int32 &tn);
+        void SetNAvgMax(std::span<const int> n, minmax::AvgMax32 &avgmax);
         std::string String();
 
-        void SetScalesRPool(tensor::Tensor<float> scales);
+        void SetScalesRPool(const tensor::Tensor<float> &scales);
         void SetWtsFunc(std::function<float(int si, int ri, tensor::Shape& send, tensor::Shape& recv)> wtFun);
         void SetScalesFunc(std::function<float(int si, int ri, tensor::Shape& send, tensor::Shape& recv)> scaleFun);
         void InitWeightsSyn(Synapse& syn);
         void InitWeights();
         void InitWtSym(Path &rpt);
         void InitGInc();
-        void SendGDelta(int si, float delta);
+        void GIncBlksInit();
+        // GIncMark marks the GIncBlks of recv units st to ed (inclusive), in SendGDelta.
+        void GIncMark(int st, int ed) {
+            GIncSent = true;
+            std::fill(GIncBlks.begin() + st / GIncBlock, GIncBlks.begin() + ed / GIncBlock + 1, 1);
+        };
+        void SendGDelta(int si, Real delta);
+        void SendGDeltaFrozen(int si, Real scdel);
         void RecvGInc();
         // Learn
-        void DWt();
+        void DWt(bool batch = false);
+        void DWtKernel(bool batch = false);
+        void DWtFromBatch();
         void WtFromDWt();
-        void WtBalFromWt();
+        void WtBalSums();
+        int WtBalFromWt(bool check = false);
         void LrateMult(float mult);
+        PruneReport Prune(float thr, float pct = 0);
+        void SetPrunedConns(std::shared_ptr<paths::ConnIndexes> ci);
+        void Freeze(bool gscale = false, WtQuants quant = WtF32, bool pathScale = false);
+        // Reports
+        MemReport MemoryReport();
+        // Checkpoints
+        void WriteCheckpoint(weights::CkptWriter &ck);
+        bool ReadCheckpoint(weights::CkptFile &ck);
+        void CkptClearDirty();
         
         std::string TypeName();
         emer::Layer* SendLayer();
         emer::Layer* RecvLayer();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         // TODO: Make sure this destructor is sufficient (check if Synapses are destroyed properly);
         ~Path() = default;
@@ -342,4 +585,5 @@ namespace leabra {
 
 void pybind_LeabraLayerTypes(pybind11::module_ &m);
 void pybind_LeabraPathTypes(pybind11::module_ &m);
-void pybind_LeabraPath(pybind11::module_ &m);
\ No newline at end of file
+void pybind_LeabraPath(pybind11::module_ &m);
+void pybind_LeabraMemReport(pybind11::module_ &m);
\ No newline at end of file
@@ -9,19 +9,19 @@ namespace leabra {
     // LrnActAvgParams has rate constants for averaging over activations at different time scales,
     // to produce the running average activation values that then drive learning in the XCAL learning rules
     struct LrnActAvgParams: params::StylerObject {
-        float SSTau; // [def: 2,4,7] [min: 1] time constant in cycles, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life), for continuously updating the super-short time-scale avg_ss value -- this is provides a pre-integration step before integrating into the avg_s short time scale -- it is particularly important for spiking -- in general 4 is the largest value without starting to impair learning, but a value of 7 can be combined with m_in_s = 0 with somewhat worse results
-        float STau; // [def: 2] [min: 1] time constant in cycles, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life), for continuously updating the short time-scale avg_s value from the super-short avg_ss value (cascade mode) -- avg_s represents the plus phase learning signal that reflects the most recent past information
-        float MTau; // [def: 10] [min: 1] time constant in cycles, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life), for continuously updating the medium time-scale avg_m value from the short avg_s value (cascade mode) -- avg_m represents the minus phase learning signal that reflects the expectation representation prior to experiencing the outcome (in addition to the outcome) -- the default value of 10 generally cannot be exceeded without impairing learning
-        float LrnM; // [def: 0.1,0] [min: 0] [max: 1] how much of the medium term average activation to mix in with the short (plus phase) to compute the Neuron AvgSLrn variable that is used for the unit's short-term average in learning. This is important to ensure that when unit turns off in plus phase (short time scale), enough medium-phase trace remains so that learning signal doesn't just go all the way to 0, at which point no learning would take place -- typically need faster time constant for updating S such that this trace of the M signal is lost -- can set SSTau=7 and set this to 0 but learning is generally somewhat worse
-        float Init; // [def: 0.15] [min: 0] [max: 1] initial value for average
-        float SSDt; // [view: -] rate = 1 / tau
-        float SDt; // [view: -] rate = 1 / tau
-        float MDt; // [view: -] rate = 1 / tau
-        float LrnS; // [view: -] 1-LrnM
+        Real SSTau; // [def: 2,4,7] [min: 1] time constant in cycles, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life), for continuously updating the super-short time-scale avg_ss value -- this is provides a pre-integration step before integrating into the avg_s short time scale -- it is particularly important for spiking -- in general 4 is the largest value without starting to impair learning, but a value of 7 can be combined with m_in_s = 0 with somewhat worse results
+        Real STau; // [def: 2] [min: 1] time constant in cycles, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life), for continuously updating the short time-scale avg_s value from the super-short avg_ss value (cascade mode) -- avg_s represents the plus phase learning signal that reflects the most recent past information
+        Real MTau; // [def: 10] [min: 1] time constant in cycles, which should be milliseconds typically (roughly, how long it takes for value to change significantly -- 1.4x the half-life), for continuously updating the medium time-scale avg_m value from the short avg_s value (cascade mode) -- avg_m represents the minus phase learning signal that reflects the expectation representation prior to experiencing the outcome (in addition to the outcome) -- the default value of 10 generally cannot be exceeded without impairing learning
+        Real LrnM; // [def: 0.1,0] [min: 0] [max: 1] how much of the medium term average activation to mix in with the short (plus phase) to compute the Neuron AvgSLrn variable that is used for the unit's short-term average in learning. This is important to ensure that when unit turns off in plus phase (short time scale), enough medium-phase trace remains so that learning signal doesn't just go all the way to 0, at which point no learning would take place -- typically need faster time constant for updating S such that this trace of the M signal is lost -- can set SSTau=7 and set this to 0 but learning is generally somewhat worse
+        Real Init; // [def: 0.15] [min: 0] [max: 1] initial value for average
+        Real SSDt; // [view: -] rate = 1 / tau
+        Real SDt; // [view: -] rate = 1 / tau
+        Real MDt; // [view: -] rate = 1 / tau
+        Real LrnS; // [view: -] 1-LrnM
 
-        LrnActAvgParams(float SSTau=2.0, float STau=2.0, float MTau=10.0, float LrnM=0.1, float Init=0.15);
+        LrnActAvgParams(Real SSTau=2.0, Real STau=2.0, Real MTau=10.0, Real LrnM=0.1, Real Init=0.15);
 
-        void AvgsFromAct(float ruAct, float &avgSS, float &avgS, float &avgM, float &avgSLrn);
+        void AvgsFromAct(Real ruAct, Real &avgSS, Real &avgS, Real &avgM, Real &avgSLrn);
 
         void Update();
         void Defaults();
@@ -30,7 +30,7 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~LrnActAvgParams() = default;
     };
@@ -42,21 +42,21 @@ namespace leabra {
     // medium-time-scale average activation at the end of the alpha-cycle.
     // Also computes an adaptive amount of BCM learning, AvgLLrn, based on AvgL.
     struct AvgLParams: params::StylerObject {
-        float Init; // [def: 0.4] [min: 0] [max: 1] initial AvgL value at start of training
-        float Gain; // [def: 1.5,2,2.5,3,4,5] [min: 0] gain multiplier on activation used in computing the running average AvgL value that is the key floating threshold in the BCM Hebbian learning rule -- when using the DELTA_FF_FB learning rule, it should generally be 2x what it was before with the old XCAL_CHL rule, i.e., default of 5 instead of 2.5 -- it is a good idea to experiment with this parameter a bit -- the default is on the high-side, so typically reducing a bit from initial default is a good direction
-        float Min; // [def: 0.2] [min: 0] miniumum AvgL value -- running average cannot go lower than this value even when it otherwise would due to inactivity -- default value is generally good and typically does not need to be changed
-        float Tau; // [def: 10] [min: 1] time constant for updating the running average AvgL -- AvgL moves toward gain*act with this time constant on every alpha-cycle - longer time constants can also work fine, but the default of 10 allows for quicker reaction to beneficial weight changes
-        float LrnMax; // [def: 0.5] [min: 0] maximum AvgLLrn value, which is amount of learning driven by AvgL factor -- when AvgL is at its maximum value (i.e., gain, as act does not exceed 1), then AvgLLrn will be at this maximum value -- by default, strong amounts of this homeostatic Hebbian form of learning can be used when the receiving unit is highly active -- this will then tend to bring down the average activity of units -- the default of 0.5, in combination with the err_mod flag, works well for most models -- use around 0.0004 for a single fixed value (with err_mod flag off)
-        float LrnMin; // [def: 0.0001,0.0004] [min: 0] miniumum AvgLLrn value (amount of learning driven by AvgL factor) -- if AvgL is at its minimum value, then AvgLLrn will be at this minimum value -- neurons that are not overly active may not need to increase the contrast of their weights as much -- use around 0.0004 for a single fixed value (with err_mod flag off)
+        Real Init; // [def: 0.4] [min: 0] [max: 1] initial AvgL value at start of training
+        Real Gain; // [def: 1.5,2,2.5,3,4,5] [min: 0] gain multiplier on activation used in computing the running average AvgL value that is the key floating threshold in the BCM Hebbian learning rule -- when using the DELTA_FF_FB learning rule, it should generally be 2x what it was before with the old XCAL_CHL rule, i.e., default of 5 instead of 2.5 -- it is a good idea to experiment with this parameter a bit -- the default is on the high-side, so typically reducing a bit from initial default is a good direction
+        Real Min; // [def: 0.2] [min: 0] miniumum AvgL value -- running average cannot go lower than this value even when it otherwise would due to inactivity -- default value is generally good and typically does not need to be changed
+        Real Tau; // [def: 10] [min: 1] time constant for updating the running average AvgL -- AvgL moves toward gain*act with this time constant on every alpha-cycle - longer time constants can also work fine, but the default of 10 allows for quicker reaction to beneficial weight changes
+        Real LrnMax; // [def: 0.5] [min: 0] maximum AvgLLrn value, which is amount of learning driven by AvgL factor -- when AvgL is at its maximum value (i.e., gain, as act does not exceed 1), then AvgLLrn will be at this maximum value -- by default, strong amounts of this homeostatic Hebbian form of learning can be used when the receiving unit is highly active -- this will then tend to bring down the average activity of units -- the default of 0.5, in combination with the err_mod flag, works well for most models -- use around 0.0004 for a single fixed value (with err_mod flag off)
+        Real LrnMin; // [def: 0.0001,0.0004] [min: 0] miniumum AvgLLrn value (amount of learning driven by AvgL factor) -- if AvgL is at its minimum value, then AvgLLrn will be at this minimum value -- neurons that are not overly active may not need to increase the contrast of their weights as much -- use around 0.0004 for a single fixed value (with err_mod flag off)
         bool ErrMod; // [def: true] modulate amount learning by normalized level of error within layer
-        float ModMin; // [def: 0.01]  minimum modulation value for ErrMod-- ensures a minimum amount of self-organizing learning even for network / layers that have a very small level of error signal
-        float Dt; // rate = 1 / tau
-        float LrnFact; // (LrnMax - LrnMin) / (Gain - Min)
+        Real ModMin; // [def: 0.01]  minimum modulation value for ErrMod-- ensures a minimum amount of self-organizing learning even for network / layers that have a very small level of error signal
+        Real Dt; // rate = 1 / tau
+        Real LrnFact; // (LrnMax - LrnMin) / (Gain - Min)
 
-        AvgLParams(float init=0.4, float gain=2.5, float min=0.2, float tau=10, float lrnMax=0.5, float lrnMin=0.0001, bool errMod=true, float modMin=0.01);
+        AvgLParams(Real init=0.4, Real gain=2.5, Real min=0.2, Real tau=10, Real lrnMax=0.5, Real lrnMin=0.0001, bool errMod=true, Real modMin=0.01);
 
-        void AvgLFromAvgM(float avgM, float &avgL, float &lrn);
-        float ErrModFromLayErr(float layCosDiffAvg);
+        void AvgLFromAvgM(Real avgM, Real &avgL, Real &lrn);
+        Real ErrModFromLayErr(Real layCosDiffAvg);
         void Defaults();
         void Update();
 
@@ -64,7 +64,7 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~AvgLParams() = default;
     };
@@ -72,13 +72,13 @@ namespace leabra {
     // CosDiffParams specify how to integrate cosine of difference between plus and minus phase activations
     // Used to modulate amount of hebbian learning, and overall learning rate.
     struct CosDiffParams: params::StylerObject {
-        float Tau; // [def: 100] [min: 1] time constant in alpha-cycles (roughly how long significant change takes, 1.4 x half-life) for computing running average CosDiff value for the layer, CosDiffAvg = cosine difference between ActM and ActP -- this is an important statistic for how much phase-based difference there is between phases in this layer -- it is used in standard X_COS_DIFF modulation of l_mix in LeabraConSpec, and for modulating learning rate as a function of predictability in the DeepLeabra predictive auto-encoder learning -- running average variance also computed with this: cos_diff_var
-        float Dt; // rate constant = 1 / Tau
-        float DtC; // complement of rate constant = 1 - Dt
+        Real Tau; // [def: 100] [min: 1] time constant in alpha-cycles (roughly how long significant change takes, 1.4 x half-life) for computing running average CosDiff value for the layer, CosDiffAvg = cosine difference between ActM and ActP -- this is an important statistic for how much phase-based difference there is between phases in this layer -- it is used in standard X_COS_DIFF modulation of l_mix in LeabraConSpec, and for modulating learning rate as a function of predictability in the DeepLeabra predictive auto-encoder learning -- running average variance also computed with this: cos_diff_var
+        Real Dt; // rate constant = 1 / Tau
+        Real DtC; // complement of rate constant = 1 - Dt
 
-        CosDiffParams(float tau=100);
+        CosDiffParams(Real tau=100);
 
-        void AvgVarFromCos(float &avg, float &vr, float cos);
+        void AvgVarFromCos(Real &avg, Real &vr, Real cos);
 
         void Update();
         void Defaults();
@@ -87,18 +87,18 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~CosDiffParams() = default;
     };
 
     // CosDiffStats holds cosine-difference statistics at the layer level
     struct CosDiffStats: params::StylerObject {
-        float Cos = 0; // cosine (normalized dot product) activation difference between ActP and ActM on this alpha-cycle for this layer -- computed by CosDiffFmActs at end of QuarterFinal for quarter = 3
-        float Avg = 0; // running average of cosine (normalized dot product) difference between ActP and ActM -- computed with CosDiff.Tau time constant in QuarterFinal, and used for modulating BCM Hebbian learning (see AvgLrn) and overall learning rate
-        float Var = 0; // running variance of cosine (normalized dot product) difference between ActP and ActM -- computed with CosDiff.Tau time constant in QuarterFinal, used for modulating overall learning rate
-        float AvgLrn = 0; // 1 - Avg and 0 for non-Hidden layers
-        float ModAvgLLrn = 0; // 1 - AvgLrn and 0 for non-Hidden layers -- this is the value of Avg used for AvgLParams ErrMod modulation of the AvgLLrn factor if enabled
+        Real Cos = 0; // cosine (normalized dot product) activation difference between ActP and ActM on this alpha-cycle for this layer -- computed by CosDiffFmActs at end of QuarterFinal for quarter = 3
+        Real Avg = 0; // running average of cosine (normalized dot product) difference between ActP and ActM -- computed with CosDiff.Tau time constant in QuarterFinal, and used for modulating BCM Hebbian learning (see AvgLrn) and overall learning rate
+        Real Var = 0; // running variance of cosine (normalized dot product) difference between ActP and ActM -- computed with CosDiff.Tau time constant in QuarterFinal, used for modulating overall learning rate
+        Real AvgLrn = 0; // 1 - Avg and 0 for non-Hidden layers
+        Real ModAvgLLrn = 0; // 1 - AvgLrn and 0 for non-Hidden layers -- this is the value of Avg used for AvgLParams ErrMod modulation of the AvgLLrn factor if enabled
 
         CosDiffStats();
         void Init();
@@ -107,7 +107,7 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~CosDiffStats() = default;
     };
@@ -132,7 +132,7 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~LearnNeurParams() = default;
     };
@@ -141,38 +141,38 @@ namespace leabra {
     // which is the standard learning equation for leabra.
     struct XCalParams: params::StylerObject {
         // multiplier on learning based on the medium-term floating average threshold which produces error-driven learning -- this is typically 1 when error-driven learning is being used, and 0 when pure Hebbian learning is used. The long-term floating average threshold is provided by the receiving unit
-        float MLrn;// `default:"1" min:"0"`
+        Real MLrn;// `default:"1" min:"0"`
 
         // if true, set a fixed AvgLLrn weighting factor that determines how much of the long-term floating average threshold (i.e., BCM, Hebbian) component of learning is used -- this is useful for setting a fully Hebbian learning connection, e.g., by setting MLrn = 0 and LLrn = 1. If false, then the receiving unit's AvgLLrn factor is used, which dynamically modulates the amount of the long-term component as a function of how active overall it is
         bool SetLLrn; // `default:"false"`
 
         // fixed l_lrn weighting factor that determines how much of the long-term floating average threshold (i.e., BCM, Hebbian) component of learning is used -- this is useful for setting a fully Hebbian learning connection, e.g., by setting MLrn = 0 and LLrn = 1.
-        float LLrn;
+        Real LLrn;
 
         // proportional point within LTD range where magnitude reverses to go back down to zero at zero -- err-driven svm component does better with smaller values, and BCM-like mvl component does better with larger values -- 0.1 is a compromise
-        float DRev; // `default:"0.1" min:"0" max:"0.99"`
+        Real DRev; // `default:"0.1" min:"0" max:"0.99"`
 
         // minimum LTD threshold value below which no weight change occurs -- this is now *relative* to the threshold
-        float DThr; // `default:"0.0001,0.01" min:"0"`
+        Real DThr; // `default:"0.0001,0.01" min:"0"`
 
         // xcal learning threshold -- don't learn when sending unit activation is below this value in both phases -- due to the nature of the learning function being 0 when the sr coproduct is 0, it should not affect learning in any substantial way -- nonstandard learning algorithms that have different properties should ignore it
-        float LrnThr; // `default:"0.01"`
+        Real LrnThr; // `default:"0.01"`
 
         // -(1-DRev)/DRev -- multiplication factor in learning rule -- builds in the minus sign!
-        float DRevRatio;
+        Real DRevRatio;
 
-        XCalParams(float mLrn = 1, bool setLLrn = false, float lLrn = 1, float dRev = 0.1, float dThr = 0.0001, float lrnThr = 0.01);
+        XCalParams(Real mLrn = 1, bool setLLrn = false, Real lLrn = 1, Real dRev = 0.1, Real dThr = 0.0001, Real lrnThr = 0.01);
 
         void Update();
         void Defaults();
-        float DWt(float srval, float thrP);
-        float LongLrate(float avgLLrn);
+        Real DWt(Real srval, Real thrP);
+        Real LongLrate(Real avgLLrn);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~XCalParams() = default;
     };
@@ -180,67 +180,67 @@ namespace leabra {
     // WtSigParams are sigmoidal weight contrast enhancement function parameters
     struct WtSigParams: params::StylerObject {
         // gain (contrast, sharpness) of the weight contrast function (1 = linear)
-        float Gain; // `default:"1,6" min:"0"`
+        Real Gain; // `default:"1,6" min:"0"`
 
         // offset of the function (1=centered at .5, >1=higher, <1=lower) -- 1 is standard for XCAL
-        float Off; // `default:"1" min:"0"`
+        Real Off; // `default:"1" min:"0"`
 
         // apply exponential soft bounding to the weight changes
         bool SoftBound; // `default:"true"`
 
-        WtSigParams(float gain = 6, float off= 1, bool softBound = true);
+        WtSigParams(Real gain = 6, Real off= 1, bool softBound = true);
 
         void Update();
         void Defaults();
-        float SigFromLinWt(float lw);
-        float LinFromSigWt(float sw);
+        Real SigFromLinWt(Real lw);
+        Real LinFromSigWt(Real sw);
         
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~WtSigParams() = default;
     };
-    float SigFun(float w, float gain, float off);
-    float SigInvFun(float w, float gain, float off);
-    float SigFun61(float w);
-    float SigInvFun61(float w);
+    Real SigFun(Real w, Real gain, Real off);
+    Real SigInvFun(Real w, Real gain, Real off);
+    Real SigFun61(Real w);
+    Real SigInvFun61(Real w);
 
     struct DWtNormParams: params::StylerObject {
         // whether to use dwt normalization, only on error-driven dwt component, based on pathway-level max_avg value -- slowly decays and instantly resets to any current max
         bool On; //  `default:"true"`
 
         // time constant for decay of dwnorm factor -- generally should be long-ish, between 1000-10000 -- integration rate factor is 1/tau
-        float DecayTau; //  `min:"1" default:"1000,10000"`
+        Real DecayTau; //  `min:"1" default:"1000,10000"`
 
         // minimum effective value of the normalization factor -- provides a lower bound to how much normalization can be applied
-        float NormMin; //  `min:"0" default:"0.001"`
+        Real NormMin; //  `min:"0" default:"0.001"`
 
         // overall learning rate multiplier to compensate for changes due to use of normalization -- allows for a common master learning rate to be used between different conditions -- 0.1 for synapse-level, maybe higher for other levels
-        float LrComp; //  `min:"0" default:"0.15"`
+        Real LrComp; //  `min:"0" default:"0.15"`
 
         // record the avg, max values of err, bcm hebbian, and overall dwt change per con group and per pathway
         bool Stats; //  `default:"false"`
 
         // rate constant of decay = 1 / decay_tau
-        float DecayDt;  
+        Real DecayDt;  
 
         // complement rate constant of decay = 1 - (1 / decay_tau)
-        float DecayDtC;
+        Real DecayDtC;
 
-        DWtNormParams(bool on = true, float decayTau = 1000, float lrComp = 0.15, float normMin = 0.001, bool stats = false);
+        DWtNormParams(bool on = true, Real decayTau = 1000, Real lrComp = 0.15, Real normMin = 0.001, bool stats = false);
 
         void Update();
         void Defaults();
-        float NormFromAbsDWt(float &norm, float absDwt);
+        Real NormFromAbsDWt(Real &norm, Real absDwt);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~DWtNormParams() = default;
     };
@@ -252,28 +252,28 @@ namespace leabra {
         bool On; // bool `default:"true"`
 
         // time constant factor for integration of momentum -- 1/tau is dt (e.g., .1), and 1-1/tau (e.g., .95 or .9) is traditional momentum time-integration factor
-        float MTau; // `min:"1" default:"10"`
+        Real MTau; // `min:"1" default:"10"`
 
         // overall learning rate multiplier to compensate for changes due to JUST momentum without normalization -- allows for a common master learning rate to be used between different conditions -- generally should use .1 to compensate for just momentum itself
-        float LrComp; // `min:"0" default:"0.1"`
+        Real LrComp; // `min:"0" default:"0.1"`
 
         // rate constant of momentum integration = 1 / m_tau
-        float MDt;
+        Real MDt;
 
         // complement rate constant of momentum integration = 1 - (1 / m_tau)
-        float MDtC;
+        Real MDtC;
 
-        MomentumParams(bool on = true, float mTau = 10, float lrComp = 0.1);
+        MomentumParams(bool on = true, Real mTau = 10, Real lrComp = 0.1);
 
         void Update(){MDt = 1/MTau; MDtC = 1 - MDt;};
         void Defaults();
-        float MomentFromDWt(float &moment, float dwt);
+        Real MomentFromDWt(Real &moment, Real dwt);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~MomentumParams() = default;
     };
@@ -290,31 +290,31 @@ namespace leabra {
         bool Targs;
 
         // threshold on weight value for inclusion into the weight average that is then subject to the further HiThr threshold for then driving a change in weight balance -- this AvgThr allows only stronger weights to contribute so that weakening of lower weights does not dilute sensitivity to number and strength of strong weights
-        float AvgThr; // `default:"0.25"`
+        Real AvgThr; // `default:"0.25"`
 
         // high threshold on weight average (subject to AvgThr) before it drives changes in weight increase vs. decrease factors
-        float HiThr; // `default:"0.4"`
+        Real HiThr; // `default:"0.4"`
 
         // gain multiplier applied to above-HiThr thresholded weight averages -- higher values turn weight increases down more rapidly as the weights become more imbalanced
-        float HiGain; // `default:"4"`
+        Real HiGain; // `default:"4"`
 
         // low threshold on weight average (subject to AvgThr) before it drives changes in weight increase vs. decrease factors
-        float LoThr; // `default:"0.4"`
+        Real LoThr; // `default:"0.4"`
 
         // gain multiplier applied to below-lo_thr thresholded weight averages -- higher values turn weight increases up more rapidly as the weights become more imbalanced -- generally beneficial but sometimes not -- worth experimenting with either 6 or 0
-        float LoGain; // `default:"6,0"`
+        Real LoGain; // `default:"6,0"`
 
-        WtBalParams(float on = true, bool targs = false, float avgThr = 0.25, float hiThr = 0.4, float hiGain = 4, float loThr = 0.4, float loGain = 6);
+        WtBalParams(Real on = true, bool targs = false, Real avgThr = 0.25, Real hiThr = 0.4, Real hiGain = 4, Real loThr = 0.4, Real loGain = 6);
 
         void Update();
         void Defaults();
-        std::tuple<float, float, float> WtBal(float wbAvg);
+        std::tuple<Real, Real, Real> WtBal(Real wbAvg);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~WtBalParams() = default;
     };
@@ -325,10 +325,10 @@ namespace leabra {
         bool Learn;
 
         // current effective learning rate (multiplies DWt values, determining rate of change of weights)
-        float Lrate;
+        Real Lrate;
 
         // initial learning rate -- this is set from Lrate in UpdateParams, which is called when Params are updated, and used in LrateMult to compute a new learning rate for learning rate schedules.
-        float LrateInit;
+        Real LrateInit;
 
         // parameters for the XCal learning rule
         XCalParams XCal;
@@ -345,21 +345,21 @@ namespace leabra {
         // parameters for balancing strength of weight increases vs. decreases
         WtBalParams WtBal;
 
-        LearnSynParams(bool learn = true, float lrate = 0.04);
+        LearnSynParams(bool learn = true, Real lrate = 0.04);
 
         void Update();
         void Defaults();
         void LWtFromWt(Synapse& syn);
         void WtFromLWt(Synapse& syn);
-        std::tuple<float, float> CHLdWt(float suAvgSLrn, float suAvgM, float ruAvgSLrn, float ruAvgM, float ruAvgL);
-        float BCMdWt(float suAvgSLrn, float ruAvgSLrn, float ruAvgL);
-        void WtFromDWt(float wbInc, float wbDec, float &dwt, float &wt, float &lwt, float scale);
+        std::tuple<Real, Real> CHLdWt(Real suAvgSLrn, Real suAvgM, Real ruAvgSLrn, Real ruAvgM, Real ruAvgL);
+        Real BCMdWt(Real suAvgSLrn, Real ruAvgSLrn, Real ruAvgL);
+        void WtFromDWt(Real wbInc, Real wbDec, Real &dwt, Real &wt, Real &lwt, Real scale);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~LearnSynParams() = default;
     };
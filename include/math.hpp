@@ -10,8 +10,8 @@ namespace math {
         float X, Y, Z;
 
         Vector3();
-        Vector3(int scalar);
-        Vector3(int x, int y, int z);
+        Vector3(float scalar);
+        Vector3(float x, float y, float z);
 
         Vector3 Min(Vector3 other);
         void SetMin(Vector3 other);
@@ -24,8 +24,8 @@ namespace math {
         float X, Y;
 
         Vector2();
-        Vector2(int scalar);
-        Vector2(int x, int y);
+        Vector2(float scalar);
+        Vector2(float x, float y);
 
         Vector2 Sub(Vector2 other);
         Vector2 Add(Vector2 other);
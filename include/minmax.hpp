@@ -3,48 +3,58 @@
 
 namespace minmax {
 
-    // F32 represents a min / max range for float32 values.
+    // MinMax represents a min / max range for values of type T.
     // Supports clipping, renormalizing, etc
-    struct F32 {
-        float Max;
-        float Min;
+    template <typename T>
+    struct MinMax {
+        T Max;
+        T Min;
 
-        void Set(float mn, float mx);
+        void Set(T mn, T mx);
         void SetInfinity();
         bool IsValid();
-        bool InRange(float val);
-        bool IsLow(float val);
-        bool IsHigh(float val);
-        float Range();
-        float Scale();
-        float Midpoint();
-        float FitValInRange(float val);
-        float NormValue(float val);
-        float ProjValue(float val);
-        float ClipValue(float val);
-        float ClipNormValue(float val);
+        bool InRange(T val);
+        bool IsLow(T val);
+        bool IsHigh(T val);
+        T Range();
+        T Scale();
+        T Midpoint();
+        T FitValInRange(T val);
+        T NormValue(T val);
+        T ProjValue(T val);
+        T ClipValue(T val);
+        T ClipNormValue(T val);
         std::string String();
-        bool FitInRange(F32 oth);
+        bool FitInRange(MinMax oth);
     };
     
+    // F32 represents a min / max range for float32 values.
+    using F32 = MinMax<float>;
+    // F64 represents a min / max range for float64 values.
+    using F64 = MinMax<double>;
+
     // AvgMax holds average and max statistics
-    struct AvgMax32 {
-        float Avg;
-        float Max;
-        float Sum; // sum for computing average
+    template <typename T>
+    struct AvgMax {
+        T Avg;
+        T Max;
+        T Sum; // sum for computing average
         int MaxIndex; // index of max item
         int N; // number of items in sum
         int pad;
         int pad1;
         int pad2;
-        AvgMax32();
-        void UpdateValue(float val, int idx);
-        void UpdateFromOther(int oSum, float oMax, int oN, int oMaxIndex);
+        AvgMax();
+        void UpdateValue(T val, int idx);
+        void UpdateFromOther(int oSum, T oMax, int oN, int oMaxIndex);
         void CalcAvg();
         std::string String();
-        void CopyFrom(AvgMax32* oth);
+        void CopyFrom(AvgMax* oth);
 
         void Init();
     };
-    
-}
\ No newline at end of file
+
+    using AvgMax32 = AvgMax<float>;
+    using AvgMax64 = AvgMax<double>;
+
+} // namespace minmax
@@ -2,6 +2,8 @@
 #include <string>
 #include <vector>
 #include <tuple>
+#include <thread>
+#include <memory>
 #include <pybind11/pybind11.h>
 #include "tensor.hpp"
 #include "emer.hpp"
@@ -18,6 +20,12 @@ namespace leabra {
         int NThreads;
         int WtBalInterval; // how frequently to update the weight balance average weight factor -- relatively expensive.
         int WtBalCtr; // counter for how long it has been since last WtBal.
+        bool WtBalCheck; // check the running WtBal sums of the pathways against a full recompute in each WtBalFromWt (slow: for testing)
+        int WtBalErrs; // number of receiving units whose running WtBal sums did not match, with WtBalCheck
+        size_t BuildMemHWM; // high-water mark of network memory (bytes) reached during the last Build, including transient pattern tables
+        size_t InitWeightsMemHWM; // high-water mark of network memory (bytes) reached during the last InitWeights, including synapses being copied (see Path.InitWeightsPeak)
+        bool Frozen; // inference only: the pathways have dropped their learning state (see Freeze)
+        uint64_t StructGen; // generation of the synapse layout, incremented by Build, Prune and loading pruned connections, so that Checkpointer starts a new base
 
         Network(std::string name, int wtBalInterval = 10);
 
@@ -39,6 +47,7 @@ namespace leabra {
         Path* LateralConnectLayer(Layer* lay, paths::Pattern *pat);
         Path* LateralConnectLayerPath(Layer* lay, paths::Pattern *pat, Path* pt);
         void Build();
+        void CountConnsViews();
         // std::tuple<int,int> VarRange(std::string varName); // VarRange returns the min / max values for given variable
 
         void AlphaCycInit(bool updtActAvg);
@@ -49,13 +58,17 @@ namespace leabra {
         void InhibFromGeAct(Context* ctx);
         void ActFromG(Context* ctx);
         void AvgMaxAct(Context* ctx);
+        Real ActDelMax();
         void QuarterFinal(Context* ctx);
         void MinusPhase(Context* ctx);
         void PlusPhase(Context* ctx);
         // Learn Methods
-        void Dwt();
+        void Dwt(bool batch = false);
+        void DWtFromBatch();
         void WtFromDwt();
         void LrateMult(float mult);
+        PruneReport Prune(float thr, float pct = 0, std::vector<std::string> paths = {});
+        MemReport Freeze(bool gscale = false, WtQuants quant = WtF32, bool pathScale = false);
         // Init Methods
         void InitWeights();
         void InitTopoScales();
@@ -68,7 +81,57 @@ namespace leabra {
         // Lesion Methods
         void LayersSetOff(bool off);
         void UnLesionNeurons();
-        
+        // Reports
+        MemReport MemoryReport();
+        // Checkpoints
+        void SaveCheckpoint(std::string fileName, bool learnState = false);
+        void LoadCheckpoint(std::string fileName);
+    };
+
+    // Checkpointer writes a chain of incremental weight checkpoints for a
+    // network, to files named <Prefix>-<seq>.wts (see weights::CkptFileName).
+    // Every FullEvery'th checkpoint (starting with the first) is a full base,
+    // and the others only hold the sending rows that learned since the
+    // previous one. A Build or Prune of the network since the last base
+    // changes the synapse layout, so the next checkpoint is a new base. Any checkpoint in the chain can be turned back into a full
+    // checkpoint with weights::RebuildCheckpoint.
+    // Save takes a snapshot of the state to write, and the file is written by
+    // a background thread while the simulation continues.
+    struct Checkpointer {
+        Network *Net;
+        std::string Prefix; // file name prefix for the chain
+        int FullEvery; // write a full base checkpoint every this many checkpoints
+        bool LearnState; // also save DWt, Norm and Moment -- see Network.SaveCheckpoint
+        uint64_t Seq; // sequence number of the last checkpoint saved, 0 if none
+        uint64_t BaseSeq; // sequence number of the last full base, 0 if none
+        uint64_t BaseGen; // Net.StructGen when the last full base was saved
+        std::thread Writer; // background thread writing the last checkpoint
+        std::string WriteErr; // error from the last background write, if any
+
+        Checkpointer(Network *net, std::string prefix, int fullEvery = 10, bool learnState = false);
+        ~Checkpointer();
+
+        std::string Save();
+        void Wait();
+    };
+
+    // PruneSchedule prunes the synapses of a network during training
+    // (see Network.Prune), every Interval epochs from epoch Start up to Stop.
+    // Each time, it removes the synapses with Wt below Thr, or if Pct > 0,
+    // the proportion Pct of the remaining synapses with the smallest Wt.
+    struct PruneSchedule {
+        bool On = false;
+        int Start = 10; // first epoch to prune after
+        int Interval = 10; // epochs between prunings
+        int Stop = 0; // last epoch to prune after, 0 for no limit
+        float Thr = 0.05; // prune synapses with Wt below this
+        float Pct = 0; // if > 0, prune this proportion (0-1) of the synapses instead of using Thr
+        std::vector<std::string> Paths; // names of the pathways to prune, all of them if empty
+        PruneReport Last; // report of the last pruning
+        PruneReport Total; // sum of the reports of all the prunings
+
+        bool Due(int epoch);
+        PruneReport Epoch(Network &net, int epoch);
     };
     
 } // namespace leabra
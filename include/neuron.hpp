@@ -2,6 +2,7 @@
 
 #include <vector>
 #include "params.hpp"
+#include "real.hpp"
 
 namespace leabra {
     enum NeurFlags{ // NeurFlags are bit-flags encoding relevant binary state for neurons
@@ -16,44 +17,44 @@ namespace leabra {
     // rate-code only and no optional features at all.
     // All variables accessible via Unit interface must be float32 and start at the top, in contiguous order
     struct Neuron: params::StylerObject {
-        NeurFlags Flags;
+        NeurFlags Flags = NeurFlags(0);
         int SubPool = 0;
-        float Act = 0;
-        float ActLrn = 0;
-        float Ge = 0;
-        float Gi = 0;
-        float Gk = 0;
-        float Inet = 0;
-        float Vm = 0;
-        float Targ = 0;
-        float Ext = 0;
-        float AvgSS = 0;
-        float AvgS = 0;
-        float AvgM = 0;
-        float AvgL = 0;
-        float AvgLLrn = 0;
-        float AvgSLrn = 0;
-        float ActQ0 = 0;
-        float ActQ1 = 0;
-        float ActQ2 = 0;
-        float ActQM = 0;
-        float ActM = 0;
-        float ActP = 0;
-        float ActDif = 0;
-        float ActDel = 0;
-        float ActAvg = 0;
-        float Noise = 0;
-        float GiSyn = 0;
-        float GiSelf = 0;
-        float ActSent = 0;
-        float GeRaw = 0;
-        float GiRaw = 0;
-        float GknaFast = 0;
-        float GknaMed = 0;
-        float GknaSlow = 0;
-        float Spike = 0;
-        float ISI = 0;
-        float ISIAvg = 0;
+        Real Act = 0;
+        Real ActLrn = 0;
+        Real Ge = 0;
+        Real Gi = 0;
+        Real Gk = 0;
+        Real Inet = 0;
+        Real Vm = 0;
+        Real Targ = 0;
+        Real Ext = 0;
+        Real AvgSS = 0;
+        Real AvgS = 0;
+        Real AvgM = 0;
+        Real AvgL = 0;
+        Real AvgLLrn = 0;
+        Real AvgSLrn = 0;
+        Real ActQ0 = 0;
+        Real ActQ1 = 0;
+        Real ActQ2 = 0;
+        Real ActQM = 0;
+        Real ActM = 0;
+        Real ActP = 0;
+        Real ActDif = 0;
+        Real ActDel = 0;
+        Real ActAvg = 0;
+        Real Noise = 0;
+        Real GiSyn = 0;
+        Real GiSelf = 0;
+        Real ActSent = 0;
+        Real GeRaw = 0;
+        Real GiRaw = 0;
+        Real GknaFast = 0;
+        Real GknaMed = 0;
+        Real GknaSlow = 0;
+        Real Spike = 0;
+        Real ISI = 0;
+        Real ISIAvg = 0;
 
         Neuron();
         
@@ -68,7 +69,7 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~Neuron() = default;
     };
@@ -14,15 +14,38 @@ namespace params {
 
     std::string PathAfterType(std::string path);
 
+    struct StylerObject;
+
+    // ParamField records where a named parameter lives within its owning
+    // StylerObject type: the byte offset from the StylerObject base, and its type.
+    struct ParamField {
+        std::ptrdiff_t Offset;
+        const std::type_info *Type;
+    };
+
+    // ParamRegistry maps parameter names to their fields for a single StylerObject type.
+    // One registry is built per type on first use (see StylerObject::ParamFields),
+    // so individual objects do not carry any maps of their own.
+    struct ParamRegistry {
+        std::map<std::string, ParamField> Fields;
+
+        // Add registers the given member of obj under name
+        template<typename T>
+        void Add(StylerObject *obj, std::string name, T &member) {
+            Fields[name] = ParamField{(char *)&member - (char *)obj, &typeid(T)};
+        }
+
+        size_t Bytes();
+    };
+
+    size_t ParamRegistryBytes();
+
     // The params.Styler interface exposes TypeName, Class, and Name methods
     // that allow the params.Sel CSS-style selection specifier to determine
     // whether a given parameter applies.
     // Adding Set versions of Name and Class methods is a good idea but not
     // needed for this interface, so they are not included here.
     struct StylerObject{
-        std::map<std::string, void*> ParamNameMap;
-        std::map<std::string, const std::type_info*> ParamTypeMap;
-
         // StylerObject();
         virtual ~StylerObject() = default;
 
@@ -45,9 +68,17 @@ namespace params {
         // only in the Sel selector on params.Sel.
         virtual std::string StyleName() = 0;
 
-        // InitParamMaps is overridden for each object and initializes the param maps
-        // that allow the params objects to access and modify params by string name
-        virtual void InitParamMaps() = 0;
+        // InitParamMaps is overridden for each type and registers the params that
+        // can be accessed and modified by string name into the given registry.
+        // It is only called once per type, the first time ParamFields is needed.
+        virtual void InitParamMaps(ParamRegistry &reg) = 0;
+
+        // ParamFields returns the param registry shared by all objects of this type
+        const ParamRegistry &ParamFields();
+
+        // ParamPtr returns a pointer to the named param on this object, and its type,
+        // or nullptr if there is no param of that name.
+        void *ParamPtr(const std::string &name, const std::type_info **typ = nullptr);
 
         // Finds the appropriate parameter to set from the string given
         std::string SetByName(std::string varName, std::string value);
@@ -59,9 +90,43 @@ namespace params {
 
         float GetByPath(std::string path);
 
+        void *FieldByPath(std::string path, const std::type_info **typ);
+
         void *GetStyleObject();
     };
 
+    enum ParamKinds {
+        FloatParam,
+        DoubleParam,
+        IntParam,
+        BoolParam
+    };
+
+    // ParamWrite is a single param assignment that has already been resolved
+    // to the address of a field on a specific object, with its value parsed.
+    // Applying it is just a typed store -- see CompileWrite.
+    struct ParamWrite {
+        void *Ptr; // address of the field to set
+        ParamKinds Kind; // type of the field
+        union {
+            float F;
+            double D;
+            int I;
+            bool B;
+        } Val; // value to store, according to Kind
+
+        void Apply() {
+            switch (Kind) {
+            case FloatParam: *(float *)Ptr = Val.F; break;
+            case DoubleParam: *(double *)Ptr = Val.D; break;
+            case IntParam: *(int *)Ptr = Val.I; break;
+            case BoolParam: *(bool *)Ptr = Val.B; break;
+            }
+        };
+    };
+
+    std::string CompileWrite(StylerObject *obj, std::string path, std::string value, ParamWrite &pw);
+
     // Params is a name-value map for parameter values that can be applied
     // to any numeric type in any object.
     // The name must be a dot-separated path to a specific parameter, e.g., Path.Learn.Lrate
@@ -140,6 +205,8 @@ namespace params {
         std::string ParamValue(std::string param);
 
         bool Apply(std::any obj, bool setMsg);
+        bool ApplyTo(std::any obj, bool setMsg);
+        bool CompileTo(StylerObject *obj, std::vector<ParamWrite> &writes);
         bool TargetTypeMatch(std::any obj);
         bool SelMatch(std::any obj);
     };
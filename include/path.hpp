@@ -1,6 +1,10 @@
 #pragma once
 #include <fstream>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <span>
 #include <pybind11/pybind11.h>
 
 #include "learn.hpp"
@@ -8,6 +12,7 @@
 #include "synapse.hpp"
 #include "tensor.hpp"
 #include "math.hpp"
+#include "weights.hpp"
 
 
 namespace paths {
@@ -42,6 +47,19 @@ namespace paths {
         void Defaults();
     };
 
+    // UnitConsTypes are the ways a Pattern can give its connectivity one
+    // unit at a time -- see Pattern.UnitCons.
+    enum UnitConsTypes {
+        // the pattern only gives its connectivity with Connect
+        NoUnitCons,
+
+        // UnitCons gives the sending units of each receiving unit
+        RecvUnitCons,
+
+        // UnitCons gives the receiving units of each sending unit
+        SendUnitCons,
+    };
+
     // Pattern defines a pattern of connectivity between two layers.
     // The pattern is stored efficiently using a bitslice tensor of binary values indicating
     // presence or absence of connection between two items.
@@ -59,18 +77,50 @@ namespace paths {
         // The same flag should be set to true if the send and recv layers are the same (i.e., a self-connection)
         // often there are some different options for such connections.
         virtual std::tuple<tensor::Int32*, tensor::Int32*, tensor::Bits*> Connect(tensor::Shape &send, tensor::Shape &recv, bool same) = 0;
+
+        // Key returns the pattern type and all of the params that affect its
+        // connectivity, as a string identifying the result of Connect for
+        // given layer shapes -- see ConnCache. Patterns that return "" are
+        // never cached.
+        virtual std::string Key() { return ""; };
+
+        // Transposes returns true if connecting the recv layer to the send
+        // layer always gives the transpose of the connectivity from send to
+        // recv, so a reciprocal pathway can share its connection indexes --
+        // see ConnIndexes.
+        virtual bool Transposes() { return false; };
+
+        // UnitConsType returns how UnitCons gives the connections of each
+        // unit, if the pattern supports it, in which case NewConnIndexes
+        // builds the indexes directly from it, in parallel, without the
+        // recv x send tables of Connect.
+        virtual UnitConsTypes UnitConsType() { return NoUnitCons; };
+
+        // UnitCons sets cons to the sorted indexes of the units connected to
+        // unit ui -- see UnitConsType. It must always give the same result for
+        // the same arguments, and be safe to call concurrently.
+        virtual void UnitCons(tensor::Shape &send, tensor::Shape &recv, bool same, int ui, std::vector<int> &cons) {};
+
+        virtual ~Pattern() = default;
     };
 
     std::tuple<tensor::Int32*, tensor::Int32*, tensor::Bits*> NewTensors(tensor::Shape &send, tensor::Shape &recv);
+    std::tuple<tensor::Int32*, tensor::Int32*, tensor::Bits*> ConnectUnitCons(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same);
+    bool Edge(int &ci, int max, bool wrap);
+
+    struct ConnIndexes;
+    struct PoolKernel;
     
     // Full implements full all-to-all pattern of connectivity between two layers
     struct Full: Pattern {
         std::string type = "Full";
         // if true, and connecting layer to itself (self pathway), then make a self-connection from unit to itself
-        bool SelfCon;
+        bool SelfCon = false;
 
         std::string Name(){return "Full";};
         std::tuple<tensor::Int32*, tensor::Int32*, tensor::Bits*> Connect(tensor::Shape &send, tensor::Shape &recv, bool same);
+        std::string Key();
+        bool Transposes() { return true; };
     };
 
     // PoolTile implements tiled 2D connectivity between pools within layers, where
@@ -82,7 +132,8 @@ namespace paths {
     // the filters and the outer dims are locations filtered.
     // Various initial weight / scaling patterns are also available -- code
     // must specifically apply these to the receptive fields.
-    // TODO IMPLEMENT POOLTILE
+    // All receiving pools can also share one set of weights (see PoolKernel
+    // and leabra.Path.Shared), which makes this a true convolution.
     struct PoolTile: Pattern {
         std::string type = "PoolTile";
 
@@ -116,7 +167,15 @@ namespace paths {
         // min..max range of topographic weight values to generate
         minmax::F32 TopoRange;
 
+        PoolTile();
+        void Defaults();
+        std::string Name(){return "PoolTile";};
+        std::tuple<tensor::Int32*, tensor::Int32*, tensor::Bits*> Connect(tensor::Shape &send, tensor::Shape &recv, bool same);
+        void TilePools(tensor::Shape &send, tensor::Shape &recv, std::function<void(int spi, int rpi, int off)> fun);
+        std::shared_ptr<PoolKernel> Kernel(tensor::Shape &send, tensor::Shape &recv, const ConnIndexes &ci);
+
         bool HasTopoWeights();
+        std::string Key();
 
         void TopoWeights(tensor::Shape &send, tensor::Shape &recv, tensor::Tensor<float> &wts);
 
@@ -125,9 +184,12 @@ namespace paths {
 
         void TopoWeightsSigmoid2D(tensor::Shape &send, tensor::Shape &recv, tensor::Tensor<float> &wts);
         void TopoWeightsSigmoid4D(tensor::Shape &send, tensor::Shape &recv, tensor::Tensor<float> &wts);
-    };
+        std::string TopoKey();
 
-    float gaussWts(int si, int ri, tensor::Shape &send, tensor::Shape &recv);
+        std::tuple<int, int> recvPoolSize(tensor::Shape &recv);
+        void topoWeights(int nfY, int nfX, int sNuY, int sNuX, int rNuY, int rNuX, bool sig, tensor::Tensor<float> &wts);
+        void topoAxis(int rn, int nf, int sn, bool sig, float fpar, float ppar, std::vector<float> &f);
+    };
 
     // Circle implements a circular pattern of connectivity between two layers
     // where the center moves in proportion to receiver position with offset
@@ -165,8 +227,199 @@ namespace paths {
         // if true, and connecting layer to itself (self pathway), then make a self-connection from unit to itself
         bool SelfCon;
 
-        std::function<float (int si, int ri, tensor::Shape &send, tensor::Shape &recv)> GaussWts = gaussWts;
+        Circle();
+        void Defaults();
+        std::string Name(){return "Circle";};
+        std::tuple<tensor::Int32*, tensor::Int32*, tensor::Bits*> Connect(tensor::Shape &send, tensor::Shape &recv, bool same);
+        UnitConsTypes UnitConsType() { return RecvUnitCons; };
+        void UnitCons(tensor::Shape &send, tensor::Shape &recv, bool same, int ri, std::vector<int> &cons);
+        math::Vector2 SendScale(tensor::Shape &send, tensor::Shape &recv);
+        float GaussWts(int si, int ri, tensor::Shape &send, tensor::Shape &recv);
+        std::string Key();
     };
+
+    // UniformRand implements uniform random pattern of connectivity between
+    // two layers, where each receiving unit gets the same number of
+    // connections (fan-in): PCon of the sending units, chosen without
+    // replacement. The random source of each unit is seeded from RandSeed
+    // and the unit index, so the connectivity is fully reproducible,
+    // does not interfere with other random number streams, and does not
+    // depend on the order in which units are connected.
+    struct UniformRand: Pattern {
+        std::string type = "UniformRand";
+
+        // probability of connection (0-1)
+        float PCon;
+
+        // if true, and connecting layer to itself (self pathway), then make a self-connection from unit to itself
+        bool SelfCon;
+
+        // reciprocal connectivity: if true, switch the sending and receiving layers to create a symmetric top-down pathway -- ESSENTIAL to use same RandSeed between two paths to ensure symmetry
+        bool Recip;
+
+        // random seed for the connectivity -- patterns with the same seed
+        // and params connect the same layer shapes the same way
+        int RandSeed;
+
+        UniformRand();
+        void Defaults();
+        std::string Name(){return "UniformRand";};
+        std::tuple<tensor::Int32*, tensor::Int32*, tensor::Bits*> Connect(tensor::Shape &send, tensor::Shape &recv, bool same);
+        UnitConsTypes UnitConsType() { return Recip ? SendUnitCons : RecvUnitCons; };
+        void UnitCons(tensor::Shape &send, tensor::Shape &recv, bool same, int ui, std::vector<int> &cons);
+        std::string Key();
+    };
+
+    // ConnIndexes are the connection index lists of a pathway, built from
+    // the connectivity of a Pattern -- see leabra.Path for each of them.
+    // Pathways only view these lists, so they are shared by all pathways
+    // with the same pattern and shapes (see ConnCache), and a reciprocal
+    // pathway views them transposed: its send side lists are the recv side
+    // lists here and vice-versa, and its RSynIndex is SynRIndex.
+    // The lists are views, of the Built lists, or of a ConnCache file
+    // mapped in File, which is kept open for as long as they are viewed.
+    struct ConnIndexes {
+        std::span<const int> SConN;
+        std::span<const int> SConIndexSt;
+        std::span<const int> SConIndex;
+        std::span<const int> RConN;
+        std::span<const int> RConIndexSt;
+        std::span<const int> RConIndex;
+        std::span<const int> RSynIndex;
+
+        // Lists holds the lists, when built rather than loaded.
+        struct Lists {
+            std::vector<int> SConN;
+            std::vector<int> SConIndexSt;
+            std::vector<int> SConIndex;
+            std::vector<int> RConN;
+            std::vector<int> RConIndexSt;
+            std::vector<int> RConIndex;
+            std::vector<int> RSynIndex;
+        };
+
+        // the lists built by NewConnIndexes (or Path.Prune) -- call View once
+        // they are complete.
+        Lists Built;
+
+        // the cache file the lists are mapped from, if loaded from one
+        std::shared_ptr<weights::CkptFile> File;
+
+        // bytes of the tables that Pattern.Connect produced to build these,
+        // 0 if they came from a cache.
+        size_t PatternBytes = 0;
+
+        // held by a ConnCache, see leabra.Path.Build
+        mutable bool Cached = false;
+
+        void View();
+        void Check(int slen, int rlen) const;
+        uint64_t Sum() const;
+
+        // SynRIndex is the inverse of RSynIndex: the index in recv order of
+        // each synapse in send order, computed on first use.
+        std::span<const int> SynRIndex() const;
+        size_t Bytes() const;
+
+        // storage for SynRIndex
+        mutable std::vector<int> synRIndex;
+        mutable std::once_flag synROnce;
+    };
+
+    // PoolKernel is the one kernel of synapses shared by all the receiving
+    // pools of a PoolTile pathway. Kernel synapses are indexed by the
+    // position (Off) of the sending pool in the receptive field, fy * Size.X
+    // + fx, the sending unit within that pool (sui) and the receiving unit
+    // within its pool (rui): (Off * SNu + sui) * RNu + rui, so the synapses
+    // to all the units of a receiving pool are contiguous.
+    // 2D layers are one pool.
+    struct PoolKernel {
+        // number of units in each sending and receiving pool
+        int SNu = 1;
+        int RNu = 1;
+
+        // number of receptive field positions, Size.X * Size.Y
+        int NOff = 0;
+
+        // the receiving pools connected to each sending pool, in order,
+        // and the position of the sending pool in their receptive fields:
+        // pairs SPoolSt[spi] .. SPoolSt[spi] + SPoolN[spi] of RPool and Off.
+        std::vector<int> SPoolSt;
+        std::vector<int> SPoolN;
+        std::vector<int> RPool;
+        std::vector<int> Off;
+
+        // kernel synapse of each connection, in send order (as in SConIndex)
+        std::vector<int> SynIndex;
+
+        int Len() const { return NOff * SNu * RNu; };
+        size_t Bytes() const;
+    };
+
+    std::shared_ptr<ConnIndexes> NewConnIndexes(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same, int nThreads = 0);
+    std::shared_ptr<ConnIndexes> NewUnitConnIndexes(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same, int nThreads);
+    std::string ConnKey(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same);
+
+    // ConnCache caches the ConnIndexes built for each Pattern and pair of
+    // layer shapes, so that building the same topology again (e.g., in a
+    // parameter sweep) does not need to call Pattern.Connect and index its
+    // results. Entries are keyed by ConnKey: the pattern Key, the send and
+    // recv shapes and whether it is a self pathway.
+    // Built indexes are kept in process, and if Dir is set, also saved to
+    // files there (in the weights checkpoint format), which later processes
+    // map and view in place instead of building. Files are only replaced
+    // by renaming, never rewritten, so a mapped file never changes.
+    struct ConnCache {
+        // use the cache -- if false, Get always builds the indexes
+        bool On = true;
+
+        // directory for cache files, "" to only cache in this process.
+        // The directory must already exist.
+        std::string Dir;
+
+        // number of threads for building the indexes of patterns that
+        // support UnitCons, 0 for one per core
+        int NThreads = 0;
+
+        // number of Get calls served from memory, from Dir, or built
+        int Hits = 0;
+        int FileHits = 0;
+        int Misses = 0;
+
+        std::mutex Mu;
+        std::map<std::string, std::shared_ptr<const ConnIndexes>> Conns;
+
+        std::shared_ptr<const ConnIndexes> Get(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same);
+        void Clear();
+        std::string FileName(const std::string &key);
+        std::shared_ptr<ConnIndexes> Load(const std::string &fileName, const std::string &key, int slen, int rlen);
+        void Save(const std::string &fileName, const std::string &key, const ConnIndexes &ci);
+    };
+
+    // DefaultConnCache is the cache used by leabra.Path.Build.
+    extern ConnCache DefaultConnCache;
+
+    // TopoCache caches the topographic weights computed by
+    // PoolTile.TopoWeights for each set of topographic params (TopoKey) and
+    // pair of layer shapes, which many pathways usually have in common --
+    // see leabra.Network.InitTopoScales.
+    struct TopoCache {
+        // use the cache -- if false, Get always computes the weights
+        bool On = true;
+
+        // number of Get calls served from the cache, or computed
+        int Hits = 0;
+        int Misses = 0;
+
+        std::mutex Mu;
+        std::map<std::string, std::shared_ptr<const tensor::Tensor<float>>> Wts;
+
+        std::shared_ptr<const tensor::Tensor<float>> Get(PoolTile &pt, tensor::Shape &send, tensor::Shape &recv);
+        void Clear();
+    };
+
+    // DefaultTopoCache is the cache used by leabra.Network.InitTopoScales.
+    extern TopoCache DefaultTopoCache;
     
 
 } // namespace paths
@@ -6,9 +6,9 @@ namespace leabra {
 
     // ActAvg are running-average activation levels used for netinput scaling and adaptive inhibition
     struct ActAvg {
-        float ActMAvg; // running-average minus-phase activity -- used for adapting inhibition -- see ActAvgParams.Tau for time constant etc
-        float ActPAvg; // running-average plus-phase activity -- used for synaptic input scaling -- see ActAvgParams.Tau for time constant etc
-        float ActPAvgEff; // ActPAvg * ActAvgParams.Adjust -- adjusted effective layer activity directly used in synaptic input scaling
+        Real ActMAvg; // running-average minus-phase activity -- used for adapting inhibition -- see ActAvgParams.Tau for time constant etc
+        Real ActPAvg; // running-average plus-phase activity -- used for synaptic input scaling -- see ActAvgParams.Tau for time constant etc
+        Real ActPAvgEff; // ActPAvg * ActAvgParams.Adjust -- adjusted effective layer activity directly used in synaptic input scaling
     };
 
     // Pool contains computed values for FFFB inhibition, and various other state values for layers
@@ -19,8 +19,8 @@ namespace leabra {
         int StIndex,
             EdIndex; // starting and ending (exlusive) indexes for the list of neurons in this pool
         fffb::Inhib Inhib; // FFFB inhibition computed values, including Ge and Act AvgMax which drive inhibition
-        minmax::AvgMax32 ActM; // minus phase average and max Act activation values, for ActAvg updt
-        minmax::AvgMax32 ActP; // plus phase average and max Act activation values, for ActAvg updt
+        minmax::AvgMax<Real> ActM; // minus phase average and max Act activation values, for ActAvg updt
+        minmax::AvgMax<Real> ActP; // plus phase average and max Act activation values, for ActAvg updt
         ActAvg ActAvgs; // running-average activation levels used for netinput scaling and adaptive inhibition
 
         Pool();
@@ -30,7 +30,7 @@ namespace leabra {
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~Pool() = default;
     };
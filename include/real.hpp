@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// Real is the scalar type of the network state (Neuron, Synapse, Pool and
+// the params structs) and of the kernels that update it. It is float as in
+// Go, or double when built with PRECISION=double (-DLEABRA_DOUBLE), for
+// validating the numerics. PRECISION=mixed (-DLEABRA_MIXED) keeps float
+// but stores the Synapse state as math::Half (see SynReal).
+#ifdef LEABRA_DOUBLE
+using Real = double;
+#else
+using Real = float;
+#endif
+
+// PrecisionName is the PRECISION the network state was built with.
+#if defined(LEABRA_DOUBLE)
+constexpr const char *PrecisionName = "double";
+#elif defined(LEABRA_MIXED)
+constexpr const char *PrecisionName = "mixed";
+#else
+constexpr const char *PrecisionName = "float";
+#endif
+
+namespace math {
+
+    // Half is an IEEE 754 half precision float, used for storage only:
+    // it converts to and from float, and all arithmetic is done in float.
+    struct Half {
+        uint16_t Bits = 0;
+
+        Half() = default;
+
+        Half(float f) {
+            uint32_t u;
+            std::memcpy(&u, &f, sizeof(u));
+            uint32_t sign = (u >> 16) & 0x8000;
+            uint32_t mag = u & 0x7fffffff;
+            if (mag >= 0x7f800000) { // inf or nan
+                Bits = sign | 0x7c00 | (mag > 0x7f800000 ? 0x200 : 0);
+            } else if (mag >= 0x477ff000) { // rounds past 65504
+                Bits = sign | 0x7c00;
+            } else if (mag < 0x38800000) { // subnormal, rounded by adding 0.5
+                float sub;
+                std::memcpy(&sub, &mag, sizeof(sub));
+                sub += 0.5f;
+                uint32_t su;
+                std::memcpy(&su, &sub, sizeof(su));
+                Bits = sign | (su - 0x3f000000);
+            } else { // round to nearest even
+                mag += 0xc8000fff + ((mag >> 13) & 1);
+                Bits = sign | (mag >> 13);
+            }
+        }
+
+        operator float() const {
+            uint32_t sign = uint32_t(Bits & 0x8000) << 16;
+            uint32_t mag = Bits & 0x7fff;
+            uint32_t u;
+            if (mag >= 0x7c00) { // inf or nan
+                u = sign | 0x7f800000 | ((mag & 0x3ff) << 13);
+            } else if (mag < 0x400) { // subnormal
+                float f = float(mag) * 5.9604645e-8f; // 2^-24
+                std::memcpy(&u, &f, sizeof(u));
+                u |= sign;
+            } else {
+                u = sign | ((mag << 13) + 0x38000000);
+            }
+            float f;
+            std::memcpy(&f, &u, sizeof(f));
+            return f;
+        }
+
+        Half &operator+=(float x) { return *this = float(*this) + x; }
+        Half &operator-=(float x) { return *this = float(*this) - x; }
+        Half &operator*=(float x) { return *this = float(*this) * x; }
+        Half &operator/=(float x) { return *this = float(*this) / x; }
+    };
+
+} // namespace math
+
+// SynReal is the storage type of the Synapse state: math::Half in the
+// mixed PRECISION, else Real.
+#ifdef LEABRA_MIXED
+using SynReal = math::Half;
+#else
+using SynReal = Real;
+#endif
@@ -8,6 +8,7 @@
 #include "pattable.hpp"
 #include "tensor.hpp"
 #include "params.hpp"
+#include "network.hpp"
 
 namespace leabra {
 
@@ -45,7 +46,6 @@ namespace leabra {
         void TableFromFile(std::string fileName);
     };
     
-    struct Network;
     struct Context;
 
     struct Sim {
@@ -56,6 +56,11 @@ namespace leabra {
 
         bool isInitialized;
 
+        int Epoch; // number of epochs trained in the current run
+        PruneSchedule Prune; // synaptic pruning applied after training epochs
+        int BatchSize; // number of training trials whose DWt is summed before each WtFromDwt, 1 to update the weights every trial
+        int BatchN; // number of trials of DWt accumulated since the last WtFromDwt
+
         std::map<std::string, std::vector<float>> EpochSSE; // map of target layer names and their SSE over each epoch
         std::map<std::string, std::vector<float>> TrialSSE; // map of target layer names and their SSE for each trial
         
@@ -72,9 +77,37 @@ namespace leabra {
         void ApplyParams();
 
         void Run(int numEpochs, bool train = true);
+        void EndBatch();
 
         void RecordSSE(); // populates SSEmap with sse from each layer of type "TargetLayer"
     };
+
+    // Inference runs a trained network on one input pattern at a time, for
+    // online use. Inputs are read from, and output activations written to,
+    // buffers bound to layers ahead of time with BindInput and BindOutput,
+    // so that Run makes no heap allocations and no lookups by name.
+    // Run settles the minus phase only, with Ctx.Testing set so that no
+    // learning averages are updated, and ends it early if Ctx.Settle is On.
+    struct Inference {
+        // Binding is a caller-owned buffer of N floats, one per neuron of Lay.
+        struct Binding {
+            Layer *Lay;
+            float *Buf;
+            int N;
+        };
+
+        Network *Net;
+        Context Ctx;
+        int Quarters; // number of quarters of settling, 3 for the minus phase
+        std::vector<Binding> Inputs; // clamped to Ext, whatever the layer Type
+        std::vector<Binding> Outputs; // get the Act of their layer after Run
+
+        Inference(Network *net);
+
+        bool BindInput(std::string layer, float *buf, int n);
+        bool BindOutput(std::string layer, float *buf, int n);
+        int Run();
+    };
     
     
 } // namespace leabra
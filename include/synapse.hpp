@@ -3,6 +3,7 @@
 #include <vector>
 #include <map>
 #include "params.hpp"
+#include "real.hpp"
 
 namespace leabra {
 
@@ -11,24 +12,24 @@ namespace leabra {
     
     // leabra::Synapse holds state for the synaptic connection between neurons
     struct Synapse: params::StylerObject {
-        float Wt;
-        float LWt;
-        float DWt;
-        float Norm;
-        float Moment;
-        float Scale;
+        SynReal Wt;
+        SynReal LWt;
+        SynReal DWt;
+        SynReal Norm;
+        SynReal Moment;
+        SynReal Scale;
 
-        Synapse(){InitParamMaps();};
+        Synapse(){};
 
-        float* SynapseVarByName(std::string varNm);
-        float* VarByName(std::string varNm);
-        void SetVarByName(std::string varNm, float val);
+        SynReal* SynapseVarByName(std::string varNm);
+        SynReal* VarByName(std::string varNm);
+        void SetVarByName(std::string varNm, Real val);
 
         std::string StyleType();
         std::string StyleClass();
         std::string StyleName();
 
-        void InitParamMaps();
+        void InitParamMaps(params::ParamRegistry &reg);
 
         ~Synapse() = default;
     };
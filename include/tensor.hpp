@@ -84,6 +84,7 @@ namespace tensor {
             int nln = Shp.Len();
             Values.resize(nln);
         };
+        virtual ~Tensor() = default;
 
         void SetShape(std::vector<int> sizes, std::vector<std::string> names);
 
@@ -151,6 +152,7 @@ namespace tensor {
 
     std::tuple<int, int, int, int> Projection2DShape(Shape &shp, bool oddRow);
     int Projection2DIndex(Shape &shp, bool oddRow, int row, int col);
+    std::tuple<int, int> Projection2DCoords(Shape &shp, bool oddRow, int idx);
     
     template <typename T>
     void Tensor<T>::SetShape(std::vector<int> sizes, std::vector<std::string> names) {
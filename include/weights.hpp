@@ -0,0 +1,204 @@
+#pragma once
+#include <cstdint>
+#include <pybind11/pybind11.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include "real.hpp"
+
+// weights implements the weights file formats:
+//
+// The binary checkpoint format: a fixed header, a table of contents of named
+// arrays, and the raw arrays themselves, each aligned so that a
+// memory-mapped file can be used in place. Array keys are <Layer>/<Var>
+// for layer state, and <RecvLayer>/<Path>/<Var> for pathway state,
+// e.g., Hidden1/InputToHidden1/Wt. Incremental (CkptDelta) checkpoints
+// also have <RecvLayer>/<Path>/RowSt and RowN arrays for each path, giving
+// the start and length in the full synapse arrays of each sending row that
+// is included, and the synapse arrays (marked by CkptEntry.Rows) hold just
+// those rows, in order, with CkptEntry.FullN the length of the full array
+// they are rows of, so that they are only applied to a base of that layout.
+//
+// The JSON format used by the Go emergent packages: Network -> Layers ->
+// Paths (named by the sending layer, From) -> Rs (one per receiving unit,
+// with the Si sending unit indexes and their Wt values). It is read and
+// written as a stream, so files of any size use constant memory.
+namespace weights {
+
+    // CkptMagic identifies a weights checkpoint file.
+    extern const char CkptMagic[8];
+
+    // CkptVersion is the current version of the checkpoint format.
+    const uint32_t CkptVersion = 2;
+
+    // CkptAlign is the byte alignment of each array in the file.
+    const uint64_t CkptAlign = 64;
+
+    // CkptFlags record the optional state included in a checkpoint.
+    enum CkptFlags {
+        // CkptLearn includes the learning state of synapses (DWt, Norm, Moment),
+        // needed to resume training exactly where it left off.
+        CkptLearn = 1,
+
+        // CkptDelta is an incremental checkpoint, holding only the synapses of the
+        // sending rows that learned since checkpoint PrevSeq, on top of which it
+        // applies -- see RebuildCheckpoint.
+        CkptDelta = 2,
+    };
+
+    // CkptTypes are the element types of checkpoint arrays.
+    enum CkptTypes {
+        CkptFloat32,
+        CkptInt32,
+        CkptUint8,
+        CkptFloat64,
+    };
+
+    // CkptReal is the type of the Real arrays of this build: CkptFloat64 with
+    // PRECISION=double, else CkptFloat32 (Half synapses fit in float32).
+    const CkptTypes CkptReal = sizeof(Real) == sizeof(double) ? CkptFloat64 : CkptFloat32;
+
+    size_t CkptTypeSize(uint32_t typ);
+
+    // CkptHeader is the first 64 bytes of a checkpoint file.
+    struct CkptHeader {
+        char Magic[8];
+        uint32_t Version;
+        uint32_t Flags; // CkptFlags
+        uint64_t NEntries; // number of entries in the table of contents
+        uint64_t TOCOff; // byte offset of the table of contents
+        uint64_t FileSize; // total file size, to detect truncated files
+        uint64_t Seq; // sequence number in a chain of checkpoints, 0 if not in a chain
+        uint64_t PrevSeq; // for a CkptDelta, the Seq of the checkpoint it applies to
+        uint64_t Reserved;
+    };
+
+    // CkptEntry is one table of contents entry: an array of N values at Off.
+    struct CkptEntry {
+        char Key[96]; // null terminated
+        uint32_t Type; // CkptTypes
+        uint32_t Rows; // 1 if the array only holds the rows given by the RowSt and RowN arrays with the same prefix
+        uint64_t Off;
+        uint64_t N;
+        uint64_t FullN; // N, or for Rows, the length of the full array the rows are from
+    };
+
+    static_assert(sizeof(CkptHeader) == 64, "CkptHeader must be 64 bytes");
+    static_assert(sizeof(CkptEntry) == 128, "CkptEntry must be 128 bytes");
+
+    // CkptWriter writes a checkpoint, one array at a time, either directly to
+    // a file, or into memory (Mem) to be written to a file later with SaveMem,
+    // e.g., from a background thread.
+    // Arrays can be written from a contiguous buffer with Add, or gathered from
+    // strided state (e.g., one field of a Synapse) with AddFunc, which streams
+    // through a small buffer so no copy of the whole array is made.
+    struct CkptWriter {
+        std::ofstream File;
+        std::vector<char> Mem; // checkpoint data, when not writing to a file
+        bool InMem;
+        std::vector<CkptEntry> TOC;
+        uint64_t Pos; // current write position
+        uint32_t Flags;
+        uint64_t Seq; // see CkptHeader
+        uint64_t PrevSeq;
+
+        CkptWriter(std::string fileName, uint32_t flags);
+        CkptWriter(uint32_t flags);
+
+        void Add(std::string key, const Real *data, size_t n);
+        void Add(std::string key, const int32_t *data, size_t n);
+        void Add(std::string key, const uint8_t *data, size_t n);
+        void MarkRows(size_t fullN);
+        void Close();
+        void SaveMem(std::string fileName);
+
+        // AddFunc writes an array of n values, value i given by fun(i),
+        // which must return an int32_t or a Real (written as CkptReal).
+        template<typename F>
+        void AddFunc(std::string key, size_t n, F fun) {
+            using V = decltype(fun(size_t(0)));
+            using T = std::conditional_t<std::is_same_v<V, int32_t>, int32_t, Real>;
+            static_assert(std::is_same_v<T, int32_t> || std::is_convertible_v<V, Real>, "AddFunc values must be Real or int32_t");
+            const size_t bufN = 4096;
+            T buf[bufN];
+            Begin(key, n, std::is_same_v<T, Real> ? CkptReal : CkptInt32);
+            for (size_t st = 0; st < n; st += bufN) {
+                size_t ed = std::min(n, st + bufN);
+                for (size_t i = st; i < ed; i++) {
+                    buf[i - st] = T(fun(i));
+                }
+                Write((const char*)buf, (ed - st) * sizeof(T));
+            }
+        }
+
+        void Begin(std::string key, size_t n, CkptTypes typ);
+        void Write(const char *data, size_t n);
+        void Pad();
+    };
+
+    // CkptFile is a read-only memory map of a checkpoint file.
+    // Array returns pointers directly into the mapping, so reading state
+    // makes no copies beyond those done by the caller.
+    struct CkptFile {
+        std::string FileName;
+        int Fd;
+        char *Data;
+        size_t Size;
+        const CkptHeader *Header;
+        std::vector<const CkptEntry*> TOC; // entries in file order
+        std::map<std::string, const CkptEntry*> Entries;
+
+        CkptFile(std::string fileName);
+        ~CkptFile();
+        CkptFile(const CkptFile&) = delete;
+        CkptFile &operator=(const CkptFile&) = delete;
+
+        bool HasFlag(CkptFlags flag);
+        const Real *Array(const std::string &key, size_t &n);
+        const Real *ArrayN(const std::string &key, size_t n);
+        const int32_t *IntArray(const std::string &key, size_t &n);
+        const uint8_t *Bytes(const std::string &key, size_t &n);
+        const void *Entry(const std::string &key, CkptTypes typ, size_t &n);
+    };
+
+    std::string CkptFileName(std::string prefix, uint64_t seq);
+    void RebuildCheckpoint(std::string prefix, uint64_t seq, std::string fileName);
+
+    // JSONReader receives the contents of a JSON weights file, in file order,
+    // as ReadJSON streams through it. MetaData is passed at the end of the
+    // object it belongs to.
+    struct JSONReader {
+        virtual void NetMetaData(std::map<std::string, std::string> &md) {};
+
+        // Layer starts a new layer -- return false to skip its contents.
+        virtual bool Layer(const std::string &name) = 0;
+        virtual void LayerMetaData(std::map<std::string, std::string> &md) {};
+
+        // Path starts a new pathway from the given sending layer, within the
+        // current layer -- return false to skip its contents.
+        virtual bool Path(const std::string &from) = 0;
+        virtual void PathMetaData(std::map<std::string, std::string> &md) {};
+
+        // Recv sets the weights from sending units si for receiving unit ri
+        // in the current pathway.
+        virtual void Recv(int ri, std::vector<int> &si, std::vector<float> &wt) = 0;
+
+        virtual ~JSONReader() = default;
+    };
+
+    void ReadJSON(std::istream &r, JSONReader &rd);
+
+    // JSON writing helpers
+    void Indent(std::ostream &w, int depth);
+    std::string Quote(const std::string &s);
+    void AppendFloat(std::string &buf, float v);
+    void AppendInt(std::string &buf, int v);
+
+} // namespace weights
+
+void pybind_Weights(pybind11::module_ &m);
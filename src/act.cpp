@@ -3,11 +3,10 @@
 #include <vector>
 #include <cmath>
 
-leabra::OptThreshParams::OptThreshParams(float Send, float Delta) {
+leabra::OptThreshParams::OptThreshParams(Real Send, Real Delta) {
     this->Send = Send;
     this->Delta = Delta;
 
-	InitParamMaps();
 }
 
 void leabra::OptThreshParams::Defaults() {
@@ -30,21 +29,17 @@ std::string leabra::OptThreshParams::StyleName() {
     return "";
 }
 
-void leabra::OptThreshParams::InitParamMaps() {
-	ParamNameMap["Send"] = (void*) &Send;
-	ParamNameMap["Delta"] = (void*) &Delta;
-
-	ParamTypeMap["Send"] = &typeid(Send);
-	ParamTypeMap["Delta"] = &typeid(Delta);
+void leabra::OptThreshParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Send", Send);
+	reg.Add(this, "Delta", Delta);
 }
 
-leabra::ActInitParams::ActInitParams(float Decay, float Vm, float Act, float Ge) {
+leabra::ActInitParams::ActInitParams(Real Decay, Real Vm, Real Act, Real Ge) {
     this->Decay = Decay;
     this->Vm = Vm;
     this->Act = Act;
     this->Ge = Ge;
 
-	InitParamMaps();
 }
 
 void leabra::ActInitParams::Defaults() {
@@ -69,24 +64,18 @@ std::string leabra::ActInitParams::StyleName() {
     return "";
 }
 
-void leabra::ActInitParams::InitParamMaps() {
-	ParamNameMap["Decay"] = (void*) &Decay;
-	ParamNameMap["Vm"] = (void*) &Vm;
-	ParamNameMap["Act"] = (void*) &Act;
-	ParamNameMap["Ge"] = (void*) &Ge;
-
-	ParamTypeMap["Decay"] = &typeid(Decay);
-	ParamTypeMap["Vm"] = &typeid(Vm);
-	ParamTypeMap["Act"] = &typeid(Act);
-	ParamTypeMap["Ge"] = &typeid(Ge);
+void leabra::ActInitParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Decay", Decay);
+	reg.Add(this, "Vm", Vm);
+	reg.Add(this, "Act", Act);
+	reg.Add(this, "Ge", Ge);
 }
 
-leabra::DtParams::DtParams(float Integ, float VmTau, float AvgTau) {
+leabra::DtParams::DtParams(Real Integ, Real VmTau, Real AvgTau) {
     this->Integ = Integ;
     this->VmTau = VmTau;
     this->AvgTau = AvgTau;
     Update(); // Initialize derived member variables
-	InitParamMaps();
 }
 
 void leabra::DtParams::Update() {
@@ -95,7 +84,7 @@ void leabra::DtParams::Update() {
     this->AvgDt = 1 / AvgTau;
 }
 
-void leabra::DtParams::GFromRaw(float geRaw, float &ge) {
+void leabra::DtParams::GFromRaw(Real geRaw, Real &ge) {
     ge += GDt * (geRaw - ge);
 }
 
@@ -119,41 +108,32 @@ std::string leabra::DtParams::StyleName() {
     return "";
 }
 
-void leabra::DtParams::InitParamMaps() {
-	ParamNameMap["Integ"] = (void*) &Integ;
-	ParamNameMap["VmTau"] = (void*) &VmTau;
-	ParamNameMap["GTau"] = (void*) &GTau;
-	ParamNameMap["AvgTau"] = (void*) &AvgTau;
-	ParamNameMap["VmDt"] = (void*) &VmDt;
-	ParamNameMap["GDt"] = (void*) &GDt;
-	ParamNameMap["AvgDt"] = (void*) &AvgDt;
-
-	ParamTypeMap["Integ"] = &typeid(Integ);
-	ParamTypeMap["VmTau"] = &typeid(VmTau);
-	ParamTypeMap["GTau"] = &typeid(GTau);
-	ParamTypeMap["AvgTau"] = &typeid(AvgTau);
-	ParamTypeMap["VmDt"] = &typeid(VmDt);
-	ParamTypeMap["GDt"] = &typeid(GDt);
-	ParamTypeMap["AvgDt"] = &typeid(AvgDt);
+void leabra::DtParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Integ", Integ);
+	reg.Add(this, "VmTau", VmTau);
+	reg.Add(this, "GTau", GTau);
+	reg.Add(this, "AvgTau", AvgTau);
+	reg.Add(this, "VmDt", VmDt);
+	reg.Add(this, "GDt", GDt);
+	reg.Add(this, "AvgDt", AvgDt);
 }
 
-leabra::ClampParams::ClampParams(bool Hard, float RangeMax, float Gain, bool Avg, float AvgGain) {
+leabra::ClampParams::ClampParams(bool Hard, Real RangeMax, Real Gain, bool Avg, Real AvgGain) {
     this->Hard = Hard;
-    this->Range.Max = RangeMax; // TODO: check if this Range gets automatically initialized
+    this->Range.Set(0, RangeMax);
     this->Gain = Gain;
     this->Avg = Avg;
     this->AvgGain = AvgGain;
-	InitParamMaps();
 }
 
 // AvgGe computes Avg-based Ge clamping value if using that option.
-float leabra::ClampParams::AvgGe(float ext, float ge) {
+Real leabra::ClampParams::AvgGe(Real ext, Real ge) {
     return AvgGain*Gain*ext + (1-AvgGain)*ge;
 }
 
 void leabra::ClampParams::Defaults() {
     Hard = true;
-	Range.Max = 0.95;
+	Range.Set(0, 0.95);
 	Gain = 0.2;
 	Avg = false;
 	AvgGain = 0.2;
@@ -174,16 +154,11 @@ std::string leabra::ClampParams::StyleName() {
     return "";
 }
 
-void leabra::ClampParams::InitParamMaps() {
-	ParamNameMap["Hard"] = (void*) &Hard;
-	ParamNameMap["Gain"] = (void*) &Gain;
-	ParamNameMap["Avg"] = (void*) &Avg;
-	ParamNameMap["AvgGain"] = (void*) &AvgGain;
-
-	ParamTypeMap["Hard"] = &typeid(Hard);
-	ParamTypeMap["Gain"] = &typeid(Gain);
-	ParamTypeMap["Avg"] = &typeid(Avg);
-	ParamTypeMap["AvgGain"] = &typeid(AvgGain);
+void leabra::ClampParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Hard", Hard);
+	reg.Add(this, "Gain", Gain);
+	reg.Add(this, "Avg", Avg);
+	reg.Add(this, "AvgGain", AvgGain);
 }
 
 leabra::ActNoiseParams::ActNoiseParams(){Type = ActNoiseType::NoNoise; Defaults();}
@@ -210,15 +185,12 @@ std::string leabra::ActNoiseParams::StyleName() {
     return "";
 }
 
-void leabra::ActNoiseParams::InitParamMaps() {
-	ParamNameMap["Type"] = (void*) &Type;
-	ParamNameMap["Fixed"] = (void*) &Fixed;
-
-	ParamTypeMap["Type"] = &typeid(Type);
-	ParamTypeMap["Fixed"] = &typeid(Fixed);
+void leabra::ActNoiseParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Type", Type);
+	reg.Add(this, "Fixed", Fixed);
 }
 
-leabra::WtInitParams::WtInitParams(float mean, float var, float par, rands::RandDists type):
+leabra::WtInitParams::WtInitParams(Real mean, Real var, Real par, rands::RandDists type):
 	Dist(mean, var, par, type){
 
 }
@@ -230,8 +202,7 @@ void leabra::WtInitParams::Defaults() {
 	Sym = true;
 }
 
-leabra::WtScaleParams::WtScaleParams(float abs, float rel): Abs(abs), Rel(rel) {
-	InitParamMaps();
+leabra::WtScaleParams::WtScaleParams(Real abs, Real rel): Abs(abs), Rel(rel) {
 }
 
 void leabra::WtScaleParams::Defaults(){Abs = 1; Rel = 1;}
@@ -239,26 +210,26 @@ void leabra::WtScaleParams::Defaults(){Abs = 1; Rel = 1;}
 void leabra::WtScaleParams::Update() {
 }
 
-float leabra::WtScaleParams::SLayActScale(float savg, float snu, float ncon) {
-    ncon = std::max(ncon, 1.0f); // path Avg can be < 1 in some cases
-	float semExtra = 2;
+Real leabra::WtScaleParams::SLayActScale(Real savg, Real snu, Real ncon) {
+    ncon = std::max(ncon, Real(1)); // path Avg can be < 1 in some cases
+	Real semExtra = 2;
 	int slayActN = int(std::round(savg * snu)); // sending layer actual # active
 	slayActN = std::max(slayActN, 1);
-	float sc;
+	Real sc;
 	if (ncon == snu) {
-		sc = 1 / slayActN;
+		sc = 1 / Real(slayActN);
 	} else {
-		int maxActN = int(std::min(ncon, float(slayActN))); // max number we could get
+		int maxActN = int(std::min(ncon, Real(slayActN))); // max number we could get
 		int avgActN = int(std::round(savg * ncon));           // recv average actual # active if uniform
 		avgActN = std::max(avgActN, 1);
 		int expActN = avgActN + semExtra; // expected
 		expActN = std::min(expActN, maxActN);
-		sc = 1 / float(expActN);
+		sc = 1 / Real(expActN);
 	}
 	return sc;
 }
 
-float leabra::WtScaleParams::FullScale(float savg, float snu, float ncon) {
+Real leabra::WtScaleParams::FullScale(Real savg, Real snu, Real ncon) {
     return Abs * Rel * SLayActScale(savg, snu, ncon);
 }
 
@@ -274,12 +245,9 @@ std::string leabra::WtScaleParams::StyleName() {
     return "";
 }
 
-void leabra::WtScaleParams::InitParamMaps() {
-	ParamNameMap["Abs"] = (void*) &Abs;
-	ParamNameMap["Rel"] = (void*) &Rel;
-
-	ParamTypeMap["Abs"] = &typeid(Abs);
-	ParamTypeMap["Rel"] = &typeid(Rel);
+void leabra::WtScaleParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Abs", Abs);
+	reg.Add(this, "Rel", Rel);
 }
 
 leabra::ActParams::ActParams():
@@ -287,7 +255,6 @@ leabra::ActParams::ActParams():
 		VmRange.Max = 2.0;
 		ErevSubThr.SetFromOtherMinus(Erev, XX1.Thr);
 		ThrSubErev.SetFromMinusOther(XX1.Thr, Erev);
-		InitParamMaps();
 }
 
 void leabra::ActParams::Defaults() {
@@ -368,7 +335,7 @@ void leabra::ActParams::InitActQs(leabra::Neuron &nrn) {
 
 // GeFromRaw integrates Ge excitatory conductance from GeRaw value
 // (can add other terms to geRaw prior to calling this)
-void leabra::ActParams::GeFromRaw(Neuron &nrn, float geRaw) {
+void leabra::ActParams::GeFromRaw(Neuron &nrn, Real geRaw) {
 	if (!Clamp.Hard && nrn.HasFlag(NeurHasExt)) {
 		if (Clamp.Avg) {
 			geRaw = Clamp.AvgGe(nrn.Ext, geRaw);
@@ -389,13 +356,13 @@ void leabra::ActParams::GeFromRaw(Neuron &nrn, float geRaw) {
 
 // GiFromRaw integrates GiSyn inhibitory synaptic conductance from GiRaw value
 // (can add other terms to geRaw prior to calling this)
-void leabra::ActParams::GiFromRaw(Neuron &nrn, float giRaw) {
+void leabra::ActParams::GiFromRaw(Neuron &nrn, Real giRaw) {
 	Dt.GFromRaw(giRaw, nrn.GiSyn);
-	nrn.GiSyn = std::max(nrn.GiSyn, (float)0.0); // negative inhib G doesn't make any sense
+	nrn.GiSyn = std::max(nrn.GiSyn, (Real)0.0); // negative inhib G doesn't make any sense
 }
 
 // InetFromG computes net current from conductances and Vm
-float leabra::ActParams::InetFromG(float vm, float ge, float gi, float gk) {
+Real leabra::ActParams::InetFromG(Real vm, Real ge, Real gi, Real gk) {
 	return ge*(Erev.E-vm) + Gbar.L*(Erev.L-vm) + gi*(Erev.I-vm) + gk*(Erev.K-vm);
 }
 
@@ -403,11 +370,11 @@ float leabra::ActParams::InetFromG(float vm, float ge, float gi, float gk) {
 // The Vm value is only used in pure rate-code computation within the sub-threshold regime
 // because firing rate is a direct function of excitatory conductance Ge.
 void leabra::ActParams::VmFromG(Neuron &nrn) {
-	float ge = nrn.Ge * Gbar.E;
-	float gi = nrn.Gi * Gbar.I;
-	float gk = nrn.Gk * Gbar.K;
+	Real ge = nrn.Ge * Gbar.E;
+	Real gi = nrn.Gi * Gbar.I;
+	Real gk = nrn.Gk * Gbar.K;
 	nrn.Inet = InetFromG(nrn.Vm, ge, gi, gk);
-	float nwVm = nrn.Vm + Dt.VmDt*nrn.Inet;
+	Real nwVm = nrn.Vm + Dt.VmDt*nrn.Inet;
 
 	if (Noise.Type == VmNoise) {
 		nwVm += nrn.Noise;
@@ -417,13 +384,13 @@ void leabra::ActParams::VmFromG(Neuron &nrn) {
 
 // GeThrFromG computes the threshold for Ge based on all other conductances,
 // including Gk.  This is used for computing the adapted Act value.
-float leabra::ActParams::GeThrFromG(Neuron &nrn) {
+Real leabra::ActParams::GeThrFromG(Neuron &nrn) {
     return ((Gbar.I*nrn.Gi*ErevSubThr.I + Gbar.L*ErevSubThr.L + Gbar.K*nrn.Gk*ErevSubThr.K) / ThrSubErev.E);
 }
 
 // GeThrFromGnoK computes the threshold for Ge based on other conductances,
 // excluding Gk.  This is used for computing the non-adapted ActLrn value.
-float leabra::ActParams::GeThrFromGnoK(Neuron &nrn) {
+Real leabra::ActParams::GeThrFromGnoK(Neuron &nrn) {
     return ((Gbar.I*nrn.Gi*ErevSubThr.I + Gbar.L*ErevSubThr.L) / ThrSubErev.E);
 }
 
@@ -433,7 +400,7 @@ void leabra::ActParams::ActFromG(Neuron &nrn) {
 		HardClamp(nrn);
 		return;
 	}
-	float nwAct, nwActLrn;
+	Real nwAct, nwActLrn;
 	if (nrn.Act < XX1.VmActThr && nrn.Vm <= XX1.Thr) {
 		// note: this is quite important -- if you directly use the gelin
 		// the whole time, then units are active right away -- need Vm dynamics to
@@ -441,13 +408,13 @@ void leabra::ActParams::ActFromG(Neuron &nrn) {
 		nwAct = XX1.NoisyXX1(nrn.Vm - XX1.Thr);
 		nwActLrn = nwAct;
 	} else {
-		float ge = nrn.Ge * Gbar.E;
-		float geThr = GeThrFromG(nrn);
+		Real ge = nrn.Ge * Gbar.E;
+		Real geThr = GeThrFromG(nrn);
 		nwAct = XX1.NoisyXX1(ge - geThr);
 		geThr = GeThrFromGnoK(nrn);          // excludes K adaptation effect
 		nwActLrn = XX1.NoisyXX1(ge - geThr); // learning is non-adapted
 	}
-	float &curAct = nrn.Act;
+	Real &curAct = nrn.Act;
 	nwAct = curAct + Dt.VmDt*(nwAct-curAct);
 	nrn.ActDel = nwAct - curAct;
 
@@ -472,7 +439,7 @@ bool leabra::ActParams::HasHardClamp(Neuron &nrn) {
 
 // DecayState decays the activation state toward initial values in proportion to given decay parameter
 // Called with ac.Init.Decay by Layer during AlphaCycInit
-void leabra::ActParams::DecayState(Neuron &nrn, float decay) {
+void leabra::ActParams::DecayState(Neuron &nrn, Real decay) {
 	if (decay > 0) { // no-op for most, but not all..
 		nrn.Act -= decay * (nrn.Act - Init.Act);
 		nrn.Ge -= decay * (nrn.Ge - Init.Ge);
@@ -489,11 +456,11 @@ void leabra::ActParams::DecayState(Neuron &nrn, float decay) {
 // HardClamp clamps activation from external input -- just does it -- use HasHardClamp to check
 // if it should do it.  Also adds any Noise *if* noise is set to ActNoise.
 void leabra::ActParams::HardClamp(Neuron &nrn) {
-	float &ext = nrn.Ext;
+	Real &ext = nrn.Ext;
 	if (Noise.Type == ActNoise) {
 		ext += nrn.Noise;
 	}
-	float clmp = Clamp.Range.ClipValue(ext);
+	Real clmp = Clamp.Range.ClipValue(ext);
 	nrn.Act = clmp + nrn.Noise;
 	nrn.ActLrn = clmp;
 	nrn.Vm = XX1.Thr + nrn.Act/XX1.Gain;
@@ -513,30 +480,17 @@ std::string leabra::ActParams::StyleName() {
     return "";
 }
 
-void leabra::ActParams::InitParamMaps() {
-	ParamNameMap["XX1"] = (void*) &XX1;
-	ParamNameMap["OptThresh"] = (void*) &OptThresh;
-	ParamNameMap["Init"] = (void*) &Init;
-	ParamNameMap["Dt"] = (void*) &Dt;
-	ParamNameMap["Gbar"] = (void*) &Gbar;
-	ParamNameMap["Erev"] = (void*) &Erev;
-	ParamNameMap["Clamp"] = (void*) &Clamp;
-	ParamNameMap["Noise"] = (void*) &Noise;
-	ParamNameMap["VmRange"] = (void*) &VmRange;
-	ParamNameMap["KNa"] = (void*) &KNa;
-	ParamNameMap["ErevSubThr"] = (void*) &ErevSubThr;
-	ParamNameMap["ThrSubErev"] = (void*) &ThrSubErev;
-
-	ParamTypeMap["XX1"] = &typeid(XX1);
-	ParamTypeMap["OptThresh"] = &typeid(OptThresh);
-	ParamTypeMap["Init"] = &typeid(Init);
-	ParamTypeMap["Dt"] = &typeid(Dt);
-	ParamTypeMap["Gbar"] = &typeid(Gbar);
-	ParamTypeMap["Erev"] = &typeid(Erev);
-	ParamTypeMap["Clamp"] = &typeid(Clamp);
-	ParamTypeMap["Noise"] = &typeid(Noise);
-	ParamTypeMap["VmRange"] = &typeid(VmRange);
-	ParamTypeMap["KNa"] = &typeid(KNa);
-	ParamTypeMap["ErevSubThr"] = &typeid(ErevSubThr);
-	ParamTypeMap["ThrSubErev"] = &typeid(ThrSubErev);
+void leabra::ActParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "XX1", XX1);
+	reg.Add(this, "OptThresh", OptThresh);
+	reg.Add(this, "Init", Init);
+	reg.Add(this, "Dt", Dt);
+	reg.Add(this, "Gbar", Gbar);
+	reg.Add(this, "Erev", Erev);
+	reg.Add(this, "Clamp", Clamp);
+	reg.Add(this, "Noise", Noise);
+	reg.Add(this, "VmRange", VmRange);
+	reg.Add(this, "KNa", KNa);
+	reg.Add(this, "ErevSubThr", ErevSubThr);
+	reg.Add(this, "ThrSubErev", ThrSubErev);
 }
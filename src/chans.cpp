@@ -1,11 +1,10 @@
 #include "chans.hpp"
 
-chans::Chans::Chans(float e, float l, float i, float k): E(e), L(l), I(i), K(k){
-    InitParamMaps();
+chans::Chans::Chans(Real e, Real l, Real i, Real k): E(e), L(l), I(i), K(k){
 }
 
 // SetAll sets all the values
-void chans::Chans::SetAll(float e, float l, float i, float k) {
+void chans::Chans::SetAll(Real e, Real l, Real i, Real k) {
     E = e;
     L = l;
     I = i;
@@ -13,7 +12,7 @@ void chans::Chans::SetAll(float e, float l, float i, float k) {
 }
 
 // SetFmOtherMinus sets all the values from other Chans minus given value
-void chans::Chans::SetFromOtherMinus(Chans oth, float minus) {
+void chans::Chans::SetFromOtherMinus(Chans oth, Real minus) {
     E = oth.E - minus;
     L = oth.L - minus;
     I = oth.I - minus;
@@ -21,7 +20,7 @@ void chans::Chans::SetFromOtherMinus(Chans oth, float minus) {
 }
 
 // SetFmMinusOther sets all the values from given value minus other Chans
-void chans::Chans::SetFromMinusOther(float minus, Chans oth) {
+void chans::Chans::SetFromMinusOther(Real minus, Chans oth) {
     E = minus - oth.E;
     L = minus - oth.L;
     I = minus - oth.I;
@@ -40,14 +39,9 @@ std::string chans::Chans::StyleName() {
     return "";
 }
 
-void chans::Chans::InitParamMaps() {
-    ParamNameMap["E"] = (void*) &E;
-    ParamNameMap["L"] = (void*) &L;
-    ParamNameMap["I"] = (void*) &I;
-    ParamNameMap["K"] = (void*) &K;
-
-    ParamTypeMap["E"] = &typeid(E);
-    ParamTypeMap["L"] = &typeid(L);
-    ParamTypeMap["I"] = &typeid(I);
-    ParamTypeMap["K"] = &typeid(K);
+void chans::Chans::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "E", E);
+    reg.Add(this, "L", L);
+    reg.Add(this, "I", I);
+    reg.Add(this, "K", K);
 }
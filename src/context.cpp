@@ -1,21 +1,25 @@
 #include "context.hpp"
+#include <algorithm>
 
 leabra::Context::Context(float timePerCyc, int cycPerQtr): TimePerCyc(timePerCyc), CycPerQtr(cycPerQtr) {
+    Mode = Train;
+    Testing = false;
     Reset();
 }
 
 void leabra::Context::Reset(){ 
     Time=0;
-    Cycle=0;
     CycleTot=0;
-    Quarter=times::Quarters::Q1;
-    PlusPhase=false;
+    AlphaCycStart();
 }
 
 void leabra::Context::AlphaCycStart(){
     Cycle=0; 
     Quarter=times::Quarters::Q1; 
     PlusPhase=false;
+    QuarterCycSt=0;
+    SettledCyc=0;
+    std::fill(QuarterCycles, QuarterCycles + 4, 0);
 }
 
 void leabra::Context::CycleInc(){
@@ -25,9 +29,55 @@ void leabra::Context::CycleInc(){
 }
 
 void leabra::Context::QuarterInc(){
+    QuarterCycles[int(Quarter)] = Cycle - QuarterCycSt;
+    QuarterCycSt = Cycle;
+    SettledCyc = 0;
     Quarter = times::NextQuarter(Quarter);
 }
 
 int leabra::Context::QuarterCycle(){
-    return Cycle - ((int)Quarter * CycPerQtr);
+    return Cycle - QuarterCycSt;
+}
+
+// Settled is called after each cycle with the max |ActDel| over all the
+// layers, and returns true if the current quarter can end now: Settle is
+// On (and not TestOnly while training), and activations have changed by
+// less than Settle.Tol for the last Settle.K cycles, after Settle.MinCyc.
+bool leabra::Context::Settled(float actDelMax){
+    if (!Settle.On || (Settle.TestOnly && Mode == Train)) {
+        return false;
+    }
+    if (actDelMax < Settle.Tol) {
+        SettledCyc++;
+    } else {
+        SettledCyc = 0;
+    }
+    return SettledCyc >= Settle.K && QuarterCycle() >= Settle.MinCyc;
+}
+
+void pybind_LeabraContext(pybind11::module_ &m) {
+    pybind11::class_<leabra::SettleParams>(m, "SettleParams")
+        .def(pybind11::init<>())
+        .def_readwrite("On", &leabra::SettleParams::On)
+        .def_readwrite("TestOnly", &leabra::SettleParams::TestOnly)
+        .def_readwrite("Tol", &leabra::SettleParams::Tol)
+        .def_readwrite("K", &leabra::SettleParams::K)
+        .def_readwrite("MinCyc", &leabra::SettleParams::MinCyc)
+    ;
+
+    pybind11::class_<leabra::Context>(m, "Context")
+        .def(pybind11::init<float, int>(),
+            pybind11::arg("timePerCyc") = 0.001,
+            pybind11::arg("cycPerQtr") = 25
+            )
+        .def_readonly("Time", &leabra::Context::Time)
+        .def_readonly("Cycle", &leabra::Context::Cycle)
+        .def_readonly("CycleTot", &leabra::Context::CycleTot)
+        .def_readwrite("CycPerQtr", &leabra::Context::CycPerQtr)
+        .def_readwrite("Testing", &leabra::Context::Testing)
+        .def_readwrite("Settle", &leabra::Context::Settle)
+        .def_property_readonly("QuarterCycles", [](leabra::Context &ctx) {
+            return std::vector<int>(ctx.QuarterCycles, ctx.QuarterCycles + 4);
+        })
+    ;
 }
@@ -4,6 +4,7 @@
 // submodules. Each c++ object file defines a function for exposing its
 // underlying structs and enums to the python module.
 PYBIND11_MODULE(_culeabra, m) {
+    m.attr("Precision") = PrecisionName; // float, double or mixed (see real.hpp)
 
     // Leabra module definitions
     pybind_LeabraNet(m);
@@ -11,7 +12,9 @@ PYBIND11_MODULE(_culeabra, m) {
     pybind_LeabraLayer(m);
     pybind_LeabraPathTypes(m);
     pybind_LeabraPath(m);
+    pybind_LeabraMemReport(m);
     pybind_LeabraSim(m);
+    pybind_LeabraContext(m);
     
     // Patterns of connections
     pybind11::module_ patterns = m.def_submodule("patterns", "Patterns submodule defines different "
@@ -23,6 +26,10 @@ PYBIND11_MODULE(_culeabra, m) {
     pybind11::module_ params = m.def_submodule("params", "CSS-like methods for defining parameters of the network.");
     pybind_ParamContainers(params);
 
+    // Weights files
+    pybind11::module_ weightsmod = m.def_submodule("weights", "Weights checkpoint files.");
+    pybind_Weights(weightsmod);
+
     // Env
     pybind11::module_ environments = m.def_submodule("environments", "Classes for applying inputs to the network.");
     pybind_LeabraEnv(environments);
@@ -161,14 +161,28 @@ void emer::Network::LayoutBoundsUpdate() {
 // If setMsg is true, then a message is printed to confirm each parameter that is set.
 // it always prints a message if a parameter fails to be set.
 // returns true if any params were set, and error if there were any errors.
+// Selectors are matched through the SelMatchIndex, which is only rebuilt when
+// layer or path names or classes change.
 bool emer::Network::ApplyParams(params::Sheet &pars, bool setMsg) {
 	bool applied = true;
 	std::vector<std::string> errs;
-	// en := nt.EmerNetwork
+	SelIndex &idx = SelMatchIndex();
+	std::vector<std::vector<int>> objSels = idx.SheetMatches(pars);
 	int nlay = NumLayers();
 	for (int li = 0; li < nlay; li++) {
 		emer::Layer &ly = *EmerLayer(li);
-		bool app = ly.ApplyParams(pars, setMsg);
+		int oi = idx.LayerObj[li];
+		bool app = false;
+		if (idx.ApplyObj(pars, objSels[oi], oi, setMsg)) {
+			ly.UpdateParams();
+			app = true;
+		}
+		for (int pi = 0; pi < ly.NumRecvPaths(); pi++) {
+			if (idx.ApplyObj(pars, objSels[oi+1+pi], oi+1+pi, setMsg)) {
+				ly.RecvPath(pi)->UpdateParams();
+				app = true;
+			}
+		}
 		if (!app) {
 			applied = false;
 			break;
@@ -200,13 +214,368 @@ bool emer::Network::ApplyParams(params::Sets &pars, bool setMsg, std::string nam
     return ApplyParams(pars.sheets[name], setMsg);
 }
 
+// CompileParams compiles given parameter style Sheet against the layers and paths
+// in this network -- see CompiledParams. Apply on the result then sets the same
+// values as ApplyParams, without any selector matching or string parsing.
+// Every layer is compiled, including those that come after a layer no Sel applies to.
+// Selectors are matched through the SelMatchIndex.
+emer::CompiledParams emer::Network::CompileParams(params::Sheet &pars) {
+	CompiledParams cp;
+	SelIndex &idx = SelMatchIndex();
+	std::vector<std::vector<int>> objSels = idx.SheetMatches(pars);
+	int nlay = NumLayers();
+	for (int li = 0; li < nlay; li++) {
+		emer::Layer *ly = EmerLayer(li);
+		int oi = idx.LayerObj[li];
+		int wst = cp.Writes.size();
+		if (idx.CompileObj(pars, objSels[oi], oi, cp.Writes)) {
+			cp.Targets.push_back(ParamTarget{ly, nullptr, wst, int(cp.Writes.size()) - wst});
+		}
+		for (int pi = 0; pi < ly->NumRecvPaths(); pi++) {
+			wst = cp.Writes.size();
+			if (idx.CompileObj(pars, objSels[oi+1+pi], oi+1+pi, cp.Writes)) {
+				cp.Targets.push_back(ParamTarget{nullptr, ly->RecvPath(pi), wst, int(cp.Writes.size()) - wst});
+			}
+		}
+	}
+	return cp;
+}
+
+// CompileParams compiles a sheet from the Sets of parameter sheets provided.
+// Defaults to the 'Base' sheet if the name is not provided.
+// If name="ALL" then all the sheets are compiled, in order.
+emer::CompiledParams emer::Network::CompileParams(params::Sets &pars, std::string name) {
+	if (name != "ALL") {
+		return CompileParams(pars.sheets[name]);
+	}
+	CompiledParams cp;
+	for (auto &[name,sheet]: pars.sheets) {
+		CompiledParams scp = CompileParams(sheet);
+		int wst = cp.Writes.size();
+		cp.Writes.insert(cp.Writes.end(), scp.Writes.begin(), scp.Writes.end());
+		for (ParamTarget &tg: scp.Targets) {
+			tg.WtSt += wst;
+			cp.Targets.push_back(tg);
+		}
+	}
+	return cp;
+}
+
+// SelMatchIndex returns the selector index for this network,
+// rebuilding it first if any layer or path names or classes have changed.
+emer::SelIndex &emer::Network::SelMatchIndex() {
+	if (!SelIdx.Valid()) {
+		SelIdx.Build(*this);
+	}
+	return SelIdx;
+}
+
+// SelMatchCount sets the NMatch of each Sel in the sheet to the number of layers
+// and paths it applies to, using the SelIndex, without setting any params.
+// Use with Sheet.SelNoMatchWarn to check a sheet against this network.
+void emer::Network::SelMatchCount(params::Sheet &pars) {
+	SelIndex &idx = SelMatchIndex();
+	std::vector<std::vector<int>> objSels = idx.SheetMatches(pars);
+	for (params::Sel_ &sl: pars.sel) {
+		sl.NMatch = 0;
+	}
+	for (std::vector<int> &sels: objSels) {
+		for (int si: sels) {
+			pars.sel[si].NMatch++;
+		}
+	}
+}
+
+uint64_t emer::SelIndexGen = 1;
+
+// Build indexes all of the layers and recv paths in the network.
+void emer::SelIndex::Build(Network &net) {
+	Objs.clear();
+	LayerObj.clear();
+	Types.clear();
+	Sels.clear();
+	Gen = SelIndexGen;
+	int nlay = net.NumLayers();
+	for (int li = 0; li < nlay; li++) {
+		Layer *ly = net.EmerLayer(li);
+		LayerObj.push_back(Objs.size());
+		Objs.push_back(ly);
+		for (int pi = 0; pi < ly->NumRecvPaths(); pi++) {
+			Objs.push_back(ly->RecvPath(pi));
+		}
+	}
+	for (int oi = 0; oi < int(Objs.size()); oi++) {
+		params::StylerObject *obj = Objs[oi];
+		Types.push_back(obj->StyleType());
+		Sels[Types[oi]].push_back(oi);
+		std::string nm = obj->StyleName();
+		if (nm != "") {
+			Sels["#" + nm].push_back(oi);
+		}
+		for (std::string &cl: strings::split(obj->StyleClass(), ' ')) {
+			std::string tcl = strings::TrimSpace(cl);
+			if (tcl == "") {
+				continue;
+			}
+			std::vector<int> &objs = Sels["." + tcl];
+			if (objs.empty() || objs.back() != oi) { // class listed twice
+				objs.push_back(oi);
+			}
+		}
+	}
+}
+
+// Valid returns true if the index is up to date with the layers and paths
+// in the network, and their names and classes: if nothing has changed
+// SelIndexGen since it was built.
+bool emer::SelIndex::Valid() {
+	return Gen == SelIndexGen;
+}
+
+// Match returns the indexes in Objs of the objects the selector matches.
+const std::vector<int> &emer::SelIndex::Match(const std::string &sel) {
+	static const std::vector<int> none;
+	auto it = Sels.find(sel);
+	if (it == Sels.end()) {
+		return none;
+	}
+	return it->second;
+}
+
+// SheetMatches returns, for each object in Objs, the indexes of the Sels in
+// the sheet that apply to it (selector and target type), in sheet order.
+std::vector<std::vector<int>> emer::SelIndex::SheetMatches(params::Sheet &pars) {
+	std::vector<std::vector<int>> objSels(Objs.size());
+	for (int si = 0; si < int(pars.sel.size()); si++) {
+		params::Sel_ &sl = pars.sel[si];
+		std::string trg = sl.ParamsSet.TargetType();
+		std::string trgh = sl.HyperSet.TargetType();
+		for (int oi: Match(sl.Sel)) {
+			if (Types[oi] == trg || Types[oi] == trgh) {
+				objSels[oi].push_back(si);
+			}
+		}
+	}
+	return objSels;
+}
+
+// ApplyObj applies the given matching Sels of the sheet to object oi,
+// updating NMatch as Sheet.Apply does. Returns true if any applied.
+bool emer::SelIndex::ApplyObj(params::Sheet &pars, const std::vector<int> &sels, int oi, bool setMsg) {
+	bool applied = false;
+	std::any obj(Objs[oi]);
+	for (int si: sels) {
+		if (pars.sel[si].ApplyTo(obj, setMsg)) {
+			applied = true;
+			pars.sel[si].NMatch++;
+		}
+	}
+	return applied;
+}
+
+// CompileObj compiles the given matching Sels of the sheet against object oi,
+// updating NMatch as ApplyObj does, but only for the Sels with any values
+// compiled. Returns true if any applied.
+bool emer::SelIndex::CompileObj(params::Sheet &pars, const std::vector<int> &sels, int oi, std::vector<params::ParamWrite> &writes) {
+	bool applied = false;
+	for (int si: sels) {
+		if (pars.sel[si].CompileTo(Objs[oi], writes)) {
+			pars.sel[si].NMatch++;
+			applied = true;
+		}
+	}
+	return applied;
+}
+
+// Apply sets all of the compiled param values, calling UpdateParams on each
+// target after its values are set.
+void emer::CompiledParams::Apply() {
+	for (ParamTarget &tg: Targets) {
+		int ed = tg.WtSt + tg.WtN;
+		for (int wi = tg.WtSt; wi < ed; wi++) {
+			Writes[wi].Apply();
+		}
+		if (tg.Lay != nullptr) {
+			tg.Lay->UpdateParams();
+		} else {
+			tg.Pt->UpdateParams();
+		}
+	}
+}
+
+// Push adds a param change to the pending buffer. Safe to call from any thread.
+void emer::ParamQueue::Push(std::string sel, std::string path, std::string value) {
+	std::lock_guard<std::mutex> lock(Mu);
+	Pending.push_back(ParamChange{sel, path, value});
+	HasPending.store(true, std::memory_order_release);
+}
+
+// Swap moves all pending changes into Active (which must have been cleared),
+// returning false without locking if there are none.
+// Only call from the simulation thread.
+bool emer::ParamQueue::Swap() {
+	if (!HasPending.load(std::memory_order_acquire)) {
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(Mu);
+	std::swap(Pending, Active);
+	HasPending.store(false, std::memory_order_relaxed);
+	return !Active.empty();
+}
+
+// QueueParam queues a param change to be applied to all layers or paths
+// matching the sel selector at the next boundary of a running simulation
+// (start of AlphaCycInit, end of epoch). Safe to call from any thread.
+// path must include the target type, e.g., Path.Learn.Lrate.
+void emer::Network::QueueParam(std::string sel, std::string path, std::string value) {
+	ParamUpdates.Push(sel, path, value);
+}
+
+// ApplyQueuedParams applies all param changes queued with QueueParam, in the order
+// they were queued, calling UpdateParams on each layer and path that was changed.
+// Called by the simulation thread at defined boundaries.
+// Returns true if any changes were applied.
+bool emer::Network::ApplyQueuedParams() {
+	if (!ParamUpdates.Swap()) {
+		return false;
+	}
+	params::Sheet sheet;
+	for (ParamChange &ch: ParamUpdates.Active) {
+		sheet.sel.push_back(params::Sel_{ch.Sel, "", params::Params({{ch.Path, ch.Value}}), params::Hypers(), 0, "Queued"});
+	}
+	ParamUpdates.Active.clear();
+	sheet.SelMatchReset("Queued");
+	CompileParams(sheet).Apply();
+	sheet.SelNoMatchWarn("Queued", Name);
+	return true;
+}
+
+// WriteWeightsJSON writes the weights of all layers to w, in the JSON format
+// of the Go emergent packages, streaming each layer as it goes.
+void emer::Network::WriteWeightsJSON(std::ostream &w) {
+	int depth = 0;
+	weights::Indent(w, depth);
+	w << "{\n";
+	depth++;
+	weights::Indent(w, depth);
+	w << "\"Network\": " << weights::Quote(Name) << ",\n";
+	weights::Indent(w, depth);
+	w << "\"MetaData\": {\n";
+	depth++;
+	int mi = 0;
+	for (auto &[key, val]: MetaData) {
+		weights::Indent(w, depth);
+		w << weights::Quote(key) << ": " << weights::Quote(val);
+		w << (++mi < int(MetaData.size()) ? ",\n" : "\n");
+	}
+	depth--;
+	weights::Indent(w, depth);
+	w << "},\n";
+	weights::Indent(w, depth);
+	w << "\"Layers\": [\n";
+	int nlay = NumLayers();
+	for (int li = 0; li < nlay; li++) {
+		EmerLayer(li)->WriteWeightsJSON(w, depth+1);
+		w << (li < nlay-1 ? ",\n" : "\n");
+	}
+	weights::Indent(w, depth);
+	w << "]\n";
+	depth--;
+	weights::Indent(w, depth);
+	w << "}\n";
+}
+
+// netWeightsReader sets the weights of a network as ReadJSON streams
+// through a JSON weights file, finding layers by name via the LayerNameMap,
+// and paths by the name of their sending layer.
+struct netWeightsReader: weights::JSONReader {
+	emer::Network &Net;
+	emer::Layer *Ly;
+	emer::Path *Pt;
+
+	netWeightsReader(emer::Network &net): Net(net), Ly(nullptr), Pt(nullptr) {};
+
+	void NetMetaData(std::map<std::string, std::string> &md) {
+		for (auto &[key, val]: md) {
+			Net.MetaData[key] = val;
+		}
+	}
+
+	bool Layer(const std::string &name) {
+		Ly = Net.LayerByName(name);
+		if (Ly == nullptr) {
+			std::cerr << "ReadWeightsJSON: layer not found in network " << Net.Name << ": " << name << std::endl;
+		}
+		return Ly != nullptr;
+	}
+
+	void LayerMetaData(std::map<std::string, std::string> &md) {
+		Ly->SetWeightsMetaData(md);
+	}
+
+	bool Path(const std::string &from) {
+		Pt = Ly->RecvPathBySendName(from);
+		if (Pt == nullptr) {
+			std::cerr << "ReadWeightsJSON: path from " << from << " not found in layer: " << Ly->Name << std::endl;
+		}
+		return Pt != nullptr;
+	}
+
+	void PathMetaData(std::map<std::string, std::string> &md) {
+		Pt->SetWeightsMetaData(md);
+	}
+
+	void Recv(int ri, std::vector<int> &si, std::vector<float> &wt) {
+		Pt->SetRecvWeights(ri, si, wt);
+	}
+};
+
+// ReadWeightsJSON sets the weights of this network from a JSON weights file
+// in the format written by WriteWeightsJSON (and the Go emergent packages).
+// The file is streamed, so memory use does not depend on its size.
+// Layers and paths in the file that are not in the network are skipped with
+// a warning. Throws on malformed JSON.
+void emer::Network::ReadWeightsJSON(std::istream &r) {
+	netWeightsReader rd(*this);
+	weights::ReadJSON(r, rd);
+}
+
+// SaveWeightsJSON saves the weights of this network to a JSON weights file.
+// To write compressed files, use WriteWeightsJSON with a compressing stream.
+void emer::Network::SaveWeightsJSON(std::string fileName) {
+	std::ofstream w(fileName);
+	if (!w) {
+		throw std::runtime_error("SaveWeightsJSON: could not open file: " + fileName);
+	}
+	WriteWeightsJSON(w);
+	w.close();
+	if (!w) {
+		throw std::runtime_error("SaveWeightsJSON: error writing file: " + fileName);
+	}
+	WeightsFile = fileName;
+}
+
+// OpenWeightsJSON sets the weights of this network from a JSON weights file
+// -- see ReadWeightsJSON.
+void emer::Network::OpenWeightsJSON(std::string fileName) {
+	std::ifstream r(fileName);
+	if (!r) {
+		throw std::runtime_error("OpenWeightsJSON: could not open file: " + fileName);
+	}
+	ReadWeightsJSON(r);
+	WeightsFile = fileName;
+}
+
 void emer::Network::SetRandSeed(int seed){
 	RandSeed = seed;
 	ResetRandSeed();
 }
 
+// ResetRandSeed sets the random seed to RandSeed, for the network Rand and
+// the global random source that weight initialization draws from.
 void emer::Network::ResetRandSeed(){
 	Rand.NewSeed(RandSeed);
+	rands::NewGlobalRand()->NewSeed(RandSeed);
 }
 
 void emer::Path::AddClass(std::vector<std::string> classes){
@@ -220,6 +589,7 @@ void emer::Path::AddClass(std::vector<std::string> classes){
         }
     };
     Class += newClasses;
+    SelIndexGen++;
 }
 
 void emer::Path::SetParam(std::string path, std::string val) {
@@ -262,6 +632,18 @@ std::string emer::Layer::Label() {
 	return Name;
 }
 
+// SetName sets the Name of the layer, which must stay unique in the network.
+void emer::Layer::SetName(std::string name) {
+	Name = name;
+	SelIndexGen++;
+}
+
+// SetClass sets the space-separated Class list of the layer.
+void emer::Layer::SetClass(std::string cls) {
+	Class = cls;
+	SelIndexGen++;
+}
+
 bool emer::Layer::Is2D() {
 	return Shape.NumDims() == 2;
 }
@@ -496,7 +878,7 @@ bool emer::Layer::ApplyParams(params::Sheet &pars, bool setMsg) {
 }
 
 emer::Path::Path(std::string name, std::string cls):
-	Name(name), Class(cls), Info(), Notes() {
+	Name(name), Class(cls), Info(), Notes(), Off(false) {
 	Pattern = nullptr;
 	// InitParamMaps();
 }
@@ -517,4 +899,16 @@ std::string emer::Path::Label() {
 	return Name;
 }
 
+// SetName sets the Name of the path.
+void emer::Path::SetName(std::string name) {
+	Name = name;
+	SelIndexGen++;
+}
+
+// SetClass sets the space-separated Class list of the path.
+void emer::Path::SetClass(std::string cls) {
+	Class = cls;
+	SelIndexGen++;
+}
+
 
@@ -2,9 +2,8 @@
 
 fffb::Inhib::Inhib() {
     Zero();
-    this->Ge = minmax::AvgMax32();
-    this->Act = minmax::AvgMax32();
-    InitParamMaps();
+    this->Ge = minmax::AvgMax<Real>();
+    this->Act = minmax::AvgMax<Real>();
 }
 
 // Zero clears inhibition but does not affect Ge, Act averages
@@ -17,7 +16,7 @@ void fffb::Inhib::Zero() {
 }
 
 // Decay reduces inhibition values by given decay proportion
-void fffb::Inhib::Decay(float decay) {
+void fffb::Inhib::Decay(Real decay) {
     Ge.Max -= decay * Ge.Max;
 	Ge.Avg -= decay * Ge.Avg;
 	Act.Max -= decay * Act.Max;
@@ -45,21 +44,15 @@ std::string fffb::Inhib::StyleName() {
     return "";
 }
 
-void fffb::Inhib::InitParamMaps() {
-    ParamNameMap["FFi"] = (void*) &FFi;
-    ParamNameMap["FBi"] = (void*) &FBi;
-    ParamNameMap["Gi"] = (void*) &Gi;
-    ParamNameMap["GiOrig"] = (void*) &GiOrig;
-    ParamNameMap["LayGi"] = (void*) &LayGi;
-
-    ParamTypeMap["FFi"] = &typeid(float);
-    ParamTypeMap["FBi"] = &typeid(float);
-    ParamTypeMap["Gi"] = &typeid(float);
-    ParamTypeMap["GiOrig"] = &typeid(float);
-    ParamTypeMap["LayGi"] = &typeid(float);
+void fffb::Inhib::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "FFi", FFi);
+    reg.Add(this, "FBi", FBi);
+    reg.Add(this, "Gi", Gi);
+    reg.Add(this, "GiOrig", GiOrig);
+    reg.Add(this, "LayGi", LayGi);
 }
 
-fffb::Params::Params(float Gi, float FF, float FB, float FBTau, float MaxVsAvg, float FF0) {
+fffb::Params::Params(Real Gi, Real FF, Real FB, Real FBTau, Real MaxVsAvg, Real FF0) {
     //TODO Check if On needs to be intitialized to zero or one
     this->Gi = Gi;
     this->FF = FF;
@@ -68,7 +61,6 @@ fffb::Params::Params(float Gi, float FF, float FB, float FBTau, float MaxVsAvg,
     this->MaxVsAvg = MaxVsAvg;
     this->FF0 = FF0;
     Update();
-    InitParamMaps();
 }
 
 void fffb::Params::Update() {
@@ -86,9 +78,9 @@ void fffb::Params::Defaults(){
 
 // FFInhib returns the feedforward inhibition value based on average and max excitatory conductance within
 // relevant scope
-float fffb::Params::FFInhib(float avgGe, float maxGe) {
-    float ffNetin = avgGe + MaxVsAvg*(maxGe-avgGe);
-	float ffi = 0;
+Real fffb::Params::FFInhib(Real avgGe, Real maxGe) {
+    Real ffNetin = avgGe + MaxVsAvg*(maxGe-avgGe);
+	Real ffi = 0;
 	if (ffNetin > FF0) {
 		ffi = FF * (ffNetin - FF0);
 	}
@@ -96,13 +88,13 @@ float fffb::Params::FFInhib(float avgGe, float maxGe) {
 }
 
 // FBInhib computes feedback inhibition value as function of average activation
-float fffb::Params::FBInhib(float avgAct) {
-    float fbi = FB * avgAct;
+Real fffb::Params::FBInhib(Real avgAct) {
+    Real fbi = FB * avgAct;
 	return fbi;
 }
 
 // FBUpdt updates feedback inhibition using time-integration rate constant
-void fffb::Params::FBUpdt(float *fbi, float newFbi) {
+void fffb::Params::FBUpdt(Real *fbi, Real newFbi) {
     *fbi += FBDt * (newFbi - *fbi);
 }
 
@@ -115,8 +107,8 @@ void fffb::Params::Inhib(fffb::Inhib *inh) {
 		return;
 	}
 
-	float ffi = FFInhib(inh->Ge.Avg, inh->Ge.Max);
-	float fbi = FBInhib(inh->Act.Avg);
+	Real ffi = FFInhib(inh->Ge.Avg, inh->Ge.Max);
+	Real fbi = FBInhib(inh->Act.Avg);
 
 	inh->FFi = ffi;
 	FBUpdt(&(inh->FBi), fbi);
@@ -137,22 +129,13 @@ std::string fffb::Params::StyleName() {
     return "";
 }
 
-void fffb::Params::InitParamMaps() {
-    ParamNameMap["On"] = (void*) &On;
-    ParamNameMap["Gi"] = (void*) &Gi;
-    ParamNameMap["FF"] = (void*) &FF;
-    ParamNameMap["FB"] = (void*) &FB;
-    ParamNameMap["FBTau"] = (void*) &FBTau;
-    ParamNameMap["MaxVsAvg"] = (void*) &MaxVsAvg;
-    ParamNameMap["FF0"] = (void*) &FF0;
-    ParamNameMap["FBDt"] = (void*) &FBDt;
-
-    ParamTypeMap["On"] = &typeid(bool);
-    ParamTypeMap["Gi"] = &typeid(float);
-    ParamTypeMap["FF"] = &typeid(float);
-    ParamTypeMap["FB"] = &typeid(float);
-    ParamTypeMap["FBTau"] = &typeid(float);
-    ParamTypeMap["MaxVsAvg"] = &typeid(float);
-    ParamTypeMap["FF0"] = &typeid(float);
-    ParamTypeMap["FBDt"] = &typeid(float);
+void fffb::Params::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "On", On);
+    reg.Add(this, "Gi", Gi);
+    reg.Add(this, "FF", FF);
+    reg.Add(this, "FB", FB);
+    reg.Add(this, "FBTau", FBTau);
+    reg.Add(this, "MaxVsAvg", MaxVsAvg);
+    reg.Add(this, "FF0", FF0);
+    reg.Add(this, "FBDt", FBDt);
 }
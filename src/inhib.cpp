@@ -1,11 +1,10 @@
 #include "inhib.hpp"
 
-inhib::SelfInhibParams::SelfInhibParams(bool On, float Gi, float Tau) {
+inhib::SelfInhibParams::SelfInhibParams(bool On, Real Gi, Real Tau) {
     this->On = On;
     this->Gi = Gi;
     this->Tau = Tau;
     Update();
-    InitParamMaps();
 }
 
 void inhib::SelfInhibParams::Update() {
@@ -13,7 +12,7 @@ void inhib::SelfInhibParams::Update() {
 }
 
 // Inhib updates the self inhibition value based on current unit activation
-void inhib::SelfInhibParams::Inhib(float *self, float act) {
+void inhib::SelfInhibParams::Inhib(Real *self, Real act) {
     if (On) {
         *self += Dt * (Gi * act - *self);
     }
@@ -34,25 +33,21 @@ std::string inhib::SelfInhibParams::StyleName() {
     return "";
 }
 
-void inhib::SelfInhibParams::InitParamMaps() {
-    ParamNameMap["On"] = (void *) &On;
-    ParamNameMap["Gi"] = (void *) &Gi;
-    ParamNameMap["Tau"] = (void *) &Tau;
-    ParamNameMap["Dt"] = (void *) &Dt;
-
-    ParamTypeMap["On"] = &typeid(bool);
-    ParamTypeMap["Gi"] = &typeid(float);
-    ParamTypeMap["Tau"] = &typeid(float);
-    ParamTypeMap["Dt"] = &typeid(float);
+void inhib::SelfInhibParams::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "On", On);
+    reg.Add(this, "Gi", Gi);
+    reg.Add(this, "Tau", Tau);
+    reg.Add(this, "Dt", Dt);
 }
 
-inhib::ActAvgParams::ActAvgParams(float Init, bool Fixed, bool UseExtAct, bool Usefirst, float Tau, float Adjust) {
+inhib::ActAvgParams::ActAvgParams(Real Init, bool Fixed, bool UseExtAct, bool Usefirst, Real Tau, Real Adjust) {
     this->Init = Init;
     this->Fixed = Fixed;
     this->UseExtAct = UseExtAct;
-    this->UseFirst = UseFirst;
+    this->UseFirst = Usefirst;
+    this->Tau = Tau;
+    this->Adjust = Adjust;
     Update();
-    InitParamMaps();
 }
 
 void inhib::ActAvgParams::Update() {
@@ -60,7 +55,7 @@ void inhib::ActAvgParams::Update() {
 }
 
 // EffInit returns the initial value applied during InitWts for the AvgPAvgEff effective layer activity
-float inhib::ActAvgParams::EffInit() {
+Real inhib::ActAvgParams::EffInit() {
     if (Fixed) {
 		return Init;
 	}
@@ -68,7 +63,7 @@ float inhib::ActAvgParams::EffInit() {
 }
 
 // AvgFmAct updates the running-average activation given average activity level in layer
-void inhib::ActAvgParams::AvgFmAct(float *avg, float act) {
+void inhib::ActAvgParams::AvgFmAct(Real *avg, Real act) {
     if (act < 0.0001) {
 		return;
 	}
@@ -80,7 +75,7 @@ void inhib::ActAvgParams::AvgFmAct(float *avg, float act) {
 }
 
 // EffFmAvg updates the effective value from the running-average value
-void inhib::ActAvgParams::EffFmAvg(float *eff, float avg) {
+void inhib::ActAvgParams::EffFmAvg(Real *eff, Real avg) {
     if (Fixed) {
 		*eff = Init;
 	} else {
@@ -100,22 +95,14 @@ std::string inhib::ActAvgParams::StyleName() {
     return "";
 }
 
-void inhib::ActAvgParams::InitParamMaps() {
-    ParamNameMap["Init"] = (void*) &Init;
-    ParamNameMap["Fixed"] = (void*) &Fixed;
-    ParamNameMap["UseExtAct"] = (void*) &UseExtAct;
-    ParamNameMap["UseFirst"] = (void*) &UseFirst;
-    ParamNameMap["Tau"] = (void*) &Tau;
-    ParamNameMap["Adjust"] = (void*) &Adjust;
-    ParamNameMap["Dt"] = (void*) &Dt;
-
-    ParamTypeMap["Init"] = &typeid(float);
-    ParamTypeMap["Fixed"] = &typeid(bool);
-    ParamTypeMap["UseExtAct"] = &typeid(bool);
-    ParamTypeMap["UseFirst"] = &typeid(bool);
-    ParamTypeMap["Tau"] = &typeid(float);
-    ParamTypeMap["Adjust"] = &typeid(float);
-    ParamTypeMap["Dt"] = &typeid(float);
+void inhib::ActAvgParams::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "Init", Init);
+    reg.Add(this, "Fixed", Fixed);
+    reg.Add(this, "UseExtAct", UseExtAct);
+    reg.Add(this, "UseFirst", UseFirst);
+    reg.Add(this, "Tau", Tau);
+    reg.Add(this, "Adjust", Adjust);
+    reg.Add(this, "Dt", Dt);
 }
 
 inhib::InhibParams::InhibParams() {
@@ -123,7 +110,6 @@ inhib::InhibParams::InhibParams() {
     this->Pool = fffb::Params();
     this->Self = inhib::SelfInhibParams();
     this->ActAvg = inhib::ActAvgParams();
-    InitParamMaps();
 }
 
 std::string inhib::InhibParams::StyleType() {
@@ -138,14 +124,9 @@ std::string inhib::InhibParams::StyleName() {
     return "";
 }
 
-void inhib::InhibParams::InitParamMaps() {
-    ParamNameMap["Layer"] = (void*) &Layer;
-    ParamNameMap["Pool"] = (void*) &Pool;
-    ParamNameMap["Self"] = (void*) &Self;
-    ParamNameMap["ActAvg"] = (void*) &ActAvg;
-
-    ParamTypeMap["Layer"] = &typeid(Layer);
-    ParamTypeMap["Pool"] = &typeid(Pool);
-    ParamTypeMap["Self"] = &typeid(Self);
-    ParamTypeMap["ActAvg"] = &typeid(ActAvg);
+void inhib::InhibParams::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "Layer", Layer);
+    reg.Add(this, "Pool", Pool);
+    reg.Add(this, "Self", Self);
+    reg.Add(this, "ActAvg", ActAvg);
 }
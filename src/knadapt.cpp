@@ -1,8 +1,7 @@
 #include "knadapt.hpp"
 
-knadapt::Chan::Chan(bool on, float rise, float max, float tau): On(on), Rise(rise), Max(max), Tau(tau) {
+knadapt::Chan::Chan(bool on, Real rise, Real max, Real tau): On(on), Rise(rise), Max(max), Tau(tau) {
     Update();
-    InitParamMaps();
 }
 
 void knadapt::Chan::Defaults()
@@ -14,7 +13,7 @@ void knadapt::Chan::Defaults()
     Update();
 }
 
-void knadapt::Chan::GcFmSpike(float *gKNa, bool spike) {
+void knadapt::Chan::GcFmSpike(Real *gKNa, bool spike) {
     if (On) {
 		if (spike) {
 			*gKNa += Rise * (Max - *gKNa);
@@ -26,7 +25,7 @@ void knadapt::Chan::GcFmSpike(float *gKNa, bool spike) {
 	}
 }
 
-void knadapt::Chan::GcFmRate(float *gKNa, float act) {
+void knadapt::Chan::GcFmRate(Real *gKNa, Real act) {
     if (On) {
 		*gKNa += act*Rise*(Max-*gKNa) - (Dt * *gKNa);
 	} else {
@@ -46,21 +45,15 @@ std::string knadapt::Chan::StyleName() {
     return "";
 }
 
-void knadapt::Chan::InitParamMaps() {
-    ParamNameMap["On"] = (void*) &On;
-    ParamNameMap["Rise"] = (void*) &Rise;
-    ParamNameMap["Max"] = (void*) &Max;
-    ParamNameMap["Tau"] = (void*) &Tau;
-    ParamNameMap["Dt"] = (void*) &Dt;
-
-    ParamTypeMap["On"] = &typeid(bool);
-    ParamTypeMap["Rise"] = &typeid(float);
-    ParamTypeMap["Max"] = &typeid(float);
-    ParamTypeMap["Tau"] = &typeid(float);
-    ParamTypeMap["Dt"] = &typeid(float);
+void knadapt::Chan::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "On", On);
+    reg.Add(this, "Rise", Rise);
+    reg.Add(this, "Max", Max);
+    reg.Add(this, "Tau", Tau);
+    reg.Add(this, "Dt", Dt);
 }
 
-knadapt::Params::Params(bool on, float rate) {
+knadapt::Params::Params(bool on, Real rate) {
     On = on;
     Rate = rate;
 
@@ -71,7 +64,6 @@ knadapt::Params::Params(bool on, float rate) {
     Slow = Chan(true, 0.001, 1, 1000);
 
     // Update(); Redundant because Chan calls its own update
-    InitParamMaps();
 }
 
 void knadapt::Params::Defaults() {
@@ -101,13 +93,13 @@ void knadapt::Params::Update() {
     Slow.Update();
 }
 
-void knadapt::Params::GcFromSpike(float *gKNaF, float *gKNaM, float *gKNaS, bool spike) {
+void knadapt::Params::GcFromSpike(Real *gKNaF, Real *gKNaM, Real *gKNaS, bool spike) {
     Fast.GcFmSpike(gKNaF, spike);
 	Med.GcFmSpike(gKNaM, spike);
 	Slow.GcFmSpike(gKNaS, spike);
 }
 
-void knadapt::Params::GcFromRate(float *gKNaF, float *gKNaM, float *gKNaS, float act) {
+void knadapt::Params::GcFromRate(Real *gKNaF, Real *gKNaM, Real *gKNaS, Real act) {
     Fast.GcFmSpike(gKNaF, act);
 	Med.GcFmSpike(gKNaM, act);
 	Slow.GcFmSpike(gKNaS, act);
@@ -125,16 +117,10 @@ std::string knadapt::Params::StyleName() {
     return "";
 }
 
-void knadapt::Params::InitParamMaps(){
-    ParamNameMap["On"] = (void*) & On;
-    ParamNameMap["Rate"] = (void*) & Rate;
-    ParamNameMap["Fast"] = (void*) & Fast;
-    ParamNameMap["Med"] = (void*) & Med;
-    ParamNameMap["Slow"] = (void*) & Slow;
-
-    ParamTypeMap["On"] = &typeid(On);
-    ParamTypeMap["Rate"] = &typeid(Rate);
-    ParamTypeMap["Fast"] = &typeid(Fast);
-    ParamTypeMap["Med"] = &typeid(Med);
-    ParamTypeMap["Slow"] = &typeid(Slow);
+void knadapt::Params::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "On", On);
+    reg.Add(this, "Rate", Rate);
+    reg.Add(this, "Fast", Fast);
+    reg.Add(this, "Med", Med);
+    reg.Add(this, "Slow", Slow);
 }
\ No newline at end of file
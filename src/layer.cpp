@@ -2,9 +2,8 @@
 #include "network.hpp"
 
 leabra::Layer::Layer(std::string name, int index, Network *net): 
-	emer::Layer(name), Index(index), Net(net), RecvPaths(), SendPaths(), Act(), Inhib(), Learn(), Neurons(), Pools(), CosDiff() {
+	emer::Layer(name), Index(index), Net(net), RecvPaths(), SendPaths(), Act(), Inhib(), Learn(), Neurons(), Pools(), CosDiff(), ActDelMax(0) {
 	Inhib.Layer.On = true;
-	InitParamMaps();
 }
 
 void leabra::Layer::Defaults() {
@@ -158,23 +157,25 @@ void leabra::Layer::InitActs() {
 
 // InitWeightsSym initializes the weight symmetry.
 // higher layers copy weights from lower layers.
+// Tied reciprocal pathways are tied here, with the pathway from the lower
+// layer owning the synapses.
 void leabra::Layer::InitWtSym() { //TODO: check if this is useful...
     for (leabra::Path *pt: SendPaths) {
         if (pt->Off) {
 			continue;
 		}
-		if (!pt->WtInit.Sym) {
-			continue;
-		}
 		// key ordering constraint on which way weights are copied
 		if (pt->Recv->Index < pt->Send->Index) {
 			continue;
 		}
 		Path *rpt = RecipToSendPath(pt);
-		if (rpt == nullptr) {
+		if (rpt == nullptr || rpt->Off) {
+			continue;
+		}
+		if (pt->Tied && rpt->Tied && rpt->Tie(*pt)) {
 			continue;
 		}
-		if (!rpt->WtInit.Sym) {
+		if (!pt->WtInit.Sym || !rpt->WtInit.Sym) {
 			continue;
 		}
 		pt->InitWtSym(*rpt);
@@ -466,17 +467,17 @@ void leabra::Layer::AvgLFromAvgM() {
 // coming into the units to achieve a general target of around .5 to 1
 // for the integrated Ge value.
 void leabra::Layer::GScaleFromAvgAct() {
-	float totGeRel = 0;
-	float totGiRel = 0;
+	Real totGeRel = 0;
+	Real totGiRel = 0;
 	for (Path *pt : RecvPaths) {
 		if (pt->Off) {
 			continue;
 		}
 		Layer &slay = *pt->Send;
 		Pool &slpl = slay.Pools[0];
-		float savg = slpl.ActAvgs.ActPAvgEff;
+		Real savg = slpl.ActAvgs.ActPAvgEff;
 		int snu = slay.Neurons.size();
-		int ncon = pt->RConNAvgMax.Avg;
+		Real ncon = pt->RConNAvgMax.Avg;
 		pt->GScale = pt->WtScale.FullScale(savg, float(snu), ncon);
 
 		if (pt->Type == InhibPath) {
@@ -578,7 +579,7 @@ void leabra::Layer::SendGDelta(Context *ctx) {
 			continue;
 		}
 		if (nrn.Act > Act.OptThresh.Send) {
-			float delta = nrn.Act - nrn.ActSent;
+			Real delta = nrn.Act - nrn.ActSent;
 			if (std::abs(delta) > Act.OptThresh.Delta) {
 				for (Path *sp: SendPaths) {
 					if (sp->Off) {
@@ -589,7 +590,7 @@ void leabra::Layer::SendGDelta(Context *ctx) {
 				nrn.ActSent = nrn.Act;
 			}
 		} else if (nrn.ActSent > Act.OptThresh.Send) {
-			float delta = -nrn.ActSent; // un-send the last above-threshold activation to get back to 0
+			Real delta = -nrn.ActSent; // un-send the last above-threshold activation to get back to 0
 			for (Path *sp: SendPaths) {
 				if (sp->Off) {
 					continue;
@@ -692,16 +693,24 @@ void leabra::Layer::InhibFromPool(Context *ctx) {
 }
 
 // ActFromG computes rate-code activation from Ge, Gi, Gl conductances
-// and updates learning running-average activations from that Act
+// and updates learning running-average activations from that Act,
+// unless ctx.Testing or the network is Frozen.
+// Also records the max |ActDel| in ActDelMax.
 void leabra::Layer::ActFromG(Context *ctx) {
+	bool lrn = !ctx->Testing && !(Net != nullptr && Net->Frozen);
+	Real mx = 0;
 	for (Neuron &nrn: Neurons) {
 		if (nrn.IsOff()) {
 			continue;
 		}
 		Act.VmFromG(nrn);
 		Act.ActFromG(nrn);
-		Learn.AvgsFromAct(nrn);
+		if (lrn) {
+			Learn.AvgsFromAct(nrn);
+		}
+		mx = std::max(mx, std::abs(nrn.ActDel));
 	}
+	ActDelMax = mx;
 }
 
 // AvgMaxAct computes the average and max Act stats, used in inhibition
@@ -719,6 +728,70 @@ void leabra::Layer::AvgMaxAct(Context *ctx) {
 	}
 }
 
+// Cycle runs the steps of one cycle that follow SendGDelta: GFromInc, AvgMaxGe,
+// InhibFromGeAct, ActFromG and AvgMaxAct, with the same results, but in two
+// passes through the neurons instead of five. The first integrates Ge and Gi
+// and accumulates the Ge stats, then the pools compute their FFFB inhibition,
+// and the second computes each neuron's Gi, Vm, Act and learning averages,
+// and accumulates the Act stats. The stats of each pool are accumulated in
+// the same order as in AvgMaxGe and AvgMaxAct.
+void leabra::Layer::Cycle(Context *ctx) {
+	RecvGInc(ctx);
+	int nn = Neurons.size();
+	Neuron *nrns = Neurons.data();
+	for (Pool &pl: Pools) {
+		pl.Inhib.Ge.Init();
+	}
+	Pool &lpl = Pools[0];
+	for (int ni = 0; ni < nn; ni++) {
+		Neuron &nrn = nrns[ni];
+		if (nrn.IsOff()) {
+			continue;
+		}
+		Act.GeFromRaw(nrn, nrn.GeRaw);
+		Act.GiFromRaw(nrn, nrn.GiRaw);
+		lpl.Inhib.Ge.UpdateValue(nrn.Ge, ni);
+		if (nrn.SubPool > 0) {
+			Pools[nrn.SubPool].Inhib.Ge.UpdateValue(nrn.Ge, ni);
+		}
+	}
+	for (Pool &pl: Pools) {
+		pl.Inhib.Ge.CalcAvg();
+	}
+
+	Inhib.Layer.Inhib(&lpl.Inhib);
+	PoolInhibFromGeAct(ctx);
+
+	for (Pool &pl: Pools) {
+		pl.Inhib.Act.Init();
+	}
+	bool lrn = !ctx->Testing && !(Net != nullptr && Net->Frozen);
+	Real mx = 0;
+	for (int ni = 0; ni < nn; ni++) {
+		Neuron &nrn = nrns[ni];
+		if (nrn.IsOff()) {
+			continue;
+		}
+		Pool &pl = Pools[nrn.SubPool];
+		Inhib.Self.Inhib(nrn.GiSelf, nrn.Act);
+		nrn.Gi = pl.Inhib.Gi + nrn.GiSelf + nrn.GiSyn;
+		Act.VmFromG(nrn);
+		Act.ActFromG(nrn);
+		if (lrn) {
+			Learn.AvgsFromAct(nrn);
+		}
+		mx = std::max(mx, std::abs(nrn.ActDel));
+		lpl.Inhib.Act.UpdateValue(nrn.Act, ni);
+		if (nrn.SubPool > 0) {
+			pl.Inhib.Act.UpdateValue(nrn.Act, ni);
+		}
+	}
+	ActDelMax = mx;
+	for (Pool &pl: Pools) {
+		pl.Inhib.Act.CalcAvg();
+	}
+}
+
 void leabra::Layer::CyclePost(Context *ctx) {
 }
 
@@ -737,6 +810,9 @@ void leabra::Layer::QuarterFinal(Context *ctx) {
 		default:
 			break;
 	}
+	if (Net != nullptr && Net->Frozen) { // quarter snapshots are only for learning
+		return;
+	}
 	for (Neuron &nrn: Neurons) {
 		if (nrn.IsOff()) {
 			continue;
@@ -791,23 +867,23 @@ void leabra::Layer::PlusPhase(Context *ctx) {
 // this is also used for modulating the amount of BCM hebbian learning
 void leabra::Layer::CosDiffFromActs() {
 	Pool &lpl = Pools[0];
-	float avgM = lpl.ActM.Avg;
-	float avgP = lpl.ActP.Avg;
-	float cosv = 0;
-	float ssm = 0;
-	float ssp = 0;
+	Real avgM = lpl.ActM.Avg;
+	Real avgP = lpl.ActP.Avg;
+	Real cosv = 0;
+	Real ssm = 0;
+	Real ssp = 0;
 	for (Neuron &nrn: Neurons) {
 		if (nrn.IsOff()) {
 			continue;
 		}
-		float ap = nrn.ActP - avgP; // zero mean
-		float am = nrn.ActM - avgM;
+		Real ap = nrn.ActP - avgP; // zero mean
+		Real am = nrn.ActM - avgM;
 		cosv += ap * am;
 		ssm += am * am;
 		ssp += ap * ap;
 	}
 
-	float dist = std::sqrt(ssm * ssp);
+	Real dist = std::sqrt(ssm * ssp);
 	if (dist != 0) {
 		cosv /= dist;
 	}
@@ -829,12 +905,23 @@ bool leabra::Layer::IsTarget() {
 }
 
 // DWt computes the weight change (learning) -- calls DWt method on sending pathways
-void leabra::Layer::DWt() {
+void leabra::Layer::DWt(bool batch) {
+	for (Path *pt: SendPaths) {
+		if (pt->Off) {
+			continue;
+		}
+		pt->DWt(batch);
+	}
+}
+
+// DWtFromBatch computes the DWt from the raw changes summed over a
+// minibatch -- on the sending pathways (see Path.DWtFromBatch)
+void leabra::Layer::DWtFromBatch() {
 	for (Path *pt: SendPaths) {
 		if (pt->Off) {
 			continue;
 		}
-		pt->DWt();
+		pt->DWtFromBatch();
 	}
 }
 
@@ -848,14 +935,18 @@ void leabra::Layer::WtFromDWt() {
 	}
 }
 
-// WtBalFromWt computes the Weight Balance factors based on average recv weights
-void leabra::Layer::WtBalFromWt() {
+// WtBalFromWt computes the Weight Balance factors based on average recv weights.
+// If check, returns the number of recv units whose running sums did not
+// match a full recompute (see Path.WtBalFromWt).
+int leabra::Layer::WtBalFromWt(bool check) {
+	int nbad = 0;
 	for (Path *pt: RecvPaths) {
 		if (pt->Off) {
 			continue;
 		}
-		pt->WtBalFromWt();
+		nbad += pt->WtBalFromWt(check);
 	}
+	return nbad;
 }
 
 // LrateMult sets the new Lrate parameter for Paths to LrateInit * mult.
@@ -880,7 +971,7 @@ std::tuple<int, int, int> leabra::Layer::CostEst() {
 	int neur = Neurons.size() * perNeur;
 	int syn = 0;
 	for (Path *pt: SendPaths) {
-		int ns = pt->Syns.size();
+		int ns = pt->NumSyns();
 		syn += ns;
 	}
 	int tot = neur + syn;
@@ -888,11 +979,11 @@ std::tuple<int, int, int> leabra::Layer::CostEst() {
 }
 
 
-std::tuple<int, int> leabra::Layer::MSE(float tol) {
+std::tuple<float, float> leabra::Layer::MSE(float tol) {
 	float sse, mse;
     int nn = Neurons.size();
 	if (nn == 0) {
-		return std::tuple<int,int>(0, 0);
+		return std::tuple<float, float>(0, 0);
 	}
 	sse = 0.0;
 	for (Neuron &nrn: Neurons) {
@@ -911,7 +1002,7 @@ std::tuple<int, int> leabra::Layer::MSE(float tol) {
 		sse += d * d;
 	}
 	mse = sse/nn;
-	return std::tuple<int,int>(sse, mse);
+	return std::tuple<float, float>(sse, mse);
 }
 
 // SSE returns the sum-squared-error over the layer, in terms of ActP - ActM
@@ -920,8 +1011,7 @@ std::tuple<int, int> leabra::Layer::MSE(float tol) {
 // (e.g., .5 = activity just has to be on the right side of .5).
 // Use this in Python which only allows single return values.
 float leabra::Layer::SSE(float tol) {
-	auto intTuple = MSE(tol);
-    return std::get<0>(intTuple);
+	return std::get<0>(MSE(tol));
 }
 
 // UnLesionNeurons unlesions (clears the Off flag) for all neurons in the layer
@@ -1009,27 +1099,144 @@ emer::Path *leabra::Layer::SendPath(int idx) {
     return SendPaths[idx];
 }
 
-void leabra::Layer::InitParamMaps() {
-	ParamNameMap["Act"] = (void*) &Act;
-	ParamNameMap["Inhib"] = (void*) &Inhib;
-	ParamNameMap["Learn"] = (void*) &Learn;
-	ParamNameMap["CosDiff"] = (void*) &CosDiff;
-
-	ParamTypeMap["Act"] = &typeid(Act);
-	ParamTypeMap["Inhib"] = &typeid(Inhib);
-	ParamTypeMap["Learn"] = &typeid(Learn);
-	ParamTypeMap["CosDiff"] = &typeid(CosDiff);
+void leabra::Layer::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Act", Act);
+	reg.Add(this, "Inhib", Inhib);
+	reg.Add(this, "Learn", Learn);
+	reg.Add(this, "CosDiff", CosDiff);
 }
 
 leabra::LayerShape::LayerShape(int x, int y, int poolsX, int poolsY): X(x),Y(y),PoolsX(poolsX),PoolsY(poolsY){}
 
+// MemoryReport returns the memory held by this layer's neuron and pool state,
+// plus that of all of its receiving pathways
+leabra::MemReport leabra::Layer::MemoryReport() {
+	MemReport mr;
+	mr.NeuronState = Neurons.capacity() * sizeof(Neuron) + Pools.capacity() * sizeof(Pool);
+	for (Path *pt: RecvPaths) {
+		mr.Add(pt->MemoryReport());
+	}
+	return mr;
+}
+
+// WriteWeightsJSON writes the weights from this layer from the receiver-side
+// perspective in the JSON format of the Go emergent packages,
+// including the running-average activity levels in its MetaData.
+void leabra::Layer::WriteWeightsJSON(std::ostream &w, int depth) {
+	std::string buf;
+	weights::Indent(w, depth);
+	w << "{\n";
+	depth++;
+	weights::Indent(w, depth);
+	w << "\"Layer\": " << weights::Quote(Name) << ",\n";
+	weights::Indent(w, depth);
+	w << "\"MetaData\": {\n";
+	weights::Indent(w, depth+1);
+	buf = "\"ActMAvg\": \"";
+	weights::AppendFloat(buf, Pools[0].ActAvgs.ActMAvg);
+	buf += "\",\n";
+	w << buf;
+	weights::Indent(w, depth+1);
+	buf = "\"ActPAvg\": \"";
+	weights::AppendFloat(buf, Pools[0].ActAvgs.ActPAvg);
+	buf += "\"\n";
+	w << buf;
+	weights::Indent(w, depth);
+	w << "},\n";
+	std::vector<Path*> onps;
+	for (Path *pt: RecvPaths) {
+		if (!pt->Off) {
+			onps.push_back(pt);
+		}
+	}
+	weights::Indent(w, depth);
+	if (onps.empty()) {
+		w << "\"Paths\": null\n";
+	} else {
+		w << "\"Paths\": [\n";
+		for (int pi = 0; pi < int(onps.size()); pi++) {
+			onps[pi]->WriteWeightsJSON(w, depth+1);
+			w << (pi < int(onps.size())-1 ? ",\n" : "\n");
+		}
+		weights::Indent(w, depth);
+		w << "]\n";
+	}
+	depth--;
+	weights::Indent(w, depth);
+	w << "}";
+}
+
+// SetWeightsMetaData sets the running-average activity levels
+// from the MetaData of a JSON weights file.
+void leabra::Layer::SetWeightsMetaData(std::map<std::string, std::string> &md) {
+	Pool &pl = Pools[0];
+	if (md.count("ActMAvg") > 0) {
+		pl.ActAvgs.ActMAvg = std::stof(md["ActMAvg"]);
+	}
+	if (md.count("ActPAvg") > 0) {
+		pl.ActAvgs.ActPAvg = std::stof(md["ActPAvg"]);
+		Inhib.ActAvg.EffFromAvg(pl.ActAvgs.ActPAvgEff, pl.ActAvgs.ActPAvg);
+	}
+}
+
+// WriteCheckpoint writes the long-term running averages of this layer's
+// neurons and pools to a checkpoint, under keys <Layer>/<Var>,
+// followed by the state of all of its receiving pathways.
+void leabra::Layer::WriteCheckpoint(weights::CkptWriter &ck) {
+	std::string pfx = Name + "/";
+	const Neuron *nrn = Neurons.data();
+	size_t nn = Neurons.size();
+	ck.AddFunc(pfx + "AvgL", nn, [nrn](size_t i) { return nrn[i].AvgL; });
+	ck.AddFunc(pfx + "ActAvg", nn, [nrn](size_t i) { return nrn[i].ActAvg; });
+	const Pool *pl = Pools.data();
+	size_t np = Pools.size();
+	ck.AddFunc(pfx + "Pools.ActMAvg", np, [pl](size_t i) { return pl[i].ActAvgs.ActMAvg; });
+	ck.AddFunc(pfx + "Pools.ActPAvg", np, [pl](size_t i) { return pl[i].ActAvgs.ActPAvg; });
+	ck.AddFunc(pfx + "Pools.ActPAvgEff", np, [pl](size_t i) { return pl[i].ActAvgs.ActPAvgEff; });
+	for (Path *pt: RecvPaths) {
+		pt->WriteCheckpoint(ck);
+	}
+}
+
+// ReadCheckpoint sets this layer's running averages and the state of its
+// receiving pathways from a checkpoint written by WriteCheckpoint.
+// Pathways not in the checkpoint are left as is, with a warning.
+void leabra::Layer::ReadCheckpoint(weights::CkptFile &ck) {
+	std::string pfx = Name + "/";
+	size_t nn = Neurons.size();
+	if (const Real *ar = ck.ArrayN(pfx + "AvgL", nn)) {
+		for (size_t i = 0; i < nn; i++) Neurons[i].AvgL = ar[i];
+	}
+	if (const Real *ar = ck.ArrayN(pfx + "ActAvg", nn)) {
+		for (size_t i = 0; i < nn; i++) Neurons[i].ActAvg = ar[i];
+	}
+	size_t np = Pools.size();
+	if (const Real *ar = ck.ArrayN(pfx + "Pools.ActMAvg", np)) {
+		for (size_t i = 0; i < np; i++) Pools[i].ActAvgs.ActMAvg = ar[i];
+	}
+	if (const Real *ar = ck.ArrayN(pfx + "Pools.ActPAvg", np)) {
+		for (size_t i = 0; i < np; i++) Pools[i].ActAvgs.ActPAvg = ar[i];
+	}
+	if (const Real *ar = ck.ArrayN(pfx + "Pools.ActPAvgEff", np)) {
+		for (size_t i = 0; i < np; i++) Pools[i].ActAvgs.ActPAvgEff = ar[i];
+	}
+	for (Path *pt: RecvPaths) {
+		if (!pt->ReadCheckpoint(ck)) {
+			std::cerr << "weights: no state for path " << pt->Name << " in checkpoint " << ck.FileName << std::endl;
+		}
+	}
+}
+
 void pybind_LeabraLayer(pybind11::module_ &m) {
 	pybind11::class_<leabra::Layer>(m, "Layer")
 		.def_readonly("Name", &leabra::Layer::Name)
+		.def_readonly("Class", &leabra::Layer::Class)
+		.def("SetClass", &leabra::Layer::SetClass)
 		.def_readonly("Index", &leabra::Layer::Index)
 		.def_readonly("Net", &leabra::Layer::Net)
 		.def_readonly("Act", &leabra::Layer::Act)
 		.def_readwrite("Off", &leabra::Layer::Off)
 		.def("NumPools", &leabra::Layer::NumPools)
+		.def("MemoryReport", &leabra::Layer::MemoryReport)
 	;
 }
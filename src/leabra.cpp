@@ -1,7 +1,12 @@
 #include "leabra.hpp"
 #include "layer.hpp"
+#include "network.hpp"
+#include <chrono>
+#include <algorithm>
+#include <bit>
+#include <numeric>
 
-void leabra::SelfInhibParams::Inhib(float &self, float act) {
+void leabra::SelfInhibParams::Inhib(Real &self, Real act) {
     if (On){
         self += Dt * (Gi*act - self);
     } else {
@@ -21,19 +26,14 @@ std::string leabra::SelfInhibParams::StyleName() {
     return "";
 }
 
-void leabra::SelfInhibParams::InitParamMaps(){
-    ParamNameMap["On"] = (void*) &On;
-	ParamNameMap["Gi"] = (void *) &Gi;
-	ParamNameMap["Tau"] = (void *) &Tau;
-	ParamNameMap["Dt"] = (void *) &Dt;
-
-    ParamTypeMap["On"] = &typeid(bool);
-	ParamTypeMap["Gi"] = &typeid(float);
-	ParamTypeMap["Tau"] = &typeid(float);
-	ParamTypeMap["Dt"] = &typeid(float);
+void leabra::SelfInhibParams::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "On", On);
+	reg.Add(this, "Gi", Gi);
+	reg.Add(this, "Tau", Tau);
+	reg.Add(this, "Dt", Dt);
 }
 
-float leabra::ActAvgParams::EffInit() {
+Real leabra::ActAvgParams::EffInit() {
     if (Fixed){
         return Init;
     } else {
@@ -41,7 +41,7 @@ float leabra::ActAvgParams::EffInit() {
     }
 }
 
-void leabra::ActAvgParams::AvgFromAct(float &avg, float act) {
+void leabra::ActAvgParams::AvgFromAct(Real &avg, Real act) {
     if (act < 0.0001) {
         return ;
     };
@@ -53,7 +53,7 @@ void leabra::ActAvgParams::AvgFromAct(float &avg, float act) {
     }
 }
 
-void leabra::ActAvgParams::EffFromAvg(float &eff, float avg) {
+void leabra::ActAvgParams::EffFromAvg(Real &eff, Real avg) {
     if (Fixed){
         eff = Init;
     } else {
@@ -73,22 +73,14 @@ std::string leabra::ActAvgParams::StyleName() {
     return "";
 }
 
-void leabra::ActAvgParams::InitParamMaps(){
-	ParamNameMap["Init"] = (void*) &Init;
-	ParamNameMap["Fixed"] = (void*) &Fixed;
-	ParamNameMap["UseExtAct"] = (void*) &UseExtAct;
-	ParamNameMap["UseFirst"] = (void*) &UseFirst;
-	ParamNameMap["Tau"] = (void*) &Tau;
-	ParamNameMap["Adjust"] = (void*) &Adjust;
-	ParamNameMap["Dt"] = (void*) &Dt;
-
-	ParamTypeMap["Init"] = &typeid(float);
-	ParamTypeMap["Fixed"] = &typeid(bool);
-	ParamTypeMap["UseExtAct"] = &typeid(bool);
-	ParamTypeMap["UseFirst"] = &typeid(bool);
-	ParamTypeMap["Tau"] = &typeid(float);
-	ParamTypeMap["Adjust"] = &typeid(float);
-	ParamTypeMap["Dt"] = &typeid(float);
+void leabra::ActAvgParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Init", Init);
+	reg.Add(this, "Fixed", Fixed);
+	reg.Add(this, "UseExtAct", UseExtAct);
+	reg.Add(this, "UseFirst", UseFirst);
+	reg.Add(this, "Tau", Tau);
+	reg.Add(this, "Adjust", Adjust);
+	reg.Add(this, "Dt", Dt);
 }
 
 void leabra::InhibParams::Update() {
@@ -118,22 +110,61 @@ std::string leabra::InhibParams::StyleName() {
     return "";
 }
 
-void leabra::InhibParams::InitParamMaps(){
-	ParamNameMap["Layer"] = (void*) &Layer;
-	ParamNameMap["Pool"] = (void*) &Pool;
-	ParamNameMap["Self"] = (void*) &Self;
-	ParamNameMap["ActAvg"] = (void*) &ActAvg;
-
-	ParamTypeMap["Layer"] = &typeid(Layer);
-	ParamTypeMap["Pool"] = &typeid(Pool);
-	ParamTypeMap["Self"] = &typeid(Self);
-	ParamTypeMap["ActAvg"] = &typeid(ActAvg);
+void leabra::InhibParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Layer", Layer);
+	reg.Add(this, "Pool", Pool);
+	reg.Add(this, "Self", Self);
+	reg.Add(this, "ActAvg", ActAvg);
 }
 
 leabra::Path::Path(std::string name, std::string cls):emer::Path(name, cls){
 	Send=nullptr;
 	Recv=nullptr;
-	InitParamMaps();
+	ConnsTransposed = false;
+	ConnsBuilt = false;
+	ConnsViews = 0;
+	Tied = false;
+	TiedTo = nullptr;
+	Shared = false;
+	PatternBytes = 0;
+	InitWeightsPeak = 0;
+	GIncSent = false;
+	SConSorted = false;
+	WbSums = false;
+	WbSumThr = 0;
+	Frozen = false;
+	FrozenGScale = false;
+	FrozenQuant = WtF32;
+	FrozenDense = false;
+}
+
+// notFrozen throws if pt is Frozen, for operations that need its learning state.
+static void notFrozen(leabra::Path &pt, std::string op) {
+	if (pt.Frozen) {
+		throw std::runtime_error("ERROR: " + op + " on path " + pt.Name + ", which is Frozen for inference only");
+	}
+}
+
+// unfreeze frees the frozen weights of pt, which is no longer Frozen, for Build.
+static void unfreeze(leabra::Path &pt) {
+	pt.Frozen = false;
+	pt.FrozenGScale = false;
+	pt.FrozenQuant = leabra::WtF32;
+	pt.FrozenDense = false;
+	pt.FrozenWt.clear();
+	pt.FrozenWt.shrink_to_fit();
+	pt.FrozenBF16.clear();
+	pt.FrozenBF16.shrink_to_fit();
+	pt.FrozenInt8.clear();
+	pt.FrozenInt8.shrink_to_fit();
+	pt.FrozenQScale.clear();
+	pt.FrozenQScale.shrink_to_fit();
+}
+
+// notePeak raises the InitWeightsPeak of pt to its resident bytes, plus those
+// of the transient buffers it holds that MemoryReport does not see.
+static void notePeak(leabra::Path &pt, size_t transient) {
+	pt.InitWeightsPeak = std::max(pt.InitWeightsPeak, pt.MemoryReport().Resident() + transient);
 }
 
 // UpdateParams updates all params given any changes that might have been made to individual values
@@ -152,7 +183,7 @@ void leabra::Path::Defaults() {
 }
 
 int leabra::Path::NumSyns(){
-	return Syns.size();
+	return SConIndex.size();
 }
 
 // SynIndex returns the index of the synapse between given send, recv unit indexes
@@ -171,99 +202,198 @@ int leabra::Path::SynIndex(int sidx, int ridx) {
 	return -1;
 }
 
+// WriteWeightsJSON writes the weights from this pathway from the receiver-side
+// perspective in the JSON format of the Go emergent packages: for each receiving
+// unit, the indexes of its sending units (Si) and the weights from them (Wt).
+void leabra::Path::WriteWeightsJSON(std::ostream &w, int depth) {
+	notFrozen(*this, "WriteWeightsJSON");
+	std::string buf;
+	weights::Indent(w, depth);
+	w << "{\n";
+	depth++;
+	weights::Indent(w, depth);
+	w << "\"From\": " << weights::Quote(Send->Name) << ",\n";
+	weights::Indent(w, depth);
+	w << "\"MetaData\": {\n";
+	weights::Indent(w, depth+1);
+	buf = "\"GScale\": \"";
+	weights::AppendFloat(buf, GScale);
+	w << buf << "\"\n";
+	weights::Indent(w, depth);
+	w << "},\n";
+	weights::Indent(w, depth);
+	w << "\"Rs\": [\n";
+	depth++;
+	int nr = RConN.size();
+	for (int ri = 0; ri < nr; ri++) {
+		int nc = RConN[ri];
+		int st = RConIndexSt[ri];
+		weights::Indent(w, depth);
+		w << "{\n";
+		weights::Indent(w, depth+1);
+		w << "\"Ri\": " << ri << ",\n";
+		weights::Indent(w, depth+1);
+		w << "\"N\": " << nc << ",\n";
+		weights::Indent(w, depth+1);
+		buf = "\"Si\": [ ";
+		for (int ci = 0; ci < nc; ci++) {
+			weights::AppendInt(buf, RConIndex[st+ci]);
+			buf += ci == nc-1 ? " " : ", ";
+		}
+		buf += "],\n";
+		w << buf;
+		weights::Indent(w, depth+1);
+		buf = "\"Wt\": [ ";
+		for (int ci = 0; ci < nc; ci++) {
+			weights::AppendFloat(buf, Syn(RSynIndex[st+ci]).Wt);
+			buf += ci == nc-1 ? " " : ", ";
+		}
+		buf += "]\n";
+		w << buf;
+		weights::Indent(w, depth);
+		w << (ri < nr-1 ? "},\n" : "}\n");
+	}
+	depth--;
+	weights::Indent(w, depth);
+	w << "]\n";
+	depth--;
+	weights::Indent(w, depth);
+	w << "}";
+}
+
+// SetWeightsMetaData sets GScale from the MetaData of a JSON weights file.
+void leabra::Path::SetWeightsMetaData(std::map<std::string, std::string> &md) {
+	if (md.count("GScale") > 0) {
+		GScale = std::stof(md["GScale"]);
+	}
+}
+
+// SetRecvWeights sets the weights from sending units si to receiving unit ri,
+// along with the linear weights (LWt) they imply.
+// Sending units are normally in the same order as this pathway's
+// recv connections, in which case no searching is needed.
+void leabra::Path::SetRecvWeights(int ri, std::vector<int> &si, std::vector<float> &wt) {
+	notFrozen(*this, "SetRecvWeights");
+	if (ri < 0 || ri >= int(RConN.size())) {
+		std::cerr << "SetRecvWeights: recv unit index " << ri << " out of range in path: " << Name << std::endl;
+		return;
+	}
+	int nc = RConN[ri];
+	int st = RConIndexSt[ri];
+	int nmiss = 0;
+	(TiedTo != nullptr ? TiedTo : this)->WbSums = false;
+	for (int i = 0; i < int(si.size()); i++) {
+		int ci = i;
+		if (ci >= nc || RConIndex[st+ci] != si[i]) {
+			for (ci = 0; ci < nc && RConIndex[st+ci] != si[i]; ci++) {}
+			if (ci == nc) {
+				nmiss++;
+				continue;
+			}
+		}
+		Synapse &sy = Syn(RSynIndex[st+ci]);
+		sy.Wt = wt[i];
+		Learn.LWtFromWt(sy);
+		if (TiedTo != nullptr) {
+			TiedTo->CkptDirty[ri] = 1;
+		} else {
+			CkptDirty[si[i]] = 1;
+		}
+	}
+	if (nmiss > 0) {
+		std::cerr << "SetRecvWeights: " << nmiss << " synapses to recv unit " << ri << " not found in path: " << Name << std::endl;
+	}
+}
+
 // Connect sets the connectivity between two layers and the pattern to use in interconnecting them
 void leabra::Path::Connect(leabra::Layer *slay, leabra::Layer *rlay, paths::Pattern *pat, PathTypes typ) {
     Send = slay;
 	Recv = rlay;
 	Pattern = pat;
 	Type = typ;
-	Name = Send->Name + "To" + Recv->Name;
+	SetName(Send->Name + "To" + Recv->Name);
 }
 
 // Build constructs the full connectivity among the layers
 // as specified in this pathway.
 // Calls Validate and returns false if invalid.
-// Pattern.Connect is called to get the pattern of the connection.
-// Then the connection indexes are configured according to that pattern.
+// The connection indexes come from paths.DefaultConnCache, which calls
+// Pattern.Connect to get the pattern of the connection and configures
+// the indexes according to it, unless the same pattern and layer shapes
+// have been built before. If the reciprocal pathway has already been built
+// with the same pattern, and the pattern Transposes, its indexes are shared
+// instead, viewed transposed -- unless it was pruned since (see ConnsBuilt).
+// Any pruned indexes of this pathway are dropped, restoring the full
+// connectivity of the Pattern, and a Frozen pathway is unfrozen, dropping
+// its frozen weights: it needs InitWeights or loaded weights again.
 void leabra::Path::Build() {
     if (Off) {
         return;
     }
+	unfreeze(*this);
     // bool err = Validate(true);
     tensor::Shape &ssh = Send->Shape;
     tensor::Shape &rsh = Recv->Shape;
 
-    std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *> tensorTuple = Pattern->Connect(ssh, rsh, Recv==Send);
-    tensor::Int32 *sendn = std::get<0>(tensorTuple);
-    tensor::Int32 *recvn = std::get<1>(tensorTuple);
-    tensor::Bits *cons = std::get<2>(tensorTuple);
-
-    int slen = ssh.Len();
-    int rlen = rsh.Len();
-    int tcons = SetNIndexSt(SConN, SConNAvgMax, SConIndexSt, *sendn);
-    int tconr = SetNIndexSt(RConN, RConNAvgMax, RConIndexSt, *recvn);
-    if (tconr != tcons) {
-        std::cerr << String() << " programmer error: total recv cons " << tconr << " != total send cons " << tcons << std::endl;
-	}
-	RConIndex.resize(tconr);
-	RSynIndex.resize(tconr);
-	SConIndex.resize(tcons);
-    
-    auto sconN = std::vector<int>(); // temporary mem needed to tracks cur n of sending cons
-    sconN.resize(slen);
-
-    std::vector<bool> &cbits = cons->Values;
-	for (int ri = 0; ri < rlen; ri++) {
-		int rbi = ri * slen;     // recv bit index
-		int rtcn = RConN[ri]; // number of cons
-		int rst = RConIndexSt[ri];
-		int rci = 0;
-		for (int si = 0; si < slen; si++) {
-			if (!cbits[rbi + si]) { // no connection
-				continue;
-			}
-			int sst = SConIndexSt[si];
-			if (rci >= rtcn) {
-                std::cerr << String() << " programmer error: recv target total con number: " << rtcn << " exceeded at recv idx: " << ri << ", send idx: " << si << std::endl;
-				break;
-			}
-			RConIndex[rst+rci] = si;
-
-			int sci = sconN[si];
-			int stcn = SConN[si];
-			if (sci >= stcn) {
-                std::cerr << String() << " programmer error: send target total con number: " << rtcn << " exceeded at recv idx: " << ri << ", send idx: " << si << std::endl;
-				break;
-			}
-			SConIndex[sst+sci] = ri;
-			RSynIndex[rst+rci] = sst + sci;
-			(sconN[si])++;
-			rci++;
-		}
+	int slen = ssh.Len();
+	int rlen = rsh.Len();
+	Conns = nullptr;
+	Path *rpt = Send == Recv ? nullptr : Send->RecipToSendPath(this);
+	if (rpt != nullptr && !rpt->Off && rpt->Conns != nullptr && rpt->ConnsBuilt && Pattern->Transposes() &&
+			rpt->Pattern->Key() == Pattern->Key() && int(rpt->SConN.size()) == rlen && int(rpt->RConN.size()) == slen) {
+		// view the reciprocal's indexes transposed
+		Conns = rpt->Conns;
+		ConnsTransposed = !rpt->ConnsTransposed;
+		PatternBytes = 0;
+	} else {
+		int built = paths::DefaultConnCache.Misses;
+		Conns = paths::DefaultConnCache.Get(*Pattern, ssh, rsh, Recv==Send);
+		ConnsTransposed = false;
+		// the pattern tables were only made, and held, if the cache missed
+		PatternBytes = !Conns->Cached || paths::DefaultConnCache.Misses != built ? Conns->PatternBytes : 0;
+	}
+	ConnsBuilt = true;
+	ConnsViews = 1; // until the network counts them
+	const paths::ConnIndexes &ci = *Conns;
+	if (ConnsTransposed) {
+		SConN = ci.RConN;
+		SConIndexSt = ci.RConIndexSt;
+		SConIndex = ci.RConIndex;
+		RConN = ci.SConN;
+		RConIndexSt = ci.SConIndexSt;
+		RConIndex = ci.SConIndex;
+		RSynIndex = ci.SynRIndex();
+	} else {
+		SConN = ci.SConN;
+		SConIndexSt = ci.SConIndexSt;
+		SConIndex = ci.SConIndex;
+		RConN = ci.RConN;
+		RConIndexSt = ci.RConIndexSt;
+		RConIndex = ci.RConIndex;
+		RSynIndex = ci.RSynIndex;
 	}
+	SetNAvgMax(SConN, SConNAvgMax);
+	SetNAvgMax(RConN, RConNAvgMax);
+
+	TiedTo = nullptr;
+	TiedSynIndex = {};
+	Kernel = nullptr;
 	Syns.resize(SConIndex.size());
 	GInc.resize(rlen);
+	GIncBlksInit();
 	WbRecv.resize(rlen);
+	WbSums = false;
+	CkptDirty.assign(slen, 1);
+	DWtRowsAll();
 }
 
-// SetNIndexSt sets the *ConN and *ConIndexSt values given n tensor from Pat.
-// Returns total number of connections for this direction.
-int leabra::Path::SetNIndexSt(std::vector<int> &n, minmax::AvgMax32 &avgmax, std::vector<int> &idxst, tensor::Int32 &tn) {
-    int ln = tn.Len();
-	std::vector<int> &tnv = tn.Values;
-	n.resize(ln);
-	idxst.resize(ln);
-	int idx = 0;
-	// avgmax.Init();
-	for (int i = 0; i < ln; i++) {
-		int nv = tnv[i];
-		n[i] = nv;
-		idxst[i] = idx;
-		idx += nv;
-		avgmax.UpdateValue(nv, i);
+// SetNAvgMax sets the average and maximum of the *ConN number of connections.
+void leabra::Path::SetNAvgMax(std::span<const int> n, minmax::AvgMax32 &avgmax) {
+	avgmax.Init();
+	for (size_t i = 0; i < n.size(); i++) {
+		avgmax.UpdateValue(n[i], i);
 	}
 	avgmax.CalcAvg();
-	return idx;
 }
 
 std::string leabra::Path::String() {
@@ -288,44 +418,26 @@ std::string leabra::Path::String() {
 
 // SetScalesRPool initializes synaptic Scale values using given tensor
 // of values which has unique values for each recv neuron within a given pool.
-void leabra::Path::SetScalesRPool(tensor::Tensor<float> scales) {
-    int rNuY = scales.Dim(0);
-    int rNuX = scales.Dim(1);
-    int rNu = rNuY * rNuX;
-    float rfsz = scales.Len() / rNu;
-
-    tensor::Shape rsh = Recv->Shape;
-    int rNpY = rsh.Sizes[0];
-    int rNpX = rsh.Sizes[1];
-    bool r2d = false;
-
-    if (rsh.NumDims() != 4) {
-        r2d = true;
-        rNpY = 1;
-        rNpX = 1;
-    }
-
-    for (int rpy = 0; rpy < rNpY; rpy++) {
-		for (int rpx = 0; rpx < rNpX; rpx++) {
-			for (int ruy = 0; ruy < rNuY; ruy++) {
-				for (int rux = 0; rux < rNuX; rux++) {
-					int ri = 0;
-					if (r2d) {
-						ri = rsh.Offset({ruy, rux});
-					} else {
-						ri = rsh.Offset({rpy, rpx, ruy, rux});
-					}
-					float scst = (ruy*rNuX + rux) * rfsz;
-					int nc = RConN[ri];
-					int st = RConIndexSt[ri];
-					for (int ci = 0; ci < nc; ci++) {
-						// si := int(pj.RConIndex[st+ci]) // could verify coords etc
-						int rsi = RSynIndex[st+ci];
-						Synapse &sy = Syns[rsi];
-						float sc = scales.Values[scst + ci];
-						sy.Scale = sc;
-					}
-				}
+// The scales of each recv neuron are written in one flat pass over its
+// recv connections.
+void leabra::Path::SetScalesRPool(const tensor::Tensor<float> &scales) {
+	notFrozen(*this, "SetScalesRPool");
+	int rNu = scales.Shp.Sizes[0] * scales.Shp.Sizes[1];
+	int rfsz = scales.Values.size() / rNu;
+	int rn = RConN.size();
+	for (int ri = 0; ri < rn; ri++) {
+		// recv neurons are pools of rNu units, or the whole layer if 2D
+		const float *sc = scales.Values.data() + (ri % rNu) * rfsz;
+		int nc = std::min(RConN[ri], rfsz);
+		const int *rsi = RSynIndex.data() + RConIndexSt[ri];
+		if (TiedTo == nullptr && Kernel == nullptr) {
+			Synapse *syns = Syns.data();
+			for (int ci = 0; ci < nc; ci++) {
+				syns[rsi[ci]].Scale = sc[ci];
+			}
+		} else {
+			for (int ci = 0; ci < nc; ci++) {
+				Syn(rsi[ci]).Scale = sc[ci];
 			}
 		}
 	}
@@ -334,9 +446,11 @@ void leabra::Path::SetScalesRPool(tensor::Tensor<float> scales) {
 // SetWtsFunc initializes synaptic Wt value using given function
 // based on receiving and sending unit indexes.
 void leabra::Path::SetWtsFunc(std::function<float(int si, int ri, tensor::Shape &send, tensor::Shape &recv)> wtFun) {
+	notFrozen(*this, "SetWtsFunc");
 	tensor::Shape &rsh = Recv->Shape;
 	int rn = rsh.Len();
 	tensor::Shape &ssh = Send->Shape;
+	(TiedTo != nullptr ? TiedTo : this)->WbSums = false;
 
 	for (int ri = 0; ri < rn; ri++) {
 		int nc = RConN[ri];
@@ -345,7 +459,7 @@ void leabra::Path::SetWtsFunc(std::function<float(int si, int ri, tensor::Shape
 			int si = RConIndex[st+ci];
 			float wt = wtFun(si, ri, ssh, rsh);
 			int rsi = RSynIndex[st+ci];
-			Synapse &sy = Syns[rsi];
+			Synapse &sy = Syn(rsi);
 			sy.Wt = wt * sy.Scale;
 			Learn.LWtFromWt(sy);
 		}
@@ -355,6 +469,7 @@ void leabra::Path::SetWtsFunc(std::function<float(int si, int ri, tensor::Shape
 // SetScalesFunc initializes synaptic Scale values using given function
 // based on receiving and sending unit indexes.
 void leabra::Path::SetScalesFunc(std::function<float(int si, int ri, tensor::Shape &send, tensor::Shape &recv)> scaleFun) {
+	notFrozen(*this, "SetScalesFunc");
 	tensor::Shape &rsh = Recv->Shape;
 	int rn = rsh.Len();
 	tensor::Shape &ssh = Send->Shape;
@@ -366,7 +481,7 @@ void leabra::Path::SetScalesFunc(std::function<float(int si, int ri, tensor::Sha
 			int si = RConIndex[st+ci];
 			float sc = scaleFun(si, ri, ssh, rsh);
 			int rsi = RSynIndex[st+ci];
-			Synapse &sy = Syns[rsi];
+			Synapse &sy = Syn(rsi);
 			sy.Scale = sc;
 		}
 	}
@@ -395,20 +510,170 @@ void leabra::Path::InitWeightsSyn(Synapse &syn) {
 	syn.Moment = 0;
 }
 
-// InitWeights initializes weight values according to Learn.WtInit params
+// InitWeights initializes weight values according to Learn.WtInit params.
+// A Tied pathway that does not own its synapses leaves them to the owner,
+// and is untied first if Tied has been turned off.
+// The kernel of synapses is made or removed here if Shared has changed.
 void leabra::Path::InitWeights() {
+	notFrozen(*this, "InitWeights");
+	InitWeightsPeak = 0;
+	notePeak(*this, 0);
+	if (TiedTo != nullptr && !(Tied && TiedTo->Tied)) {
+		Untie();
+	}
+	if (Shared && Kernel == nullptr) {
+		Share();
+	} else if (!Shared && Kernel != nullptr) {
+		Unshare();
+	}
 	for (Synapse &sy: Syns) {
 		InitWeightsSyn(sy);
 	}
 	for (WtBalRecvPath &wb: WbRecv) {
 		wb.Init();
 	}
+	WbSums = false;
+	std::fill(CkptDirty.begin(), CkptDirty.end(), 1);
+	DWtRowsAll();
 	InitGInc();
+	notePeak(*this, 0);
+}
+
+// DWtRowsAll lists all of the rows of Syns in DWtRows, for when their DWt
+// may have been set other than by DWt, or the rows have changed.
+// A Tied pathway has no rows: its DWt go to the rows of TiedTo.
+void leabra::Path::DWtRowsAll() {
+	int nrow = 0;
+	if (TiedTo == nullptr) {
+		nrow = Kernel != nullptr ? Kernel->NOff * Kernel->SNu : int(SConN.size());
+	}
+	DWtRowMark.assign(nrow, 1);
+	DWtRows.resize(nrow);
+	std::iota(DWtRows.begin(), DWtRows.end(), 0);
+}
+
+// Tie makes this Tied pathway use the synapses of its reciprocal pathway
+// owner, freeing its own, returning false if it cannot: the pathways must
+// share their connection indexes, transposed.
+bool leabra::Path::Tie(Path &owner) {
+	if (TiedTo == &owner) {
+		return true;
+	}
+	if (Conns == nullptr || owner.Conns != Conns || owner.ConnsTransposed == ConnsTransposed || owner.TiedTo != nullptr) {
+		std::cerr << "Tie: path " << Name << " does not share its connection indexes with " << owner.Name
+			<< ", so it cannot be tied to it" << std::endl;
+		return false;
+	}
+	if (TiedTo != nullptr) {
+		Untie();
+	}
+	TiedTo = &owner;
+	// synapse i here is synapse TiedSynIndex[i] of the owner -- see InitWtSym
+	TiedSynIndex = ConnsTransposed ? Conns->RSynIndex : Conns->SynRIndex();
+	Syns.clear();
+	Syns.shrink_to_fit();
+	DWtRowsAll();
+	return true;
+}
+
+// Untie gives a Tied pathway its own copy of the synapses it uses.
+void leabra::Path::Untie() {
+	if (TiedTo == nullptr) {
+		return;
+	}
+	Syns.resize(SConIndex.size());
+	for (size_t i = 0; i < Syns.size(); i++) {
+		Syns[i] = TiedTo->Syns[TiedSynIndex[i]];
+	}
+	TiedTo = nullptr;
+	TiedSynIndex = {};
+	WbSums = false;
+	DWtRowsAll();
+}
+
+// TiedBy returns the reciprocal pathway Tied to this one, which uses its
+// synapses, or nullptr if there is none.
+leabra::Path *leabra::Path::TiedBy() {
+	if (!Tied || TiedTo != nullptr) {
+		return nullptr;
+	}
+	Path *rpt = Send->RecipToSendPath(this);
+	return rpt != nullptr && rpt->TiedTo == this ? rpt : nullptr;
+}
+
+// Share replaces the synapses of this pathway with one kernel shared by
+// all of the receiving pools, returning false if it cannot: the Pattern
+// must be a paths.PoolTile. Each kernel synapse starts as a copy of the
+// first synapse using it (e.g., keeping Scale from InitTopoScales).
+bool leabra::Path::Share() {
+	if (Kernel != nullptr) {
+		return true;
+	}
+	paths::PoolTile *pt = dynamic_cast<paths::PoolTile*>(Pattern);
+	if (pt == nullptr || TiedTo != nullptr || Conns == nullptr || ConnsTransposed) {
+		std::cerr << "Share: path " << Name << " does not have a PoolTile pattern, so it cannot share weights" << std::endl;
+		return false;
+	}
+	std::shared_ptr<paths::PoolKernel> kn = pt->Kernel(Send->Shape, Recv->Shape, *Conns);
+	std::vector<Synapse> ksyns(kn->Len());
+	std::vector<char> set(ksyns.size());
+	for (size_t i = 0; i < Syns.size(); i++) {
+		int ki = kn->SynIndex[i];
+		if (!set[ki]) {
+			ksyns[ki] = Syns[i];
+			set[ki] = 1;
+		}
+	}
+	notePeak(*this, ksyns.capacity() * sizeof(Synapse) + set.capacity());
+	Syns.swap(ksyns);
+	Kernel = kn;
+	kernelDWt.assign(Syns.size(), 0);
+	kernelDWtN.assign(Syns.size(), 0);
+	WbSums = false;
+	DWtRowsAll();
+	return true;
+}
+
+// Unshare gives each receiving pool of a Shared pathway its own copy of the
+// kernel of synapses.
+void leabra::Path::Unshare() {
+	if (Kernel == nullptr) {
+		return;
+	}
+	std::vector<Synapse> syns(SConIndex.size());
+	for (size_t i = 0; i < syns.size(); i++) {
+		syns[i] = Syns[Kernel->SynIndex[i]];
+	}
+	notePeak(*this, syns.capacity() * sizeof(Synapse));
+	Syns.swap(syns);
+	Kernel = nullptr;
+	kernelDWt = {};
+	kernelDWtN = {};
+	WbSums = false;
+	DWtRowsAll();
 }
 
 // InitWtSym initializes weight symmetry -- is given the reciprocal pathway where
 // the Send and Recv layers are reversed.
+// When the two pathways share their connection indexes (see Conns),
+// the reciprocal synapses are looked up directly.
 void leabra::Path::InitWtSym(Path &rpt) {
+	if (Kernel != nullptr || rpt.Kernel != nullptr) {
+		return; // kernel synapses are not one-to-one with the reciprocal's
+	}
+	rpt.WbSums = false;
+	if (Conns != nullptr && rpt.Conns == Conns && rpt.ConnsTransposed != ConnsTransposed) {
+		// synapse i here is the reciprocal of synapse ri[i] in rpt
+		std::span<const int> ri = ConnsTransposed ? Conns->RSynIndex : Conns->SynRIndex();
+		for (size_t i = 0; i < Syns.size(); i++) {
+			Synapse &sy = Syns[i];
+			Synapse &rsy = rpt.Syns[ri[i]];
+			rsy.Wt = sy.Wt;
+			rsy.LWt = sy.LWt;
+			rsy.Scale = sy.Scale;
+		}
+		return;
+	}
 	leabra::Layer &slay = *Send;
 	int ns = slay.Neurons.size();
 	for (int si = 0; si < ns; si++) {
@@ -447,7 +712,7 @@ void leabra::Path::InitWtSym(Path &rpt) {
 					int rrii = rsst + up;
 					int rri = rpt.SConIndex[rrii];
 					if (rri == si) {
-						Synapse &rsy = Syns[rrii];
+						Synapse &rsy = rpt.Syns[rrii];
 						rsy.Wt = sy.Wt;
 						rsy.LWt = sy.LWt;
 						rsy.Scale = sy.Scale;
@@ -461,7 +726,7 @@ void leabra::Path::InitWtSym(Path &rpt) {
 					int rrii = rsst + dn;
 					int rri = rpt.SConIndex[rrii];
 					if (rri == si) {
-						Synapse &rsy = Syns[rrii];
+						Synapse &rsy = rpt.Syns[rrii];
 						rsy.Wt = sy.Wt;
 						rsy.LWt = sy.LWt;
 						rsy.Scale = sy.Scale;
@@ -481,55 +746,209 @@ void leabra::Path::InitWtSym(Path &rpt) {
 // InitGInc initializes the per-pathway GInc threadsafe increment -- not
 // typically needed (called during InitWeights only) but can be called when needed
 void leabra::Path::InitGInc() {
-	for (float &ginc: GInc) {
+	for (Real &ginc: GInc) {
 		ginc = 0;
 	}
+	GIncSent = false;
+	std::fill(GIncBlks.begin(), GIncBlks.end(), 0);
+}
+
+// GIncBlksInit sizes GIncBlks for the recv units and sets SConSorted,
+// for the current connections.
+void leabra::Path::GIncBlksInit() {
+	GIncBlks.assign((GInc.size() + GIncBlock - 1) / GIncBlock, 0);
+	GIncSent = false;
+	SConSorted = true;
+	for (size_t si = 0; si < SConN.size() && SConSorted; si++) {
+		const int *scons = SConIndex.data() + SConIndexSt[si];
+		for (int ci = 1; ci < SConN[si]; ci++) {
+			if (scons[ci] <= scons[ci-1]) {
+				SConSorted = false;
+				break;
+			}
+		}
+	}
 }
 
 
-void leabra::Path::SendGDelta(int si, float delta){
-	float scdel = delta * GScale;
+// SendGDelta sends the change in activation delta of sending unit si,
+// times the weights from it, into GInc.
+// A Shared pathway sends to each receiving pool from the kernel synapses
+// at the position of the unit's pool in the pool's receptive field.
+void leabra::Path::SendGDelta(int si, Real delta){
+	Real scdel = delta * GScale;
+	if (Frozen) {
+		SendGDeltaFrozen(si, FrozenGScale ? delta : scdel);
+		return;
+	}
+	if (Kernel != nullptr) {
+		const paths::PoolKernel &kn = *Kernel;
+		int spi = si / kn.SNu;
+		int sui = si % kn.SNu;
+		int st = kn.SPoolSt[spi];
+		int ed = st + kn.SPoolN[spi];
+		for (int pi = st; pi < ed; pi++) {
+			const Synapse *ksy = Syns.data() + (kn.Off[pi] * kn.SNu + sui) * kn.RNu;
+			Real *ginc = GInc.data() + kn.RPool[pi] * kn.RNu;
+			for (int rui = 0; rui < kn.RNu; rui++) {
+				ginc[rui] += scdel * ksy[rui].Wt;
+			}
+			GIncMark(kn.RPool[pi] * kn.RNu, (kn.RPool[pi] + 1) * kn.RNu - 1);
+		}
+		return;
+	}
 	int nc = SConN[si];
 	int st = SConIndexSt[si];
+	const int *scons = SConIndex.data() + st;
+	if (nc == 0) {
+		return;
+	}
+	GIncMark(SConSorted ? scons[0] : 0, SConSorted ? scons[nc-1] : int(GInc.size()) - 1);
 
-	// slicing is ugly in c++...
-	auto synStart = Syns.begin() + st;
-	auto synEnd = Syns.begin() + st + nc;
-	auto syns = std::vector<leabra::Synapse>(synStart, synEnd);
+	if (TiedTo != nullptr) {
+		const Synapse *tsyns = TiedTo->Syns.data();
+		const int *tsi = TiedSynIndex.data() + st;
+		for (int ci = 0; ci < nc; ci++) {
+			GInc[scons[ci]] += scdel * tsyns[tsi[ci]].Wt;
+		}
+		return;
+	}
+	const Synapse *syns = Syns.data() + st;
+	for (int ci = 0; ci < nc; ci++) {
+		GInc[scons[ci]] += scdel * syns[ci].Wt;
+	}
+}
+
+// dequant returns a weight stored in the format of a Frozen pathway,
+// without its WtInt8 scale.
+static inline Real dequant(Real wt) {
+	return wt;
+}
+
+static inline float dequant(uint16_t wt) {
+	return std::bit_cast<float>(uint32_t(wt) << 16);
+}
 
-	auto sconStart = SConIndex.begin() + st;
-	auto sconEnd = SConIndex.begin() + st + nc;
-	auto scons = std::vector<int>(sconStart, sconEnd);
+static inline float dequant(int8_t wt) {
+	return float(wt);
+}
+
+// bf16FromFloat returns the bfloat16 nearest to f, rounding to even.
+static inline uint16_t bf16FromFloat(float f) {
+	uint32_t u = std::bit_cast<uint32_t>(f);
+	u += 0x7fff + ((u >> 16) & 1);
+	return uint16_t(u >> 16);
+}
+
+// sendFrozen is SendGDeltaFrozen for the weights wts of pt, in any format.
+// The loop over a FrozenDense span of GInc is vectorized by the compiler,
+// converting the weights on the fly.
+template <typename W>
+static void sendFrozen(leabra::Path &pt, const W *wts, int si, Real scdel) {
+	Real *ginc = pt.GInc.data();
+	if (pt.Kernel != nullptr) {
+		const paths::PoolKernel &kn = *pt.Kernel;
+		int spi = si / kn.SNu;
+		int sui = si % kn.SNu;
+		int st = kn.SPoolSt[spi];
+		int ed = st + kn.SPoolN[spi];
+		for (int pi = st; pi < ed; pi++) {
+			const W *kwt = wts + (kn.Off[pi] * kn.SNu + sui) * kn.RNu;
+			Real *pginc = ginc + kn.RPool[pi] * kn.RNu;
+			for (int rui = 0; rui < kn.RNu; rui++) {
+				pginc[rui] += scdel * dequant(kwt[rui]);
+			}
+			pt.GIncMark(kn.RPool[pi] * kn.RNu, (kn.RPool[pi] + 1) * kn.RNu - 1);
+		}
+		return;
+	}
+	int nc = pt.SConN[si];
+	int st = pt.SConIndexSt[si];
+	const int *scons = pt.SConIndex.data() + st;
+	wts += st;
+	if (nc == 0) {
+		return;
+	}
+	pt.GIncMark(pt.SConSorted ? scons[0] : 0, pt.SConSorted ? scons[nc-1] : int(pt.GInc.size()) - 1);
+	if (pt.FrozenDense) {
+		Real *dginc = ginc + scons[0];
+		for (int ci = 0; ci < nc; ci++) {
+			dginc[ci] += scdel * dequant(wts[ci]);
+		}
+		return;
+	}
+	for (int ci = 0; ci < nc; ci++) {
+		ginc[scons[ci]] += scdel * dequant(wts[ci]);
+	}
+}
 
-	for (uint ci = 0; ci < syns.size();  ci++) {
-		int ri = scons[ci];
-		GInc[ri] += scdel * syns[ci].Wt;
+// SendGDeltaFrozen is SendGDelta for a Frozen pathway, from its weights
+// in FrozenQuant format, given the delta already scaled by GScale if needed.
+void leabra::Path::SendGDeltaFrozen(int si, Real scdel) {
+	switch (FrozenQuant) {
+	case WtBF16:
+		sendFrozen(*this, FrozenBF16.data(), si, scdel);
+		break;
+	case WtInt8:
+		sendFrozen(*this, FrozenInt8.data(), si, FrozenQScale.size() == 1 ? scdel * FrozenQScale[0] : scdel);
+		break;
+	default:
+		sendFrozen(*this, FrozenWt.data(), si, scdel);
+		break;
 	}
 }
 
 // RecvGInc increments the receiver's GeRaw or GiRaw from that of all the pathways.
+// GInc is first scaled by the FrozenQScale of each receiver, if any.
+// Only the GIncBlks that SendGDelta marked are visited, as GInc is 0
+// everywhere else, and nothing at all if there were no sends, as is
+// common late in settling.
 void leabra::Path::RecvGInc() {
-	Layer &rlay = *Recv;
-	if (Type == InhibPath) {
-		for (uint ri = 0; ri < rlay.Neurons.size(); ri++) {
-			Neuron &rn = rlay.Neurons[ri];
-			rn.GiRaw += GInc[ri];
-			GInc[ri] = 0;
+	if (!GIncSent) {
+		return;
+	}
+	GIncSent = false;
+	Neuron *rns = Recv->Neurons.data();
+	int nr = GInc.size();
+	bool qscale = FrozenQScale.size() > 1;
+	bool inhib = Type == InhibPath;
+	for (int bi = 0; bi < int(GIncBlks.size()); bi++) {
+		if (!GIncBlks[bi]) {
+			continue;
 		}
-	} else {
-		for (uint ri = 0; ri < rlay.Neurons.size(); ri++) {
-			Neuron &rn = rlay.Neurons[ri];
-			rn.GeRaw += GInc[ri];
+		GIncBlks[bi] = 0;
+		int ed = std::min(nr, (bi + 1) * GIncBlock);
+		for (int ri = bi * GIncBlock; ri < ed; ri++) {
+			if (qscale) {
+				GInc[ri] *= FrozenQScale[ri];
+			}
+			if (inhib) {
+				rns[ri].GiRaw += GInc[ri];
+			} else {
+				rns[ri].GeRaw += GInc[ri];
+			}
 			GInc[ri] = 0;
 		}
 	}
 }
 
-// DWt computes the weight change (learning) -- on sending pathways
-void leabra::Path::DWt() {
+// DWt computes the weight change (learning) -- on sending pathways.
+// If batch, the raw weight changes of a minibatch of trials are summed in
+// DWt instead, and DWtFromBatch applies Norm, Momentum and Lrate to them
+// once at the end of the batch (see Sim.BatchSize).
+// The two pathways of a Tied pair also sum their raw changes in the DWt of
+// the synapses they share, to which the owner applies Norm, Momentum and
+// Lrate once, with DWtFromBatch (see Network.Dwt).
+void leabra::Path::DWt(bool batch) {
+	notFrozen(*this, "DWt");
 	if (!Learn.Learn) {
 		return;
 	}
+	if (Kernel != nullptr) {
+		DWtKernel(batch);
+		return;
+	}
+	bool raw = batch || TiedTo != nullptr || TiedBy() != nullptr;
 	Layer &slay = *Send;
 	Layer &rlay = *Recv;
 	for (uint si = 0; si < slay.Neurons.size(); si++) {
@@ -539,124 +958,742 @@ void leabra::Path::DWt() {
 		}
 		int nc = int(SConN[si]);
 		int st = int(SConIndexSt[si]);
+		CkptDirty[si] = 1;
+		if (TiedTo == nullptr) {
+			DWtRow(si);
+		}
 
-		auto start = Syns.begin() + st;
-		auto end = Syns.begin() + st + nc;
-		auto syns = std::vector<leabra::Synapse>(start, end);
-
-		auto sconStart = SConIndex.begin() + st;
-		auto sconEnd = SConIndex.begin() + st + nc;
-		auto scons = std::vector<int>(sconStart, sconEnd);
-
-		for (uint ci = 0; ci < syns.size(); ci++) {
-			Synapse &sy = syns[ci];
-			int ri = scons[ci];
+		for (int ci = 0; ci < nc; ci++) {
+			Synapse &sy = Syn(st+ci);
+			int ri = SConIndex[st+ci];
 			Neuron &rn = rlay.Neurons[ri];
-			float err, bcm;
+			if (TiedTo != nullptr) {
+				TiedTo->CkptDirty[ri] = 1;
+				TiedTo->DWtRow(ri);
+			}
+			Real err, bcm;
 			auto dwtTuple = Learn.CHLdWt(sn.AvgSLrn, sn.AvgM, rn.AvgSLrn, rn.AvgM, rn.AvgL);
 			err = std::get<0>(dwtTuple);
 			bcm = std::get<1>(dwtTuple);
 
 			bcm *= Learn.XCal.LongLrate(rn.AvgLLrn);
 			err *= Learn.XCal.MLrn;
-			float dwt = bcm + err;
-			float norm = 1;
+			Real dwt = bcm + err;
+			if (raw) {
+				sy.DWt += dwt;
+				continue;
+			}
+			Real norm = 1;
 			if (Learn.Norm.On) {
-				norm = Learn.Norm.NormFromAbsDWt(sy.Norm, std::abs(dwt));
+				Real snorm = sy.Norm;
+				norm = Learn.Norm.NormFromAbsDWt(snorm, std::abs(dwt));
+				sy.Norm = snorm;
 			}
 			if (Learn.Momentum.On) {
-				dwt = norm * Learn.Momentum.MomentFromDWt(sy.Moment, dwt);
+				Real moment = sy.Moment;
+				dwt = norm * Learn.Momentum.MomentFromDWt(moment, dwt);
+				sy.Moment = moment;
 			} else {
 				dwt *= norm;
 			}
 			sy.DWt += Learn.Lrate * dwt;
 		}
 		// aggregate max DWtNorm over sending synapses
-		if (Learn.Norm.On) {
-			float maxNorm = 0;
-			for (uint ci = 0; ci < syns.size(); ci++) {
-				Synapse &sy = syns[ci];
+		if (Learn.Norm.On && !raw) {
+			Real maxNorm = 0;
+			for (int ci = 0; ci < nc; ci++) {
+				Synapse &sy = Syn(st+ci);
 				if (sy.Norm > maxNorm) {
 					maxNorm = sy.Norm;
 				}
 			}
-			for (uint ci = 0; ci < syns.size(); ci++) {
-				Synapse &sy = syns[ci];
+			for (int ci = 0; ci < nc; ci++) {
+				Synapse &sy = Syn(st+ci);
 				sy.Norm = maxNorm;
 			}
 		}
 	}
 }
 
-// WtFromDWt updates the synaptic weight values from delta-weight changes -- on sending pathways
-void leabra::Path::WtFromDWt() {
-	if (!Learn.Learn) {
+// DWtKernel is DWt for a Shared pathway: the weight changes computed for
+// all the receiving pools are averaged into each kernel synapse, which
+// then applies Norm and Momentum once.
+// Norm is aggregated over the kernel synapses from each sending unit
+// at each receptive field position.
+// If batch, the averaged raw changes are summed in DWt, as in DWt.
+void leabra::Path::DWtKernel(bool batch) {
+	Layer &slay = *Send;
+	Layer &rlay = *Recv;
+	const paths::PoolKernel &kn = *Kernel;
+	std::fill(kernelDWt.begin(), kernelDWt.end(), 0);
+	std::fill(kernelDWtN.begin(), kernelDWtN.end(), 0);
+	for (uint si = 0; si < slay.Neurons.size(); si++) {
+		Neuron &sn = slay.Neurons[si];
+		if (sn.AvgS < Learn.XCal.LrnThr && sn.AvgM < Learn.XCal.LrnThr) {
+			continue;
+		}
+		CkptDirty[si] = 1;
+		int spi = si / kn.SNu;
+		int sui = si % kn.SNu;
+		int st = kn.SPoolSt[spi];
+		int ed = st + kn.SPoolN[spi];
+		for (int pi = st; pi < ed; pi++) {
+			int kst = (kn.Off[pi] * kn.SNu + sui) * kn.RNu;
+			const Neuron *rns = rlay.Neurons.data() + kn.RPool[pi] * kn.RNu;
+			for (int rui = 0; rui < kn.RNu; rui++) {
+				const Neuron &rn = rns[rui];
+				auto [err, bcm] = Learn.CHLdWt(sn.AvgSLrn, sn.AvgM, rn.AvgSLrn, rn.AvgM, rn.AvgL);
+				bcm *= Learn.XCal.LongLrate(rn.AvgLLrn);
+				err *= Learn.XCal.MLrn;
+				kernelDWt[kst + rui] += bcm + err;
+				kernelDWtN[kst + rui]++;
+			}
+		}
+	}
+	int nrow = kn.NOff * kn.SNu;
+	for (int row = 0; row < nrow; row++) {
+		int st = row * kn.RNu;
+		bool any = false;
+		for (int ki = st; ki < st + kn.RNu; ki++) {
+			if (kernelDWtN[ki] == 0) {
+				continue;
+			}
+			if (!any) {
+				DWtRow(row);
+			}
+			any = true;
+			Synapse &sy = Syns[ki];
+			Real dwt = kernelDWt[ki] / Real(kernelDWtN[ki]);
+			if (batch) {
+				sy.DWt += dwt;
+				continue;
+			}
+			Real norm = 1;
+			if (Learn.Norm.On) {
+				Real snorm = sy.Norm;
+				norm = Learn.Norm.NormFromAbsDWt(snorm, std::abs(dwt));
+				sy.Norm = snorm;
+			}
+			if (Learn.Momentum.On) {
+				Real moment = sy.Moment;
+				dwt = norm * Learn.Momentum.MomentFromDWt(moment, dwt);
+				sy.Moment = moment;
+			} else {
+				dwt *= norm;
+			}
+			sy.DWt += Learn.Lrate * dwt;
+		}
+		if (any && Learn.Norm.On) {
+			Real maxNorm = 0;
+			for (int ki = st; ki < st + kn.RNu; ki++) {
+				maxNorm = std::max(maxNorm, Real(Syns[ki].Norm));
+			}
+			for (int ki = st; ki < st + kn.RNu; ki++) {
+				Syns[ki].Norm = maxNorm;
+			}
+		}
+	}
+}
+
+// DWtFromBatch turns the raw weight changes summed in DWt over a minibatch
+// (see DWt) into the DWt for WtFromDWt, applying Norm, Momentum and Lrate
+// as DWt does for each trial. Only the DWtRows are visited, and rows
+// with no changes are skipped, as in DWt.
+// Synapses shared by Tied pathways are only updated by their owner, which
+// also calls this after each trial for the raw changes of both of them.
+void leabra::Path::DWtFromBatch() {
+	notFrozen(*this, "DWtFromBatch");
+	if (!Learn.Learn || TiedTo != nullptr) {
 		return;
 	}
-	if (Learn.WtBal.On) {
-		for (uint si = 0; si < Syns.size(); si++) {
-			Synapse &sy = Syns[si];
-			int ri = SConIndex[si];
-			WtBalRecvPath &wb = WbRecv[ri];
-			Learn.WtFromDWt(wb.Inc, wb.Dec, sy.DWt, sy.Wt, sy.LWt, sy.Scale);
+	for (int row: DWtRows) {
+		int st = Kernel != nullptr ? row * Kernel->RNu : int(SConIndexSt[row]);
+		int nc = Kernel != nullptr ? Kernel->RNu : int(SConN[row]);
+		Synapse *sys = Syns.data() + st;
+		bool any = false;
+		for (int ci = 0; ci < nc; ci++) {
+			if (sys[ci].DWt != 0) {
+				any = true;
+				break;
+			}
 		}
-	} else {
-		for (uint si = 0; si < Syns.size(); si++) {
-			Synapse &sy = Syns[si];
-			Learn.WtFromDWt(1, 1, sy.DWt, sy.Wt, sy.LWt, sy.Scale);
+		if (!any) {
+			continue;
+		}
+		Real maxNorm = 0;
+		for (int ci = 0; ci < nc; ci++) {
+			Synapse &sy = sys[ci];
+			Real dwt = sy.DWt;
+			Real norm = 1;
+			if (Learn.Norm.On) {
+				Real snorm = sy.Norm;
+				norm = Learn.Norm.NormFromAbsDWt(snorm, std::abs(dwt));
+				sy.Norm = snorm;
+				maxNorm = std::max(maxNorm, snorm);
+			}
+			if (Learn.Momentum.On) {
+				Real moment = sy.Moment;
+				dwt = norm * Learn.Momentum.MomentFromDWt(moment, dwt);
+				sy.Moment = moment;
+			} else {
+				dwt *= norm;
+			}
+			sy.DWt = Learn.Lrate * dwt;
 		}
+		if (Learn.Norm.On) {
+			for (int ci = 0; ci < nc; ci++) {
+				sys[ci].Norm = maxNorm;
+			}
+		}
+	}
+}
+
+// wtFromDWt applies ls.WtFromDWt to the synapse. With Half synapses
+// (SynReal != Real) the values are updated in Real and stored back.
+template<typename S>
+static inline void wtFromDWt(leabra::LearnSynParams &ls, Real wbInc, Real wbDec, S &sy) {
+	if constexpr (std::is_same_v<SynReal, Real>) {
+		ls.WtFromDWt(wbInc, wbDec, sy.DWt, sy.Wt, sy.LWt, sy.Scale);
+	} else {
+		Real dwt = sy.DWt, wt = sy.Wt, lwt = sy.LWt;
+		ls.WtFromDWt(wbInc, wbDec, dwt, wt, lwt, sy.Scale);
+		sy.DWt = dwt;
+		sy.Wt = wt;
+		sy.LWt = lwt;
 	}
 }
 
-// WtBalFromWt computes the Weight Balance factors based on average recv weights
-void leabra::Path::WtBalFromWt() {
-	if (!Learn.Learn || !Learn.WtBal.On) {
+// WtFromDWt updates the synaptic weight values from delta-weight changes -- on sending pathways.
+// Only the DWtRows are visited, as all other synapses have no DWt, so
+// the cost is proportional to the number of sending units that learned.
+// Also keeps the WbRecv sums up to date, if WbSums.
+// Synapses shared by Tied pathways are only updated by their owner.
+void leabra::Path::WtFromDWt() {
+	notFrozen(*this, "WtFromDWt");
+	if (!Learn.Learn || TiedTo != nullptr) {
 		return;
 	}
+	Real thr = Learn.WtBal.AvgThr;
+	if (!Learn.WtBal.On || WbSumThr != thr) {
+		WbSums = false;
+	}
+	for (int row: DWtRows) {
+		int st = Kernel != nullptr ? row * Kernel->RNu : int(SConIndexSt[row]);
+		int nc = Kernel != nullptr ? Kernel->RNu : int(SConN[row]);
+		Synapse *sys = Syns.data() + st;
+		if (Learn.WtBal.On && WbSums) {
+			const int *ris = Kernel != nullptr ? nullptr : SConIndex.data() + st;
+			for (int ci = 0; ci < nc; ci++) {
+				WtBalRecvPath &wb = WbRecv[ris != nullptr ? ris[ci] : ci];
+				Synapse &sy = sys[ci];
+				Real owt = sy.Wt;
+				wtFromDWt(Learn, wb.Inc, wb.Dec, sy);
+				wb.SumFromWt(owt, sy.Wt, thr);
+			}
+		} else if (Learn.WtBal.On) {
+			const int *ris = Kernel != nullptr ? nullptr : SConIndex.data() + st;
+			for (int ci = 0; ci < nc; ci++) {
+				WtBalRecvPath &wb = WbRecv[ris != nullptr ? ris[ci] : ci];
+				wtFromDWt(Learn, wb.Inc, wb.Dec, sys[ci]);
+			}
+		} else {
+			for (int ci = 0; ci < nc; ci++) {
+				wtFromDWt(Learn, 1, 1, sys[ci]);
+			}
+		}
+		DWtRowMark[row] = 0;
+	}
+	DWtRows.clear();
+}
+
+// WtBalSums recomputes the WbRecv SumWt and SumN from all of the synapses,
+// going through them in send order, and sets WbSums.
+// A Shared pathway sums its kernel synapses for the units of the first
+// receiving pool.
+void leabra::Path::WtBalSums() {
+	Real thr = Learn.WtBal.AvgThr;
+	for (WtBalRecvPath &wb: WbRecv) {
+		wb.SumWt = 0;
+		wb.SumN = 0;
+	}
+	int rnu = Kernel != nullptr ? Kernel->RNu : 0;
+	for (size_t i = 0; i < Syns.size(); i++) {
+		Real wt = Syns[i].Wt;
+		if (wt >= thr) {
+			WtBalRecvPath &wb = WbRecv[Kernel != nullptr ? i % rnu : SConIndex[i]];
+			wb.SumWt += wt;
+			wb.SumN++;
+		}
+	}
+	WbSums = true;
+	WbSumThr = thr;
+}
+
+// WtBalFromWt computes the Weight Balance factors based on average recv weights.
+// The averages come from the WbRecv sums kept by WtFromDWt, so this only
+// goes through the synapses when those are not up to date (see WbSums).
+// If check, they are recomputed anyway, and the number of recv units whose
+// sums did not match is returned.
+// A Shared pathway computes them for the units of the first receiving pool,
+// from their kernel synapses, and WtFromDWt uses those for the kernel.
+int leabra::Path::WtBalFromWt(bool check) {
+	notFrozen(*this, "WtBalFromWt");
+	if (!Learn.Learn || !Learn.WtBal.On || TiedTo != nullptr) {
+		return 0;
+	}
 
 	leabra::Layer &rlay = *Recv;
 	if (!Learn.WtBal.Targs && rlay.IsTarget()) {
-		return;
+		return 0;
 	}
-	for (uint ri = 0; ri < rlay.Neurons.size(); ri++) {
-		int nc = RConN[ri];
-		if (nc < 1) {
+	int nbad = 0;
+	if (!WbSums || WbSumThr != Learn.WtBal.AvgThr) {
+		WtBalSums();
+	} else if (check) {
+		std::vector<WtBalRecvPath> run = WbRecv;
+		WtBalSums();
+		for (size_t ri = 0; ri < WbRecv.size(); ri++) {
+			WtBalRecvPath &wb = WbRecv[ri];
+			// exact for float weights, but not for double ones
+			if (run[ri].SumN != wb.SumN || std::abs(run[ri].SumWt - wb.SumWt) > 1e-9 * std::max(1.0, wb.SumWt)) {
+				nbad++;
+			}
+		}
+	}
+	int nr = Kernel != nullptr ? Kernel->RNu : int(rlay.Neurons.size());
+	for (int ri = 0; ri < nr; ri++) {
+		if (Kernel == nullptr && RConN[ri] < 1) {
 			continue;
 		}
 		WtBalRecvPath &wb = WbRecv[ri];
+		wb.Avg = wb.SumN > 0 ? Real(wb.SumWt / wb.SumN) : 0;
+		std::tie(wb.Fact, wb.Inc, wb.Dec) = Learn.WtBal.WtBal(wb.Avg);
+	}
+	return nbad;
+}
+
+// LrateMult sets the new Lrate parameter for Paths to LrateInit * mult.
+// Useful for implementing learning rate schedules.
+void leabra::Path::LrateMult(float mult) {
+	Learn.Lrate = Learn.LrateInit * mult;
+}
+
+// Prune removes the synapses with Wt below thr, or if pct > 0, the
+// proportion pct (0-1) of the synapses with the smallest Wt (of those tied
+// at the cut, the first in send order), and compacts Syns and the
+// connection indexes in place. This pathway then has its own indexes, no
+// longer shared with other pathways (see Conns), and
+// RConNAvgMax, SConNAvgMax and the GScale of the Recv layer are updated.
+// Tied and Shared pathways cannot be pruned. A Build restores the full
+// connectivity of the Pattern.
+leabra::PruneReport leabra::Path::Prune(float thr, float pct) {
+	notFrozen(*this, "Prune");
+	PruneReport pr;
+	if (Off || Syns.empty()) {
+		return pr;
+	}
+	if (Tied || TiedTo != nullptr || Kernel != nullptr) {
+		std::cerr << "Prune: path " << Name << " is Tied or Shared, so it cannot be pruned" << std::endl;
+		return pr;
+	}
+	auto t0 = std::chrono::steady_clock::now();
+	int ns = Syns.size();
+	pr.Paths = 1;
+	pr.Before = ns;
+	pr.BytesBefore = MemoryReport().Resident();
+	Real cut = thr;
+	int ties = 0; // synapses with Wt at cut that are pruned too, the first in send order
+	if (pct > 0) {
+		std::vector<Real> wts(ns);
+		for (int i = 0; i < ns; i++) {
+			wts[i] = std::abs(Real(Syns[i].Wt));
+		}
+		int n = std::min(int(pct * ns), ns - 1);
+		std::nth_element(wts.begin(), wts.begin() + n, wts.end());
+		cut = wts[n];
+		ties = n - std::count_if(wts.begin(), wts.begin() + n, [cut](Real wt) { return wt < cut; });
+	}
+
+	// new index of each synapse in send order, -1 if pruned
+	std::vector<int> keep(ns);
+	int nk = 0;
+	for (int i = 0; i < ns; i++) {
+		Real wt = std::abs(Real(Syns[i].Wt));
+		keep[i] = wt < cut || (wt == cut && ties-- > 0) ? -1 : nk++;
+	}
+	if (nk == ns) {
+		pr.After = ns;
+		pr.BytesAfter = pr.BytesBefore;
+		return pr;
+	}
+	auto ci = std::make_shared<paths::ConnIndexes>();
+	int slen = SConN.size();
+	int rlen = RConN.size();
+	ci->Built.SConN.resize(slen);
+	ci->Built.SConIndexSt.resize(slen);
+	ci->Built.SConIndex.reserve(nk);
+	for (int si = 0; si < slen; si++) {
+		int st = SConIndexSt[si];
+		ci->Built.SConIndexSt[si] = ci->Built.SConIndex.size();
+		for (int i = st; i < st + SConN[si]; i++) {
+			if (keep[i] >= 0) {
+				ci->Built.SConIndex.push_back(SConIndex[i]);
+				Syns[keep[i]] = Syns[i];
+			}
+		}
+		ci->Built.SConN[si] = ci->Built.SConIndex.size() - ci->Built.SConIndexSt[si];
+	}
+	ci->Built.RConN.resize(rlen);
+	ci->Built.RConIndexSt.resize(rlen);
+	ci->Built.RConIndex.reserve(nk);
+	ci->Built.RSynIndex.reserve(nk);
+	for (int ri = 0; ri < rlen; ri++) {
 		int st = RConIndexSt[ri];
+		ci->Built.RConIndexSt[ri] = ci->Built.RConIndex.size();
+		for (int i = st; i < st + RConN[ri]; i++) {
+			int k = keep[RSynIndex[i]];
+			if (k >= 0) {
+				ci->Built.RConIndex.push_back(RConIndex[i]);
+				ci->Built.RSynIndex.push_back(k);
+			}
+		}
+		ci->Built.RConN[ri] = ci->Built.RConIndex.size() - ci->Built.RConIndexSt[ri];
+	}
+	ci->View();
+	Syns.resize(nk);
+	Syns.shrink_to_fit();
+	SetPrunedConns(ci);
+
+	pr.After = nk;
+	pr.BytesAfter = MemoryReport().Resident();
+	pr.Msec = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+	return pr;
+}
 
-		auto start = RSynIndex.begin() + st;
-		auto end = RSynIndex.begin() + st + nc;
-		auto rsidxs = std::vector<int>(start, end);
+// SetPrunedConns makes ci, a pruned subset of the connections of the
+// Pattern, the private connection indexes of this pathway, for Syns already
+// compacted to them, and updates the state that depends on them.
+// It increments the StructGen of the network, as the synapse layout changed.
+void leabra::Path::SetPrunedConns(std::shared_ptr<paths::ConnIndexes> ci) {
+	Conns = ci;
+	ConnsTransposed = false;
+	ConnsBuilt = false;
+	PatternBytes = 0;
+	SConN = ci->SConN;
+	SConIndexSt = ci->SConIndexSt;
+	SConIndex = ci->SConIndex;
+	RConN = ci->RConN;
+	RConIndexSt = ci->RConIndexSt;
+	RConIndex = ci->RConIndex;
+	RSynIndex = ci->RSynIndex;
+	SetNAvgMax(SConN, SConNAvgMax);
+	SetNAvgMax(RConN, RConNAvgMax);
+	GIncBlksInit();
+	Recv->GScaleFromAvgAct();
+	std::fill(CkptDirty.begin(), CkptDirty.end(), 1);
+	WbSums = false;
+
+	// the indexes given up are now viewed by one pathway fewer
+	ConnsViews = 1;
+	if (Recv->Net != nullptr) {
+		Recv->Net->CountConnsViews();
+		Recv->Net->StructGen++;
+	}
+}
 
-		float sumWt = 0;
-		int sumN = 0;
-		for (uint ci = 0; ci < rsidxs.size(); ci++) {
-			int rsi = rsidxs[ci];
-			Synapse &sy = Syns[rsi];
-			if (sy.Wt >= Learn.WtBal.AvgThr) {
-				sumWt += sy.Wt;
-				sumN++;
+// Freeze makes this pathway inference only: the weights are kept in
+// the quant format (see WtQuants), premultiplied by the current GScale if
+// gscale is true, and the synapses and the other learning state are freed.
+// WtInt8 weights get a scale for each receiving unit, or for the whole
+// pathway if pathScale or Shared. Learning, pruning, checkpoints and
+// InitWeights then throw. A Tied pathway takes its own copy of the weights
+// it uses, so it must be frozen before its owner (see Network.Freeze).
+void leabra::Path::Freeze(bool gscale, WtQuants quant, bool pathScale) {
+	if (Frozen) {
+		return;
+	}
+	Real sc = gscale ? GScale : 1;
+	std::vector<Real> wts(TiedTo != nullptr ? NumSyns() : Syns.size());
+	for (size_t i = 0; i < wts.size(); i++) {
+		wts[i] = sc * (TiedTo != nullptr ? Syn(i).Wt : Syns[i].Wt);
+	}
+	TiedTo = nullptr;
+	TiedSynIndex = {};
+	FrozenDense = Kernel == nullptr;
+	for (size_t si = 0; si < SConN.size() && FrozenDense; si++) {
+		const int *scons = SConIndex.data() + SConIndexSt[si];
+		for (int ci = 1; ci < SConN[si]; ci++) {
+			if (scons[ci] != scons[0] + ci) {
+				FrozenDense = false;
+				break;
 			}
 		}
-		if (sumN > 0) {
-			sumWt /= float(sumN);
-		} else {
-			sumWt = 0;
+	}
+	switch (quant) {
+	case WtBF16:
+		FrozenBF16.resize(wts.size());
+		for (size_t i = 0; i < wts.size(); i++) {
+			FrozenBF16[i] = bf16FromFloat(float(wts[i]));
+		}
+		break;
+	case WtInt8: {
+		bool perRecv = !pathScale && Kernel == nullptr;
+		FrozenQScale.assign(perRecv ? RConN.size() : 1, 0);
+		for (size_t i = 0; i < wts.size(); i++) {
+			float &mx = FrozenQScale[perRecv ? SConIndex[i] : 0];
+			mx = std::max(mx, float(std::abs(wts[i])));
 		}
-		wb.Avg = sumWt;
-		std::tuple<float, float, float> wtbalTuple = Learn.WtBal.WtBal(sumWt);
-		wb.Fact = std::get<0>(wtbalTuple);
-		wb.Inc = std::get<1>(wtbalTuple);
-		wb.Dec = std::get<2>(wtbalTuple);
+		for (float &qs: FrozenQScale) {
+			qs = qs > 0 ? qs / 127 : 1;
+		}
+		FrozenInt8.resize(wts.size());
+		for (size_t i = 0; i < wts.size(); i++) {
+			FrozenInt8[i] = int8_t(std::lround(wts[i] / FrozenQScale[perRecv ? SConIndex[i] : 0]));
+		}
+		break;
+	}
+	default:
+		FrozenWt.swap(wts);
+		break;
 	}
+	FrozenQuant = quant;
+	FrozenGScale = gscale;
+	Frozen = true;
+	Syns.clear();
+	Syns.shrink_to_fit();
+	WbRecv.clear();
+	WbRecv.shrink_to_fit();
+	kernelDWt.clear();
+	kernelDWt.shrink_to_fit();
+	kernelDWtN.clear();
+	kernelDWtN.shrink_to_fit();
+	CkptDirty.clear();
+	CkptDirty.shrink_to_fit();
+	DWtRows.clear();
+	DWtRows.shrink_to_fit();
+	DWtRowMark.clear();
+	DWtRowMark.shrink_to_fit();
 }
 
-// LrateMult sets the new Lrate parameter for Paths to LrateInit * mult.
-// Useful for implementing learning rate schedules.
-void leabra::Path::LrateMult(float mult) {
-	Learn.Lrate = Learn.LrateInit * mult;
+// MemoryReport returns the memory held by this pathway's synaptic state
+// and its share of the connection indexes, along with the size of the pattern
+// tables generated during the last Build.
+leabra::MemReport leabra::Path::MemoryReport() {
+	MemReport mr;
+	mr.SynapseState = Syns.capacity() * sizeof(Synapse) + GInc.capacity() * sizeof(Real) + GIncBlks.capacity() + WbRecv.capacity() * sizeof(WtBalRecvPath) +
+		kernelDWt.capacity() * sizeof(Real) + kernelDWtN.capacity() * sizeof(int) + FrozenWt.capacity() * sizeof(Real) +
+		FrozenBF16.capacity() * sizeof(uint16_t) + FrozenInt8.capacity() + FrozenQScale.capacity() * sizeof(float);
+	if (Conns != nullptr) {
+		// shared indexes are split evenly among the pathways viewing them
+		mr.ConIndexes = Conns->Bytes() / std::max(ConnsViews, 1);
+	}
+	if (Kernel != nullptr) {
+		mr.ConIndexes += Kernel->Bytes();
+	}
+	mr.PatternTables = PatternBytes;
+	return mr;
+}
+
+// WriteCheckpoint writes this pathway's synaptic and weight balance state
+// to a checkpoint, under keys <RecvLayer>/<Path>/<Var>.
+// DWt, Norm and Moment are only written with the CkptLearn flag.
+// With the CkptDelta flag, only the synapses of the sending rows marked in
+// CkptDirty are written, along with their RowSt and RowN -- for a Shared
+// pathway, the whole kernel is one row, written if any row is marked.
+// A Tied pathway only writes its weight balance state.
+// A pruned pathway also writes its connection indexes to a full checkpoint,
+// under <RecvLayer>/<Path>/Conns.<List>, so that ReadCheckpoint can restore
+// them after a Build.
+void leabra::Path::WriteCheckpoint(weights::CkptWriter &ck) {
+	notFrozen(*this, "WriteCheckpoint");
+	std::string pfx = Recv->Name + "/" + Name + "/";
+	const Synapse *sy = Syns.data();
+	size_t ns = Syns.size();
+	std::vector<int32_t> synIdx; // synapses written, for a delta
+	if (TiedTo != nullptr) {
+		// synapses are written by the pathway they are Tied to
+	} else if (ck.Flags & weights::CkptDelta) {
+		std::vector<int32_t> rowSt, rowN;
+		if (Kernel != nullptr) {
+			if (std::find(CkptDirty.begin(), CkptDirty.end(), 1) != CkptDirty.end()) {
+				rowSt.push_back(0);
+				rowN.push_back(ns);
+				for (size_t i = 0; i < ns; i++) {
+					synIdx.push_back(i);
+				}
+			}
+		}
+		for (size_t si = 0; si < CkptDirty.size() && Kernel == nullptr; si++) {
+			if (!CkptDirty[si] || SConN[si] == 0) {
+				continue;
+			}
+			rowSt.push_back(SConIndexSt[si]);
+			rowN.push_back(SConN[si]);
+			for (int ci = 0; ci < SConN[si]; ci++) {
+				synIdx.push_back(SConIndexSt[si] + ci);
+			}
+		}
+		ck.Add(pfx + "RowSt", rowSt.data(), rowSt.size());
+		ck.Add(pfx + "RowN", rowN.data(), rowN.size());
+		const int32_t *idx = synIdx.data();
+		ns = synIdx.size();
+		ck.AddFunc(pfx + "Wt", ns, [sy, idx](size_t i) { return sy[idx[i]].Wt; });
+		ck.MarkRows(Syns.size());
+		ck.AddFunc(pfx + "LWt", ns, [sy, idx](size_t i) { return sy[idx[i]].LWt; });
+		ck.MarkRows(Syns.size());
+		ck.AddFunc(pfx + "Scale", ns, [sy, idx](size_t i) { return sy[idx[i]].Scale; });
+		ck.MarkRows(Syns.size());
+		if (ck.Flags & weights::CkptLearn) {
+			ck.AddFunc(pfx + "DWt", ns, [sy, idx](size_t i) { return sy[idx[i]].DWt; });
+			ck.MarkRows(Syns.size());
+			ck.AddFunc(pfx + "Norm", ns, [sy, idx](size_t i) { return sy[idx[i]].Norm; });
+			ck.MarkRows(Syns.size());
+			ck.AddFunc(pfx + "Moment", ns, [sy, idx](size_t i) { return sy[idx[i]].Moment; });
+			ck.MarkRows(Syns.size());
+		}
+	} else {
+		if (Conns != nullptr && !ConnsBuilt) {
+			const paths::ConnIndexes &ci = *Conns;
+			ck.Add(pfx + "Conns.SConN", ci.SConN.data(), ci.SConN.size());
+			ck.Add(pfx + "Conns.SConIndexSt", ci.SConIndexSt.data(), ci.SConIndexSt.size());
+			ck.Add(pfx + "Conns.SConIndex", ci.SConIndex.data(), ci.SConIndex.size());
+			ck.Add(pfx + "Conns.RConN", ci.RConN.data(), ci.RConN.size());
+			ck.Add(pfx + "Conns.RConIndexSt", ci.RConIndexSt.data(), ci.RConIndexSt.size());
+			ck.Add(pfx + "Conns.RConIndex", ci.RConIndex.data(), ci.RConIndex.size());
+			ck.Add(pfx + "Conns.RSynIndex", ci.RSynIndex.data(), ci.RSynIndex.size());
+		}
+		ck.AddFunc(pfx + "Wt", ns, [sy](size_t i) { return sy[i].Wt; });
+		ck.AddFunc(pfx + "LWt", ns, [sy](size_t i) { return sy[i].LWt; });
+		ck.AddFunc(pfx + "Scale", ns, [sy](size_t i) { return sy[i].Scale; });
+		if (ck.Flags & weights::CkptLearn) {
+			ck.AddFunc(pfx + "DWt", ns, [sy](size_t i) { return sy[i].DWt; });
+			ck.AddFunc(pfx + "Norm", ns, [sy](size_t i) { return sy[i].Norm; });
+			ck.AddFunc(pfx + "Moment", ns, [sy](size_t i) { return sy[i].Moment; });
+		}
+	}
+	const WtBalRecvPath *wb = WbRecv.data();
+	size_t nr = WbRecv.size();
+	ck.AddFunc(pfx + "Wb.Avg", nr, [wb](size_t i) { return wb[i].Avg; });
+	ck.AddFunc(pfx + "Wb.Fact", nr, [wb](size_t i) { return wb[i].Fact; });
+	ck.AddFunc(pfx + "Wb.Inc", nr, [wb](size_t i) { return wb[i].Inc; });
+	ck.AddFunc(pfx + "Wb.Dec", nr, [wb](size_t i) { return wb[i].Dec; });
+}
+
+// CkptClearDirty clears the CkptDirty flags after an incremental checkpoint,
+// except for rows with DWt still to be applied by WtFromDWt.
+void leabra::Path::CkptClearDirty() {
+	if (TiedTo != nullptr) {
+		std::fill(CkptDirty.begin(), CkptDirty.end(), 0);
+		return;
+	}
+	if (Kernel != nullptr) {
+		bool pend = std::any_of(Syns.begin(), Syns.end(), [](const Synapse &sy) { return sy.DWt != 0; });
+		std::fill(CkptDirty.begin(), CkptDirty.end(), pend);
+		return;
+	}
+	for (size_t si = 0; si < CkptDirty.size(); si++) {
+		if (!CkptDirty[si]) {
+			continue;
+		}
+		int st = SConIndexSt[si];
+		int ed = st + SConN[si];
+		bool pend = false;
+		for (int i = st; i < ed && !pend; i++) {
+			pend = Syns[i].DWt != 0;
+		}
+		CkptDirty[si] = pend;
+	}
+}
+
+// readPrunedConns sets the pruned connection indexes of pt from those
+// written to checkpoint ck by WriteCheckpoint, if it has them and they are
+// not the ones pt has, resizing Syns to them for their state to be read.
+static void readPrunedConns(leabra::Path &pt, weights::CkptFile &ck, const std::string &pfx) {
+	auto ci = std::make_shared<paths::ConnIndexes>();
+	paths::ConnIndexes::Lists &ls = ci->Built;
+	std::pair<const char*, std::vector<int>*> lists[] = {{"SConN", &ls.SConN}, {"SConIndexSt", &ls.SConIndexSt},
+		{"SConIndex", &ls.SConIndex}, {"RConN", &ls.RConN}, {"RConIndexSt", &ls.RConIndexSt},
+		{"RConIndex", &ls.RConIndex}, {"RSynIndex", &ls.RSynIndex}};
+	for (auto &[name, list]: lists) {
+		size_t n;
+		const int32_t *ar = ck.IntArray(pfx + "Conns." + name, n);
+		if (ar == nullptr) {
+			return;
+		}
+		list->assign(ar, ar + n);
+	}
+	ci->View();
+	try {
+		ci->Check(pt.SConN.size(), pt.RConN.size());
+	} catch (const std::runtime_error &e) {
+		throw std::runtime_error("ReadCheckpoint: pruned connections of path " + pt.Name + " in " + ck.FileName + " do not fit it: " + e.what());
+	}
+	if (pt.Conns != nullptr && !pt.ConnsBuilt && std::ranges::equal(ls.SConIndex, pt.SConIndex) &&
+			std::ranges::equal(ls.SConN, pt.SConN) && std::ranges::equal(ls.RSynIndex, pt.RSynIndex)) {
+		return;
+	}
+	pt.Syns.resize(ls.SConIndex.size());
+	pt.Syns.shrink_to_fit();
+	pt.SetPrunedConns(ci);
+}
+
+// ReadCheckpoint sets this pathway's state from a checkpoint written by
+// WriteCheckpoint, reading directly from the mapped file.
+// Optional state that is not in the checkpoint is left as is.
+// The pruned connection indexes of a checkpoint replace those of this
+// pathway (see SetPrunedConns), if different.
+// Returns false if the checkpoint has no weights for this pathway, and
+// throws if they are for a pathway with a different number of synapses.
+bool leabra::Path::ReadCheckpoint(weights::CkptFile &ck) {
+	notFrozen(*this, "ReadCheckpoint");
+	std::string pfx = Recv->Name + "/" + Name + "/";
+	if (TiedTo == nullptr && Kernel == nullptr) {
+		readPrunedConns(*this, ck, pfx);
+	}
+	if (TiedTo == nullptr) { // else read by the pathway they are Tied to
+		size_t ns = Syns.size();
+		const Real *wt = ck.ArrayN(pfx + "Wt", ns);
+		if (wt == nullptr) {
+			return false;
+		}
+		std::fill(CkptDirty.begin(), CkptDirty.end(), 1);
+		DWtRowsAll();
+		WbSums = false;
+		Synapse *sy = Syns.data();
+		for (size_t i = 0; i < ns; i++) {
+			sy[i].Wt = wt[i];
+		}
+		if (const Real *ar = ck.ArrayN(pfx + "LWt", ns)) {
+			for (size_t i = 0; i < ns; i++) sy[i].LWt = ar[i];
+		}
+		if (const Real *ar = ck.ArrayN(pfx + "Scale", ns)) {
+			for (size_t i = 0; i < ns; i++) sy[i].Scale = ar[i];
+		}
+		if (const Real *ar = ck.ArrayN(pfx + "DWt", ns)) {
+			for (size_t i = 0; i < ns; i++) sy[i].DWt = ar[i];
+		}
+		if (const Real *ar = ck.ArrayN(pfx + "Norm", ns)) {
+			for (size_t i = 0; i < ns; i++) sy[i].Norm = ar[i];
+		}
+		if (const Real *ar = ck.ArrayN(pfx + "Moment", ns)) {
+			for (size_t i = 0; i < ns; i++) sy[i].Moment = ar[i];
+		}
+	}
+	WtBalRecvPath *wb = WbRecv.data();
+	size_t nr = WbRecv.size();
+	if (const Real *ar = ck.ArrayN(pfx + "Wb.Avg", nr)) {
+		for (size_t i = 0; i < nr; i++) wb[i].Avg = ar[i];
+	}
+	if (const Real *ar = ck.ArrayN(pfx + "Wb.Fact", nr)) {
+		for (size_t i = 0; i < nr; i++) wb[i].Fact = ar[i];
+	}
+	if (const Real *ar = ck.ArrayN(pfx + "Wb.Inc", nr)) {
+		for (size_t i = 0; i < nr; i++) wb[i].Inc = ar[i];
+	}
+	if (const Real *ar = ck.ArrayN(pfx + "Wb.Dec", nr)) {
+		for (size_t i = 0; i < nr; i++) wb[i].Dec = ar[i];
+	}
+	return true;
 }
 
 std::string PathTypeArr[] = {"ForwardPath","BackPath","LateralPath","InhibPath","CTCtxtPath"};
@@ -673,16 +1710,13 @@ emer::Layer *leabra::Path::RecvLayer() {
 	return Recv;
 }
 
-void leabra::Path::InitParamMaps() {
-	ParamNameMap["WtInit"] = (void*) &WtInit;
-	ParamNameMap["WtScale"] = (void*) &WtScale;
-	ParamNameMap["Learn"] = (void*) &Learn;
-	ParamNameMap["GScale"] = (void*) &GScale;
-
-	ParamTypeMap["WtInit"] = &typeid(WtInit);
-	ParamTypeMap["WtScale"] = &typeid(WtScale);
-	ParamTypeMap["Learn"] = &typeid(Learn);
-	ParamTypeMap["GScale"] = &typeid(GScale);
+void leabra::Path::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "WtInit", WtInit);
+	reg.Add(this, "WtScale", WtScale);
+	reg.Add(this, "Learn", Learn);
+	reg.Add(this, "GScale", GScale);
+	reg.Add(this, "Tied", Tied);
+	reg.Add(this, "Shared", Shared);
 }
 
 std::string leabra::WtBalRecvPath::StyleType() {
@@ -697,16 +1731,11 @@ std::string leabra::WtBalRecvPath::StyleName() {
     return "";
 }
 
-void leabra::WtBalRecvPath::InitParamMaps() {
-	ParamNameMap["Avg"] = (void*) &Avg;
-	ParamNameMap["Fact"] = (void*) &Fact;
-	ParamNameMap["Inc"] = (void*) &Inc;
-	ParamNameMap["Dec"] = (void*) &Dec;
-
-	ParamTypeMap["Avg"] = &typeid(float);
-	ParamTypeMap["Fact"] = &typeid(float);
-	ParamTypeMap["Inc"] = &typeid(float);
-	ParamTypeMap["Dec"] = &typeid(float);
+void leabra::WtBalRecvPath::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Avg", Avg);
+	reg.Add(this, "Fact", Fact);
+	reg.Add(this, "Inc", Inc);
+	reg.Add(this, "Dec", Dec);
 }
 
 void pybind_LeabraLayerTypes(pybind11::module_ &m) {
@@ -731,6 +1760,102 @@ void pybind_LeabraPathTypes(pybind11::module_ &m) {
 		.value("InhibPath", leabra::PathTypes::InhibPath)
 		.value("CTCtxtPath", leabra::PathTypes::CTCtxtPath)
 		.export_values();
+
+	pybind11::enum_<leabra::WtQuants>(m, "WtQuants")
+		.value("WtF32", leabra::WtQuants::WtF32)
+		.value("WtBF16", leabra::WtQuants::WtBF16)
+		.value("WtInt8", leabra::WtQuants::WtInt8)
+		.export_values();
+}
+
+// Add accumulates the given report into this one
+void leabra::MemReport::Add(const MemReport &mr) {
+	SynapseState += mr.SynapseState;
+	ConIndexes += mr.ConIndexes;
+	NeuronState += mr.NeuronState;
+	ParamMaps += mr.ParamMaps;
+	PatternTables += mr.PatternTables;
+}
+
+// Resident returns the bytes held by state that persists after Build,
+// i.e., everything except the transient PatternTables.
+size_t leabra::MemReport::Resident() {
+	return SynapseState + ConIndexes + NeuronState + ParamMaps;
+}
+
+// Total returns the bytes summed over all categories.
+size_t leabra::MemReport::Total() {
+	return Resident() + PatternTables;
+}
+
+// Map returns the report as a category name to bytes map.
+std::map<std::string, size_t> leabra::MemReport::Map() {
+	return std::map<std::string, size_t>{
+		{"SynapseState", SynapseState},
+		{"ConIndexes", ConIndexes},
+		{"NeuronState", NeuronState},
+		{"ParamMaps", ParamMaps},
+		{"PatternTables", PatternTables},
+	};
+}
+
+// Add adds the counts of another report to this one.
+void leabra::PruneReport::Add(const PruneReport &pr) {
+	Paths += pr.Paths;
+	Before += pr.Before;
+	After += pr.After;
+	BytesBefore += pr.BytesBefore;
+	BytesAfter += pr.BytesAfter;
+	Msec += pr.Msec;
+}
+
+// Pruned returns the number of synapses removed.
+int leabra::PruneReport::Pruned() {
+	return Before - After;
+}
+
+// BytesSaved returns the bytes of synaptic state and connection indexes freed.
+size_t leabra::PruneReport::BytesSaved() {
+	return BytesBefore - BytesAfter;
+}
+
+// SynFrac returns the proportion of the synapses remaining, which is the
+// proportion of the time of the per-synapse passes (SendGDelta, DWt,
+// WtFromDWt) still spent on these pathways.
+float leabra::PruneReport::SynFrac() {
+	return Before > 0 ? float(After) / float(Before) : 1;
+}
+
+std::string leabra::PruneReport::String() {
+	return "Pruned " + std::to_string(Pruned()) + " of " + std::to_string(Before) + " synapses in " +
+		std::to_string(Paths) + " paths, saved " + std::to_string(BytesSaved()) + " bytes, in " + std::to_string(Msec) + " ms";
+}
+
+void pybind_LeabraMemReport(pybind11::module_ &m) {
+	pybind11::class_<leabra::MemReport>(m, "MemReport")
+		.def_readonly("SynapseState", &leabra::MemReport::SynapseState)
+		.def_readonly("ConIndexes", &leabra::MemReport::ConIndexes)
+		.def_readonly("NeuronState", &leabra::MemReport::NeuronState)
+		.def_readonly("ParamMaps", &leabra::MemReport::ParamMaps)
+		.def_readonly("PatternTables", &leabra::MemReport::PatternTables)
+		.def("Resident", &leabra::MemReport::Resident)
+		.def("Total", &leabra::MemReport::Total)
+		.def("Map", &leabra::MemReport::Map)
+	;
+
+	pybind11::class_<leabra::PruneReport>(m, "PruneReport")
+		.def(pybind11::init<>())
+		.def_readonly("Paths", &leabra::PruneReport::Paths)
+		.def_readonly("Before", &leabra::PruneReport::Before)
+		.def_readonly("After", &leabra::PruneReport::After)
+		.def_readonly("BytesBefore", &leabra::PruneReport::BytesBefore)
+		.def_readonly("BytesAfter", &leabra::PruneReport::BytesAfter)
+		.def_readonly("Msec", &leabra::PruneReport::Msec)
+		.def("Pruned", &leabra::PruneReport::Pruned)
+		.def("BytesSaved", &leabra::PruneReport::BytesSaved)
+		.def("SynFrac", &leabra::PruneReport::SynFrac)
+		.def("__repr__", &leabra::PruneReport::String)
+	;
 }
 
 void pybind_LeabraPath(pybind11::module_ &m) {
@@ -740,11 +1865,22 @@ void pybind_LeabraPath(pybind11::module_ &m) {
 			pybind11::arg("cls") = ""
 		)
 		.def_readonly("Name", &leabra::Path::Name)
+		.def_readonly("Class", &leabra::Path::Class)
+		.def("SetClass", &leabra::Path::SetClass)
 		.def_readonly("Send", &leabra::Path::Send)
 		.def_readonly("Recv", &leabra::Path::Recv)
 		.def_readonly("Type", &leabra::Path::Type)
 		.def_readonly("GScale", &leabra::Path::GScale)
+		.def_readwrite("Tied", &leabra::Path::Tied)
+		.def_readwrite("Shared", &leabra::Path::Shared)
+		.def_readonly("Frozen", &leabra::Path::Frozen)
+		.def_readonly("FrozenQuant", &leabra::Path::FrozenQuant)
 		.def("SynIndex", &leabra::Path::SynIndex)
+		.def("MemoryReport", &leabra::Path::MemoryReport)
+		.def("Prune", &leabra::Path::Prune,
+			pybind11::arg("thr"),
+			pybind11::arg("pct") = 0
+			)
 	;
 
 	// TODO: Allow access to inspect other variables/params for the path
@@ -1,10 +1,9 @@
 #include "learn.hpp"
 #include <cmath>
 
-leabra::XCalParams::XCalParams(float mLrn, bool setLLrn, float lLrn, float dRev, float dThr, float lrnThr):
+leabra::XCalParams::XCalParams(Real mLrn, bool setLLrn, Real lLrn, Real dRev, Real dThr, Real lrnThr):
 	MLrn(mLrn), SetLLrn(setLLrn), LLrn(lLrn), DRev(dRev), DThr(dThr), LrnThr(lrnThr){ 
 	Update();
-	InitParamMaps();
 }
 
 void leabra::XCalParams::Update()
@@ -27,8 +26,8 @@ void leabra::XCalParams::Defaults() {
 }
 
 // DWt is the XCAL function for weight change -- the "check mark" function -- no DGain, no ThrPMin
-float leabra::XCalParams::DWt(float srval, float thrP) {
-	float dwt;
+Real leabra::XCalParams::DWt(Real srval, Real thrP) {
+	Real dwt;
 	if (srval < DThr) {
 		dwt = 0;
 	} else if (srval > thrP * DRev) {
@@ -40,7 +39,7 @@ float leabra::XCalParams::DWt(float srval, float thrP) {
 }
 
 // LongLrate returns the learning rate for long-term floating average component (BCM)
-float leabra::XCalParams::LongLrate(float avgLLrn) {
+Real leabra::XCalParams::LongLrate(Real avgLLrn) {
 	if (SetLLrn) {
 		return LLrn;
 	}
@@ -59,26 +58,17 @@ std::string leabra::XCalParams::StyleName() {
     return "";
 }
 
-void leabra::XCalParams::InitParamMaps() {
-	ParamNameMap["MLrn"] = (void*) &MLrn;
-	ParamNameMap["SetLLrn"] = (void*) &SetLLrn;
-	ParamNameMap["LLrn"] = (void*) &LLrn;
-	ParamNameMap["DRev"] = (void*) &DRev;
-	ParamNameMap["DThr"] = (void*) &DThr;
-	ParamNameMap["LrnThr"] = (void*) &LrnThr;
-	ParamNameMap["DRevRatio"] = (void*) &DRevRatio;
-
-	ParamTypeMap["MLrn"] = &typeid(float);
-	ParamTypeMap["SetLLrn"] = &typeid(bool);
-	ParamTypeMap["LLrn"] = &typeid(float);
-	ParamTypeMap["DRev"] = &typeid(float);
-	ParamTypeMap["DThr"] = &typeid(float);
-	ParamTypeMap["LrnThr"] = &typeid(float);
-	ParamTypeMap["DRevRatio"] = &typeid(float);
+void leabra::XCalParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "MLrn", MLrn);
+	reg.Add(this, "SetLLrn", SetLLrn);
+	reg.Add(this, "LLrn", LLrn);
+	reg.Add(this, "DRev", DRev);
+	reg.Add(this, "DThr", DThr);
+	reg.Add(this, "LrnThr", LrnThr);
+	reg.Add(this, "DRevRatio", DRevRatio);
 }
 
 leabra::LearnNeurParams::LearnNeurParams():ActAvg(), AvgL(), CosDiff(){
-	InitParamMaps();
 }
 
 void leabra::LearnNeurParams::Update()
@@ -129,25 +119,20 @@ std::string leabra::LearnNeurParams::StyleName() {
     return "";
 }
 
-void leabra::LearnNeurParams::InitParamMaps() {
-	ParamNameMap["ActAvg"] = (void*) &ActAvg;
-	ParamNameMap["AvgL"] = (void*) &AvgL;
-	ParamNameMap["CosDiff"] = (void*) &CosDiff;
-
-	ParamTypeMap["ActAvg"] = &typeid(ActAvg);
-	ParamTypeMap["AvgL"] = &typeid(AvgL);
-	ParamTypeMap["CosDiff"] = &typeid(CosDiff);
+void leabra::LearnNeurParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "ActAvg", ActAvg);
+	reg.Add(this, "AvgL", AvgL);
+	reg.Add(this, "CosDiff", CosDiff);
 }
 
-leabra::AvgLParams::AvgLParams(float init, float gain, float min, float tau, float lrnMax, float lrnMin, bool errMod, float modMin):
+leabra::AvgLParams::AvgLParams(Real init, Real gain, Real min, Real tau, Real lrnMax, Real lrnMin, bool errMod, Real modMin):
 	Init(init),Gain(gain),Tau(tau),LrnMax(lrnMax),LrnMin(lrnMin),ErrMod(errMod),ModMin(modMin) {
 	Update();
-	InitParamMaps();
 }
 
 // AvgLFromAvgM computes long-term average activation value, and learning factor, from given
 // medium-scale running average activation avgM
-void leabra::AvgLParams::AvgLFromAvgM(float avgM, float &avgL, float &lrn) {
+void leabra::AvgLParams::AvgLFromAvgM(Real avgM, Real &avgL, Real &lrn) {
 	avgL += Dt * (Gain*avgM - avgL);
 	if (avgL < Min) {
 		avgL = Min;
@@ -156,8 +141,8 @@ void leabra::AvgLParams::AvgLFromAvgM(float avgM, float &avgL, float &lrn) {
 }
 
 // ErrModFromLayErr computes AvgLLrn multiplier from layer cosine diff avg statistic
-float leabra::AvgLParams::ErrModFromLayErr(float layCosDiffAvg) {
-	float mod = 1;
+Real leabra::AvgLParams::ErrModFromLayErr(Real layCosDiffAvg) {
+	Real mod = 1;
 	if (!ErrMod){
 		return mod;
 	}
@@ -195,39 +180,27 @@ std::string leabra::AvgLParams::StyleName() {
     return "";
 }
 
-void leabra::AvgLParams::InitParamMaps() {
-	ParamNameMap["Init"] = (void*) &Init;
-	ParamNameMap["Gain"] = (void*) &Gain;
-	ParamNameMap["Min"] = (void*) &Min;
-	ParamNameMap["Tau"] = (void*) &Tau;
-	ParamNameMap["LrnMax"] = (void*) &LrnMax;
-	ParamNameMap["LrnMin"] = (void*) &LrnMin;
-	ParamNameMap["ErrMod"] = (void*) &ErrMod;
-	ParamNameMap["ModMin"] = (void*) &ModMin;
-	ParamNameMap["Dt"] = (void*) &Dt;
-	ParamNameMap["LrnFact"] = (void*) &LrnFact;
-
-	ParamTypeMap["Init"] = &typeid(float);
-	ParamTypeMap["Gain"] = &typeid(float);
-	ParamTypeMap["Min"] = &typeid(float);
-	ParamTypeMap["Tau"] = &typeid(float);
-	ParamTypeMap["LrnMax"] = &typeid(float);
-	ParamTypeMap["LrnMin"] = &typeid(float);
-	ParamTypeMap["ErrMod"] = &typeid(bool);
-	ParamTypeMap["ModMin"] = &typeid(float);
-	ParamTypeMap["Dt"] = &typeid(float);
-	ParamTypeMap["LrnFact"] = &typeid(float);
-}
-
-leabra::LrnActAvgParams::LrnActAvgParams(float SSTau, float STau, float MTau, float LrnM, float Init):
+void leabra::AvgLParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Init", Init);
+	reg.Add(this, "Gain", Gain);
+	reg.Add(this, "Min", Min);
+	reg.Add(this, "Tau", Tau);
+	reg.Add(this, "LrnMax", LrnMax);
+	reg.Add(this, "LrnMin", LrnMin);
+	reg.Add(this, "ErrMod", ErrMod);
+	reg.Add(this, "ModMin", ModMin);
+	reg.Add(this, "Dt", Dt);
+	reg.Add(this, "LrnFact", LrnFact);
+}
+
+leabra::LrnActAvgParams::LrnActAvgParams(Real SSTau, Real STau, Real MTau, Real LrnM, Real Init):
 	SSTau(SSTau),STau(STau),MTau(MTau),LrnM(LrnM),Init(Init) {
 	Update();
-	InitParamMaps();
 }
 
-void leabra::LrnActAvgParams::AvgsFromAct(float ruAct, float &avgSS, float &avgS, float &avgM, float &avgSLrn)
+void leabra::LrnActAvgParams::AvgsFromAct(Real ruAct, Real &avgSS, Real &avgS, Real &avgM, Real &avgSLrn)
 {
-    avgSS += SSDt * (ruAct = avgSS);
+    avgSS += SSDt * (ruAct - avgSS);
 	avgS += SDt * (avgSS - avgS);
 	avgM += MDt * (avgS - avgM);
 
@@ -263,41 +236,30 @@ std::string leabra::LrnActAvgParams::StyleName() {
     return "";
 }
 
-void leabra::LrnActAvgParams::InitParamMaps() {
-	ParamNameMap["SSTau"] = (void*) &SSTau;
-	ParamNameMap["STau"] = (void*) &STau;
-	ParamNameMap["MTau"] = (void*) &MTau;
-	ParamNameMap["LrnM"] = (void*) &LrnM;
-	ParamNameMap["Init"] = (void*) &Init;
-	ParamNameMap["SSDt"] = (void*) &SSDt;
-	ParamNameMap["SDt"] = (void*) &SDt;
-	ParamNameMap["MDt"] = (void*) &MDt;
-	ParamNameMap["LrnS"] = (void*) &LrnS;
-
-	ParamTypeMap["SSTau"] = &typeid(float);
-	ParamTypeMap["STau"] = &typeid(float);
-	ParamTypeMap["MTau"] = &typeid(float);
-	ParamTypeMap["LrnM"] = &typeid(float);
-	ParamTypeMap["Init"] = &typeid(float);
-	ParamTypeMap["SSDt"] = &typeid(float);
-	ParamTypeMap["SDt"] = &typeid(float);
-	ParamTypeMap["MDt"] = &typeid(float);
-	ParamTypeMap["LrnS"] = &typeid(float);
-}
-
-leabra::CosDiffParams::CosDiffParams(float tau):Tau(tau) {
+void leabra::LrnActAvgParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "SSTau", SSTau);
+	reg.Add(this, "STau", STau);
+	reg.Add(this, "MTau", MTau);
+	reg.Add(this, "LrnM", LrnM);
+	reg.Add(this, "Init", Init);
+	reg.Add(this, "SSDt", SSDt);
+	reg.Add(this, "SDt", SDt);
+	reg.Add(this, "MDt", MDt);
+	reg.Add(this, "LrnS", LrnS);
+}
+
+leabra::CosDiffParams::CosDiffParams(Real tau):Tau(tau) {
 	Update();
-	InitParamMaps();
 }
 
-void leabra::CosDiffParams::AvgVarFromCos(float &avg, float &vr, float cos)
+void leabra::CosDiffParams::AvgVarFromCos(Real &avg, Real &vr, Real cos)
 {
     if (avg==0){
 		avg = cos;
 		vr = 0;
 	} else {
-		float del = cos - avg;
-		float incr = Dt * del;
+		Real del = cos - avg;
+		Real incr = Dt * del;
 		avg += incr;
 		if (vr == 0){
 			vr = 2 * DtC * del * incr;
@@ -329,19 +291,14 @@ std::string leabra::CosDiffParams::StyleName() {
     return "";
 }
 
-void leabra::CosDiffParams::InitParamMaps() {
-	ParamNameMap["Tau"] = (void*) &Tau;
-	ParamNameMap["Dt"] = (void*) &Dt;
-	ParamNameMap["DtC"] = (void*) &DtC;
-
-	ParamTypeMap["Tau"] = &typeid(float);
-	ParamTypeMap["Dt"] = &typeid(float);
-	ParamTypeMap["DtC"] = &typeid(float);
+void leabra::CosDiffParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Tau", Tau);
+	reg.Add(this, "Dt", Dt);
+	reg.Add(this, "DtC", DtC);
 }
 
 leabra::CosDiffStats::CosDiffStats() {
 	Init();
-	InitParamMaps();
 }
 
 void leabra::CosDiffStats::Init()
@@ -365,23 +322,16 @@ std::string leabra::CosDiffStats::StyleName() {
     return "";
 }
 
-void leabra::CosDiffStats::InitParamMaps() {
-	ParamNameMap["Cos"] = (void*) &Cos;
-	ParamNameMap["Avg"] = (void*) &Avg;
-	ParamNameMap["Var"] = (void*) &Var;
-	ParamNameMap["AvgLrn"] = (void*) &AvgLrn;
-	ParamNameMap["ModAvgLLrn"] = (void*) &ModAvgLLrn;
-
-	ParamTypeMap["Cos"] = &typeid(float);
-	ParamTypeMap["Avg"] = &typeid(float);
-	ParamTypeMap["Var"] = &typeid(float);
-	ParamTypeMap["AvgLrn"] = &typeid(float);
-	ParamTypeMap["ModAvgLLrn"] = &typeid(float);
+void leabra::CosDiffStats::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Cos", Cos);
+	reg.Add(this, "Avg", Avg);
+	reg.Add(this, "Var", Var);
+	reg.Add(this, "AvgLrn", AvgLrn);
+	reg.Add(this, "ModAvgLLrn", ModAvgLLrn);
 }
 
-leabra::WtSigParams::WtSigParams(float gain, float off, bool softBound): Gain(gain), Off(off), SoftBound(softBound){
+leabra::WtSigParams::WtSigParams(Real gain, Real off, bool softBound): Gain(gain), Off(off), SoftBound(softBound){
 	Update();
-	InitParamMaps();
 }
 
 void leabra::WtSigParams::Update() {
@@ -394,7 +344,7 @@ void leabra::WtSigParams::Defaults()
 }
 
 // SigFromLinWt returns sigmoidal contrast-enhanced weight from linear weight
-float leabra::WtSigParams::SigFromLinWt(float lw) {
+Real leabra::WtSigParams::SigFromLinWt(Real lw) {
 	if (Gain == 1 && Off == 1) {
 		return lw;
 	}
@@ -405,7 +355,7 @@ float leabra::WtSigParams::SigFromLinWt(float lw) {
 }
 
 // LinFromSigWt returns linear weight from sigmoidal contrast-enhanced weight
-float leabra::WtSigParams::LinFromSigWt(float sw) {
+Real leabra::WtSigParams::LinFromSigWt(Real sw) {
 	if (Gain == 1 && Off == 1) {
 		return sw;
 	}
@@ -427,18 +377,14 @@ std::string leabra::WtSigParams::StyleName() {
     return "";
 }
 
-void leabra::WtSigParams::InitParamMaps() {
-	ParamNameMap["Gain"] = (void*) &Gain;
-	ParamNameMap["Off"] = (void*) &Off;
-	ParamNameMap["SoftBound"] = (void*) &SoftBound;
-
-	ParamTypeMap["Gain"] = &typeid(float);
-	ParamTypeMap["Off"] = &typeid(float);
-	ParamTypeMap["SoftBound"] = &typeid(bool);
+void leabra::WtSigParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Gain", Gain);
+	reg.Add(this, "Off", Off);
+	reg.Add(this, "SoftBound", SoftBound);
 }
 
 // SigFun is the sigmoid function for value w in 0-1 range, with gain and offset params
-float leabra::SigFun(float w, float gain, float off) {
+Real leabra::SigFun(Real w, Real gain, Real off) {
 	if (w <= 0) {
 		return 0;
 	}
@@ -449,7 +395,7 @@ float leabra::SigFun(float w, float gain, float off) {
 }
 
 // SigFun61 is the sigmoid function for value w in 0-1 range, with default gain = 6, offset = 1 params
-float leabra::SigInvFun(float w, float gain, float off) {
+Real leabra::SigInvFun(Real w, Real gain, Real off) {
 	if (w <= 0) {
 		return 0;
 	}
@@ -460,33 +406,32 @@ float leabra::SigInvFun(float w, float gain, float off) {
 }
 
 // SigInvFun is the inverse of the sigmoid function
-float leabra::SigFun61(float w) {
+Real leabra::SigFun61(Real w) {
     if (w <= 0) {
 		return 0;
 	}
 	if (w >= 1) {
 		return 1;
 	}
-	float pw = (1 - w) / w;
+	Real pw = (1 - w) / w;
 	return 1.0 / (1.0 + pw*pw*pw*pw*pw*pw);
 }
 
 // SigInvFun61 is the inverse of the sigmoid function, with default gain = 6, offset = 1 params
-float leabra::SigInvFun61(float w) {
+Real leabra::SigInvFun61(Real w) {
 	if (w <= 0) {
 		return 0;
 	}
 	if (w >= 1) {
 		return 1;
 	}
-    float rval = 1.0 / (1.0 + std::pow((1.0-w)/w, 1.0/6.0));
+    Real rval = 1.0 / (1.0 + std::pow((1.0-w)/w, 1.0/6.0));
 	return rval;
 }
 
-leabra::DWtNormParams::DWtNormParams(bool on, float decayTau, float lrComp, float normMin, bool stats):
+leabra::DWtNormParams::DWtNormParams(bool on, Real decayTau, Real lrComp, Real normMin, bool stats):
     On(on), DecayTau(decayTau), NormMin(normMin), LrComp(lrComp), Stats(stats) {
 		Update();
-		InitParamMaps();
 }
 
 void leabra::DWtNormParams::Update() {
@@ -506,12 +451,12 @@ void leabra::DWtNormParams::Defaults() {
 // DWtNormParams updates the dwnorm running max_abs, slowly decaying value
 // jumps up to max(abs_dwt) and slowly decays
 // returns the effective normalization factor, as a multiplier, including lrate comp
-float leabra::DWtNormParams::NormFromAbsDWt(float &norm, float absDwt) {
+Real leabra::DWtNormParams::NormFromAbsDWt(Real &norm, Real absDwt) {
 	norm = std::max(DecayDt*norm, absDwt);
 	if (norm == 0) {
 		return 1;
 	}
-    return LrComp / std::pow(norm, NormMin);
+    return LrComp / std::max(norm, NormMin);
 }
 
 std::string leabra::DWtNormParams::StyleType() {
@@ -526,27 +471,18 @@ std::string leabra::DWtNormParams::StyleName() {
     return "";
 }
 
-void leabra::DWtNormParams::InitParamMaps() {
-	ParamNameMap["On"] = (void*) &On;
-	ParamNameMap["DecayTau"] = (void*) &DecayTau;
-	ParamNameMap["NormMin"] = (void*) &NormMin;
-	ParamNameMap["LrComp"] = (void*) &LrComp;
-	ParamNameMap["Stats"] = (void*) &Stats;
-	ParamNameMap["DecayDt"] = (void*) &DecayDt;
-	ParamNameMap["DecayDtC"] = (void*) &DecayDtC;
-
-	ParamTypeMap["On"] = &typeid(bool);
-	ParamTypeMap["DecayTau"] = &typeid(float);
-	ParamTypeMap["NormMin"] = &typeid(float);
-	ParamTypeMap["LrComp"] = &typeid(float);
-	ParamTypeMap["Stats"] = &typeid(bool);
-	ParamTypeMap["DecayDt"] = &typeid(float);
-	ParamTypeMap["DecayDtC"] = &typeid(float);
+void leabra::DWtNormParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "On", On);
+	reg.Add(this, "DecayTau", DecayTau);
+	reg.Add(this, "NormMin", NormMin);
+	reg.Add(this, "LrComp", LrComp);
+	reg.Add(this, "Stats", Stats);
+	reg.Add(this, "DecayDt", DecayDt);
+	reg.Add(this, "DecayDtC", DecayDtC);
 }
 
-leabra::WtBalParams::WtBalParams(float on, bool targs, float avgThr, float hiThr, float hiGain, float loThr, float loGain):
+leabra::WtBalParams::WtBalParams(Real on, bool targs, Real avgThr, Real hiThr, Real hiGain, Real loThr, Real loGain):
 	On(on), Targs(targs), AvgThr(avgThr), HiThr(hiThr), HiGain(hiGain), LoThr(loThr), LoGain(loGain) {
-		InitParamMaps();
 }
 
 void leabra::WtBalParams::Update() {
@@ -563,15 +499,15 @@ void leabra::WtBalParams::Defaults() {
 
 // WtBal computes weight balance factors for increase and decrease based on extent
 // to which weights and average act exceed thresholds
-std::tuple<float, float, float> leabra::WtBalParams::WtBal(float wbAvg) {
-	float fact;
-	float inc = 1;
-	float dec = 1;
+std::tuple<Real, Real, Real> leabra::WtBalParams::WtBal(Real wbAvg) {
+	Real fact = 0;
+	Real inc = 1;
+	Real dec = 1;
 	if (wbAvg < LoThr) {
 		if (wbAvg < AvgThr) {
 			wbAvg = AvgThr; // prevent extreme low if everyone below thr
 		}
-		float fact = LoGain * (LoThr - wbAvg);
+		fact = LoGain * (LoThr - wbAvg);
 		dec = 1 / (1 + fact);
 		inc = 2 - dec;
 	} else if (wbAvg > HiThr) {
@@ -580,7 +516,7 @@ std::tuple<float, float, float> leabra::WtBalParams::WtBal(float wbAvg) {
 		dec = 2 - inc;        // as inc goes down, dec goes up..  sum to 2
 	}
 
-    return std::tuple<float, float, float>(fact, inc, dec);
+    return std::tuple<Real, Real, Real>(fact, inc, dec);
 }
 
 std::string leabra::WtBalParams::StyleType() {
@@ -595,28 +531,19 @@ std::string leabra::WtBalParams::StyleName() {
     return "";
 }
 
-void leabra::WtBalParams::InitParamMaps() {
-	ParamNameMap["On"] = (void*) &On;
-	ParamNameMap["Targs"] = (void*) &Targs;
-	ParamNameMap["AvgThr"] = (void*) &AvgThr;
-	ParamNameMap["HiThr"] = (void*) &HiThr;
-	ParamNameMap["HiGain"] = (void*) &HiGain;
-	ParamNameMap["LoThr"] = (void*) &LoThr;
-	ParamNameMap["LoGain"] = (void*) &LoGain;
-
-	ParamTypeMap["On"] = &typeid(bool);
-	ParamTypeMap["Targs"] = &typeid(bool);
-	ParamTypeMap["AvgThr"] = &typeid(float);
-	ParamTypeMap["HiThr"] = &typeid(float);
-	ParamTypeMap["HiGain"] = &typeid(float);
-	ParamTypeMap["LoThr"] = &typeid(float);
-	ParamTypeMap["LoGain"] = &typeid(float);
+void leabra::WtBalParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "On", On);
+	reg.Add(this, "Targs", Targs);
+	reg.Add(this, "AvgThr", AvgThr);
+	reg.Add(this, "HiThr", HiThr);
+	reg.Add(this, "HiGain", HiGain);
+	reg.Add(this, "LoThr", LoThr);
+	reg.Add(this, "LoGain", LoGain);
 }
 
-leabra::MomentumParams::MomentumParams(bool on, float mTau, float lrComp):
+leabra::MomentumParams::MomentumParams(bool on, Real mTau, Real lrComp):
 	On(on), MTau(mTau), LrComp(lrComp){
 	Update();
-	InitParamMaps();
 }
 
 void leabra::MomentumParams::Defaults(){
@@ -627,7 +554,7 @@ void leabra::MomentumParams::Defaults(){
 
 // MomentFromDWt updates synaptic moment variable based on dwt weight change value
 // and returns new momentum factor * LrComp
-float leabra::MomentumParams::MomentFromDWt(float &moment, float dwt) {
+Real leabra::MomentumParams::MomentFromDWt(Real &moment, Real dwt) {
 	moment = MDtC * moment + dwt;
 	return LrComp * moment;
 }
@@ -644,23 +571,16 @@ std::string leabra::MomentumParams::StyleName() {
     return "";
 }
 
-void leabra::MomentumParams::InitParamMaps() {
-	ParamNameMap["On"] = (void*) &On;
-	ParamNameMap["MTau"] = (void*) &MTau;
-	ParamNameMap["LrComp"] = (void*) &LrComp;
-	ParamNameMap["MDt"] = (void*) &MDt;
-	ParamNameMap["MDtC"] = (void*) &MDtC;
-
-	ParamTypeMap["On"] = &typeid(bool);
-	ParamTypeMap["MTau"] = &typeid(float);
-	ParamTypeMap["LrComp"] = &typeid(float);
-	ParamTypeMap["MDt"] = &typeid(float);
-	ParamTypeMap["MDtC"] = &typeid(float);
+void leabra::MomentumParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "On", On);
+	reg.Add(this, "MTau", MTau);
+	reg.Add(this, "LrComp", LrComp);
+	reg.Add(this, "MDt", MDt);
+	reg.Add(this, "MDtC", MDtC);
 }
 
-leabra::LearnSynParams::LearnSynParams(bool learn, float lrate):
+leabra::LearnSynParams::LearnSynParams(bool learn, Real lrate):
 	Learn(learn), Lrate(lrate), LrateInit(lrate), XCal(), WtSig(), Norm(), Momentum(), WtBal() {
-		InitParamMaps();
 }
 
 void leabra::LearnSynParams::Update()
@@ -698,26 +618,26 @@ void leabra::LearnSynParams::WtFromLWt(Synapse &syn) {
 
 // CHLdWt returns the error-driven and BCM Hebbian weight change components for the
 // temporally eXtended Contrastive Attractor Learning (XCAL), CHL version
-std::tuple<float, float> leabra::LearnSynParams::CHLdWt(float suAvgSLrn, float suAvgM, float ruAvgSLrn, float ruAvgM, float ruAvgL) {
-	float err, bcm;
-	float srs = suAvgSLrn * ruAvgSLrn;
-	float srm = suAvgM * ruAvgM;
+std::tuple<Real, Real> leabra::LearnSynParams::CHLdWt(Real suAvgSLrn, Real suAvgM, Real ruAvgSLrn, Real ruAvgM, Real ruAvgL) {
+	Real err, bcm;
+	Real srs = suAvgSLrn * ruAvgSLrn;
+	Real srm = suAvgM * ruAvgM;
 	bcm = XCal.DWt(srs, ruAvgL);
 	err = XCal.DWt(srs, srm);
-    return std::tuple<float, float>(err, bcm);
+    return std::tuple<Real, Real>(err, bcm);
 }
 
 // BCMdWt returns the BCM Hebbian weight change for AvgSLrn vs. AvgL
 // long-term average floating activation on the receiver.
-float leabra::LearnSynParams::BCMdWt(float suAvgSLrn, float ruAvgSLrn, float ruAvgL) {
-	float srs = suAvgSLrn * ruAvgSLrn;
+Real leabra::LearnSynParams::BCMdWt(Real suAvgSLrn, Real ruAvgSLrn, Real ruAvgL) {
+	Real srs = suAvgSLrn * ruAvgSLrn;
 	return XCal.DWt(srs, ruAvgL);
 }
 
 // WtFromDWt updates the synaptic weights from accumulated weight changes
 // wbInc and wbDec are the weight balance factors, wt is the sigmoidal contrast-enhanced
 // weight and lwt is the linear weight value
-void leabra::LearnSynParams::WtFromDWt(float wbInc, float wbDec, float &dwt, float &wt, float &lwt, float scale) {
+void leabra::LearnSynParams::WtFromDWt(Real wbInc, Real wbDec, Real &dwt, Real &wt, Real &lwt, Real scale) {
 		if (dwt == 0) {
 			return;
 		}
@@ -756,22 +676,13 @@ std::string leabra::LearnSynParams::StyleName() {
     return "";
 }
 
-void leabra::LearnSynParams::InitParamMaps() {
-	ParamNameMap["Learn"] = (void*) &Learn;
-	ParamNameMap["Lrate"] = (void*) &Lrate;
-	ParamNameMap["LrateInit"] = (void*) &LrateInit;
-	ParamNameMap["XCal"] = (void*) &XCal;
-	ParamNameMap["WtSig"] = (void*) &WtSig;
-	ParamNameMap["Norm"] = (void*) &Norm;
-	ParamNameMap["Momentum"] = (void*) &Momentum;
-	ParamNameMap["WtBal"] = (void*) &WtBal;
-
-	ParamTypeMap["Learn"] = &typeid(Learn);
-	ParamTypeMap["Lrate"] = &typeid(Lrate);
-	ParamTypeMap["LrateInit"] = &typeid(LrateInit);
-	ParamTypeMap["XCal"] = &typeid(XCal);
-	ParamTypeMap["WtSig"] = &typeid(WtSig);
-	ParamTypeMap["Norm"] = &typeid(Norm);
-	ParamTypeMap["Momentum"] = &typeid(Momentum);
-	ParamTypeMap["WtBal"] = &typeid(WtBal);
+void leabra::LearnSynParams::InitParamMaps(params::ParamRegistry &reg) {
+	reg.Add(this, "Learn", Learn);
+	reg.Add(this, "Lrate", Lrate);
+	reg.Add(this, "LrateInit", LrateInit);
+	reg.Add(this, "XCal", XCal);
+	reg.Add(this, "WtSig", WtSig);
+	reg.Add(this, "Norm", Norm);
+	reg.Add(this, "Momentum", Momentum);
+	reg.Add(this, "WtBal", WtBal);
 }
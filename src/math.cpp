@@ -38,15 +38,15 @@ math::Vector3::Vector3(){
 
 }
 
-math::Vector3::Vector3(int scalar):X(scalar),Y(scalar),Z(scalar){}
+math::Vector3::Vector3(float scalar):X(scalar),Y(scalar),Z(scalar){}
 
-math::Vector3::Vector3(int x, int y, int z):X(x),Y(y),Z(z){}
+math::Vector3::Vector3(float x, float y, float z):X(x),Y(y),Z(z){}
 
 math::Vector2::Vector2(){X=0; Y=0;}
 
-math::Vector2::Vector2(int scalar):X(scalar),Y(scalar){}
+math::Vector2::Vector2(float scalar):X(scalar),Y(scalar){}
 
-math::Vector2::Vector2(int x, int y): X(x),Y(y) {
+math::Vector2::Vector2(float x, float y): X(x),Y(y) {
 }
 
 math::Vector2 math::Vector2::Sub(Vector2 other) {
@@ -5,46 +5,54 @@
 // const float MinFloat32 =  1.175494351e-38
 
 // Set sets the min and max values
-void minmax::F32::Set(float mn, float mx) {
+template <typename T>
+void minmax::MinMax<T>::Set(T mn, T mx) {
     Min = mn;
     Max = mx;
 }
 
 // SetInfinity sets the Min to +MaxFloat, Max to -MaxFloat -- suitable for
 // iteratively calling Fit*InRange
-void minmax::F32::SetInfinity() {
-    Min = std::numeric_limits<float>::max();
-    Max = -std::numeric_limits<float>::max();
+template <typename T>
+void minmax::MinMax<T>::SetInfinity() {
+    Min = std::numeric_limits<T>::max();
+    Max = -std::numeric_limits<T>::max();
 }
 
 // IsValid returns true if Min <= Max
-bool minmax::F32::IsValid() {
+template <typename T>
+bool minmax::MinMax<T>::IsValid() {
     return Min <= Max;
 }
 
 // InRange tests whether value is within the range (>= Min and <= Max)
-bool minmax::F32::InRange(float val) {
+template <typename T>
+bool minmax::MinMax<T>::InRange(T val) {
     return ((val >= Min) && (val <= Max));
 }
 
 // IsLow tests whether value is lower than the minimum
-bool minmax::F32::IsLow(float val) {
+template <typename T>
+bool minmax::MinMax<T>::IsLow(T val) {
     return val < Min;
 }
 
 // IsHigh tests whether value is higher than the maximum
-bool minmax::F32::IsHigh(float val) {
+template <typename T>
+bool minmax::MinMax<T>::IsHigh(T val) {
     return val > Max;
 }
 
 // Range returns Max - Min
-float minmax::F32::Range() {
+template <typename T>
+T minmax::MinMax<T>::Range() {
     return Max - Min;
 }
 
 // Scale returns 1 / Range -- if Range = 0 then returns 0
-float minmax::F32::Scale() {
-    float r = Range();
+template <typename T>
+T minmax::MinMax<T>::Scale() {
+    T r = Range();
     if (r != 0) {
         return 1.0/r;
     }
@@ -52,13 +60,15 @@ float minmax::F32::Scale() {
 }
 
 // Scale returns 1 / Range -- if Range = 0 then returns 0
-float minmax::F32::Midpoint() {
+template <typename T>
+T minmax::MinMax<T>::Midpoint() {
     return 0.5 * (Max + Min);
 }
 
 // FitValInRange adjusts our Min, Max to fit given value within Min, Max range
 // returns true if we had to adjust to fit.
-float minmax::F32::FitValInRange(float val) {
+template <typename T>
+T minmax::MinMax<T>::FitValInRange(T val) {
     bool adj = false;
     if (val < Min) {
         Min = val;
@@ -73,18 +83,21 @@ float minmax::F32::FitValInRange(float val) {
 
 // NormVal normalizes value to 0-1 unit range relative to current Min / Max range
 // Clips the value within Min-Max range first.
-float minmax::F32::NormValue(float val) {
+template <typename T>
+T minmax::MinMax<T>::NormValue(T val) {
     return (ClipValue(val) - Min) * Scale();
 }
 
 // ProjVal projects a 0-1 normalized unit value into current Min / Max range (inverse of NormVal)
-float minmax::F32::ProjValue(float val) {
+template <typename T>
+T minmax::MinMax<T>::ProjValue(T val) {
     return Min + (val * Range());
 }
 
 // ClipVal clips given value within Min / Max range
 // Note: a NaN will remain as a NaN
-float minmax::F32::ClipValue(float val) {
+template <typename T>
+T minmax::MinMax<T>::ClipValue(T val) {
     if (val < Min) {
 		return Min;
 	}
@@ -96,7 +109,8 @@ float minmax::F32::ClipValue(float val) {
 
 // ClipNormVal clips then normalizes given value within 0-1
 // Note: a NaN will remain as a NaN
-float minmax::F32::ClipNormValue(float val) {
+template <typename T>
+T minmax::MinMax<T>::ClipNormValue(T val) {
     if (val < Min) {
 		return 0;
 	}
@@ -106,15 +120,17 @@ float minmax::F32::ClipNormValue(float val) {
 	return NormValue(val);
 }
 
-std::string minmax::F32::String() {
+template <typename T>
+std::string minmax::MinMax<T>::String() {
     std::string out; //TODO: Check if it is better to use char * here
     std::sprintf(&out[0], "{%g %g}", Min, Max);
     return out;
 }
 
-// FitInRange adjusts our Min, Max to fit within those of other F32
+// FitInRange adjusts our Min, Max to fit within those of other MinMax
 // returns true if we had to adjust to fit.
-bool minmax::F32::FitInRange(F32 oth) {
+template <typename T>
+bool minmax::MinMax<T>::FitInRange(MinMax<T> oth) {
     bool adj = false;
 	if (oth.Min < Min) {
 		Min = oth.Min;
@@ -127,16 +143,18 @@ bool minmax::F32::FitInRange(F32 oth) {
 	return adj;
 }
 
-minmax::AvgMax32::AvgMax32(){
+template <typename T>
+minmax::AvgMax<T>::AvgMax(){
     Avg = 0;
     Sum = 0;
     N = 0;
-    Max = -std::numeric_limits<float>::max();
+    Max = -std::numeric_limits<T>::max();
     MaxIndex = -1;
 }
 
 // UpdateVal updates stats from given value
-void minmax::AvgMax32::UpdateValue(float val, int idx) {
+template <typename T>
+void minmax::AvgMax<T>::UpdateValue(T val, int idx) {
     Sum += val;
 	N++;
 	if (val > Max) {
@@ -145,8 +163,9 @@ void minmax::AvgMax32::UpdateValue(float val, int idx) {
 	}
 }
 
-// UpdateFromOther updates these values from other AvgMax32 values
-void minmax::AvgMax32::UpdateFromOther(int oSum, float oMax, int oN, int oMaxIndex) {
+// UpdateFromOther updates these values from other AvgMax values
+template <typename T>
+void minmax::AvgMax<T>::UpdateFromOther(int oSum, T oMax, int oN, int oMaxIndex) {
     Sum += oSum;
 	N += oN;
 	if (oMax > Max) {
@@ -156,7 +175,8 @@ void minmax::AvgMax32::UpdateFromOther(int oSum, float oMax, int oN, int oMaxInd
 }
 
 // CalcAvg computes the average given the current Sum and N values
-void minmax::AvgMax32::CalcAvg() {
+template <typename T>
+void minmax::AvgMax<T>::CalcAvg() {
     if (N > 0) {
 		Avg = Sum / N;
 	} else {
@@ -165,22 +185,30 @@ void minmax::AvgMax32::CalcAvg() {
 	}
 }
 
-std::string minmax::AvgMax32::String() {
+template <typename T>
+std::string minmax::AvgMax<T>::String() {
     std::string out; //TODO: Check if it is better to use char * here
     std::sprintf(&out[0], "{Avg: %g, Max: %g, Sum: %g, MaxIndex: %d, N: %d}",
         Avg, Max, Sum, MaxIndex, N);
     return out;
 }
 
-void minmax::AvgMax32::CopyFrom(AvgMax32 *oth) {
+template <typename T>
+void minmax::AvgMax<T>::CopyFrom(AvgMax<T> *oth) {
     *this = *oth;
 }
 
 // Init initializes prior to new updates
-void minmax::AvgMax32::Init() {
+template <typename T>
+void minmax::AvgMax<T>::Init() {
     Avg = 0;
 	Sum = 0;
 	N = 0;
-	Max = -std::numeric_limits<float>::max();
+	Max = -std::numeric_limits<T>::max();
 	MaxIndex = -1;
 }
+
+template struct minmax::MinMax<float>;
+template struct minmax::MinMax<double>;
+template struct minmax::AvgMax<float>;
+template struct minmax::AvgMax<double>;
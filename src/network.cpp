@@ -4,6 +4,10 @@
 leabra::Network::Network(std::string name, int wtBalInterval):
 	emer::Network(name), WtBalInterval(wtBalInterval) {
 	NThreads = 1;WtBalCtr = 0;
+	WtBalCheck = false; WtBalErrs = 0;
+	BuildMemHWM = 0; InitWeightsMemHWM = 0;
+	Frozen = false;
+	StructGen = 0;
 }
 
 int leabra::Network::NumLayers() {
@@ -41,10 +45,11 @@ void leabra::Network::UpdateParams() {
 // adds it to the network, and initializes and configures it properly.
 leabra::Layer* leabra::Network::AddLayerInit(std::string name, std::vector<int> shape, LayerTypes typ) {
 	// emer::InitLayer(ly, name);
-	Layer *ly =  new leabra::Layer(name);
+	Layer *ly =  new leabra::Layer(name, Layers.size(), this);
 	ly->SetShape(shape);
 	ly->Type = typ;
 	Layers.push_back(ly);
+	emer::SelIndexGen++;
 	UpdateLayerMaps();
 	return ly;
 }
@@ -102,6 +107,7 @@ leabra::Path *leabra::Network::ConnectLayers(Layer *send, Layer *recv, paths::Pa
 	pt->Connect(send, recv, pat, typ);
 	recv->RecvPaths.push_back(pt);
 	send->SendPaths.push_back(pt);
+	emer::SelIndexGen++;
 	return pt;
 }
 
@@ -156,25 +162,76 @@ leabra::Path *leabra::Network::LateralConnectLayerPath(Layer *lay, paths::Patter
 	// TODO: Check if there are consequences to copying pt
 	lay->RecvPaths.push_back(pt);	
 	lay->SendPaths.push_back(pt);
+	emer::SelIndexGen++;
 	return pt;
 }
 
 // Build constructs the layer and pathway state based on the layer shapes
-// and patterns of interconnectivity
+// and patterns of interconnectivity. A Frozen network is no longer Frozen,
+// and needs InitWeights or loaded weights again.
 void leabra::Network::Build() {
+	Frozen = false;
+	StructGen++;
 	UpdateLayerMaps();
 	std::vector<std::string> errs = std::vector<std::string>();
+	// running total of the network memory: each layer's state is swapped
+	// for its new one as it builds, with indexes shared with a pathway
+	// built before only counted once, at their current size (a transposed
+	// view adds SynRIndex to them)
+	size_t mem = MemoryReport().Resident();
+	BuildMemHWM = mem;
+	std::map<const paths::ConnIndexes*, size_t> conns; // bytes counted for each
 	for (uint li = 0; li < Layers.size(); li ++) {
 		Layer &ly = *Layers[li];
 		ly.Index = li;
 		if (ly.Off) {
 			continue;
 		}
+		mem -= ly.MemoryReport().Resident();
 		ly.Build();
+		mem += ly.MemoryReport().Resident();
+		// pattern tables only live while each path builds, so peak is the
+		// network as it is so far plus the largest table of this layer's paths
+		size_t patMax = 0;
+		for (Path *pt: ly.RecvPaths) {
+			patMax = std::max(patMax, pt->PatternBytes);
+			if (pt->Conns == nullptr) {
+				continue;
+			}
+			size_t by = pt->Conns->Bytes();
+			auto [it, first] = conns.try_emplace(pt->Conns.get(), by);
+			if (!first) {
+				mem -= it->second;
+				it->second = by;
+			}
+		}
+		BuildMemHWM = std::max(BuildMemHWM, mem + patMax);
 	}
+	CountConnsViews();
 	LayoutLayers();
 }
 
+// CountConnsViews sets the ConnsViews of each pathway to the number of
+// pathways of the network that view the same Conns, so that MemoryReport
+// counts the bytes of shared indexes once.
+void leabra::Network::CountConnsViews() {
+	std::map<const paths::ConnIndexes*, int> views;
+	for (Layer *ly: Layers) {
+		for (Path *pt: ly->RecvPaths) {
+			if (pt->Conns != nullptr) {
+				views[pt->Conns.get()]++;
+			}
+		}
+	}
+	for (Layer *ly: Layers) {
+		for (Path *pt: ly->RecvPaths) {
+			if (pt->Conns != nullptr) {
+				pt->ConnsViews = views[pt->Conns.get()];
+			}
+		}
+	}
+}
+
 // AlphaCycInit handles all initialization at start of new input pattern.
 // Should already have presented the external input to the network at this point.
 // If updtActAvg is true, this includes updating the running-average
@@ -186,7 +243,13 @@ void leabra::Network::Build() {
 // keep the existing scaling factors (e.g., can pass a train bool to
 // only update during training).
 // This flag also affects the AvgL learning threshold.
+// Any param changes queued with QueueParam are applied first.
+// A Frozen network cannot learn, so updtActAvg must be false.
 void leabra::Network::AlphaCycInit(bool updtActAvg) {
+	if (Frozen && updtActAvg) {
+		throw std::runtime_error("ERROR: network " + Name + " is Frozen for inference only, and cannot be trained");
+	}
+	ApplyQueuedParams();
     for (Layer *ly: Layers) {
 		if (ly->Off) {
 			continue;
@@ -201,14 +264,24 @@ void leabra::Network::AlphaCycInit(bool updtActAvg) {
 // * Inhibition based on Ge stats and Act Stats (computed at end of Cycle)
 // * Activation from Ge, Gi, and Gl
 // * Average and Max Act stats
+// Once all the layers have sent, each does the rest in Layer.Cycle, which
+// gives the same results as SendGDelta, AvgMaxGe, InhibFromGeAct, ActFromG
+// and AvgMaxAct here with fewer passes through its neurons.
 // This basic version doesn't use the time info, but more specialized types do, and we
 // want to keep a consistent API for end-user code.
 void leabra::Network::Cycle(Context *ctx) {
-    SendGDelta(ctx); // also does integ
-	AvgMaxGe(ctx);
-	InhibFromGeAct(ctx);
-	ActFromG(ctx);
-	AvgMaxAct(ctx);
+    for (Layer *ly: Layers) {
+		if (ly->Off) {
+			continue;
+		}
+		ly->SendGDelta(ctx);
+	}
+    for (Layer *ly: Layers) {
+		if (ly->Off) {
+			continue;
+		}
+		ly->Cycle(ctx);
+	}
 	for (Layer *ly: Layers) {
 		if (ly->Off) {
 			continue;
@@ -217,6 +290,19 @@ void leabra::Network::Cycle(Context *ctx) {
 	}
 }
 
+// ActDelMax returns the max |ActDel| over all the layers in the last
+// cycle, for Context.Settled.
+Real leabra::Network::ActDelMax() {
+	Real mx = 0;
+	for (Layer *ly: Layers) {
+		if (ly->Off) {
+			continue;
+		}
+		mx = std::max(mx, ly->ActDelMax);
+	}
+	return mx;
+}
+
 // SendGeDelta sends change in activation since last sent, if above thresholds
 // and integrates sent deltas into GeRaw and time-integrated Ge values
 void leabra::Network::SendGDelta(Context *ctx) {
@@ -305,18 +391,48 @@ void leabra::Network::PlusPhase(Context *ctx) {
 }
 
 // DWt computes the weight change (learning) based on current
-// running-average activation values
-void leabra::Network::Dwt() {
+// running-average activation values.
+// If batch, the raw changes are summed over a minibatch of trials,
+// and DWtFromBatch must be called before WtFromDwt (see Sim.BatchSize).
+// Otherwise the owner of each Tied pair applies the raw changes summed by
+// both of its pathways with DWtFromBatch, once both have run.
+void leabra::Network::Dwt(bool batch) {
     for (Layer *ly: Layers) {
 		if (ly->Off) {
 			continue;
 		}
-		ly->DWt();
+		ly->DWt(batch);
+	}
+	if (batch) {
+		return;
+	}
+	// Tied pairs sum their raw changes, applied once by the owner
+	for (Layer *ly: Layers) {
+		if (ly->Off) {
+			continue;
+		}
+		for (Path *pt: ly->SendPaths) {
+			if (!pt->Off && pt->TiedBy() != nullptr) {
+				pt->DWtFromBatch();
+			}
+		}
+	}
+}
+
+// DWtFromBatch computes the weight changes from the raw changes summed
+// over a minibatch by Dwt, applying Norm, Momentum and Lrate once.
+void leabra::Network::DWtFromBatch() {
+    for (Layer *ly: Layers) {
+		if (ly->Off) {
+			continue;
+		}
+		ly->DWtFromBatch();
 	}
 }
 
 // WtFromDWt updates the weights from delta-weight changes.
-// Also calls WtBalFromWt every WtBalInterval times
+// Also calls WtBalFromWt every WtBalInterval times, counting any
+// mismatches of the running WtBal sums in WtBalErrs if WtBalCheck.
 void leabra::Network::WtFromDwt() {
     for (Layer *ly: Layers) {
 		if (ly->Off) {
@@ -332,7 +448,7 @@ void leabra::Network::WtFromDwt() {
             if (ly->Off) {
                 continue;
             }
-            ly->WtBalFromWt();
+            WtBalErrs += ly->WtBalFromWt(WtBalCheck);
         }
 	}
 }
@@ -348,16 +464,77 @@ void leabra::Network::LrateMult(float mult) {
 	}
 }
 
+// Prune prunes the synapses of the pathways named in paths, or all of
+// them if empty, with Path.Prune, returning their combined report.
+// Tied and Shared pathways are skipped.
+leabra::PruneReport leabra::Network::Prune(float thr, float pct, std::vector<std::string> paths) {
+	PruneReport pr;
+	for (Layer *ly: Layers) {
+		if (ly->Off) {
+			continue;
+		}
+		for (Path *pt: ly->RecvPaths) {
+			if (pt->Tied || pt->Kernel != nullptr) {
+				continue;
+			}
+			if (!paths.empty() && std::find(paths.begin(), paths.end(), pt->Name) == paths.end()) {
+				continue;
+			}
+			pr.Add(pt->Prune(thr, pct));
+		}
+	}
+	return pr;
+}
+
+// Freeze makes the network inference only, with Path.Freeze on all of its
+// pathways: they keep only their weights, in the quant format (see
+// WtQuants, and pathScale for WtInt8), premultiplied by GScale if gscale
+// is true, and training, pruning, checkpoints and InitWeights then throw.
+// Layers stop updating the neuron learning averages and quarter snapshots,
+// until a Build. Returns the memory report after freezing.
+leabra::MemReport leabra::Network::Freeze(bool gscale, WtQuants quant, bool pathScale) {
+	// tied pathways copy the weights of their owners, before those are freed
+	for (int tied = 1; tied >= 0; tied--) {
+		for (Layer *ly: Layers) {
+			for (Path *pt: ly->RecvPaths) {
+				if ((pt->TiedTo != nullptr) == tied) {
+					pt->Freeze(gscale, quant, pathScale);
+				}
+			}
+		}
+	}
+	Frozen = true;
+	return MemoryReport();
+}
+
 // InitWeights initializes synaptic weights and all other
 // associated long-term state variables including running-average
 // state values (e.g., layer running average activations etc).
+// InitWeightsMemHWM is the peak of the network memory while it runs: each
+// pathway peaks (see Path.InitWeightsPeak) with the pathways before it
+// done and those after it not yet started.
 void leabra::Network::InitWeights() {
     WtBalCtr = 0;
+	size_t memCur = MemoryReport().Resident();
+	InitWeightsMemHWM = memCur;
+	std::vector<size_t> before;
 	for (Layer *ly: Layers) {
 		if (ly->Off) {
 			continue;
 		}
+		before.clear();
+		for (Path *pt: ly->SendPaths) {
+			before.push_back(pt->MemoryReport().Resident());
+		}
 		ly->InitWeights();
+		for (size_t pi = 0; pi < ly->SendPaths.size(); pi++) {
+			Path *pt = ly->SendPaths[pi];
+			if (pt->Off) {
+				continue;
+			}
+			InitWeightsMemHWM = std::max(InitWeightsMemHWM, memCur - before[pi] + pt->InitWeightsPeak);
+			memCur = memCur - before[pi] + pt->MemoryReport().Resident();
+		}
 	}
 	for (Layer *ly: Layers) {
 		if (ly->Off) {
@@ -365,15 +542,16 @@ void leabra::Network::InitWeights() {
 		}
 		ly->InitWtSym();
 	}
+	InitWeightsMemHWM = std::max(InitWeightsMemHWM, MemoryReport().Resident());
 }
 
 // InitTopoScales initializes synapse-specific scale parameters from
 // path types that support them, with flags set to support it,
 // includes: paths.PoolTile paths.Circle.
 // call before InitWeights if using Topo wts.
+// PoolTile weights are shared by the pathways with the same topographic
+// params and layer shapes, through paths.DefaultTopoCache.
 void leabra::Network::InitTopoScales() {
-	auto shp = std::vector<int>();
-    auto scales = tensor::Tensor<float>(shp);
 	for (Layer *ly: Layers) {
 		if (ly->Off) {
 			continue;
@@ -384,20 +562,21 @@ void leabra::Network::InitTopoScales() {
 				continue;
 			}
 			paths::Pattern *pat = pt->Pattern;
-			if (pat->type == "PoolTile"){
+			if (pat->Name() == "PoolTile"){
 				auto ptn = (paths::PoolTile*) pat;
 				if (!ptn->HasTopoWeights()) {
 					continue;
 				}
 				Layer &slay = *pt->Send;
-				ptn->TopoWeights(slay.Shape, ly->Shape, scales);
-				pt->SetScalesRPool(scales);
-			} else if (pat->type == "Circle"){
+				pt->SetScalesRPool(*paths::DefaultTopoCache.Get(*ptn, slay.Shape, ly->Shape));
+			} else if (pat->Name() == "Circle"){
 				auto ptn = (paths::Circle*) pat;
 				if (!ptn->TopoWeights) {
 					continue;
 				}
-				pt->SetScalesFunc(ptn->GaussWts);
+				pt->SetScalesFunc([ptn](int si, int ri, tensor::Shape &send, tensor::Shape &recv) {
+					return ptn->GaussWts(si, ri, send, recv);
+				});
 			}
 		}
 	}
@@ -495,12 +674,168 @@ void leabra::Network::UnLesionNeurons() {
 	}
 }
 
+// MemoryReport returns the memory held by the network state, summed over
+// all layers and their receiving pathways, plus the shared param registries.
+leabra::MemReport leabra::Network::MemoryReport() {
+	MemReport mr;
+	for (Layer *ly: Layers) {
+		mr.Add(ly->MemoryReport());
+	}
+	mr.ParamMaps = params::ParamRegistryBytes();
+	return mr;
+}
+
+// SaveCheckpoint writes the weights and long-term running averages of the
+// network to a binary checkpoint file (see the weights package), which can
+// be loaded back bit-exactly with LoadCheckpoint.
+// If learnState is true, the synaptic DWt, Norm and Moment values are also
+// saved, so that training can resume exactly where it left off.
+void leabra::Network::SaveCheckpoint(std::string fileName, bool learnState) {
+	if (Frozen) { // before the file is opened
+		throw std::runtime_error("ERROR: network " + Name + " is Frozen for inference only, and cannot be checkpointed");
+	}
+	weights::CkptWriter ck(fileName, learnState ? weights::CkptLearn : 0);
+	for (Layer *ly: Layers) {
+		ly->WriteCheckpoint(ck);
+	}
+	ck.Close();
+	WeightsFile = fileName;
+}
+
+// LoadCheckpoint sets the network state from a checkpoint file written by
+// SaveCheckpoint, for a network with the same layers and pathways.
+// The file is memory-mapped and read in place.
+// Layers not in the checkpoint are left as is, with a warning.
+void leabra::Network::LoadCheckpoint(std::string fileName) {
+	weights::CkptFile ck(fileName);
+	if (ck.HasFlag(weights::CkptDelta)) {
+		throw std::runtime_error("LoadCheckpoint: " + fileName + " is an incremental checkpoint -- use RebuildCheckpoint to make a full one first");
+	}
+	for (Layer *ly: Layers) {
+		size_t n;
+		if (ck.Array(ly->Name + "/AvgL", n) == nullptr) {
+			std::cerr << "weights: no state for layer " << ly->Name << " in checkpoint " << fileName << std::endl;
+			continue;
+		}
+		ly->ReadCheckpoint(ck);
+	}
+	WeightsFile = fileName;
+}
+
+leabra::Checkpointer::Checkpointer(Network *net, std::string prefix, int fullEvery, bool learnState):
+	Net(net), Prefix(prefix), FullEvery(std::max(fullEvery, 1)), LearnState(learnState), Seq(0), BaseSeq(0), BaseGen(0) {}
+
+leabra::Checkpointer::~Checkpointer() {
+	if (Writer.joinable()) {
+		Writer.join();
+	}
+}
+
+// Save takes a checkpoint of the network and starts writing it in the
+// background, returning its file name. It first waits for the previous
+// checkpoint to finish writing.
+// The snapshot holds a copy of just the state being saved, and the dirty
+// sending rows are cleared once it is taken.
+std::string leabra::Checkpointer::Save() {
+	Wait();
+	Seq++;
+	bool full = BaseSeq == 0 || Seq - BaseSeq >= uint64_t(FullEvery) || Net->StructGen != BaseGen;
+	if (full) {
+		BaseSeq = Seq;
+		BaseGen = Net->StructGen;
+	}
+	uint32_t flags = (LearnState ? weights::CkptLearn : 0) | (full ? 0 : weights::CkptDelta);
+	auto ck = std::make_shared<weights::CkptWriter>(flags);
+	ck->Seq = Seq;
+	ck->PrevSeq = full ? Seq : Seq - 1;
+	for (Layer *ly: Net->Layers) {
+		ly->WriteCheckpoint(*ck);
+		for (Path *pt: ly->RecvPaths) {
+			pt->CkptClearDirty();
+		}
+	}
+	ck->Close();
+	std::string fileName = weights::CkptFileName(Prefix, Seq);
+	Writer = std::thread([this, ck, fileName]() {
+		try {
+			ck->SaveMem(fileName);
+		} catch (const std::exception &e) {
+			WriteErr = e.what();
+		}
+	});
+	return fileName;
+}
+
+// Wait waits for the last checkpoint to finish writing,
+// throwing if there was an error writing it.
+void leabra::Checkpointer::Wait() {
+	if (Writer.joinable()) {
+		Writer.join();
+	}
+	if (WriteErr != "") {
+		std::string err = WriteErr;
+		WriteErr = "";
+		throw std::runtime_error(err);
+	}
+}
+
+// Due returns whether to prune after the given epoch (counting from 1).
+bool leabra::PruneSchedule::Due(int epoch) {
+	if (!On || epoch < Start || (Stop > 0 && epoch > Stop)) {
+		return false;
+	}
+	return Interval <= 0 ? epoch == Start : (epoch - Start) % Interval == 0;
+}
+
+// Epoch prunes net if Due after the given epoch, returning the report
+// (empty if not Due).
+leabra::PruneReport leabra::PruneSchedule::Epoch(Network &net, int epoch) {
+	if (!Due(epoch)) {
+		return PruneReport();
+	}
+	Last = net.Prune(Thr, Pct, Paths);
+	Total.Add(Last);
+	return Last;
+}
+
 void pybind_LeabraNet(pybind11::module_ &m) {
 	// pybind11::class_<leabra::Network, leabra::Network*>(m, "Network")
     //     .def(pybind11::init<std::string, int>(),
 	// 		pybind11::arg("name"),
     //         pybind11::arg("wtBalInterval") = 10
     //     	)
+	pybind11::class_<emer::CompiledParams>(m, "CompiledParams")
+		.def("Apply", &emer::CompiledParams::Apply)
+	;
+
+	pybind11::class_<leabra::Checkpointer>(m, "Checkpointer")
+		.def(pybind11::init<leabra::Network*, std::string, int, bool>(),
+			pybind11::arg("net"),
+			pybind11::arg("prefix"),
+			pybind11::arg("fullEvery") = 10,
+			pybind11::arg("learnState") = false
+			)
+		.def("Save", &leabra::Checkpointer::Save)
+		.def("Wait", &leabra::Checkpointer::Wait)
+		.def_readonly("Seq", &leabra::Checkpointer::Seq)
+		.def_readonly("BaseSeq", &leabra::Checkpointer::BaseSeq)
+	;
+
+	pybind11::class_<leabra::PruneSchedule>(m, "PruneSchedule")
+		.def(pybind11::init<>())
+		.def_readwrite("On", &leabra::PruneSchedule::On)
+		.def_readwrite("Start", &leabra::PruneSchedule::Start)
+		.def_readwrite("Interval", &leabra::PruneSchedule::Interval)
+		.def_readwrite("Stop", &leabra::PruneSchedule::Stop)
+		.def_readwrite("Thr", &leabra::PruneSchedule::Thr)
+		.def_readwrite("Pct", &leabra::PruneSchedule::Pct)
+		.def_readwrite("Paths", &leabra::PruneSchedule::Paths)
+		.def_readonly("Last", &leabra::PruneSchedule::Last)
+		.def_readonly("Total", &leabra::PruneSchedule::Total)
+		.def("Due", &leabra::PruneSchedule::Due)
+		.def("Epoch", &leabra::PruneSchedule::Epoch)
+	;
+
 	pybind11::class_<leabra::Network>(m, "Network")
 		.def(pybind11::init<std::string, int>(),
 			pybind11::arg("name"),
@@ -513,5 +848,38 @@ void pybind_LeabraNet(pybind11::module_ &m) {
 		.def("ConnectLayers", &leabra::Network::ConnectLayers)
 		.def("BidirConnectLayers", &leabra::Network::BidirConnectLayers)
 		.def("LateralConnectLayer", &leabra::Network::LateralConnectLayer)
+		.def("CompileParams", pybind11::overload_cast<params::Sets&, std::string>(&leabra::Network::CompileParams),
+			pybind11::arg("pars"),
+			pybind11::arg("name") = "Base"
+			)
+		.def("QueueParam", &leabra::Network::QueueParam,
+			pybind11::arg("sel"),
+			pybind11::arg("path"),
+			pybind11::arg("value")
+			)
+		.def("MemoryReport", &leabra::Network::MemoryReport)
+		.def("Prune", &leabra::Network::Prune,
+			pybind11::arg("thr"),
+			pybind11::arg("pct") = 0,
+			pybind11::arg("paths") = std::vector<std::string>()
+			)
+		.def("Freeze", &leabra::Network::Freeze,
+			pybind11::arg("gscale") = false,
+			pybind11::arg("quant") = leabra::WtF32,
+			pybind11::arg("pathScale") = false
+			)
+		.def_readonly("Frozen", &leabra::Network::Frozen)
+		.def_readonly("StructGen", &leabra::Network::StructGen)
+		.def_readwrite("WtBalCheck", &leabra::Network::WtBalCheck)
+		.def_readonly("WtBalErrs", &leabra::Network::WtBalErrs)
+		.def("SaveCheckpoint", &leabra::Network::SaveCheckpoint,
+			pybind11::arg("fileName"),
+			pybind11::arg("learnState") = false
+			)
+		.def("LoadCheckpoint", &leabra::Network::LoadCheckpoint)
+		.def("SaveWeightsJSON", &leabra::Network::SaveWeightsJSON)
+		.def("OpenWeightsJSON", &leabra::Network::OpenWeightsJSON)
+		.def_readonly("BuildMemHWM", &leabra::Network::BuildMemHWM)
+		.def_readonly("InitWeightsMemHWM", &leabra::Network::InitWeightsMemHWM)
 	;
 }
@@ -2,12 +2,11 @@
 #include "bitflag.hpp"
 
 leabra::Neuron::Neuron()
-    :SubPool(0),Act(0),ActLrn(0),Ge(0),Gi(0),Gk(0),Inet(0),Vm(0),Targ(0),Ext(0),
+    :Flags(NeurFlags(0)),SubPool(0),Act(0),ActLrn(0),Ge(0),Gi(0),Gk(0),Inet(0),Vm(0),Targ(0),Ext(0),
     AvgSS(0),AvgS(0),AvgM(0),AvgL(0),AvgLLrn(0),AvgSLrn(0),ActQ0(0),ActQ1(0),
     ActQ2(0),ActQM(0),ActM(0),ActP(0),ActDif(0),ActDel(0),ActAvg(0),Noise(0),
     GiSyn(0),GiSelf(0),ActSent(0),GeRaw(0),GiRaw(0),GknaFast(0),GknaMed(0),
     GknaSlow(0),Spike(0),ISI(0),ISIAvg(0){
-    InitParamMaps();
 }
 
 bool leabra::Neuron::HasFlag(NeurFlags flag)
@@ -51,78 +50,41 @@ std::string leabra::Neuron::StyleName() {
     return "";
 }
 
-void leabra::Neuron::InitParamMaps() {
-    ParamNameMap["Act"] = (void*) &Act;
-    ParamNameMap["ActLrn"] = (void*) &ActLrn;
-    ParamNameMap["Ge"] = (void*) &Ge;
-    ParamNameMap["Gi"] = (void*) &Gi;
-    ParamNameMap["Gk"] = (void*) &Gk;
-    ParamNameMap["Inet"] = (void*) &Inet;
-    ParamNameMap["Vm"] = (void*) &Vm;
-    ParamNameMap["Targ"] = (void*) &Targ;
-    ParamNameMap["Ext"] = (void*) &Ext;
-    ParamNameMap["AvgSS"] = (void*) &AvgSS;
-    ParamNameMap["AvgS"] = (void*) &AvgS;
-    ParamNameMap["AvgM"] = (void*) &AvgM;
-    ParamNameMap["AvgL"] = (void*) &AvgL;
-    ParamNameMap["AvgLLrn"] = (void*) &AvgLLrn;
-    ParamNameMap["AvgSLrn"] = (void*) &AvgSLrn;
-    ParamNameMap["ActQ0"] = (void*) &ActQ0;
-    ParamNameMap["ActQ1"] = (void*) &ActQ1;
-    ParamNameMap["ActQ2"] = (void*) &ActQ2;
-    ParamNameMap["ActQM"] = (void*) &ActQM;
-    ParamNameMap["ActM"] = (void*) &ActM;
-    ParamNameMap["ActP"] = (void*) &ActP;
-    ParamNameMap["ActDif"] = (void*) &ActDif;
-    ParamNameMap["ActDel"] = (void*) &ActDel;
-    ParamNameMap["ActAvg"] = (void*) &ActAvg;
-    ParamNameMap["Noise"] = (void*) &Noise;
-    ParamNameMap["GiSyn"] = (void*) &GiSyn;
-    ParamNameMap["GiSelf"] = (void*) &GiSelf;
-    ParamNameMap["ActSent"] = (void*) &ActSent;
-    ParamNameMap["GeRaw"] = (void*) &GeRaw;
-    ParamNameMap["GiRaw"] = (void*) &GiRaw;
-    ParamNameMap["GknaFast"] = (void*) &GknaFast;
-    ParamNameMap["GknaMed"] = (void*) &GknaMed;
-    ParamNameMap["GknaSlow"] = (void*) &GknaSlow;
-    ParamNameMap["Spike"] = (void*) &Spike;
-    ParamNameMap["ISI"] = (void*) &ISI;
-    ParamNameMap["ISIAvg"] = (void*) &ISIAvg;
-
-    ParamTypeMap["Act"] = &typeid(float);
-    ParamTypeMap["ActLrn"] = &typeid(float);
-    ParamTypeMap["Ge"] = &typeid(float);
-    ParamTypeMap["Gi"] = &typeid(float);
-    ParamTypeMap["Gk"] = &typeid(float);
-    ParamTypeMap["Inet"] = &typeid(float);
-    ParamTypeMap["Vm"] = &typeid(float);
-    ParamTypeMap["Targ"] = &typeid(float);
-    ParamTypeMap["Ext"] = &typeid(float);
-    ParamTypeMap["AvgSS"] = &typeid(float);
-    ParamTypeMap["AvgS"] = &typeid(float);
-    ParamTypeMap["AvgM"] = &typeid(float);
-    ParamTypeMap["AvgL"] = &typeid(float);
-    ParamTypeMap["AvgLLrn"] = &typeid(float);
-    ParamTypeMap["AvgSLrn"] = &typeid(float);
-    ParamTypeMap["ActQ0"] = &typeid(float);
-    ParamTypeMap["ActQ1"] = &typeid(float);
-    ParamTypeMap["ActQ2"] = &typeid(float);
-    ParamTypeMap["ActQM"] = &typeid(float);
-    ParamTypeMap["ActM"] = &typeid(float);
-    ParamTypeMap["ActP"] = &typeid(float);
-    ParamTypeMap["ActDif"] = &typeid(float);
-    ParamTypeMap["ActDel"] = &typeid(float);
-    ParamTypeMap["ActAvg"] = &typeid(float);
-    ParamTypeMap["Noise"] = &typeid(float);
-    ParamTypeMap["GiSyn"] = &typeid(float);
-    ParamTypeMap["GiSelf"] = &typeid(float);
-    ParamTypeMap["ActSent"] = &typeid(float);
-    ParamTypeMap["GeRaw"] = &typeid(float);
-    ParamTypeMap["GiRaw"] = &typeid(float);
-    ParamTypeMap["GknaFast"] = &typeid(float);
-    ParamTypeMap["GknaMed"] = &typeid(float);
-    ParamTypeMap["GknaSlow"] = &typeid(float);
-    ParamTypeMap["Spike"] = &typeid(float);
-    ParamTypeMap["ISI"] = &typeid(float);
-    ParamTypeMap["ISIAvg"] = &typeid(float);
+void leabra::Neuron::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "Act", Act);
+    reg.Add(this, "ActLrn", ActLrn);
+    reg.Add(this, "Ge", Ge);
+    reg.Add(this, "Gi", Gi);
+    reg.Add(this, "Gk", Gk);
+    reg.Add(this, "Inet", Inet);
+    reg.Add(this, "Vm", Vm);
+    reg.Add(this, "Targ", Targ);
+    reg.Add(this, "Ext", Ext);
+    reg.Add(this, "AvgSS", AvgSS);
+    reg.Add(this, "AvgS", AvgS);
+    reg.Add(this, "AvgM", AvgM);
+    reg.Add(this, "AvgL", AvgL);
+    reg.Add(this, "AvgLLrn", AvgLLrn);
+    reg.Add(this, "AvgSLrn", AvgSLrn);
+    reg.Add(this, "ActQ0", ActQ0);
+    reg.Add(this, "ActQ1", ActQ1);
+    reg.Add(this, "ActQ2", ActQ2);
+    reg.Add(this, "ActQM", ActQM);
+    reg.Add(this, "ActM", ActM);
+    reg.Add(this, "ActP", ActP);
+    reg.Add(this, "ActDif", ActDif);
+    reg.Add(this, "ActDel", ActDel);
+    reg.Add(this, "ActAvg", ActAvg);
+    reg.Add(this, "Noise", Noise);
+    reg.Add(this, "GiSyn", GiSyn);
+    reg.Add(this, "GiSelf", GiSelf);
+    reg.Add(this, "ActSent", ActSent);
+    reg.Add(this, "GeRaw", GeRaw);
+    reg.Add(this, "GiRaw", GiRaw);
+    reg.Add(this, "GknaFast", GknaFast);
+    reg.Add(this, "GknaMed", GknaMed);
+    reg.Add(this, "GknaSlow", GknaSlow);
+    reg.Add(this, "Spike", Spike);
+    reg.Add(this, "ISI", ISI);
+    reg.Add(this, "ISIAvg", ISIAvg);
 }
@@ -3,14 +3,13 @@
 
 
 // C++ Constructor for params
-nxx1::Params::Params(float Thr, float Gain, float NVar, float VmActThr,
-                     float SigMult, float SigMultPow, float SigGain,
-                     float InterpRange, float GainCorRange, float GainCor):
+nxx1::Params::Params(Real Thr, Real Gain, Real NVar, Real VmActThr,
+                     Real SigMult, Real SigMultPow, Real SigGain,
+                     Real InterpRange, Real GainCorRange, Real GainCor):
     Thr(Thr), Gain(Gain), NVar(NVar), VmActThr(VmActThr), SigMult(SigMult),
     SigMultPow(SigMultPow), SigGain(SigGain), InterpRange(InterpRange),
     GainCorRange(GainCorRange), GainCor(GainCor){ // TODO: Initializer list is ugly... find cleaner way to do this
     Update(); // Initializes derived member variables
-    InitParamMaps();
 }
 
 void nxx1::Params::Defaults(){
@@ -37,18 +36,18 @@ void nxx1::Params::Update() {
 }
 
 // XX1 computes the basic x/(x+1) function
-float nxx1::Params::XX1(float x) {
+Real nxx1::Params::XX1(Real x) {
     return x / (x+1);
 }
 
 // XX1GainCor computes x/(x+1) with gain correction within GainCorRange to compensate for convolution effects
-float nxx1::Params::XX1GainCor(float x) {
-    float gainCorFact = (GainCorRange - (x / this->NVar)) / this->GainCorRange;
+Real nxx1::Params::XX1GainCor(Real x) {
+    Real gainCorFact = (GainCorRange - (x / this->NVar)) / this->GainCorRange;
     if (gainCorFact < 0) {
         return XX1(Gain * x);
     }
     else {
-        float newGain = Gain * (1 - GainCor * gainCorFact);
+        Real newGain = Gain * (1 - GainCor * gainCorFact);
         return XX1(newGain * x);
     }
 }
@@ -59,17 +58,17 @@ float nxx1::Params::XX1GainCor(float x) {
 // No need for a lookup table -- very reasonable approximation for standard range of parameters
 // (nvar = .01 or less -- higher values of nvar are less accurate with large gains,
 // but ok for lower gains)
-float nxx1::Params::NoisyXX1(float x)
+Real nxx1::Params::NoisyXX1(Real x)
 {
     if (x < 0){
-        float ex = - (x * SigGainNVar);
+        Real ex = - (x * SigGainNVar);
         if (ex > 50) {
             return 0;
         }
         return SigMultEff / (1 + std::exp(ex));
     }
     else if (x < InterpRange) {
-        float interp = 1 - ((InterpRange - x)/ InterpRange);
+        Real interp = 1 - ((InterpRange - x)/ InterpRange);
         return SigValAt0 + interp * InterpVal;
     }
     else {
@@ -79,12 +78,12 @@ float nxx1::Params::NoisyXX1(float x)
 
 // XX1GainCorGain computes x/(x+1) with gain correction within GainCorRange
 // to compensate for convolution effects -- using external gain factor
-float nxx1::Params::XX1GainCorGain(float x, float gain) {
-    float gainCorFact = (GainCorRange - (x / NVar)) / GainCorRange;
+Real nxx1::Params::XX1GainCorGain(Real x, Real gain) {
+    Real gainCorFact = (GainCorRange - (x / NVar)) / GainCorRange;
     if (gainCorFact < 0) {
         return XX1(gain * x);
     }
-    float newGain = gain * (1 - GainCor*gainCorFact);
+    Real newGain = gain * (1 - GainCor*gainCorFact);
     return XX1(newGain * x);
 }
 
@@ -93,20 +92,20 @@ float nxx1::Params::XX1GainCorGain(float x, float gain) {
 // No need for a lookup table -- very reasonable approximation for standard range of parameters
 // (nvar = .01 or less -- higher values of nvar are less accurate with large gains,
 // but ok for lower gains).  Using external gain factor.
-float nxx1::Params::NoisyXX1Gain(float x, float gain) {
+Real nxx1::Params::NoisyXX1Gain(Real x, Real gain) {
     if (x < InterpRange) {
-        float sigMultEffArg = SigMult * std::pow(gain * NVar, SigMultPow);
-        float sigValAt0Arg = 0.5 * sigMultEffArg;
+        Real sigMultEffArg = SigMult * std::pow(gain * NVar, SigMultPow);
+        Real sigValAt0Arg = 0.5 * sigMultEffArg;
 
         if (x < 0) {
-            float ex = -(x * SigGainNVar);
+            Real ex = -(x * SigGainNVar);
             if (ex > 50) {
                 return 0;
             }
             return sigMultEffArg / (1 + std::exp(ex));
         }
         else {
-            float interp = 1 - ((InterpRange - x) / InterpRange);
+            Real interp = 1 - ((InterpRange - x) / InterpRange);
             return sigValAt0Arg + interp*InterpVal;
         }
     }
@@ -127,34 +126,19 @@ std::string nxx1::Params::StyleName() {
     return "";
 }
 
-void nxx1::Params::InitParamMaps() {
-    ParamNameMap["Thr"] = (void*) &Thr;
-    ParamNameMap["Gain"] = (void*) &Gain;
-    ParamNameMap["NVar"] = (void*) &NVar;
-    ParamNameMap["VmActThr"] = (void*) &VmActThr;
-    ParamNameMap["SigMult"] = (void*) &SigMult;
-    ParamNameMap["SigMultPow"] = (void*) &SigMultPow;
-    ParamNameMap["SigGain"] = (void*) &SigGain;
-    ParamNameMap["InterpRange"] = (void*) &InterpRange;
-    ParamNameMap["GainCorRange"] = (void*) &GainCorRange;
-    ParamNameMap["GainCor"] = (void*) &GainCor;
-    ParamNameMap["SigGainNVar"] = (void*) &SigGainNVar;
-    ParamNameMap["SigMultEff"] = (void*) &SigMultEff;
-    ParamNameMap["SigValAt0"] = (void*) &SigValAt0;
-    ParamNameMap["InterpVal"] = (void*) &InterpVal;
-
-    ParamTypeMap["Thr"] = &typeid(float);
-    ParamTypeMap["Gain"] = &typeid(float);
-    ParamTypeMap["NVar"] = &typeid(float);
-    ParamTypeMap["VmActThr"] = &typeid(float);
-    ParamTypeMap["SigMult"] = &typeid(float);
-    ParamTypeMap["SigMultPow"] = &typeid(float);
-    ParamTypeMap["SigGain"] = &typeid(float);
-    ParamTypeMap["InterpRange"] = &typeid(float);
-    ParamTypeMap["GainCorRange"] = &typeid(float);
-    ParamTypeMap["GainCor"] = &typeid(float);
-    ParamTypeMap["SigGainNVar"] = &typeid(float);
-    ParamTypeMap["SigMultEff"] = &typeid(float);
-    ParamTypeMap["SigValAt0"] = &typeid(float);
-    ParamTypeMap["InterpVal"] = &typeid(float);
+void nxx1::Params::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "Thr", Thr);
+    reg.Add(this, "Gain", Gain);
+    reg.Add(this, "NVar", NVar);
+    reg.Add(this, "VmActThr", VmActThr);
+    reg.Add(this, "SigMult", SigMult);
+    reg.Add(this, "SigMultPow", SigMultPow);
+    reg.Add(this, "SigGain", SigGain);
+    reg.Add(this, "InterpRange", InterpRange);
+    reg.Add(this, "GainCorRange", GainCorRange);
+    reg.Add(this, "GainCor", GainCor);
+    reg.Add(this, "SigGainNVar", SigGainNVar);
+    reg.Add(this, "SigMultEff", SigMultEff);
+    reg.Add(this, "SigValAt0", SigValAt0);
+    reg.Add(this, "InterpVal", InterpVal);
 }
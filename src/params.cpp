@@ -2,6 +2,9 @@
 #include <stdexcept>
 #include <typeinfo>
 #include <iostream>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
 #include "strings.hpp"
 
 // PathAfterType returns the portion of a path string after the initial
@@ -289,7 +292,13 @@ bool params::Sel_::Apply(std::any obj, bool setMsg) {
     if (!TargetTypeMatch(obj) || !SelMatch(obj)) {
 		return false;//, nil
 	}
+	return ApplyTo(obj, setMsg);
+}
 
+// ApplyTo sets the Params and Hypers values on obj without checking the selector,
+// for callers that have already matched it (e.g., through a Network SelIndex).
+// Returns false if both failed to be set.
+bool params::Sel_::ApplyTo(std::any obj, bool setMsg) {
 	std::string errp = ParamsSet.Apply(obj, setMsg);
 	std::string errh = HyperSet.Apply(obj, setMsg);
 	if (errp != "" && errh != "") {
@@ -300,6 +309,24 @@ bool params::Sel_::Apply(std::any obj, bool setMsg) {
 	// return true;//, errp
 }
 
+// CompileTo appends the compiled ParamsSet writes for obj without checking the
+// selector, for callers that have already matched it -- see ApplyTo.
+// Returns false if none of them compiled.
+bool params::Sel_::CompileTo(StylerObject *obj, std::vector<ParamWrite> &writes) {
+    bool any = false;
+    for (auto& [path, value] : ParamsSet.params) {
+        ParamWrite pw;
+        std::string err = CompileWrite(obj, path, value, pw);
+        if (err != "") {
+            std::cerr << err << std::endl;
+            continue;
+        }
+        writes.push_back(pw);
+        any = true;
+    }
+    return any;
+}
+
 // TargetTypeMatch return true if target type applies to object
 bool params::Sel_::TargetTypeMatch(std::any obj) {
     std::string trg = ParamsSet.TargetType();
@@ -405,13 +432,14 @@ std::any params::FindParam(std::any val, std::string path) {
     }
 	std::vector<std::string> paths = strings::split(path, '.');
 	std::string fnm = paths[0];
-	if (npv.ParamNameMap.count(fnm)==0) {
+	void *fptr = npv.ParamPtr(fnm);
+	if (fptr == nullptr) {
 		std::string err = "params.FindParam: could not find Field named: "+ fnm +" in struct: "+ npv.StyleName() +" path: "+ path +"\n";
         std::cerr << err;
 		return val;
 	}
 
-    std::any newVal = npv.ParamNameMap[fnm];
+    std::any newVal = fptr;
 	if (paths.size() == 1) {
 		return newVal;
 	}
@@ -707,30 +735,99 @@ std::string params::Sets::ParamValue(std::string sheet, std::string sel, std::st
 //     InitParamMaps();
 // }
 
+// registries holds the ParamRegistry for each StylerObject type, built on first use.
+// Entries are never removed, so references handed out by ParamFields stay valid.
+static std::map<std::type_index, params::ParamRegistry> registries;
+static std::mutex registriesMu;
+
+// Bytes returns the heap memory held by the registry entries: each entry is a
+// red-black tree node (color + 3 links) holding the key / field pair, plus the
+// key's heap buffer when it is too long for the small-string buffer.
+size_t params::ParamRegistry::Bytes() {
+    size_t bytes = 0;
+    for (auto &kv: Fields) {
+        bytes += sizeof(int*) * 4 + sizeof(kv);
+        if (kv.first.capacity() >= sizeof(std::string) / 2) {
+            bytes += kv.first.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+// ParamRegistryBytes returns the memory held by all of the per-type param
+// registries built so far
+size_t params::ParamRegistryBytes() {
+    std::lock_guard<std::mutex> lock(registriesMu);
+    size_t bytes = 0;
+    for (auto &kv: registries) {
+        bytes += sizeof(int*) * 4 + sizeof(kv) + kv.second.Bytes();
+    }
+    return bytes;
+}
+
+// ParamFields returns the param registry for the actual type of this object,
+// calling InitParamMaps to build it the first time the type is seen.
+// Each thread keeps the registries it has looked up, so that only its first
+// lookup of each type takes the lock.
+// Must not be called from a constructor (the type is not yet complete).
+const params::ParamRegistry &params::StylerObject::ParamFields() {
+    thread_local std::unordered_map<std::type_index, const ParamRegistry*> seen;
+    std::type_index typ(typeid(*this));
+    auto sit = seen.find(typ);
+    if (sit != seen.end()) {
+        return *sit->second;
+    }
+    std::lock_guard<std::mutex> lock(registriesMu);
+    auto it = registries.find(typ);
+    if (it == registries.end()) {
+        it = registries.emplace(typ, ParamRegistry()).first;
+        InitParamMaps(it->second);
+    }
+    seen[typ] = &it->second;
+    return it->second;
+}
+
+void *params::StylerObject::ParamPtr(const std::string &name, const std::type_info **typ) {
+    const ParamRegistry &reg = ParamFields();
+    auto it = reg.Fields.find(name);
+    if (it == reg.Fields.end()) {
+        return nullptr;
+    }
+    if (typ != nullptr) {
+        *typ = it->second.Type;
+    }
+    return (void *)((char *)this + it->second.Offset);
+}
+
 std::string params::StylerObject::SetByName(std::string varName, std::string value) {
     std::string err = "";
-    if (ParamNameMap.size()==0 || ParamTypeMap.size()==0) {
-        throw std::runtime_error("ERROR: One or both param maps are not initialized properly.");
+    if (ParamFields().Fields.size()==0) {
+        throw std::runtime_error("ERROR: No params are registered for type " + StyleType() + ".");
     }
-    void *varPtr = ParamNameMap[varName];
-    if (ParamNameMap.count(varName) == 0) {
+    const std::type_info *varType = nullptr;
+    void *varPtr = ParamPtr(varName, &varType);
+    if (varPtr == nullptr) {
         err = "Error: variable named " + varName + " not found.";
         return err;
     }
-    if (ParamTypeMap[varName] == &typeid(int)) {
+    if (*varType == typeid(int)) {
         int val = std::stoi(value);
         int *ptr = (int *)varPtr;
         *ptr = val;
-    } else if (ParamTypeMap[varName] == &typeid(float)) {
+    } else if (*varType == typeid(float)) {
         float val = std::stof(value);
         float *ptr = (float *)varPtr;
         *ptr = val;
-    } else if (ParamTypeMap[varName] == &typeid(bool)) {
+    } else if (*varType == typeid(double)) {
+        double val = std::stod(value);
+        double *ptr = (double *)varPtr;
+        *ptr = val;
+    } else if (*varType == typeid(bool)) {
         bool val;
         std::istringstream(value) >> std::boolalpha >> val;
         bool *ptr = (bool *)varPtr;
         *ptr = val;
-    } else if (ParamTypeMap[varName] == &typeid(std::vector<int>)) {
+    } else if (*varType == typeid(std::vector<int>)) {
         value.pop_back(); // get rid of ']' character
         value.erase(value.begin()); // get rid of '[' character
         std::vector<std::string> vectorString = strings::split(value, ','); //TODO figure out how to handle optional spaces
@@ -740,7 +837,7 @@ std::string params::StylerObject::SetByName(std::string varName, std::string val
         for (std::string item: vectorString){
             vectorPtr->push_back(std::stoi(item)); // TODO figure out how to handle 
         }
-    } else if (ParamTypeMap[varName] == &typeid(std::vector<float>)) {
+    } else if (*varType == typeid(std::vector<float>)) {
         value.pop_back(); // get rid of ']' character
         value.erase(value.begin()); // get rid of '[' character
         std::vector<std::string> vectorString = strings::split(value, ','); //TODO figure out how to handle optional spaces
@@ -750,7 +847,7 @@ std::string params::StylerObject::SetByName(std::string varName, std::string val
         for (std::string item: vectorString){
             vectorPtr->push_back(std::stof(item)); // TODO figure out how to handle 
         }
-    } else if (ParamTypeMap[varName] == &typeid(std::vector<bool>)) {
+    } else if (*varType == typeid(std::vector<bool>)) {
         value.pop_back(); // get rid of ']' character
         value.erase(value.begin()); // get rid of '[' character
         std::vector<std::string> vectorString = strings::split(value, ','); //TODO figure out how to handle optional spaces
@@ -762,7 +859,7 @@ std::string params::StylerObject::SetByName(std::string varName, std::string val
             std::istringstream(item) >> std::boolalpha >> val;
             vectorPtr->push_back(val); // TODO figure out how to handle 
         }
-    // } else if (ParamTypeMap[varName] == &typeid(params::StylerObject)) {
+    // } else if (*varType == typeid(params::StylerObject)) {
         // TODO HANDLE THE CASE OF NESTED PARAMS?
         // ...maybe do nothing...
     } else {
@@ -777,26 +874,29 @@ std::string params::StylerObject::SetByName(std::string varName, std::string val
 
 float params::StylerObject::GetByName(std::string varName) {
     float var;
-    void *varPtr = ParamNameMap[varName];
-    if (ParamNameMap.count(varName) == 0) {
+    const std::type_info *varType = nullptr;
+    void *varPtr = ParamPtr(varName, &varType);
+    if (varPtr == nullptr) {
         throw std::invalid_argument("Error: variable named " + varName + " not found.");
     }
-    if (ParamTypeMap[varName] == &typeid(int)) {
+    if (*varType == typeid(int)) {
         // int val = std::stoi(value);
         int *ptr = (int *)varPtr;
         var = *ptr;
-    } else if (ParamTypeMap[varName] == &typeid(float)) {
+    } else if (*varType == typeid(float)) {
         // float val = std::stof(value);
         float *ptr = (float *)varPtr;
         // *ptr = val;
         var = *ptr;
-    } else if (ParamTypeMap[varName] == &typeid(bool)) {
+    } else if (*varType == typeid(double)) {
+        var = *(double *)varPtr;
+    } else if (*varType == typeid(bool)) {
         // bool val;
         // std::istringstream(value) >> std::boolalpha >> val;
         bool *ptr = (bool *)varPtr;
         // *ptr = val;
         var = *ptr;
-    // } else if (ParamTypeMap[varName] == &typeid(params::StylerObject)) {
+    // } else if (*varType == typeid(params::StylerObject)) {
         // TODO HANDLE THE CASE OF NESTED PARAMS?
         // ...maybe do nothing...
     } else {
@@ -804,7 +904,7 @@ float params::StylerObject::GetByName(std::string varName) {
         //     // TODO HANDLE THE CASE OF NESTED PARAMS?
         // // ...maybe do nothing...
         // }
-        throw std::invalid_argument("Error: type of variable named " + varName + " not handled. Type info: " + ParamTypeMap[varName]->name());
+        throw std::invalid_argument("Error: type of variable named " + varName + " not handled. Type info: " + varType->name());
     }
     return var;
 }
@@ -820,11 +920,12 @@ std::string params::StylerObject::SetByPath(std::string path, std::string value)
         return SetByName(name, value);
     } else {
         // paths.erase(paths.begin());
-        if (ParamNameMap.count(name)==0){
+        void *childPtr = ParamPtr(name);
+        if (childPtr == nullptr){
             throw std::runtime_error("ERROR: StylerObject " + this->StyleName() +
                 " of type " + this->StyleClass() + " does not have member " + name + "\n");
         }
-        StylerObject *child = (StylerObject*)ParamNameMap[name];
+        StylerObject *child = (StylerObject*)childPtr;
         paths.erase(paths.begin()); // this is some hacky sh*t...
         // TODO: Re-think the Styler Objects and make the syntax less confusing...
         return child->SetByPath(strings::join(paths,"."), value);
@@ -837,12 +938,65 @@ float params::StylerObject::GetByPath(std::string path) {
     if (paths.size() == 1) {
         return GetByName(name);
     } else {
-        StylerObject *child = (StylerObject*)ParamNameMap[paths[0]];
+        StylerObject *child = (StylerObject*)ParamPtr(paths[0]);
         paths.erase(paths.begin());
         return child->GetByPath(strings::join(paths,"."));
     }
 }
 
+// FieldByPath resolves a dot-separated param path, following the same rules as
+// SetByPath (a leading StyleType element is skipped at each level), to the address
+// of the field it names. The field type is returned in typ.
+// Returns nullptr if any element of the path is not found.
+void *params::StylerObject::FieldByPath(std::string path, const std::type_info **typ) {
+    std::vector<std::string> paths = strings::split(path, '.');
+    std::string &name = paths[0];
+    if (name == this->StyleType()) {
+        paths.erase(paths.begin());
+        name = paths[0];
+    }
+    if (paths.size() == 1) {
+        return ParamPtr(name, typ);
+    }
+    void *childPtr = ParamPtr(name);
+    if (childPtr == nullptr) {
+        return nullptr;
+    }
+    StylerObject *child = (StylerObject*)childPtr;
+    paths.erase(paths.begin());
+    return child->FieldByPath(strings::join(paths, "."), typ);
+}
+
+// CompileWrite resolves the param path on obj and parses value for the field type,
+// filling in pw so that the assignment can be replayed without any lookups.
+// Only float, double, int and bool fields can be compiled.
+// Returns an error message if the param cannot be compiled, else "".
+std::string params::CompileWrite(StylerObject *obj, std::string path, std::string value, ParamWrite &pw) {
+    const std::type_info *typ = nullptr;
+    pw.Ptr = obj->FieldByPath(path, &typ);
+    if (pw.Ptr == nullptr) {
+        return "Error: param path " + path + " not found on " + obj->StyleName() + ".";
+    }
+    if (*typ == typeid(float)) {
+        pw.Kind = FloatParam;
+        pw.Val.F = std::stof(value);
+    } else if (*typ == typeid(double)) {
+        pw.Kind = DoubleParam;
+        pw.Val.D = std::stod(value);
+    } else if (*typ == typeid(int)) {
+        pw.Kind = IntParam;
+        pw.Val.I = std::stoi(value);
+    } else if (*typ == typeid(bool)) {
+        pw.Kind = BoolParam;
+        bool val;
+        std::istringstream(value) >> std::boolalpha >> val;
+        pw.Val.B = val;
+    } else {
+        return "Error: type of param path " + path + " cannot be compiled. Type info: " + typ->name();
+    }
+    return "";
+}
+
 void *params::StylerObject::GetStyleObject() {
     return (void *)this;
 }
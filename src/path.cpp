@@ -1,4 +1,12 @@
 #include "path.hpp"
+#include "weights.hpp"
+#include "rand.hpp"
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+#include <cstring>
 
 
 std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *> paths::Full::Connect(tensor::Shape &send, tensor::Shape &recv, bool same){
@@ -29,6 +37,10 @@ std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *> paths::Full::Connec
     return std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *>(sendn, recvn, cons);
 }
 
+std::string paths::Full::Key() {
+    return "Full SelfCon=" + std::to_string(SelfCon);
+}
+
 // NewTensors returns the tensors used for Connect method, based on layer sizes
 std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *> paths::NewTensors(tensor::Shape &send, tensor::Shape &recv) {
     tensor::Int32 *sendn = new tensor::Int32(send);
@@ -44,6 +56,169 @@ void paths::GaussTopo::Defaults(){
     CtrMove = 1;
 }
 
+// Edge returns false if coordinate ci is outside of 0..max-1, unless wrap
+// is set, in which case it is wrapped around into that range.
+bool paths::Edge(int &ci, int max, bool wrap) {
+    if (ci >= 0 && ci < max) {
+        return true;
+    }
+    if (!wrap) {
+        return false;
+    }
+    ci = ((ci % max) + max) % max;
+    return true;
+}
+
+paths::PoolTile::PoolTile() {
+    Defaults();
+}
+
+void paths::PoolTile::Defaults() {
+    Recip = false;
+    Size.Set(4, 4);
+    Skip.Set(2, 2);
+    Start.Set(-1, -1);
+    Wrap = true;
+    TopoRange.Min = 0.8;
+    TopoRange.Max = 1;
+    GaussFull.Defaults();
+    GaussInPool.Defaults();
+    SigFull.Defaults();
+    SigInPool.Defaults();
+    GaussFull.On = true;
+    GaussInPool.On = true;
+    SigFull.On = false;
+    SigInPool.On = false;
+}
+
+// TilePools calls fun for each pair of sending and receiving pools connected
+// by the tiling, with the position off of the tiled pool in the receptive
+// field, fy * Size.X + fx. Receptive fields are over the sending pools,
+// or over the receiving pools if Recip. A pool that falls in a receptive
+// field more than once (wrapping around a small layer) is only passed
+// at its first position.
+void paths::PoolTile::TilePools(tensor::Shape &send, tensor::Shape &recv, std::function<void(int spi, int rpi, int off)> fun) {
+    tensor::Shape &rfsh = Recip ? send : recv; // pools that have receptive fields
+    tensor::Shape &tsh = Recip ? recv : send; // pools tiled by them
+    int rfNpY = 1, rfNpX = 1, tNpY = 1, tNpX = 1;
+    if (rfsh.NumDims() == 4) {
+        rfNpY = rfsh.DimSize(0);
+        rfNpX = rfsh.DimSize(1);
+    }
+    if (tsh.NumDims() == 4) {
+        tNpY = tsh.DimSize(0);
+        tNpX = tsh.DimSize(1);
+    }
+    std::vector<int> seen;
+    for (int rpy = 0; rpy < rfNpY; rpy++) {
+        for (int rpx = 0; rpx < rfNpX; rpx++) {
+            int rpi = rpy * rfNpX + rpx;
+            seen.clear();
+            for (int fy = 0; fy < Size.Y; fy++) {
+                for (int fx = 0; fx < Size.X; fx++) {
+                    int py = rpy * Skip.Y + Start.Y + fy;
+                    int px = rpx * Skip.X + Start.X + fx;
+                    if (!Edge(py, tNpY, Wrap) || !Edge(px, tNpX, Wrap)) {
+                        continue;
+                    }
+                    int tpi = py * tNpX + px;
+                    if (std::find(seen.begin(), seen.end(), tpi) != seen.end()) {
+                        continue;
+                    }
+                    seen.push_back(tpi);
+                    if (Recip) {
+                        fun(rpi, tpi, fy * Size.X + fx);
+                    } else {
+                        fun(tpi, rpi, fy * Size.X + fx);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Connect connects all the units of each pair of pools given by TilePools.
+std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *> paths::PoolTile::Connect(tensor::Shape &send, tensor::Shape &recv, bool same) {
+    auto [sendn, recvn, cons] = NewTensors(send, recv);
+    int sNtot = send.Len();
+    int sNu = send.NumDims() == 4 ? send.DimSize(2) * send.DimSize(3) : sNtot;
+    int rNu = recv.NumDims() == 4 ? recv.DimSize(2) * recv.DimSize(3) : recv.Len();
+    std::vector<int> &snv = sendn->Values;
+    std::vector<int> &rnv = recvn->Values;
+    std::vector<bool> &cbits = cons->Values;
+    TilePools(send, recv, [&](int spi, int rpi, int off) {
+        for (int rui = 0; rui < rNu; rui++) {
+            int ri = rpi * rNu + rui;
+            for (int sui = 0; sui < sNu; sui++) {
+                int si = spi * sNu + sui;
+                cbits[ri * sNtot + si] = true;
+                rnv[ri]++;
+                snv[si]++;
+            }
+        }
+    });
+    return std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *>(sendn, recvn, cons);
+}
+
+// Kernel returns the PoolKernel for sharing one set of weights among all
+// the receiving pools, for the connection indexes ci built from Connect.
+std::shared_ptr<paths::PoolKernel> paths::PoolTile::Kernel(tensor::Shape &send, tensor::Shape &recv, const ConnIndexes &ci) {
+    auto kn = std::make_shared<PoolKernel>();
+    int slen = send.Len();
+    kn->SNu = send.NumDims() == 4 ? send.DimSize(2) * send.DimSize(3) : slen;
+    kn->RNu = recv.NumDims() == 4 ? recv.DimSize(2) * recv.DimSize(3) : recv.Len();
+    kn->NOff = Size.X * Size.Y;
+    int sNp = slen / kn->SNu;
+    std::vector<std::vector<std::pair<int, int>>> spools(sNp);
+    TilePools(send, recv, [&](int spi, int rpi, int off) {
+        spools[spi].push_back({rpi, off});
+    });
+    kn->SPoolSt.resize(sNp);
+    kn->SPoolN.resize(sNp);
+    for (int spi = 0; spi < sNp; spi++) {
+        std::sort(spools[spi].begin(), spools[spi].end());
+        kn->SPoolSt[spi] = kn->RPool.size();
+        kn->SPoolN[spi] = spools[spi].size();
+        for (auto [rpi, off]: spools[spi]) {
+            kn->RPool.push_back(rpi);
+            kn->Off.push_back(off);
+        }
+    }
+
+    // sending connections are in recv unit order, so in RPool order
+    kn->SynIndex.resize(ci.SConIndex.size());
+    for (int si = 0; si < slen; si++) {
+        int spi = si / kn->SNu;
+        int sui = si % kn->SNu;
+        int pi = kn->SPoolSt[spi];
+        int ped = pi + kn->SPoolN[spi];
+        int st = ci.SConIndexSt[si];
+        for (int i = st; i < st + ci.SConN[si]; i++) {
+            int ri = ci.SConIndex[i];
+            while (pi < ped - 1 && kn->RPool[pi] != ri / kn->RNu) {
+                pi++;
+            }
+            kn->SynIndex[i] = (kn->Off[pi] * kn->SNu + sui) * kn->RNu + ri % kn->RNu;
+        }
+    }
+    return kn;
+}
+
+// Bytes returns the memory used by the kernel tables.
+size_t paths::PoolKernel::Bytes() const {
+    return (SPoolSt.capacity() + SPoolN.capacity() + RPool.capacity() + Off.capacity() + SynIndex.capacity()) * sizeof(int);
+}
+
+// Key covers the connectivity params: the topographic weight params
+// do not change which units are connected.
+std::string paths::PoolTile::Key() {
+    return "PoolTile Recip=" + std::to_string(Recip) +
+        " Size=" + std::to_string(Size.X) + "," + std::to_string(Size.Y) +
+        " Skip=" + std::to_string(Skip.X) + "," + std::to_string(Skip.Y) +
+        " Start=" + std::to_string(Start.X) + "," + std::to_string(Start.Y) +
+        " Wrap=" + std::to_string(Wrap);
+}
+
 bool paths::PoolTile::HasTopoWeights() {
     return GaussFull.On || GaussInPool.On || SigFull.On || SigInPool.On;
 }
@@ -78,86 +253,11 @@ void paths::PoolTile::TopoWeights(tensor::Shape &send, tensor::Shape &recv, tens
 // of recv layer (these are units over which topography is defined)
 // and remaing 2D is for sending layer size (2D = sender)
 void paths::PoolTile::TopoWeightsGauss2D(tensor::Shape &send, tensor::Shape &recv, tensor::Tensor<float> &wts) {
-    if (GaussFull.Sigma == 0) {
-		GaussFull.Defaults();
-	}
-	if (GaussInPool.Sigma == 0) {
-		GaussInPool.Defaults();
-	}
+	auto [rNuY, rNuX] = recvPoolSize(recv);
 	int sNuY = send.DimSize(0);
 	int sNuX = send.DimSize(1);
-	int rNuY = recv.DimSize(0); // ok if recv is 2D
-	int rNuX = recv.DimSize(1);
-	if (recv.NumDims() == 4) {
-		rNuY = recv.DimSize(2);
-		rNuX = recv.DimSize(3);
-	}
-	std::vector<int> wshp = {rNuY, rNuX, sNuY, sNuX};
-	wts.SetShape(wshp, {"rNuY", "rNuX", "szY", "szX"});
-
-	auto fsz = math::Vec2(float(sNuX-1), float(sNuY-1));    // full rf size
-	math::Vec2 hfsz = fsz.MulScalar(0.5);                   // half rf
-	float fsig = GaussFull.Sigma * hfsz.X;                  // full sigma
-	if (fsig <= 0) {
-		fsig = GaussFull.Sigma;
-	}
-
-	auto psz = math::Vec2(float(sNuX), float(sNuY)); // within-pool rf size
-	if (sNuX > 1) {
-		psz.X -= 1;
-	}
-	if (sNuY > 1) {
-		psz.Y -= 1;
-	}
-	math::Vec2 hpsz = psz.MulScalar(0.5);            // half rf
-	float psig = GaussInPool.Sigma * hpsz.X; // pool sigma
-	if (psig <= 0) {
-		psig = GaussInPool.Sigma;
-	}
-
-	auto rsz = math::Vec2(float(rNuX), float(rNuY)); // recv units-in-pool size
-	if (rNuX > 1) {
-		rsz.X -= 1;
-	}
-	if (rNuY > 1) {
-		rsz.Y -= 1;
-	}
-
-	auto hrsz = rsz.MulScalar(0.5);
-	for (int ruy = 0; ruy < rNuY; ruy++) {
-		for (int rux = 0; rux < rNuX; rux++) {
-			auto rpos = math::Vec2(float(rux), float(ruy)).Sub(hrsz).Div(hrsz); // -1..1 normalized r unit pos
-			math::Vec2 rfpos = rpos.MulScalar(GaussFull.CtrMove);
-			math::Vec2 rppos = rpos.MulScalar(GaussInPool.CtrMove);
-			math::Vec2 sfctr = rfpos.Mul(hfsz).Add(hfsz); // sending center for full
-			math::Vec2 spctr = rppos.Mul(hpsz).Add(hpsz); // sending center for within-pool
-			for (int suy = 0; suy < sNuY; suy++) {
-				for (int sux = 0; sux < sNuX; sux++) {
-					float fwt = 1;
-					if (GaussFull.On) {
-						auto sf = math::Vec2(float(sux), float(suy));
-						if (GaussFull.Wrap) {
-							sf.X = math::WrapMinDist(sf.X, fsz.X, sfctr.X);
-							sf.Y = math::WrapMinDist(sf.Y, fsz.Y, sfctr.Y);
-						}
-						fwt = math::GaussVecDistNoNorm(sf, sfctr, fsig);
-					}
-					float pwt = 1;
-					if (GaussInPool.On) {
-						auto sp = math::Vec2(float(sux), float(suy));
-						if (GaussInPool.Wrap) {
-							sp.X = math::WrapMinDist(sp.X, psz.X, spctr.X);
-							sp.Y = math::WrapMinDist(sp.Y, psz.Y, spctr.Y);
-						}
-						pwt = math::GaussVecDistNoNorm(sp, spctr, psig);
-					}
-					float wt = fwt * pwt;
-					float rwt = TopoRange.ProjValue(wt);
-					wts.Set({ruy, rux, suy, sux}, rwt);
-				}
-			}
-		}
-	}
+	wts.SetShape({rNuY, rNuX, sNuY, sNuX}, {"rNuY", "rNuX", "szY", "szX"});
+	topoWeights(1, 1, sNuY, sNuX, rNuY, rNuX, false, wts);
 }
 
 // TopoWeightsGauss4D sets values in given 6D tensor according to *Topo settings.
@@ -166,89 +266,11 @@ void paths::PoolTile::TopoWeightsGauss2D(tensor::Shape &send, tensor::Shape &rec
 // and remaing 4D is for receptive field Size by units within pool size for
 // sending layer.
 void paths::PoolTile::TopoWeightsGauss4D(tensor::Shape &send, tensor::Shape &recv, tensor::Tensor<float> &wts) {
-    if (GaussFull.Sigma == 0) {
-		GaussFull.Defaults();
-	}
-	if (GaussInPool.Sigma == 0) {
-		GaussInPool.Defaults();
-	}
+	auto [rNuY, rNuX] = recvPoolSize(recv);
 	int sNuY = send.DimSize(2);
 	int sNuX = send.DimSize(3);
-	int rNuY = recv.DimSize(0); // ok if recv is 2D
-	int rNuX = recv.DimSize(1);
-	if (recv.NumDims() == 4) {
-		rNuY = recv.DimSize(2);
-		rNuX = recv.DimSize(3);
-	}
-	std::vector<int> wshp = {rNuY, rNuX, Size.Y, Size.X, sNuY, sNuX};
-	wts.SetShape(wshp, {"rNuY", "rNuX", "szY", "szX", "sNuY", "sNuX"});
-
-	auto fsz = math::Vec2(float(Size.X*sNuX-1), float(Size.Y*sNuY-1)); // full rf size
-	math::Vec2 hfsz = fsz.MulScalar(0.5);                                               // half rf
-	float fsig = GaussFull.Sigma * hfsz.X;                                      // full sigma
-	if (fsig <= 0) {
-		fsig = GaussFull.Sigma;
-	}
-
-	auto psz = math::Vec2(float(sNuX), float(sNuY)); // within-pool rf size
-	if (sNuX > 1) {
-		psz.X -= 1;
-	}
-	if (sNuY > 1) {
-		psz.Y -=1;
-	}
-	math::Vec2 hpsz = psz.MulScalar(0.5);            // half rf
-	float psig = GaussInPool.Sigma * hpsz.X; // pool sigma
-	if (psig <= 0) {
-		psig = GaussInPool.Sigma;
-	}
-
-	auto rsz = math::Vec2(float(rNuX), float(rNuY)); // recv units-in-pool size
-	if (rNuX > 1) {
-		rsz.X -= 1;
-	}
-	if (rNuY > 1) {
-		rsz.Y -= 1;
-	}
-	math::Vec2 hrsz = rsz.MulScalar(0.5);
-	for (int ruy = 0; ruy < rNuY; ruy++) {
-		for (int rux = 0; rux < rNuX; rux++) {
-			auto rpos = math::Vec2(float(rux), float(ruy)).Sub(hrsz).Div(hrsz); // -1..1 normalized r unit pos
-			math::Vec2 rfpos = rpos.MulScalar(GaussFull.CtrMove);
-			math::Vec2 rppos = rpos.MulScalar(GaussInPool.CtrMove);
-			math::Vec2 sfctr = rfpos.Mul(hfsz).Add(hfsz); // sending center for full
-			math::Vec2 spctr = rppos.Mul(hpsz).Add(hpsz); // sending center for within-pool
-			for (int fy = 0; fy < Size.Y; fy++) {
-				for (int fx = 0; fx < Size.X; fx++) {
-					for (int suy = 0; suy < sNuY; suy++) {
-						for (int sux = 0; sux < sNuX; sux++) {
-							float fwt = 1;
-							if (GaussFull.On) {
-								auto sf = math::Vec2(float(fx*sNuX+sux), float(fy*sNuY+suy));
-								if (GaussFull.Wrap) {
-									sf.X = math::WrapMinDist(sf.X, fsz.X, sfctr.X);
-									sf.Y = math::WrapMinDist(sf.Y, fsz.Y, sfctr.Y);
-								}
-								fwt = math::GaussVecDistNoNorm(sf, sfctr, fsig);
-							}
-							float pwt = float(1);
-							if (GaussInPool.On) {
-								auto sp = math::Vec2(float(sux), float(suy));
-								if (GaussInPool.Wrap) {
-									sp.X = math::WrapMinDist(sp.X, psz.X, spctr.X);
-									sp.Y = math::WrapMinDist(sp.Y, psz.Y, spctr.Y);
-								}
-								pwt = math::GaussVecDistNoNorm(sp, spctr, psig);
-							}
-							float wt = fwt * pwt;
-							float rwt = TopoRange.ProjValue(wt);
-							wts.Set({ruy, rux, fy, fx, suy, sux}, rwt);
-						}
-					}
-				}
-			}
-		}
-	}
+	wts.SetShape({rNuY, rNuX, Size.Y, Size.X, sNuY, sNuX}, {"rNuY", "rNuX", "szY", "szX", "sNuY", "sNuX"});
+	topoWeights(Size.Y, Size.X, sNuY, sNuX, rNuY, rNuX, false, wts);
 }
 
 // TopoWeightsSigmoid2D sets values in given 4D tensor according to Topo settings.
@@ -256,88 +278,11 @@ void paths::PoolTile::TopoWeightsGauss4D(tensor::Shape &send, tensor::Shape &rec
 // of recv layer (these are units over which topography is defined)
 // and remaing 2D is for sending layer (2D = sender).
 void paths::PoolTile::TopoWeightsSigmoid2D(tensor::Shape &send, tensor::Shape &recv, tensor::Tensor<float> &wts) {
-    if (SigFull.Gain == 0) {
-		SigFull.Defaults();
-	}
-	if (SigInPool.Gain == 0) {
-		SigInPool.Defaults();
-	}
+	auto [rNuY, rNuX] = recvPoolSize(recv);
 	int sNuY = send.DimSize(0);
 	int sNuX = send.DimSize(1);
-	int rNuY = recv.DimSize(0); // ok if recv is 2D
-	int rNuX = recv.DimSize(1);
-	if (recv.NumDims() == 4) {
-		rNuY = recv.DimSize(2);
-		rNuX = recv.DimSize(3);
-	}
-	std::vector<int> wshp = {rNuY, rNuX, sNuY, sNuX};
-	wts.SetShape(wshp, {"rNuY", "rNuX", "sNuY", "sNuX"});
-
-	auto fsz = math::Vec2(float(sNuX-1), float(sNuY-1)); // full rf size
-	math::Vec2 hfsz = fsz.MulScalar(0.5);                           // half rf
-	float fgain = SigFull.Gain * hfsz.X;                    // full gain
-
-	auto psz = math::Vec2(float(sNuX), float(sNuY)); // within-pool rf size
-	if (sNuX > 1) {
-		psz.X -= 1;
-	}
-	if (sNuY > 1) {
-		psz.Y -= 1;
-	}
-	math::Vec2 hpsz = psz.MulScalar(0.5);          // half rf
-	float pgain = SigInPool.Gain * hpsz.X; // pool sigma
-
-	auto rsz = math::Vec2(float(rNuX), float(rNuY)); // recv units-in-pool size
-	if (rNuX > 1) {
-		rsz.X -= 1;
-	}
-	if (rNuY > 1) {
-		rsz.Y -= 1;
-	}
-	math::Vec2 hrsz = rsz.MulScalar(0.5);
-	for (int ruy = 0; ruy < rNuY; ruy++) {
-		for (int rux = 0; rux < rNuX; rux++) {
-			math::Vec2 rpos = math::Vec2(float(rux), float(ruy)).Div(hrsz); // 0..2 normalized r unit pos
-			math::Vec2 sgn = math::Vec2(1, 1);
-			math::Vec2 rfpos = rpos.SubScalar(0.5).MulScalar(SigFull.CtrMove).AddScalar(0.5);
-			math::Vec2 rppos = rpos.SubScalar(0.5).MulScalar(SigInPool.CtrMove).AddScalar(0.5);
-			if (rpos.X >= 1) { // flip direction half-way through
-				sgn.X = -1;
-				rpos.X = -rpos.X + 1;
-				rfpos.X = (rpos.X+0.5)*SigFull.CtrMove - 0.5;
-				rppos.X = (rpos.X+0.5)*SigInPool.CtrMove - 0.5;
-			}
-			if (rpos.Y >= 1) {
-				sgn.Y = -1;
-				rpos.Y = -rpos.Y + 1;
-				rfpos.Y = (rpos.Y+0.5)*SigFull.CtrMove - 0.5;
-				rfpos.Y = (rpos.Y+0.5)*SigInPool.CtrMove - 0.5;
-			}
-			math::Vec2 sfctr = rfpos.Mul(fsz); // sending center for full
-			math::Vec2 spctr = rppos.Mul(psz); // sending center for within-pool
-			for (int suy = 0; suy < sNuY; suy++) {
-				for (int sux = 0; sux < sNuX; sux++) {
-					float fwt = 1;
-					if (SigFull.On) {
-						auto sf = math::Vec2(float(sux), float(suy));
-						float sigx = math::Logistic(sgn.X*sf.X, fgain, sfctr.X);
-						float sigy = math::Logistic(sgn.Y*sf.Y, fgain, sfctr.Y);
-						fwt = sigx * sigy;
-					}
-					float pwt = 1;
-					if (SigInPool.On) {
-						math::Vec2 sp = math::Vec2(float(sux), float(suy));
-						float sigx = math::Logistic(sgn.X*sp.X, pgain, spctr.X);
-						float sigy = math::Logistic(sgn.Y*sp.Y, pgain, spctr.Y);
-						pwt = sigx * sigy;
-					}
-					float wt = fwt * pwt;
-					float rwt = TopoRange.ProjValue(wt);
-					wts.Set({ruy, rux, suy, sux}, rwt);
-				}
-			}
-		}
-	}
+	wts.SetShape({rNuY, rNuX, sNuY, sNuX}, {"rNuY", "rNuX", "sNuY", "sNuX"});
+	topoWeights(1, 1, sNuY, sNuX, rNuY, rNuX, true, wts);
 }
 
 // TopoWeightsSigmoid4D sets values in given 6D tensor according to Topo settings.
@@ -346,87 +291,78 @@ void paths::PoolTile::TopoWeightsSigmoid2D(tensor::Shape &send, tensor::Shape &r
 // and remaing 2D is for receptive field Size by units within pool size for
 // sending layer.
 void paths::PoolTile::TopoWeightsSigmoid4D(tensor::Shape &send, tensor::Shape &recv, tensor::Tensor<float> &wts) {
-    if (SigFull.Gain == 0) {
-		SigFull.Defaults();
-	}
-	if (SigInPool.Gain == 0) {
-		SigInPool.Defaults();
-	}
+	auto [rNuY, rNuX] = recvPoolSize(recv);
 	int sNuY = send.DimSize(2);
 	int sNuX = send.DimSize(3);
-	int rNuY = recv.DimSize(0); // ok if recv is 2D
-	int rNuX = recv.DimSize(1);
+	wts.SetShape({rNuY, rNuX, Size.Y, Size.X, sNuY, sNuX}, {"rNuY", "rNuX", "szY", "szX", "sNuY", "sNuX"});
+	topoWeights(Size.Y, Size.X, sNuY, sNuX, rNuY, rNuX, true, wts);
+}
+
+// recvPoolSize returns the Y, X size of the recv units over which
+// topography is defined: the units in each pool, or the layer if 2D.
+std::tuple<int, int> paths::PoolTile::recvPoolSize(tensor::Shape &recv) {
 	if (recv.NumDims() == 4) {
-		rNuY = recv.DimSize(2);
-		rNuX = recv.DimSize(3);
+		return {recv.DimSize(2), recv.DimSize(3)};
 	}
-	std::vector<int> wshp = {rNuY, rNuX, Size.Y, Size.X, sNuY, sNuX};
-	wts.SetShape(wshp, {"rNuY", "rNuX", "szY", "szX", "sNuY", "sNuX"});
-
-	auto fsz = math::Vec2(float(Size.X*sNuX-1), float(Size.Y*sNuY-1)); // full rf size
-	math::Vec2 hfsz = fsz.MulScalar(0.5);                                               // half rf
-	float fgain = SigFull.Gain * hfsz.X;                                        // full gain
+	return {recv.DimSize(0), recv.DimSize(1)};
+}
 
-	auto psz = math::Vec2(float(sNuX), float(sNuY)); // within-pool rf size
-	if (sNuX > 1) {
-		psz.X -= 1;
+// topoWeights fills wts, shaped {rNuY, rNuX, nfY, nfX, sNuY, sNuX}, with the
+// Gaussian or, if sig, sigmoidal topographic weights for a receptive field
+// of nfY x nfX sending pools of sNuY x sNuX units. Both are products of
+// a factor along Y and one along X, so these are computed once per recv
+// unit row or column (topoAxis), and each run of weights along sux is a
+// scaled product of two contiguous arrays.
+void paths::PoolTile::topoWeights(int nfY, int nfX, int sNuY, int sNuX, int rNuY, int rNuX, bool sig, tensor::Tensor<float> &wts) {
+	if (GaussFull.Sigma == 0) {
+		GaussFull.Defaults();
+	}
+	if (GaussInPool.Sigma == 0) {
+		GaussInPool.Defaults();
 	}
-	if (sNuY > 1) {
-		psz.Y -= 1;
+	if (SigFull.Gain == 0) {
+		SigFull.Defaults();
 	}
-	math::Vec2 hpsz = psz.MulScalar(0.5);          // half rf
-	float pgain = SigInPool.Gain * hpsz.X; // pool sigma
-
-	auto rsz = math::Vec2(float(rNuX), float(rNuY)); // recv units-in-pool size
-	if (rNuX > 1) {
-		rsz.X -= 1;
+	if (SigInPool.Gain == 0) {
+		SigInPool.Defaults();
 	}
-	if (rNuY > 1) {
-		rsz.Y -= 1;
+	// sigma and gain are relative to the X sizes, for both axes
+	float hfszX = 0.5f * float(nfX * sNuX - 1);
+	float hpszX = 0.5f * float(sNuX > 1 ? sNuX - 1 : sNuX);
+	float fpar, ppar;
+	if (sig) {
+		fpar = SigFull.Gain * hfszX;
+		ppar = SigInPool.Gain * hpszX;
+	} else {
+		fpar = GaussFull.Sigma * hfszX;
+		if (fpar <= 0) {
+			fpar = GaussFull.Sigma;
+		}
+		ppar = GaussInPool.Sigma * hpszX;
+		if (ppar <= 0) {
+			ppar = GaussInPool.Sigma;
+		}
 	}
-	auto hrsz = rsz.MulScalar(0.5);
+	std::vector<float> fy, fx;
+	topoAxis(rNuY, nfY, sNuY, sig, fpar, ppar, fy);
+	topoAxis(rNuX, nfX, sNuX, sig, fpar, ppar, fx);
+
+	float mn = TopoRange.Min;
+	float rng = TopoRange.Range();
+	int nY = nfY * sNuY;
+	int nX = nfX * sNuX;
+	float *out = wts.Values.data();
 	for (int ruy = 0; ruy < rNuY; ruy++) {
 		for (int rux = 0; rux < rNuX; rux++) {
-			auto rpos = math::Vec2(float(rux), float(ruy)).Div(hrsz); // 0..2 normalized r unit pos
-			auto sgn = math::Vec2(1, 1);
-			math::Vec2 rfpos = rpos.SubScalar(0.5).MulScalar(SigFull.CtrMove).AddScalar(0.5);
-			math::Vec2 rppos = rpos.SubScalar(0.5).MulScalar(SigInPool.CtrMove).AddScalar(0.5);
-			if (rpos.X >= 1) { // flip direction half-way through
-				sgn.X = -1;
-				rpos.X = -rpos.X + 1;
-				rfpos.X = (rpos.X+0.5)*SigFull.CtrMove - 0.5;
-				rppos.X = (rpos.X+0.5)*SigInPool.CtrMove - 0.5;
-			}
-			if (rpos.Y >= 1) {
-				sgn.Y = -1;
-				rpos.Y = -rpos.Y + 1;
-				rfpos.Y = (rpos.Y+0.5)*SigFull.CtrMove - 0.5;
-				rfpos.Y = (rpos.Y+0.5)*SigInPool.CtrMove - 0.5;
-			}
-			math::Vec2 sfctr = rfpos.Mul(fsz); // sending center for full
-			math::Vec2 spctr = rppos.Mul(psz); // sending center for within-pool
-			for (int fy = 0; fy < Size.Y; fy++) {
-				for (int fx = 0; fx < Size.X; fx++) {
+			for (int py = 0; py < nfY; py++) {
+				for (int px = 0; px < nfX; px++) {
+					const float *cx = fx.data() + rux * nX + px * sNuX;
 					for (int suy = 0; suy < sNuY; suy++) {
+						float cy = rng * fy[ruy * nY + py * sNuY + suy];
 						for (int sux = 0; sux < sNuX; sux++) {
-							float fwt = 1;
-							if (SigFull.On) {
-								auto sf = math::Vec2(float(fx*sNuX+sux), float(fy*sNuY+suy));
-								float sigx = math::Logistic(sgn.X*sf.X, fgain, sfctr.X);
-								float sigy = math::Logistic(sgn.Y*sf.Y, fgain, sfctr.Y);
-								fwt = sigx * sigy;
-							}
-							float pwt = 1;
-							if (SigInPool.On) {
-								auto sp = math::Vec2(float(sux), float(suy));
-								float sigx = math::Logistic(sgn.X*sp.X, pgain, spctr.X);
-								float sigy = math::Logistic(sgn.Y*sp.Y, pgain, spctr.Y);
-								pwt = sigx * sigy;
-							}
-							float wt = fwt * pwt;
-							float rwt = TopoRange.ProjValue(wt);
-							wts.Set({ruy, rux, fy, fx, suy, sux}, rwt);
+							out[sux] = mn + cy * cx[sux];
 						}
+						out += sNuX;
 					}
 				}
 			}
@@ -434,11 +370,789 @@ void paths::PoolTile::TopoWeightsSigmoid4D(tensor::Shape &send, tensor::Shape &r
 	}
 }
 
+// topoAxis computes the factors of the topographic weights along one axis,
+// for rn recv units and a receptive field of nf sending pools of sn units:
+// f[ru * nf * sn + i] is the full field factor at position i times the
+// within-pool factor at i % sn, for recv unit ru. fpar and ppar are the
+// full and within-pool Gaussian sigma, or sigmoid gain if sig.
+void paths::PoolTile::topoAxis(int rn, int nf, int sn, bool sig, float fpar, float ppar, std::vector<float> &f) {
+	int n = nf * sn;
+	float fsz = float(n - 1);                      // full rf size
+	float hfsz = 0.5f * fsz;                       // half rf
+	float psz = float(sn > 1 ? sn - 1 : sn);       // within-pool rf size
+	float hpsz = 0.5f * psz;
+	float hrsz = 0.5f * float(rn > 1 ? rn - 1 : rn); // half recv units-in-pool size
+	f.resize(rn * n);
+	for (int ru = 0; ru < rn; ru++) {
+		float *fr = f.data() + ru * n;
+		if (sig) {
+			float rpos = float(ru) / hrsz; // 0..2 normalized r unit pos
+			float sgn = 1;
+			float rfpos = (rpos - 0.5f) * SigFull.CtrMove + 0.5f;
+			float rppos = (rpos - 0.5f) * SigInPool.CtrMove + 0.5f;
+			if (rpos >= 1) { // flip direction half-way through
+				sgn = -1;
+				rpos = -rpos + 1;
+				rfpos = (rpos + 0.5f) * SigFull.CtrMove - 0.5f;
+				rppos = (rpos + 0.5f) * SigInPool.CtrMove - 0.5f;
+			}
+			float sfctr = rfpos * fsz; // sending center for full
+			float spctr = rppos * psz; // sending center for within-pool
+			for (int i = 0; i < n; i++) {
+				float fwt = SigFull.On ? math::Logistic(sgn * float(i), fpar, sfctr) : 1;
+				float pwt = SigInPool.On ? math::Logistic(sgn * float(i % sn), ppar, spctr) : 1;
+				fr[i] = fwt * pwt;
+			}
+			continue;
+		}
+		float rpos = (float(ru) - hrsz) / hrsz; // -1..1 normalized r unit pos
+		float sfctr = rpos * GaussFull.CtrMove * hfsz + hfsz;
+		float spctr = rpos * GaussInPool.CtrMove * hpsz + hpsz;
+		for (int i = 0; i < n; i++) {
+			float fwt = 1;
+			if (GaussFull.On) {
+				float sf = float(i);
+				if (GaussFull.Wrap) {
+					sf = math::WrapMinDist(sf, fsz, sfctr);
+				}
+				fwt = std::exp(-0.5f * (sf - sfctr) * (sf - sfctr) / (fpar * fpar));
+			}
+			float pwt = 1;
+			if (GaussInPool.On) {
+				float sp = float(i % sn);
+				if (GaussInPool.Wrap) {
+					sp = math::WrapMinDist(sp, psz, spctr);
+				}
+				pwt = std::exp(-0.5f * (sp - spctr) * (sp - spctr) / (ppar * ppar));
+			}
+			fr[i] = fwt * pwt;
+		}
+	}
+}
+
+// TopoKey returns the params that the topographic weights of TopoWeights
+// depend on, for TopoCache.
+std::string paths::PoolTile::TopoKey() {
+	std::string k = "PoolTile Size=" + std::to_string(Size.X) + "," + std::to_string(Size.Y);
+	auto add = [&k](const char *nm, float v) {
+		k += nm;
+		weights::AppendFloat(k, v);
+	};
+	for (GaussTopo *gt: {&GaussFull, &GaussInPool}) {
+		k += " Gauss=" + std::to_string(gt->On) + "," + std::to_string(gt->Wrap);
+		add(",", gt->Sigma);
+		add(",", gt->CtrMove);
+	}
+	for (SigmoidTopo *st: {&SigFull, &SigInPool}) {
+		k += " Sig=" + std::to_string(st->On);
+		add(",", st->Gain);
+		add(",", st->CtrMove);
+	}
+	add(" Range=", TopoRange.Min);
+	add(",", TopoRange.Max);
+	return k;
+}
+
+paths::TopoCache paths::DefaultTopoCache;
+
+// Get returns the topographic weights of pt.TopoWeights for layers of given
+// shapes, computing them only the first time for each TopoKey and shapes.
+std::shared_ptr<const tensor::Tensor<float>> paths::TopoCache::Get(PoolTile &pt, tensor::Shape &send, tensor::Shape &recv) {
+	std::string key = pt.TopoKey() + " Send=";
+	for (int sz: send.Sizes) {
+		key += std::to_string(sz) + ",";
+	}
+	key += " Recv=";
+	for (int sz: recv.Sizes) {
+		key += std::to_string(sz) + ",";
+	}
+	if (On) {
+		std::lock_guard<std::mutex> lock(Mu);
+		auto it = Wts.find(key);
+		if (it != Wts.end()) {
+			Hits++;
+			return it->second;
+		}
+	}
+	std::vector<int> shp;
+	auto wts = std::make_shared<tensor::Tensor<float>>(shp);
+	pt.TopoWeights(send, recv, *wts);
+	if (!On) {
+		return wts;
+	}
+	std::lock_guard<std::mutex> lock(Mu);
+	Misses++;
+	return Wts.emplace(key, wts).first->second;
+}
+
+// Clear removes all of the cached weights and resets the counts.
+void paths::TopoCache::Clear() {
+	std::lock_guard<std::mutex> lock(Mu);
+	Wts.clear();
+	Hits = 0;
+	Misses = 0;
+}
+
 void paths::SigmoidTopo::Defaults() {
     Gain = 0.05;
     CtrMove = 0.5;
 }
 
+// ConnectUnitCons implements Connect for a pattern that gives its
+// connectivity with UnitCons, by filling the tables from it.
+std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *> paths::ConnectUnitCons(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same) {
+    auto [sendn, recvn, cons] = NewTensors(send, recv);
+    bool bySend = pat.UnitConsType() == SendUnitCons;
+    int slen = send.Len();
+    int nu = bySend ? slen : recv.Len();
+    std::vector<int> ucons;
+    for (int ui = 0; ui < nu; ui++) {
+        pat.UnitCons(send, recv, same, ui, ucons);
+        for (int oi: ucons) {
+            int ri = bySend ? oi : ui;
+            int si = bySend ? ui : oi;
+            cons->Values[ri * slen + si] = true;
+            recvn->Values[ri]++;
+            sendn->Values[si]++;
+        }
+    }
+    return std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *>(sendn, recvn, cons);
+}
+
+paths::Circle::Circle() {
+    Defaults();
+}
+
+void paths::Circle::Defaults() {
+    Radius = 8;
+    Start.Set(0, 0);
+    Scale.X = 1;
+    Scale.Y = 1;
+    AutoScale = false;
+    Wrap = true;
+    TopoWeights = false;
+    Sigma = 0.5;
+    MaxWt = 1;
+    SelfCon = false;
+}
+
+std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *> paths::Circle::Connect(tensor::Shape &send, tensor::Shape &recv, bool same) {
+    return ConnectUnitCons(*this, send, recv, same);
+}
+
+// SendScale returns the scaling from receiving unit position to the
+// sending center: Scale, or the ratio of the layer sizes if AutoScale.
+math::Vector2 paths::Circle::SendScale(tensor::Shape &send, tensor::Shape &recv) {
+    if (!AutoScale) {
+        return Scale;
+    }
+    auto [sNy, sNx, sre, sce] = tensor::Projection2DShape(send, false);
+    auto [rNy, rNx, rre, rce] = tensor::Projection2DShape(recv, false);
+    math::Vector2 sc;
+    sc.X = float(sNx);
+    sc.Y = float(sNy);
+    if (Start.X >= 0 && Start.Y >= 0) {
+        sc.X -= float(2 * Start.X);
+        sc.Y -= float(2 * Start.Y);
+    }
+    sc.X /= float(rNx);
+    sc.Y /= float(rNy);
+    return sc;
+}
+
+// UnitCons gives the sending units within Radius of the sending center of
+// receiving unit ri, only visiting the sending rows and columns that can
+// be within it.
+void paths::Circle::UnitCons(tensor::Shape &send, tensor::Shape &recv, bool same, int ri, std::vector<int> &cons) {
+    auto [sNy, sNx, sre, sce] = tensor::Projection2DShape(send, false);
+    auto [ry, rx] = tensor::Projection2DCoords(recv, false, ri);
+    math::Vector2 sc = SendScale(send, recv);
+    math::Vector2 sctr;
+    sctr.X = float(rx) * sc.X + float(Start.X);
+    sctr.Y = float(ry) * sc.Y + float(Start.Y);
+    cons.clear();
+    // candidate rows or cols: all of them, or those around the center,
+    // which are distinct when wrapped
+    auto span = [this](float ctr, int n, int &st, int &ed) {
+        int w = 2 * Radius + 3;
+        st = int(std::floor(ctr)) - Radius - 1;
+        ed = st + w;
+        if (w >= n) {
+            st = 0;
+            ed = n;
+        } else if (!Wrap) {
+            st = std::max(st, 0);
+            ed = std::min(ed, n);
+        }
+    };
+    int yst, yed, xst, xed;
+    span(sctr.Y, sNy, yst, yed);
+    span(sctr.X, sNx, xst, xed);
+    for (int py = yst; py < yed; py++) {
+        int sy = py;
+        Edge(sy, sNy, true);
+        for (int px = xst; px < xed; px++) {
+            int sx = px;
+            Edge(sx, sNx, true);
+            math::Vector2 sp;
+            sp.X = float(sx);
+            sp.Y = float(sy);
+            if (Wrap) {
+                sp.X = math::WrapMinDist(sp.X, float(sNx), sctr.X);
+                sp.Y = math::WrapMinDist(sp.Y, float(sNy), sctr.Y);
+            }
+            int d = int(std::round(std::sqrt(sp.DistanceToSquared(sctr))));
+            if (d > Radius) {
+                continue;
+            }
+            int si = tensor::Projection2DIndex(send, false, sy, sx);
+            if (!SelfCon && same && ri == si) {
+                continue;
+            }
+            cons.push_back(si);
+        }
+    }
+    std::sort(cons.begin(), cons.end());
+}
+
+// GaussWts returns gaussian weight value for given unit indexes in
+// given send and recv layers according to Gaussian Sigma and MaxWt.
+// Can be used for a Path.SetScalesFunc or SetWtsFunc
+float paths::Circle::GaussWts(int si, int ri, tensor::Shape &send, tensor::Shape &recv) {
+    auto [sNy, sNx, sre, sce] = tensor::Projection2DShape(send, false);
+    auto [ry, rx] = tensor::Projection2DCoords(recv, false, ri);
+    auto [sy, sx] = tensor::Projection2DCoords(send, false, si);
+    math::Vector2 sc = SendScale(send, recv);
+    math::Vector2 sctr;
+    sctr.X = float(rx) * sc.X + float(Start.X);
+    sctr.Y = float(ry) * sc.Y + float(Start.Y);
+    math::Vector2 sp;
+    sp.X = float(sx);
+    sp.Y = float(sy);
+    if (Wrap) {
+        sp.X = math::WrapMinDist(sp.X, float(sNx), sctr.X);
+        sp.Y = math::WrapMinDist(sp.Y, float(sNy), sctr.Y);
+    }
+    return MaxWt * math::GaussVecDistNoNorm(sp, sctr, float(Radius) * Sigma);
+}
+
+// Key covers the connectivity params: the topographic weight params
+// do not change which units are connected.
+std::string paths::Circle::Key() {
+    std::string k = "Circle Radius=" + std::to_string(Radius) +
+        " Start=" + std::to_string(Start.X) + "," + std::to_string(Start.Y) + " Scale=";
+    weights::AppendFloat(k, Scale.X);
+    k += ",";
+    weights::AppendFloat(k, Scale.Y);
+    return k + " AutoScale=" + std::to_string(AutoScale) + " Wrap=" + std::to_string(Wrap) +
+        " SelfCon=" + std::to_string(SelfCon);
+}
+
+paths::UniformRand::UniformRand() {
+    Defaults();
+}
+
+void paths::UniformRand::Defaults() {
+    PCon = 0.5;
+    SelfCon = false;
+    Recip = false;
+    RandSeed = 1;
+}
+
+std::tuple<tensor::Int32 *, tensor::Int32 *, tensor::Bits *> paths::UniformRand::Connect(tensor::Shape &send, tensor::Shape &recv, bool same) {
+    return ConnectUnitCons(*this, send, recv, same);
+}
+
+// UnitCons chooses the sending units of receiving unit ui, or the receiving
+// units of sending unit ui if Recip: round(PCon * n) of the n units of the
+// other layer (not counting ui itself in a self pathway without SelfCon).
+// It draws that many with replacement and removes duplicates until it has
+// enough, which gives each subset the same probability in O(n log n) for
+// n connections, and draws the units left out instead when there are fewer.
+void paths::UniformRand::UnitCons(tensor::Shape &send, tensor::Shape &recv, bool same, int ui, std::vector<int> &cons) {
+    int n = Recip ? recv.Len() : send.Len();
+    bool noself = same && !SelfCon;
+    int nfrom = noself ? n - 1 : n;
+    int ncon = std::clamp(int(std::round(PCon * float(nfrom))), 0, std::max(nfrom, 0));
+    bool drawOut = ncon > nfrom / 2;
+    size_t ndraw = drawOut ? nfrom - ncon : ncon;
+
+    // seed from RandSeed and ui (splitmix64)
+    uint64_t z = (uint64_t(uint32_t(RandSeed)) << 32 | uint32_t(ui)) + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    rands::SysRand rnd(int((z ^ (z >> 31)) & 0x7fffffff));
+
+    std::vector<int> draws;
+    while (draws.size() < ndraw) {
+        for (size_t i = draws.size(); i < ndraw; i++) {
+            draws.push_back(rnd.Intn(nfrom));
+        }
+        std::sort(draws.begin(), draws.end());
+        draws.erase(std::unique(draws.begin(), draws.end()), draws.end());
+    }
+    cons.clear();
+    if (drawOut) {
+        size_t di = 0;
+        for (int oi = 0; oi < nfrom; oi++) {
+            if (di < draws.size() && draws[di] == oi) {
+                di++;
+            } else {
+                cons.push_back(oi);
+            }
+        }
+    } else {
+        cons.swap(draws);
+    }
+    if (noself) {
+        for (int &oi: cons) {
+            if (oi >= ui) {
+                oi++;
+            }
+        }
+    }
+}
+
+std::string paths::UniformRand::Key() {
+    std::string k = "UniformRand PCon=";
+    weights::AppendFloat(k, PCon);
+    return k + " SelfCon=" + std::to_string(SelfCon) + " Recip=" + std::to_string(Recip) +
+        " RandSeed=" + std::to_string(RandSeed);
+}
+
+// ConnKey returns the ConnCache key for connecting layers of given shapes
+// with pattern pat, or "" if the pattern cannot be cached.
+std::string paths::ConnKey(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same) {
+    std::string k = pat.Key();
+    if (k == "") {
+        return k;
+    }
+    k += " Same=" + std::to_string(same) + " Send=";
+    for (int sz: send.Sizes) {
+        k += std::to_string(sz) + ",";
+    }
+    k += " Recv=";
+    for (int sz: recv.Sizes) {
+        k += std::to_string(sz) + ",";
+    }
+    return k;
+}
+
+// NewConnIndexes calls pat.Connect for layers of given shapes, and builds
+// the sending and receiving connection index lists from its results.
+// Patterns that support UnitCons are built with NewUnitConnIndexes instead,
+// using nThreads threads.
+std::shared_ptr<paths::ConnIndexes> paths::NewConnIndexes(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same, int nThreads) {
+    if (pat.UnitConsType() != NoUnitCons) {
+        return NewUnitConnIndexes(pat, send, recv, same, nThreads);
+    }
+    auto ci = std::make_shared<ConnIndexes>();
+    auto tensorTuple = pat.Connect(send, recv, same);
+    tensor::Int32 *sendn = std::get<0>(tensorTuple);
+    tensor::Int32 *recvn = std::get<1>(tensorTuple);
+    tensor::Bits *cons = std::get<2>(tensorTuple);
+
+    int slen = send.Len();
+    int rlen = recv.Len();
+    auto setNIndexSt = [](std::vector<int> &n, std::vector<int> &idxst, tensor::Int32 &tn) {
+        n = tn.Values;
+        idxst.resize(n.size());
+        int idx = 0;
+        for (size_t i = 0; i < n.size(); i++) {
+            idxst[i] = idx;
+            idx += n[i];
+        }
+        return idx;
+    };
+    int tcons = setNIndexSt(ci->Built.SConN, ci->Built.SConIndexSt, *sendn);
+    int tconr = setNIndexSt(ci->Built.RConN, ci->Built.RConIndexSt, *recvn);
+    if (tconr != tcons) {
+        std::cerr << pat.Name() << " programmer error: total recv cons " << tconr << " != total send cons " << tcons << std::endl;
+    }
+    ci->Built.RConIndex.resize(tconr);
+    ci->Built.RSynIndex.resize(tconr);
+    ci->Built.SConIndex.resize(tcons);
+
+    std::vector<int> sconN(slen); // tracks cur n of sending cons
+    std::vector<bool> &cbits = cons->Values;
+    for (int ri = 0; ri < rlen; ri++) {
+        int rbi = ri * slen; // recv bit index
+        int rtcn = ci->Built.RConN[ri]; // number of cons
+        int rst = ci->Built.RConIndexSt[ri];
+        int rci = 0;
+        for (int si = 0; si < slen; si++) {
+            if (!cbits[rbi + si]) { // no connection
+                continue;
+            }
+            int sst = ci->Built.SConIndexSt[si];
+            if (rci >= rtcn) {
+                std::cerr << pat.Name() << " programmer error: recv target total con number: " << rtcn << " exceeded at recv idx: " << ri << ", send idx: " << si << std::endl;
+                break;
+            }
+            ci->Built.RConIndex[rst+rci] = si;
+
+            int sci = sconN[si];
+            int stcn = ci->Built.SConN[si];
+            if (sci >= stcn) {
+                std::cerr << pat.Name() << " programmer error: send target total con number: " << rtcn << " exceeded at recv idx: " << ri << ", send idx: " << si << std::endl;
+                break;
+            }
+            ci->Built.SConIndex[sst+sci] = ri;
+            ci->Built.RSynIndex[rst+rci] = sst + sci;
+            sconN[si]++;
+            rci++;
+        }
+    }
+    ci->PatternBytes = sendn->Values.capacity() * sizeof(int) + recvn->Values.capacity() * sizeof(int) + cons->Values.capacity() / 8;
+    delete sendn;
+    delete recvn;
+    delete cons;
+    ci->View();
+    return ci;
+}
+
+// NewUnitConnIndexes builds the connection index lists for a pattern that
+// gives the connections of each unit with UnitCons, directly, without the
+// recv x send tables of Connect. The units are split into nThreads blocks
+// (0 for one per core), which generate their connections in parallel:
+// the result does not depend on the number of threads.
+std::shared_ptr<paths::ConnIndexes> paths::NewUnitConnIndexes(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same, int nThreads) {
+    auto ci = std::make_shared<ConnIndexes>();
+    bool bySend = pat.UnitConsType() == SendUnitCons;
+    int slen = send.Len();
+    int rlen = recv.Len();
+    int nu = bySend ? slen : rlen; // units whose connections UnitCons gives
+    int no = bySend ? rlen : slen; // units of the other layer
+
+    if (nThreads <= 0) {
+        nThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+    }
+    const int minBlock = 64;
+    nThreads = std::max(std::min(nThreads, nu / minBlock), 1);
+    std::vector<int> un(nu);
+    std::vector<std::vector<int>> blockCons(nThreads);
+    auto gen = [&](int bi) {
+        std::vector<int> ucons;
+        for (int ui = nu * bi / nThreads; ui < nu * (bi + 1) / nThreads; ui++) {
+            pat.UnitCons(send, recv, same, ui, ucons);
+            un[ui] = ucons.size();
+            blockCons[bi].insert(blockCons[bi].end(), ucons.begin(), ucons.end());
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int bi = 1; bi < nThreads; bi++) {
+        threads.emplace_back(gen, bi);
+    }
+    gen(0);
+    for (std::thread &th: threads) {
+        th.join();
+    }
+
+    std::vector<int> &uN = bySend ? ci->Built.SConN : ci->Built.RConN;
+    std::vector<int> &uSt = bySend ? ci->Built.SConIndexSt : ci->Built.RConIndexSt;
+    std::vector<int> &uIndex = bySend ? ci->Built.SConIndex : ci->Built.RConIndex;
+    std::vector<int> &oN = bySend ? ci->Built.RConN : ci->Built.SConN;
+    std::vector<int> &oSt = bySend ? ci->Built.RConIndexSt : ci->Built.SConIndexSt;
+    std::vector<int> &oIndex = bySend ? ci->Built.RConIndex : ci->Built.SConIndex;
+    uN = std::move(un);
+    uSt.resize(nu);
+    oN.assign(no, 0);
+    oSt.resize(no);
+    size_t ncon = 0;
+    for (int ui = 0; ui < nu; ui++) {
+        uSt[ui] = ncon;
+        ncon += uN[ui];
+    }
+    uIndex.reserve(ncon);
+    for (std::vector<int> &bc: blockCons) {
+        uIndex.insert(uIndex.end(), bc.begin(), bc.end());
+        bc = {};
+    }
+    for (int oi: uIndex) {
+        oN[oi]++;
+    }
+    int idx = 0;
+    for (int oi = 0; oi < no; oi++) {
+        oSt[oi] = idx;
+        idx += oN[oi];
+    }
+
+    // the lists of the other layer, in unit order, and the synapse (in send
+    // order) of each recv connection
+    oIndex.resize(ncon);
+    ci->Built.RSynIndex.resize(ncon);
+    std::vector<int> ofill(oSt);
+    for (int ui = 0; ui < nu; ui++) {
+        for (int i = uSt[ui]; i < uSt[ui] + uN[ui]; i++) {
+            int p = ofill[uIndex[i]]++;
+            oIndex[p] = ui;
+            if (bySend) {
+                ci->Built.RSynIndex[p] = i;
+            } else {
+                ci->Built.RSynIndex[i] = p;
+            }
+        }
+    }
+    ci->View();
+    return ci;
+}
+
+// View sets the lists to view the Built lists.
+void paths::ConnIndexes::View() {
+    SConN = Built.SConN;
+    SConIndexSt = Built.SConIndexSt;
+    SConIndex = Built.SConIndex;
+    RConN = Built.RConN;
+    RConIndexSt = Built.RConIndexSt;
+    RConIndex = Built.RConIndex;
+    RSynIndex = Built.RSynIndex;
+}
+
+// Check checks that the lists are for slen sending and rlen receiving units,
+// and are consistent with each other, so that none is out of range.
+// Throws if not.
+void paths::ConnIndexes::Check(int slen, int rlen) const {
+    auto check = [](bool ok, const char *what) {
+        if (!ok) {
+            throw std::runtime_error(std::string("bad ") + what);
+        }
+    };
+    check(SConN.size() == size_t(slen) && SConIndexSt.size() == size_t(slen), "SConN");
+    check(RConN.size() == size_t(rlen) && RConIndexSt.size() == size_t(rlen), "RConN");
+    // the starts must be the running sums of the counts, to ncon on both sides
+    auto starts = [&](std::span<const int> ns, std::span<const int> sts, const char *what) {
+        size_t sum = 0;
+        for (size_t i = 0; i < ns.size(); i++) {
+            check(ns[i] >= 0 && size_t(sts[i]) == sum, what);
+            sum += ns[i];
+        }
+        return sum;
+    };
+    size_t ncon = starts(SConN, SConIndexSt, "SConIndexSt");
+    check(starts(RConN, RConIndexSt, "RConIndexSt") == ncon, "RConN");
+    check(SConIndex.size() == ncon && RConIndex.size() == ncon && RSynIndex.size() == ncon, "number of connections");
+
+    // each synapse of recv unit ri must be a distinct one, sent to ri by
+    // the unit in RConIndex, so that every index is in range
+    std::vector<int> sendOf(ncon);
+    for (int si = 0; si < slen; si++) {
+        for (int i = SConIndexSt[si]; i < SConIndexSt[si] + SConN[si]; i++) {
+            check(SConIndex[i] >= 0 && SConIndex[i] < rlen, "SConIndex");
+            sendOf[i] = si;
+        }
+    }
+    std::vector<uint8_t> seen(ncon);
+    for (int ri = 0; ri < rlen; ri++) {
+        for (int i = RConIndexSt[ri]; i < RConIndexSt[ri] + RConN[ri]; i++) {
+            int k = RSynIndex[i];
+            check(k >= 0 && size_t(k) < ncon && !seen[k] && SConIndex[k] == ri, "RSynIndex");
+            check(RConIndex[i] == sendOf[k], "RConIndex");
+            seen[k] = 1;
+        }
+    }
+}
+
+// Sum returns a checksum of the lists: a 64-bit FNV-1a hash of their
+// lengths and values, hashed in four interleaved lanes so that it runs
+// at memory speed.
+uint64_t paths::ConnIndexes::Sum() const {
+    const uint64_t prime = 1099511628211ull;
+    uint64_t h[4] = {14695981039346656037ull, 1, 2, 3};
+    for (std::span<const int> vals: {SConN, SConIndexSt, SConIndex, RConN, RConIndexSt, RConIndex, RSynIndex}) {
+        h[0] = (h[0] ^ vals.size()) * prime;
+        size_t n4 = vals.size() / 4 * 4;
+        for (size_t i = 0; i < n4; i += 4) {
+            for (int l = 0; l < 4; l++) {
+                h[l] = (h[l] ^ uint32_t(vals[i + l])) * prime;
+            }
+        }
+        for (size_t i = n4; i < vals.size(); i++) {
+            h[0] = (h[0] ^ uint32_t(vals[i])) * prime;
+        }
+    }
+    for (int l = 1; l < 4; l++) {
+        h[0] = (h[0] ^ h[l]) * prime;
+    }
+    return h[0];
+}
+
+// SynRIndex returns the index in recv order (as in RConIndex) of each
+// synapse in send order (as in SConIndex), which is the RSynIndex of the
+// transposed, reciprocal pathway.
+std::span<const int> paths::ConnIndexes::SynRIndex() const {
+    std::call_once(synROnce, [this]() {
+        synRIndex.resize(RSynIndex.size());
+        for (size_t i = 0; i < RSynIndex.size(); i++) {
+            synRIndex[RSynIndex[i]] = i;
+        }
+    });
+    return synRIndex;
+}
+
+// Bytes returns the memory used by the index lists, including those
+// mapped from a cache file.
+size_t paths::ConnIndexes::Bytes() const {
+    size_t n = synRIndex.capacity();
+    if (File != nullptr) {
+        n += SConN.size() + SConIndexSt.size() + SConIndex.size() + RConN.size() +
+            RConIndexSt.size() + RConIndex.size() + RSynIndex.size();
+    } else {
+        n += Built.SConN.capacity() + Built.SConIndexSt.capacity() + Built.SConIndex.capacity() + Built.RConN.capacity() +
+            Built.RConIndexSt.capacity() + Built.RConIndex.capacity() + Built.RSynIndex.capacity();
+    }
+    return n * sizeof(int);
+}
+
+paths::ConnCache paths::DefaultConnCache;
+
+// Get returns the connection indexes for pattern pat connecting layers of
+// given shapes: from memory if they have been built before in this process,
+// else from a file in Dir, else by building them with NewConnIndexes
+// (saving them to Dir). A cache file that cannot be read is replaced.
+std::shared_ptr<const paths::ConnIndexes> paths::ConnCache::Get(Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same) {
+    std::string key = ConnKey(pat, send, recv, same);
+    if (!On || key == "") {
+        return NewConnIndexes(pat, send, recv, same, NThreads);
+    }
+    std::string dir;
+    {
+        std::lock_guard<std::mutex> lock(Mu);
+        auto it = Conns.find(key);
+        if (it != Conns.end()) {
+            Hits++;
+            return it->second;
+        }
+        dir = Dir;
+    }
+
+    std::shared_ptr<ConnIndexes> ci;
+    bool fromFile = false;
+    std::string fileName = dir == "" ? "" : dir + "/" + FileName(key);
+    if (fileName != "" && std::filesystem::exists(fileName)) {
+        try {
+            ci = Load(fileName, key, send.Len(), recv.Len());
+            fromFile = true;
+        } catch (const std::exception &e) {
+            std::cerr << "ConnCache: rebuilding " << key << ": " << e.what() << std::endl;
+        }
+    }
+    if (ci == nullptr) {
+        ci = NewConnIndexes(pat, send, recv, same, NThreads);
+        if (fileName != "") {
+            try {
+                Save(fileName, key, *ci);
+            } catch (const std::exception &e) {
+                std::cerr << "ConnCache: " << e.what() << std::endl;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(Mu);
+    if (fromFile) {
+        FileHits++;
+    } else {
+        Misses++;
+    }
+    // another thread may have added it first
+    auto res = Conns.emplace(key, ci);
+    res.first->second->Cached = true;
+    return res.first->second;
+}
+
+// Clear removes all of the indexes cached in memory (but not in Dir),
+// and resets the counts.
+void paths::ConnCache::Clear() {
+    std::lock_guard<std::mutex> lock(Mu);
+    for (auto &kv: Conns) {
+        kv.second->Cached = false;
+    }
+    Conns.clear();
+    Hits = 0;
+    FileHits = 0;
+    Misses = 0;
+}
+
+// FileName returns the name of the cache file in Dir for given key:
+// a 64-bit FNV-1a hash of the key. The key itself is stored in the file,
+// to detect hash collisions.
+std::string paths::ConnCache::FileName(const std::string &key) {
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned char c: key) {
+        h = (h ^ c) * 1099511628211ull;
+    }
+    char sb[32];
+    snprintf(sb, sizeof(sb), "%016llx.conn", (unsigned long long)h);
+    return sb;
+}
+
+// Load returns the indexes for key in a cache file, viewing the lists in
+// place in a memory map of the file, which they keep open. The lists are
+// only checked for consistency (see ConnIndexes.Check) if the file's
+// checksum does not match them, e.g., if it was changed after Save wrote it:
+// a file that is corrupt or stale throws, and Get builds the indexes again.
+std::shared_ptr<paths::ConnIndexes> paths::ConnCache::Load(const std::string &fileName, const std::string &key, int slen, int rlen) {
+    auto cf = std::make_shared<weights::CkptFile>(fileName);
+    size_t n;
+    const uint8_t *kb = cf->Bytes("Key", n);
+    if (kb == nullptr || std::string((const char*)kb, n) != key) {
+        throw std::runtime_error("different key in " + fileName);
+    }
+    auto ci = std::make_shared<ConnIndexes>();
+    auto view = [&](const char *nm, std::span<const int> &vals) {
+        const int32_t *ar = cf->IntArray(nm, n);
+        if (ar == nullptr) {
+            throw std::runtime_error(std::string("no ") + nm + " in " + fileName);
+        }
+        vals = std::span<const int>(ar, n);
+    };
+    view("SConN", ci->SConN);
+    view("SConIndexSt", ci->SConIndexSt);
+    view("SConIndex", ci->SConIndex);
+    view("RConN", ci->RConN);
+    view("RConIndexSt", ci->RConIndexSt);
+    view("RConIndex", ci->RConIndex);
+    view("RSynIndex", ci->RSynIndex);
+    ci->File = cf;
+    const uint8_t *sb = cf->Bytes("Sum", n);
+    uint64_t sum = 0;
+    if (sb != nullptr && n == sizeof(sum)) {
+        std::memcpy(&sum, sb, sizeof(sum));
+    }
+    if (sb == nullptr || n != sizeof(sum) || sum != ci->Sum() ||
+            ci->SConN.size() != size_t(slen) || ci->RConN.size() != size_t(rlen)) {
+        try {
+            ci->Check(slen, rlen);
+        } catch (const std::runtime_error &e) {
+            throw std::runtime_error(std::string(e.what()) + " in " + fileName);
+        }
+    }
+    return ci;
+}
+
+// Save writes the indexes for key to a cache file, with their checksum,
+// after checking that they are consistent (see ConnIndexes.Check), so that
+// Load need not check them again. Throws if they are not.
+void paths::ConnCache::Save(const std::string &fileName, const std::string &key, const ConnIndexes &ci) {
+    try {
+        ci.Check(ci.SConN.size(), ci.RConN.size());
+    } catch (const std::runtime_error &e) {
+        throw std::runtime_error(std::string(e.what()) + ", not saving " + fileName);
+    }
+    uint64_t sum = ci.Sum();
+    weights::CkptWriter cw(0);
+    cw.Add("Key", (const uint8_t*)key.data(), key.size());
+    cw.Add("Sum", (const uint8_t*)&sum, sizeof(sum));
+    cw.Add("SConN", ci.SConN.data(), ci.SConN.size());
+    cw.Add("SConIndexSt", ci.SConIndexSt.data(), ci.SConIndexSt.size());
+    cw.Add("SConIndex", ci.SConIndex.data(), ci.SConIndex.size());
+    cw.Add("RConN", ci.RConN.data(), ci.RConN.size());
+    cw.Add("RConIndexSt", ci.RConIndexSt.data(), ci.RConIndexSt.size());
+    cw.Add("RConIndex", ci.RConIndex.data(), ci.RConIndex.size());
+    cw.Add("RSynIndex", ci.RSynIndex.data(), ci.RSynIndex.size());
+    cw.Close();
+    cw.SaveMem(fileName);
+}
+
 void pybind_Patterns(pybind11::module_ &m) {
 	pybind11::class_<paths::Pattern>(m, "Pattern");
 
@@ -446,12 +1160,53 @@ void pybind_Patterns(pybind11::module_ &m) {
 		.def(pybind11::init<>())
 	;
 
-	// pybind11::class_<paths::Circle, paths::Pattern>(m, "Circle")
-	// 	.def(pybind11::init<>())
-	// ;
+	pybind11::class_<paths::TopoCache>(m, "TopoCache")
+		.def_readwrite("On", &paths::TopoCache::On)
+		.def_readonly("Hits", &paths::TopoCache::Hits)
+		.def_readonly("Misses", &paths::TopoCache::Misses)
+		.def("Clear", &paths::TopoCache::Clear)
+	;
+	m.attr("DefaultTopoCache") = pybind11::cast(&paths::DefaultTopoCache, pybind11::return_value_policy::reference);
+
+	pybind11::class_<paths::ConnCache>(m, "ConnCache")
+		.def_readwrite("On", &paths::ConnCache::On)
+		.def_readwrite("Dir", &paths::ConnCache::Dir)
+		.def_readwrite("NThreads", &paths::ConnCache::NThreads)
+		.def_readonly("Hits", &paths::ConnCache::Hits)
+		.def_readonly("FileHits", &paths::ConnCache::FileHits)
+		.def_readonly("Misses", &paths::ConnCache::Misses)
+		.def("Clear", &paths::ConnCache::Clear)
+	;
+	m.attr("DefaultConnCache") = pybind11::cast(&paths::DefaultConnCache, pybind11::return_value_policy::reference);
+
+	pybind11::class_<paths::Circle, paths::Pattern>(m, "Circle")
+		.def(pybind11::init<>())
+		.def_readwrite("Radius", &paths::Circle::Radius)
+		.def_readwrite("AutoScale", &paths::Circle::AutoScale)
+		.def_readwrite("Wrap", &paths::Circle::Wrap)
+		.def_readwrite("TopoWeights", &paths::Circle::TopoWeights)
+		.def_readwrite("Sigma", &paths::Circle::Sigma)
+		.def_readwrite("MaxWt", &paths::Circle::MaxWt)
+		.def_readwrite("SelfCon", &paths::Circle::SelfCon)
+		.def("SetStart", [](paths::Circle &cr, int x, int y) { cr.Start.Set(x, y); })
+		.def("SetScale", [](paths::Circle &cr, float x, float y) { cr.Scale.X = x; cr.Scale.Y = y; })
+	;
+
+	pybind11::class_<paths::UniformRand, paths::Pattern>(m, "UniformRand")
+		.def(pybind11::init<>())
+		.def_readwrite("PCon", &paths::UniformRand::PCon)
+		.def_readwrite("SelfCon", &paths::UniformRand::SelfCon)
+		.def_readwrite("Recip", &paths::UniformRand::Recip)
+		.def_readwrite("RandSeed", &paths::UniformRand::RandSeed)
+	;
 
-	// pybind11::class_<paths::PoolTile, paths::Pattern>(m, "PoolTile")
-	// 	.def(pybind11::init<>())
-	// ;
+	pybind11::class_<paths::PoolTile, paths::Pattern>(m, "PoolTile")
+		.def(pybind11::init<>())
+		.def_readwrite("Recip", &paths::PoolTile::Recip)
+		.def_readwrite("Wrap", &paths::PoolTile::Wrap)
+		.def("SetSize", [](paths::PoolTile &pt, int x, int y) { pt.Size.Set(x, y); })
+		.def("SetSkip", [](paths::PoolTile &pt, int x, int y) { pt.Skip.Set(x, y); })
+		.def("SetStart", [](paths::PoolTile &pt, int x, int y) { pt.Start.Set(x, y); })
+	;
 
 }
@@ -3,7 +3,6 @@
 leabra::Pool::Pool():Inhib(), ActM(), ActP(), ActAvgs() {
     StIndex = 0;
     EdIndex = 0;
-    InitParamMaps();
 }
 
 void leabra::Pool::Init(){
@@ -22,8 +21,6 @@ std::string leabra::Pool::StyleName() {
     return "";
 }
 
-void leabra::Pool::InitParamMaps() {
-    ParamNameMap["Inhib"] = (void*) &Inhib;
-
-    ParamTypeMap["Inhib"] = &typeid(Inhib);
+void leabra::Pool::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "Inhib", Inhib);
 }
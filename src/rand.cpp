@@ -43,7 +43,7 @@ uint rands::SysRand::Intn(uint n) {
 	if (n > (((uint)1<<31)-1)) {
         throw std::invalid_argument("Argument to Intn greater than 32 bits");
 	}
-    auto dist = std::uniform_int_distribution<uint>(0,n);
+    auto dist = std::uniform_int_distribution<uint>(0,n-1);
     return dist(engine);
 	// return int(Int63n(int(n)));
 }
@@ -1,4 +1,6 @@
 #include "sim.hpp"
+#include <iostream>
+#include <pybind11/numpy.h>
 #include "rand.hpp"
 
 #include "leabra.hpp"
@@ -31,24 +33,52 @@ void leabra::Sim::Init() {
 // AlphaCyc runs one alpha-cycle (100 msec, 4 quarters)			 of processing.
 // External inputs must have already been applied prior to calling,
 // using ApplyExt method on relevant layers (see TrainTrial, TestTrial).
-// If train is true, then learning DWt or WtFmDWt calls are made.
+// If train is true, then learning DWt or WtFmDWt calls are made:
+// DWt every trial, and WtFromDwt once BatchSize trials have been accumulated.
+// Each quarter ends early once the network has Settled, if Ctx.Settle is On,
+// and Ctx.QuarterCycles records the cycles run.
 // Handles netview updating within scope of AlphaCycle
 void leabra::Sim::AlphaCyc(bool train) {
+	Ctx->Mode = train ? Train : Test;
 	Net->AlphaCycInit(train);
 	Ctx->AlphaCycStart();
 	for (int qtr = 0; qtr < 4; qtr++) {
 		for (int cyc = 0; cyc < Ctx->CycPerQtr; cyc++) {
 			Net->Cycle(Ctx);
 			Ctx->CycleInc();
+			if (Ctx->Settled(Net->ActDelMax())) {
+				break;
+			}
 		}
 		Net->QuarterFinal(Ctx);
 		Ctx->QuarterInc();
 	}
 
 	if (train) {
-		Net->Dwt();
-		Net->WtFromDwt();
+		Net->Dwt(BatchSize > 1);
+		BatchN++;
+		if (BatchN >= BatchSize) {
+			EndBatch();
+		}
+	}
+}
+
+// EndBatch applies the weight changes accumulated over the trials of the
+// current minibatch with WtFromDwt, if there are any. Called by AlphaCyc
+// every BatchSize trials, and at the end of each training epoch for a
+// partial batch, so BatchSize should only be changed between epochs.
+// If BatchSize > 1, the raw changes of the trials are summed, and Norm,
+// Momentum and Lrate are applied once to the sum by Net.DWtFromBatch.
+// Net.WtBalInterval then counts batches.
+void leabra::Sim::EndBatch() {
+	if (BatchN == 0) {
+		return;
+	}
+	if (BatchSize > 1) {
+		Net->DWtFromBatch();
 	}
+	Net->WtFromDwt();
+	BatchN = 0;
 }
 
 // ApplyInputs applies input patterns from given envirbonment.
@@ -75,6 +105,8 @@ void leabra::Sim::ApplyInputs() {
 
 void leabra::Sim::NewRun() {
     Ctx->Reset();
+    Epoch = 0;
+    BatchN = 0;
     Net->InitWeights();
 }
 
@@ -124,7 +156,7 @@ int leabra::TabulatedEnv::NumTrials() {
 }
 
 leabra::Sim::Sim(Network *net, params::Sets *params, Environment *env):
-    Net(net), Params(params), Env(env), isInitialized(false){
+    Net(net), Params(params), Env(env), isInitialized(false), Epoch(0), BatchSize(1), BatchN(0) {
     Ctx = new leabra::Context();
 }
 
@@ -158,6 +190,14 @@ void leabra::Sim::StepEpoch(bool train) {
 
         sseVector.clear(); // reset without clearing capacity
     }
+    if (train) {
+        EndBatch();
+    }
+    Net->ApplyQueuedParams();
+    if (train) {
+        Epoch++;
+        Prune.Epoch(*Net, Epoch);
+    }
 }
 
 leabra::TabulatedEnv::TabulatedEnv():permutation() {
@@ -193,6 +233,85 @@ void leabra::TabulatedEnv::TableFromFile(std::string fileName) {
     permutation = rands::Perm(numEvents);
 }
 
+// Inference clears the external inputs of all the layers of net, which
+// must be built, so that only the bound inputs are clamped.
+leabra::Inference::Inference(Network *net): Net(net), Quarters(3), Inputs(), Outputs() {
+    Ctx.Mode = Test;
+    Ctx.Testing = true;
+    Net->InitExt();
+}
+
+// bindLayer returns the layer with the given name, if it has n neurons.
+static leabra::Layer *bindLayer(leabra::Network *net, std::string layer, int n) {
+    leabra::Layer *ly = dynamic_cast<leabra::Layer*>(net->LayerByName(layer));
+    if (ly == nullptr) {
+        std::cerr << "Inference: layer " << layer << " not found" << std::endl;
+        return nullptr;
+    }
+    if (n != int(ly->Neurons.size())) {
+        std::cerr << "Inference: buffer of " << n << " values for layer " << layer
+            << " of " << ly->Neurons.size() << " neurons" << std::endl;
+        return nullptr;
+    }
+    return ly;
+}
+
+// BindInput binds buf, of one value per neuron, as the input to the given layer.
+// Its values are copied to Ext at the start of each Run, and the layer is
+// clamped to them. buf must outlive the binding.
+bool leabra::Inference::BindInput(std::string layer, float *buf, int n) {
+    Layer *ly = bindLayer(Net, layer, n);
+    if (ly == nullptr) {
+        return false;
+    }
+    for (Neuron &nrn: ly->Neurons) {
+        nrn.SetFlag(false, {NeurHasExt, NeurHasTarg, NeurHasCmpr});
+        nrn.SetFlag(true, {NeurHasExt});
+    }
+    Inputs.push_back({ly, buf, n});
+    return true;
+}
+
+// BindOutput binds buf, of one value per neuron, to receive the activations
+// of the given layer at the end of each Run. buf must outlive the binding.
+bool leabra::Inference::BindOutput(std::string layer, float *buf, int n) {
+    Layer *ly = bindLayer(Net, layer, n);
+    if (ly == nullptr) {
+        return false;
+    }
+    Outputs.push_back({ly, buf, n});
+    return true;
+}
+
+// Run presents the bound inputs, settles for Quarters quarters, or less if
+// Ctx.Settle is On, and writes the activations of the bound output layers.
+// Returns the number of cycles run.
+int leabra::Inference::Run() {
+    for (Binding &b: Inputs) {
+        for (int i = 0; i < b.N; i++) {
+            b.Lay->Neurons[i].Ext = b.Buf[i];
+        }
+    }
+    Net->AlphaCycInit(false);
+    Ctx.AlphaCycStart();
+    for (int qtr = 0; qtr < Quarters; qtr++) {
+        for (int cyc = 0; cyc < Ctx.CycPerQtr; cyc++) {
+            Net->Cycle(&Ctx);
+            Ctx.CycleInc();
+            if (Ctx.Settled(Net->ActDelMax())) {
+                break;
+            }
+        }
+        Ctx.QuarterInc();
+    }
+    for (Binding &b: Outputs) {
+        for (int i = 0; i < b.N; i++) {
+            b.Buf[i] = b.Lay->Neurons[i].Act;
+        }
+    }
+    return Ctx.Cycle;
+}
+
 void pybind_LeabraSim(pybind11::module_ &m) {
     pybind11::class_<leabra::Sim>(m, "Sim")
         .def(pybind11::init<leabra::Network*, params::Sets*, leabra::Environment*>(),
@@ -206,14 +325,39 @@ void pybind_LeabraSim(pybind11::module_ &m) {
         .def_readonly("Ctx", &leabra::Sim::Ctx)
         .def_readonly("TrialSSE", &leabra::Sim::TrialSSE)
         .def_readonly("EpochSSE", &leabra::Sim::EpochSSE)
+        .def_readonly("Epoch", &leabra::Sim::Epoch)
+        .def_readwrite("Prune", &leabra::Sim::Prune)
+        .def_readwrite("BatchSize", &leabra::Sim::BatchSize)
+        .def_readonly("BatchN", &leabra::Sim::BatchN)
         .def("Init", &leabra::Sim::Init)
         .def("StepTrial", &leabra::Sim::StepTrial)
         .def("StepEpoch", &leabra::Sim::StepEpoch)
         .def("ApplyParams", &leabra::Sim::ApplyParams)
         .def("Run", &leabra::Sim::Run,
             pybind11::arg("numEpochs"),
-            pybind11::arg("train") = true
+            pybind11::arg("train") = true,
+            pybind11::call_guard<pybind11::gil_scoped_release>() // lets python threads QueueParam while running
+            )
+    ;
+
+    // inputs and outputs are bound to numpy arrays, kept alive by the Inference.
+    // buf must already be a C-contiguous float32 array: noconvert makes any other
+    // a TypeError, rather than binding a temporary converted copy of it.
+    pybind11::class_<leabra::Inference>(m, "Inference")
+        .def(pybind11::init<leabra::Network*>(), pybind11::arg("net"), pybind11::keep_alive<1, 2>())
+        .def_readonly("Ctx", &leabra::Inference::Ctx)
+        .def_readwrite("Quarters", &leabra::Inference::Quarters)
+        .def("BindInput", [](leabra::Inference &inf, std::string layer, pybind11::array_t<float, pybind11::array::c_style> buf) {
+                return inf.BindInput(layer, buf.mutable_data(), buf.size());
+            },
+            pybind11::arg("layer"), pybind11::arg("buf").noconvert(), pybind11::keep_alive<1, 3>()
+            )
+        .def("BindOutput", [](leabra::Inference &inf, std::string layer, pybind11::array_t<float, pybind11::array::c_style> buf) {
+                return inf.BindOutput(layer, buf.mutable_data(), buf.size());
+            },
+            pybind11::arg("layer"), pybind11::arg("buf").noconvert(), pybind11::keep_alive<1, 3>()
             )
+        .def("Run", &leabra::Inference::Run, pybind11::call_guard<pybind11::gil_scoped_release>())
     ;
 }
 
@@ -7,7 +7,7 @@ namespace leabra {
 
 
 // SynapseVarByName returns a pointer to the variable in the Synapse, or error
-float* leabra::Synapse::SynapseVarByName(std::string varNm) {
+SynReal* leabra::Synapse::SynapseVarByName(std::string varNm) {
     if (varNm == "Wt") {
         return &Wt;
     } else if (varNm == "LWt") {
@@ -25,12 +25,12 @@ float* leabra::Synapse::SynapseVarByName(std::string varNm) {
     }
 }
 
-float *leabra::Synapse::VarByName(std::string varNm) {
+SynReal *leabra::Synapse::VarByName(std::string varNm) {
     return SynapseVarByName(varNm);
 }
 
-void leabra::Synapse::SetVarByName(std::string varNm, float val) {
-    float *var = VarByName(varNm);
+void leabra::Synapse::SetVarByName(std::string varNm, Real val) {
+    SynReal *var = VarByName(varNm);
     *var = val;
 }
 
@@ -46,8 +46,6 @@ std::string leabra::Synapse::StyleName() {
     return "";
 }
 
-void leabra::Synapse::InitParamMaps() {
-    ParamNameMap["Scale"] = (void*) &Scale;
-
-    ParamTypeMap["Scale"] = &typeid(float);
+void leabra::Synapse::InitParamMaps(params::ParamRegistry &reg) {
+    reg.Add(this, "Scale", Scale);
 }
@@ -292,6 +292,32 @@ int tensor::Projection2DIndex(Shape &shp, bool oddRow, int row, int col) {
 	return 0;
 }
 
+// Projection2DCoords returns the row, col coords of the given flat 1D index
+// in a 2D projection of the given tensor shape -- the inverse of Projection2DIndex.
+std::tuple<int, int> tensor::Projection2DCoords(Shape &shp, bool oddRow, int idx) {
+    std::vector<int> ix = shp.Index(idx);
+    int nd = shp.NumDims();
+    switch (nd) {
+        case 1:
+            if (oddRow) {
+                return {ix[0], 0};
+            }
+            return {0, ix[0]};
+        case 2:
+            return {ix[0], ix[1]};
+        case 3:
+            if (oddRow) {
+                return {ix[0] * shp.DimSize(1) + ix[1], ix[2]};
+            }
+            return {ix[1], ix[0] * shp.DimSize(2) + ix[2]};
+        case 4:
+            return {ix[0] * shp.DimSize(2) + ix[2], ix[1] * shp.DimSize(3) + ix[3]};
+        case 5:
+            // todo: oddRows version!
+            return {ix[0] * shp.DimSize(1) * shp.DimSize(3) + ix[1] * shp.DimSize(3) + ix[3], ix[2] * shp.DimSize(4) + ix[4]};
+    }
+    return {0, 0};
+}
 
 template class tensor::Tensor<float>;
 template class tensor::Tensor<int>;
@@ -0,0 +1,805 @@
+#include "weights.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <charconv>
+#include <cctype>
+#include <cstdio>
+#include <string_view>
+#include <atomic>
+
+const char weights::CkptMagic[8] = {'L', 'E', 'A', 'B', 'R', 'A', 'W', 'T'};
+
+// CkptTypeSize returns the size in bytes of one value of given CkptTypes.
+size_t weights::CkptTypeSize(uint32_t typ) {
+	switch (typ) {
+	case CkptUint8:
+		return 1;
+	case CkptFloat64:
+		return 8;
+	default:
+		return 4;
+	}
+}
+
+// CkptWriter opens the file and writes a placeholder header,
+// which Close fills in once the table of contents is known.
+weights::CkptWriter::CkptWriter(std::string fileName, uint32_t flags):
+	File(fileName, std::ios::binary | std::ios::trunc), Mem(), InMem(false), TOC(), Pos(0), Flags(flags), Seq(0), PrevSeq(0) {
+	if (!File) {
+		throw std::runtime_error("weights: could not open checkpoint file for writing: " + fileName);
+	}
+	CkptHeader hdr{};
+	Write((const char*)&hdr, sizeof(hdr));
+}
+
+// CkptWriter with no file name writes the checkpoint into Mem.
+weights::CkptWriter::CkptWriter(uint32_t flags):
+	File(), Mem(), InMem(true), TOC(), Pos(0), Flags(flags), Seq(0), PrevSeq(0) {
+	CkptHeader hdr{};
+	Write((const char*)&hdr, sizeof(hdr));
+}
+
+void weights::CkptWriter::Write(const char *data, size_t n) {
+	if (InMem) {
+		Mem.insert(Mem.end(), data, data + n);
+	} else {
+		File.write(data, n);
+	}
+	Pos += n;
+}
+
+// Pad writes zeros up to the next CkptAlign boundary.
+void weights::CkptWriter::Pad() {
+	static const char zeros[CkptAlign] = {};
+	Write(zeros, (CkptAlign - Pos % CkptAlign) % CkptAlign);
+}
+
+// Begin adds a table of contents entry for an array of n values,
+// starting at the next aligned position.
+void weights::CkptWriter::Begin(std::string key, size_t n, CkptTypes typ) {
+	if (key.size() >= sizeof(CkptEntry::Key)) {
+		throw std::invalid_argument("weights: checkpoint key is too long: " + key);
+	}
+	Pad();
+	CkptEntry ent{};
+	std::memcpy(ent.Key, key.data(), key.size());
+	ent.Type = typ;
+	ent.Off = Pos;
+	ent.N = n;
+	ent.FullN = n;
+	TOC.push_back(ent);
+}
+
+// Add writes an array of n Reals from data.
+void weights::CkptWriter::Add(std::string key, const Real *data, size_t n) {
+	Begin(key, n, CkptReal);
+	Write((const char*)data, n * sizeof(Real));
+}
+
+// Add writes an array of n ints from data.
+void weights::CkptWriter::Add(std::string key, const int32_t *data, size_t n) {
+	Begin(key, n, CkptInt32);
+	Write((const char*)data, n * sizeof(int32_t));
+}
+
+// Add writes an array of n bytes from data.
+void weights::CkptWriter::Add(std::string key, const uint8_t *data, size_t n) {
+	Begin(key, n, CkptUint8);
+	Write((const char*)data, n);
+}
+
+// MarkRows marks the last array added as holding only the sending rows
+// given by the RowSt and RowN arrays of its incremental checkpoint,
+// out of a full array of fullN values.
+void weights::CkptWriter::MarkRows(size_t fullN) {
+	TOC.back().Rows = 1;
+	TOC.back().FullN = fullN;
+}
+
+// Close writes the table of contents and the final header,
+// and closes the file if writing to one.
+void weights::CkptWriter::Close() {
+	Pad();
+	CkptHeader hdr{};
+	std::memcpy(hdr.Magic, CkptMagic, sizeof(hdr.Magic));
+	hdr.Version = CkptVersion;
+	hdr.Flags = Flags;
+	hdr.NEntries = TOC.size();
+	hdr.TOCOff = Pos;
+	hdr.Seq = Seq;
+	hdr.PrevSeq = PrevSeq;
+	Write((const char*)TOC.data(), TOC.size() * sizeof(CkptEntry));
+	hdr.FileSize = Pos;
+	if (InMem) {
+		std::memcpy(Mem.data(), &hdr, sizeof(hdr));
+		return;
+	}
+	File.seekp(0);
+	File.write((const char*)&hdr, sizeof(hdr));
+	File.close();
+	if (!File) {
+		throw std::runtime_error("weights: error writing checkpoint file");
+	}
+}
+
+// SaveMem writes a checkpoint written into Mem (and Closed) to a file.
+// It is written to a temporary file that is renamed when complete,
+// so a checkpoint file is never seen partially written, even with
+// several processes or threads writing the same file.
+void weights::CkptWriter::SaveMem(std::string fileName) {
+	static std::atomic<int> nsave(0);
+	std::string tmp = fileName + "." + std::to_string(getpid()) + "." + std::to_string(nsave++) + ".tmp";
+	std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+	f.write(Mem.data(), Mem.size());
+	f.close();
+	if (!f || std::rename(tmp.c_str(), fileName.c_str()) != 0) {
+		std::remove(tmp.c_str());
+		throw std::runtime_error("weights: error writing checkpoint file: " + fileName);
+	}
+}
+
+// CkptFile maps the checkpoint file and checks its header and table of contents.
+weights::CkptFile::CkptFile(std::string fileName):
+	FileName(fileName), Fd(-1), Data(nullptr), Size(0), Header(nullptr), TOC(), Entries() {
+	Fd = open(fileName.c_str(), O_RDONLY);
+	if (Fd < 0) {
+		throw std::runtime_error("weights: could not open checkpoint file: " + fileName);
+	}
+	struct stat st;
+	if (fstat(Fd, &st) != 0 || size_t(st.st_size) < sizeof(CkptHeader)) {
+		close(Fd);
+		throw std::runtime_error("weights: not a checkpoint file: " + fileName);
+	}
+	Size = st.st_size;
+	void *mp = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Fd, 0);
+	if (mp == MAP_FAILED) {
+		close(Fd);
+		throw std::runtime_error("weights: could not map checkpoint file: " + fileName);
+	}
+	Data = (char*)mp;
+	madvise(Data, Size, MADV_SEQUENTIAL);
+	Header = (const CkptHeader*)Data;
+	std::string err;
+	if (std::memcmp(Header->Magic, CkptMagic, sizeof(CkptMagic)) != 0) {
+		err = "not a checkpoint file";
+	} else if (Header->Version != CkptVersion) {
+		err = "unsupported checkpoint version " + std::to_string(Header->Version);
+	} else if (Header->FileSize != Size || Header->TOCOff > Size ||
+			Header->NEntries > (Size - Header->TOCOff) / sizeof(CkptEntry)) {
+		err = "truncated or corrupt checkpoint file";
+	}
+	if (err == "") {
+		const CkptEntry *toc = (const CkptEntry*)(Data + Header->TOCOff);
+		for (uint64_t i = 0; i < Header->NEntries; i++) {
+			const CkptEntry &ent = toc[i];
+			if (ent.Off % CkptAlign != 0 || ent.Off > Header->TOCOff || ent.Type > CkptFloat64 ||
+					ent.N > (Header->TOCOff - ent.Off) / CkptTypeSize(ent.Type)) {
+				err = "corrupt checkpoint table of contents";
+				break;
+			}
+			TOC.push_back(&ent);
+			Entries[std::string(ent.Key, strnlen(ent.Key, sizeof(ent.Key)))] = &ent;
+		}
+	}
+	if (err != "") {
+		munmap(Data, Size);
+		close(Fd);
+		throw std::runtime_error("weights: " + err + ": " + fileName);
+	}
+}
+
+weights::CkptFile::~CkptFile() {
+	munmap(Data, Size);
+	close(Fd);
+}
+
+bool weights::CkptFile::HasFlag(CkptFlags flag) {
+	return (Header->Flags & flag) != 0;
+}
+
+// Entry returns the data of the array with given key and type, setting n to
+// its length, or nullptr if it is not in the checkpoint.
+// Throws if it has a different type.
+const void *weights::CkptFile::Entry(const std::string &key, CkptTypes typ, size_t &n) {
+	auto it = Entries.find(key);
+	if (it == Entries.end()) {
+		n = 0;
+		return nullptr;
+	}
+	if (it->second->Type != typ) {
+		throw std::runtime_error("weights: checkpoint array " + key + " has the wrong type: " + FileName);
+	}
+	n = it->second->N;
+	return Data + it->second->Off;
+}
+
+// Array returns the Real array with given key, setting n to its length,
+// or nullptr if it is not in the checkpoint.
+// Throws if it was written by a build with a different PRECISION,
+// rather than converting it, which would lose or make up precision.
+const Real *weights::CkptFile::Array(const std::string &key, size_t &n) {
+	auto it = Entries.find(key);
+	if (it != Entries.end() && it->second->Type != CkptReal &&
+			(it->second->Type == CkptFloat32 || it->second->Type == CkptFloat64)) {
+		throw std::runtime_error("weights: checkpoint array " + key + " is " +
+			(it->second->Type == CkptFloat64 ? "float64" : "float32") +
+			", which does not match PRECISION=" + PrecisionName + ": " + FileName);
+	}
+	return (const Real*)Entry(key, CkptReal, n);
+}
+
+// IntArray returns the int array with given key, setting n to its length,
+// or nullptr if it is not in the checkpoint.
+const int32_t *weights::CkptFile::IntArray(const std::string &key, size_t &n) {
+	return (const int32_t*)Entry(key, CkptInt32, n);
+}
+
+// Bytes returns the byte array with given key, setting n to its length,
+// or nullptr if it is not in the checkpoint.
+const uint8_t *weights::CkptFile::Bytes(const std::string &key, size_t &n) {
+	return (const uint8_t*)Entry(key, CkptUint8, n);
+}
+
+// ArrayN returns the array with given key, which must have n values,
+// or nullptr if it is not in the checkpoint.
+// Throws if the length does not match, i.e., the network structure differs.
+const Real *weights::CkptFile::ArrayN(const std::string &key, size_t n) {
+	size_t an;
+	const Real *ar = Array(key, an);
+	if (ar != nullptr && an != n) {
+		throw std::runtime_error("weights: checkpoint array " + key + " has " + std::to_string(an) +
+			" values, expected " + std::to_string(n) + ": " + FileName);
+	}
+	return ar;
+}
+
+// CkptFileName returns the file name of checkpoint seq in a chain
+// of checkpoints with given file name prefix.
+std::string weights::CkptFileName(std::string prefix, uint64_t seq) {
+	char sb[32];
+	snprintf(sb, sizeof(sb), "-%06llu.wts", (unsigned long long)seq);
+	return prefix + sb;
+}
+
+// ckptArray is an array of a checkpoint being rebuilt in memory.
+struct ckptArray {
+	std::string Key;
+	weights::CkptTypes Type;
+	std::vector<char> Data;
+};
+
+// RebuildCheckpoint writes checkpoint seq of the chain of checkpoints with
+// given file name prefix to a full (non-incremental) checkpoint file,
+// which can be loaded with Network.LoadCheckpoint. The chain is followed back
+// from seq to its full base checkpoint, and each incremental checkpoint
+// is then applied on top of the base in turn, which must have the synapse
+// layout it was written for: a chain spanning a Prune or a Build is
+// rejected (Checkpointer starts a new base after either).
+void weights::RebuildCheckpoint(std::string prefix, uint64_t seq, std::string fileName) {
+	std::vector<std::string> chain;
+	for (uint64_t s = seq;;) {
+		std::string fn = CkptFileName(prefix, s);
+		CkptFile ck(fn);
+		if (ck.Header->Seq != s) {
+			throw std::runtime_error("weights: checkpoint " + fn + " has sequence number " + std::to_string(ck.Header->Seq));
+		}
+		chain.push_back(fn);
+		if (!ck.HasFlag(CkptDelta)) {
+			break;
+		}
+		if (ck.Header->PrevSeq >= s) {
+			throw std::runtime_error("weights: invalid previous checkpoint in " + fn);
+		}
+		s = ck.Header->PrevSeq;
+	}
+
+	std::vector<ckptArray> arrays;
+	std::map<std::string, int> index;
+	uint32_t flags;
+	{
+		CkptFile base(chain.back());
+		flags = base.Header->Flags;
+		for (const CkptEntry *ent: base.TOC) {
+			std::string key(ent->Key, strnlen(ent->Key, sizeof(ent->Key)));
+			const char *dt = base.Data + ent->Off;
+			index[key] = arrays.size();
+			arrays.push_back(ckptArray{key, CkptTypes(ent->Type), std::vector<char>(dt, dt + ent->N * CkptTypeSize(ent->Type))});
+		}
+	}
+
+	for (int ci = int(chain.size()) - 2; ci >= 0; ci--) {
+		CkptFile dl(chain[ci]);
+		for (const CkptEntry *ent: dl.TOC) {
+			std::string key(ent->Key, strnlen(ent->Key, sizeof(ent->Key)));
+			std::string pfx = key.substr(0, key.rfind('/') + 1);
+			std::string var = key.substr(pfx.size());
+			if (var == "RowSt" || var == "RowN") {
+				continue;
+			}
+			const char *dt = dl.Data + ent->Off;
+			if (!ent->Rows) { // full array
+				if (index.count(key) == 0) {
+					index[key] = arrays.size();
+					arrays.push_back(ckptArray{key, CkptTypes(ent->Type), {}});
+				}
+				arrays[index[key]].Type = CkptTypes(ent->Type);
+				arrays[index[key]].Data.assign(dt, dt + ent->N * CkptTypeSize(ent->Type));
+				continue;
+			}
+			size_t nst, nn;
+			const int32_t *rowSt = dl.IntArray(pfx + "RowSt", nst);
+			const int32_t *rowN = dl.IntArray(pfx + "RowN", nn);
+			if (index.count(key) == 0 || arrays[index[key]].Type != CkptTypes(ent->Type) || rowSt == nullptr || rowN == nullptr || nn != nst) {
+				throw std::runtime_error("weights: incremental checkpoint array " + key + " does not match its base: " + chain[ci]);
+			}
+			std::vector<char> &bd = arrays[index[key]].Data;
+			size_t tsz = CkptTypeSize(ent->Type);
+			if (bd.size() != ent->FullN * tsz) {
+				throw std::runtime_error("weights: incremental checkpoint array " + key + " is rows of " + std::to_string(ent->FullN) +
+					" values, but its base has " + std::to_string(bd.size() / tsz) + ": " + chain[ci]);
+			}
+			size_t off = 0;
+			for (size_t ri = 0; ri < nst; ri++) {
+				size_t st = size_t(rowSt[ri]) * tsz;
+				size_t n = size_t(rowN[ri]) * tsz;
+				if (st + n > bd.size() || off + n > ent->N * tsz) {
+					throw std::runtime_error("weights: incremental checkpoint array " + key + " does not match its base: " + chain[ci]);
+				}
+				std::memcpy(bd.data() + st, dt + off, n);
+				off += n;
+			}
+		}
+	}
+
+	CkptWriter out(fileName, flags & ~CkptDelta);
+	out.Seq = seq;
+	out.PrevSeq = seq;
+	for (ckptArray &ar: arrays) {
+		out.Begin(ar.Key, ar.Data.size() / CkptTypeSize(ar.Type), ar.Type);
+		out.Write(ar.Data.data(), ar.Data.size());
+	}
+	out.Close();
+}
+
+void pybind_Weights(pybind11::module_ &m) {
+	m.def("RebuildCheckpoint", &weights::RebuildCheckpoint,
+		pybind11::arg("prefix"),
+		pybind11::arg("seq"),
+		pybind11::arg("fileName")
+		);
+	m.def("CkptFileName", &weights::CkptFileName);
+}
+
+// jsonLexer splits a JSON stream into tokens, reading it in large chunks.
+// Numbers are returned as their text, so that the reader can parse them
+// directly into the type it needs.
+struct jsonLexer {
+	enum Tokens {End, Punct, String, Number, Literal};
+
+	std::istream &R;
+	std::vector<char> Buf;
+	size_t Pos;
+	size_t Len;
+	size_t Off; // stream offset of Buf[0], for error messages
+	std::string Text; // text of the last String token
+	const char *TokSt; // start of the text of the last Number or Literal token
+	const char *TokEd; // end of the text of the last Number or Literal token
+	char Ch; // the last Punct token
+
+	jsonLexer(std::istream &r): R(r), Buf(1 << 20), Pos(0), Len(0), Off(0), TokSt(nullptr), TokEd(nullptr), Ch(0) {};
+
+	static bool IsNumChar(int c) {
+		return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '-' || c == '+' || c == '.';
+	}
+
+	// Peek returns the next char without consuming it, or -1 at the end.
+	int Peek() {
+		if (Pos == Len) {
+			Off += Len;
+			R.read(Buf.data(), Buf.size());
+			Len = R.gcount();
+			Pos = 0;
+			if (Len == 0) {
+				return -1;
+			}
+		}
+		return (unsigned char)Buf[Pos];
+	}
+
+	[[noreturn]] void Error(std::string msg) {
+		throw std::runtime_error("weights: JSON parse error at byte " + std::to_string(Off + Pos) + ": " + msg);
+	}
+
+	void AppendUTF8(unsigned cp) {
+		if (cp < 0x80) {
+			Text += char(cp);
+		} else if (cp < 0x800) {
+			Text += char(0xC0 | (cp >> 6));
+			Text += char(0x80 | (cp & 0x3F));
+		} else if (cp < 0x10000) {
+			Text += char(0xE0 | (cp >> 12));
+			Text += char(0x80 | ((cp >> 6) & 0x3F));
+			Text += char(0x80 | (cp & 0x3F));
+		} else {
+			Text += char(0xF0 | (cp >> 18));
+			Text += char(0x80 | ((cp >> 12) & 0x3F));
+			Text += char(0x80 | ((cp >> 6) & 0x3F));
+			Text += char(0x80 | (cp & 0x3F));
+		}
+	}
+
+	unsigned Hex4() {
+		unsigned cp = 0;
+		for (int i = 0; i < 4; i++) {
+			int c = Peek();
+			Pos++;
+			cp <<= 4;
+			if (c >= '0' && c <= '9') {
+				cp |= c - '0';
+			} else if (c >= 'a' && c <= 'f') {
+				cp |= c - 'a' + 10;
+			} else if (c >= 'A' && c <= 'F') {
+				cp |= c - 'A' + 10;
+			} else {
+				Error("invalid \\u escape");
+			}
+		}
+		return cp;
+	}
+
+	void ReadString() {
+		Text.clear();
+		for (;;) {
+			int c = Peek();
+			if (c < 0) {
+				Error("unterminated string");
+			}
+			Pos++;
+			if (c == '"') {
+				return;
+			}
+			if (c != '\\') {
+				Text += char(c);
+				continue;
+			}
+			c = Peek();
+			Pos++;
+			switch (c) {
+			case '"': Text += '"'; break;
+			case '\\': Text += '\\'; break;
+			case '/': Text += '/'; break;
+			case 'b': Text += '\b'; break;
+			case 'f': Text += '\f'; break;
+			case 'n': Text += '\n'; break;
+			case 'r': Text += '\r'; break;
+			case 't': Text += '\t'; break;
+			case 'u': {
+				unsigned cp = Hex4();
+				if (cp >= 0xD800 && cp < 0xDC00) {
+					if (Peek() != '\\') {
+						Error("invalid surrogate pair");
+					}
+					Pos++;
+					if (Peek() != 'u') {
+						Error("invalid surrogate pair");
+					}
+					Pos++;
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (Hex4() - 0xDC00);
+				}
+				AppendUTF8(cp);
+				break;
+			}
+			default:
+				Error("invalid escape in string");
+			}
+		}
+	}
+
+	// Next reads the next token.
+	Tokens Next() {
+		int c;
+		for (;;) {
+			while (Pos < Len && (Buf[Pos] == ' ' || Buf[Pos] == '\t' || Buf[Pos] == '\n' || Buf[Pos] == '\r')) {
+				Pos++;
+			}
+			c = Peek();
+			if (!(c == ' ' || c == '\t' || c == '\n' || c == '\r')) {
+				break;
+			}
+		}
+		if (c < 0) {
+			return End;
+		}
+		switch (c) {
+		case '{': case '}': case '[': case ']': case ':': case ',':
+			Pos++;
+			Ch = char(c);
+			return Punct;
+		case '"':
+			Pos++;
+			ReadString();
+			return String;
+		}
+		// scan in place when the token ends within the buffer, else copy to Text
+		size_t st = Pos;
+		while (Pos < Len && IsNumChar(Buf[Pos])) {
+			Pos++;
+		}
+		if (Pos < Len) {
+			TokSt = Buf.data() + st;
+			TokEd = Buf.data() + Pos;
+		} else {
+			Text.assign(Buf.data() + st, Pos - st);
+			c = Peek();
+			while (c >= 0 && IsNumChar(c)) {
+				Text += char(c);
+				Pos++;
+				c = Peek();
+			}
+			TokSt = Text.data();
+			TokEd = Text.data() + Text.size();
+		}
+		std::string_view tx(TokSt, TokEd - TokSt);
+		if (tx.empty()) {
+			Error(std::string("unexpected character '") + char(c) + "'");
+		}
+		if (tx == "true" || tx == "false" || tx == "null") {
+			return Literal;
+		}
+		if (!(std::isdigit((unsigned char)tx[0]) || tx[0] == '-')) {
+			Error("invalid literal " + std::string(tx));
+		}
+		return Number;
+	}
+};
+
+// jsonReader streams through a JSON weights file, tracking where it is in the
+// weights structure with a stack of frames, and buffering only the Si and Wt
+// lists of the current receiving unit, and any MetaData.
+struct jsonReader {
+	enum Frame {Root, Meta, Layers, Layer, Paths, Path, Rs, R, RSi, RWt, Skip};
+
+	jsonLexer Lex;
+	weights::JSONReader &Rd;
+	std::vector<Frame> Stack;
+	std::vector<bool> IsObj; // whether each frame is an object (else an array)
+	std::string Key;
+	std::map<std::string, std::string> MetaData;
+	bool InLayer;
+	bool InPath;
+	int Ri;
+	std::vector<int> Si;
+	std::vector<float> Wt;
+
+	jsonReader(std::istream &r, weights::JSONReader &rd): Lex(r), Rd(rd), InLayer(false), InPath(false), Ri(-1) {};
+
+	Frame Top() {
+		return Stack.empty() ? Skip : Stack.back();
+	}
+
+	template<typename T>
+	T ParseNumber() {
+		T v;
+		auto res = std::from_chars(Lex.TokSt, Lex.TokEd, v);
+		if (res.ec != std::errc() || res.ptr != Lex.TokEd) {
+			Lex.Error("invalid number " + std::string(Lex.TokSt, Lex.TokEd));
+		}
+		return v;
+	}
+
+	// Value handles a scalar value, for the current Key if in an object.
+	void Value(jsonLexer::Tokens tok) {
+		Frame tp = Top();
+		if (tok == jsonLexer::Number) {
+			if (tp == RWt) {
+				Wt.push_back(ParseNumber<float>());
+			} else if (tp == RSi) {
+				Si.push_back(ParseNumber<int>());
+			} else if (tp == R && Key == "Ri") {
+				Ri = ParseNumber<int>();
+			} else {
+				ParseNumber<double>();
+			}
+		} else if (tok == jsonLexer::String) {
+			if (tp == Meta) {
+				MetaData[Key] = Lex.Text;
+			} else if (tp == Layer && Key == "Layer") {
+				InLayer = Rd.Layer(Lex.Text);
+			} else if (tp == Path && Key == "From") {
+				InPath = Rd.Path(Lex.Text);
+			}
+		}
+	}
+
+	void StartObject() {
+		Frame tp = Top();
+		Frame fr = Skip;
+		if (Stack.empty()) {
+			fr = Root;
+		} else if ((tp == Root || tp == Layer || tp == Path) && Key == "MetaData") {
+			MetaData.clear();
+			fr = Meta;
+		} else if (tp == Layers) {
+			InLayer = false;
+			fr = Layer;
+		} else if (tp == Paths) {
+			InPath = false;
+			fr = Path;
+		} else if (tp == Rs) {
+			Ri = -1;
+			Si.clear();
+			Wt.clear();
+			fr = R;
+		}
+		Stack.push_back(fr);
+		IsObj.push_back(true);
+	}
+
+	void EndObject() {
+		Frame fr = Top();
+		Stack.pop_back();
+		IsObj.pop_back();
+		Frame tp = Top();
+		if (fr == Meta) {
+			if (tp == Root) {
+				Rd.NetMetaData(MetaData);
+			} else if (tp == Layer && InLayer) {
+				Rd.LayerMetaData(MetaData);
+			} else if (tp == Path && InPath) {
+				Rd.PathMetaData(MetaData);
+			}
+		} else if (fr == R) {
+			if (Ri < 0 || Si.size() != Wt.size()) {
+				Lex.Error("Rs entry must have Ri and the same number of Si and Wt values");
+			}
+			Rd.Recv(Ri, Si, Wt);
+		}
+	}
+
+	void StartArray() {
+		Frame tp = Top();
+		Frame fr = Skip;
+		if (tp == Root && Key == "Layers") {
+			fr = Layers;
+		} else if (tp == Layer && Key == "Paths") {
+			fr = InLayer ? Paths : Skip;
+		} else if (tp == Path && Key == "Rs") {
+			fr = InPath ? Rs : Skip;
+		} else if (tp == R && Key == "Si") {
+			fr = RSi;
+		} else if (tp == R && Key == "Wt") {
+			fr = RWt;
+		}
+		Stack.push_back(fr);
+		IsObj.push_back(false);
+	}
+
+	// Read reads the whole stream. Each iteration reads one value, preceded by
+	// its key when in an object, and followed by a ',' or the end of its container.
+	void Read() {
+		jsonLexer::Tokens tok = Lex.Next();
+		bool first = true; // at first element of the current container
+		for (;;) {
+			if (!IsObj.empty() && IsObj.back() && !(first && tok == jsonLexer::Punct && Lex.Ch == '}')) {
+				if (tok != jsonLexer::String) {
+					Lex.Error("expected object key");
+				}
+				Key = Lex.Text;
+				if (Lex.Next() != jsonLexer::Punct || Lex.Ch != ':') {
+					Lex.Error("expected ':'");
+				}
+				tok = Lex.Next();
+			}
+			bool closed = false;
+			if (tok == jsonLexer::Punct && Lex.Ch == '{') {
+				StartObject();
+				first = true;
+				tok = Lex.Next();
+				continue;
+			} else if (tok == jsonLexer::Punct && Lex.Ch == '[') {
+				StartArray();
+				first = true;
+				tok = Lex.Next();
+				if (!(tok == jsonLexer::Punct && Lex.Ch == ']')) {
+					continue;
+				}
+				closed = true;
+			} else if (first && tok == jsonLexer::Punct && Lex.Ch == '}' && !IsObj.empty() && IsObj.back()) {
+				closed = true;
+			} else if (tok == jsonLexer::String || tok == jsonLexer::Number || tok == jsonLexer::Literal) {
+				if (Stack.empty()) {
+					Lex.Error("expected object");
+				}
+				Value(tok);
+			} else {
+				Lex.Error(tok == jsonLexer::End ? "unexpected end of input" : std::string("unexpected '") + Lex.Ch + "'");
+			}
+			// after a value: close any containers that end here
+			for (;;) {
+				if (closed) {
+					if (IsObj.back()) {
+						EndObject();
+					} else {
+						Stack.pop_back();
+						IsObj.pop_back();
+					}
+					closed = false;
+					if (Stack.empty()) {
+						if (Lex.Next() != jsonLexer::End) {
+							Lex.Error("unexpected data after end");
+						}
+						return;
+					}
+				}
+				tok = Lex.Next();
+				if (tok == jsonLexer::Punct && Lex.Ch == ',') {
+					tok = Lex.Next();
+					first = false;
+					break;
+				}
+				if (tok == jsonLexer::Punct && Lex.Ch == (IsObj.back() ? '}' : ']')) {
+					closed = true;
+					continue;
+				}
+				Lex.Error(tok == jsonLexer::End ? "unexpected end of input" : "expected ',' or end of " + std::string(IsObj.back() ? "object" : "array"));
+			}
+		}
+	}
+};
+
+// ReadJSON streams through a JSON weights file, passing its contents to rd.
+// Only the lists for one receiving unit are held in memory at a time.
+// Layer and Path objects must give their Layer and From names before
+// their Paths and Rs lists, as the Go writer does -- otherwise these
+// are skipped. Throws on malformed JSON.
+void weights::ReadJSON(std::istream &r, JSONReader &rd) {
+	jsonReader jr(r, rd);
+	jr.Read();
+}
+
+// Indent writes depth tabs.
+void weights::Indent(std::ostream &w, int depth) {
+	static const std::string tabs(64, '\t');
+	w.write(tabs.data(), std::min(depth, int(tabs.size())));
+}
+
+// Quote returns s as a quoted, escaped JSON string.
+std::string weights::Quote(const std::string &s) {
+	std::string q = "\"";
+	for (char c: s) {
+		switch (c) {
+		case '"': q += "\\\""; break;
+		case '\\': q += "\\\\"; break;
+		case '\n': q += "\\n"; break;
+		case '\r': q += "\\r"; break;
+		case '\t': q += "\\t"; break;
+		default:
+			if ((unsigned char)c < 0x20) {
+				char hb[8];
+				snprintf(hb, sizeof(hb), "\\u%04x", c);
+				q += hb;
+			} else {
+				q += c;
+			}
+		}
+	}
+	return q + "\"";
+}
+
+// AppendFloat appends the shortest decimal representation of v
+// that reads back as exactly v.
+void weights::AppendFloat(std::string &buf, float v) {
+	char cb[32];
+	auto res = std::to_chars(cb, cb + sizeof(cb), v);
+	buf.append(cb, res.ptr);
+}
+
+void weights::AppendInt(std::string &buf, int v) {
+	char cb[16];
+	auto res = std::to_chars(cb, cb + sizeof(cb), v);
+	buf.append(cb, res.ptr);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <numeric>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+#include "sim.hpp"
+
+// ra25 sets up the random associator network that most of the tests
+// train, as in the ra25 example: 5x5 Input and Output layers with hidden
+// layers between them, learning the 25 random 5x5 patterns of
+// random_5x5_25.tsv.
+namespace ra25 {
+
+    // Params returns the Base params of the ra25 example, with WtBal on,
+    // followed by the extra selectors, which override them.
+    inline params::Sets Params(std::initializer_list<params::Sel_> extra = {}) {
+        params::Sheet base = {
+            {Sel: "Path", Desc: "", ParamsSet: {{"Path.Learn.Norm.On", "true"}, {"Path.Learn.Momentum.On", "true"}, {"Path.Learn.WtBal.On", "true"}}},
+            {Sel: "Layer", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "1.8"}, {"Layer.Act.Init.Decay", "0.0"}, {"Layer.Act.Gbar.L", "0.1"}}},
+            {Sel: ".BackPath", Desc: "", ParamsSet: {{"Path.WtScale.Rel", "0.2"}}},
+            {Sel: "#Output", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "1.4"}}},
+        };
+        base.sel.insert(base.sel.end(), extra.begin(), extra.end());
+        return params::Sets({{"Base", base}});
+    }
+
+    // AddLayers adds the layers of the ra25 network to net, with nhid
+    // hidden layers of ny x nx units, Hidden1, Hidden2, ... or just Hidden
+    // if there is one: Full Forward from the Input to the first, and Full
+    // Bidir between the others and on to the Output.
+    inline void AddLayers(leabra::Network *net, int ny = 10, int nx = 10, int nhid = 2) {
+        leabra::Layer *inp = net->AddLayer2D("Input", 5, 5, leabra::InputLayer);
+        std::vector<leabra::Layer*> hids;
+        for (int hi = 0; hi < nhid; hi++) {
+            hids.push_back(net->AddLayer2D(nhid == 1 ? "Hidden" : "Hidden" + std::to_string(hi + 1), ny, nx, leabra::SuperLayer));
+        }
+        leabra::Layer *out = net->AddLayer2D("Output", 5, 5, leabra::TargetLayer);
+        paths::Pattern *full = new paths::Full();
+        net->ConnectLayers(inp, hids[0], full, leabra::ForwardPath);
+        for (int hi = 0; hi < nhid; hi++) {
+            net->BidirConnectLayers(hids[hi], hi + 1 < nhid ? hids[hi + 1] : out, full);
+        }
+    }
+
+    // NewNet returns a new network with the layers of AddLayers.
+    inline leabra::Network *NewNet(std::string name, int ny = 10, int nx = 10, int nhid = 2) {
+        leabra::Network *net = new leabra::Network(name);
+        AddLayers(net, ny, nx, nhid);
+        return net;
+    }
+
+    // NewSim returns a Sim of net with the params ps, on the random 5x5
+    // patterns, initialized for a new run. The patterns are presented in
+    // order if ordered, for runs that must be repeatable.
+    inline leabra::Sim *NewSim(leabra::Network *net, params::Sets *ps, bool ordered = false) {
+        leabra::TabulatedEnv *env = new leabra::TabulatedEnv("random_5x5_25.tsv");
+        leabra::Sim *sim = new leabra::Sim(net, ps, env);
+        sim->Init();
+        sim->NewRun();
+        if (ordered) {
+            std::iota(env->permutation.begin(), env->permutation.end(), 0);
+        }
+        return sim;
+    }
+
+} // namespace ra25
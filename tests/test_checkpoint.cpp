@@ -0,0 +1,118 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+#include "weights.hpp"
+
+// Saves a network to a binary weights checkpoint, re-initializes its weights,
+// then loads the checkpoint back and checks that all of the saved state
+// round-trips bit-exactly.
+
+// SameBits compares the values in their own type (Real, or SynReal for
+// the synapses), so that any precision lost in the round trip is seen.
+template <typename T>
+bool SameBits(T a, T b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+int main() {
+    leabra::Network net("CkptTest");
+    leabra::Layer *inp = net.AddLayer2D("Input", 20, 20, leabra::InputLayer);
+    leabra::Layer *hid = net.AddLayer4D("Hidden", 4, 4, 5, 5, leabra::SuperLayer);
+    leabra::Layer *out = net.AddLayer2D("Output", 10, 10, leabra::TargetLayer);
+    paths::Pattern *full = new paths::Full();
+    net.ConnectLayers(inp, hid, full, leabra::ForwardPath);
+    net.BidirConnectLayers(hid, out, full);
+    net.Build();
+    net.Defaults();
+    net.SetRandSeed(1);
+    net.InitWeights();
+
+    // give the learning and running-average state distinct values
+    for (leabra::Layer *ly: net.Layers) {
+        for (size_t ni = 0; ni < ly->Neurons.size(); ni++) {
+            ly->Neurons[ni].AvgL = 0.1 + 0.001 * ni;
+            ly->Neurons[ni].ActAvg = 0.2 + 0.001 * ni;
+        }
+        for (leabra::Pool &pl: ly->Pools) {
+            pl.ActAvgs.ActPAvg = 0.3;
+        }
+        for (leabra::Path *pt: ly->RecvPaths) {
+            for (size_t si = 0; si < pt->Syns.size(); si++) {
+                pt->Syns[si].DWt = 1e-4 * si;
+                pt->Syns[si].Moment = -1e-4 * si;
+            }
+        }
+    }
+
+    std::vector<std::vector<leabra::Synapse>> syns;
+    for (leabra::Layer *ly: net.Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            syns.push_back(pt->Syns);
+        }
+    }
+    leabra::Neuron hidNrn = hid->Neurons[7];
+
+    std::string fname = "test_checkpoint.wts";
+    auto t0 = std::chrono::steady_clock::now();
+    net.SaveCheckpoint(fname, true);
+    auto t1 = std::chrono::steady_clock::now();
+
+    net.SetRandSeed(2);
+    net.InitWeights();
+    hid->Neurons[7].AvgL = 0;
+
+    auto t2 = std::chrono::steady_clock::now();
+    net.LoadCheckpoint(fname);
+    auto t3 = std::chrono::steady_clock::now();
+
+    int nbad = 0;
+    size_t nsyn = 0;
+    int pi = 0;
+    for (leabra::Layer *ly: net.Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            std::vector<leabra::Synapse> &sv = syns[pi++];
+            for (size_t si = 0; si < sv.size(); si++, nsyn++) {
+                leabra::Synapse &a = sv[si];
+                leabra::Synapse &b = pt->Syns[si];
+                if (!SameBits(a.Wt, b.Wt) || !SameBits(a.LWt, b.LWt) || !SameBits(a.Scale, b.Scale) ||
+                    !SameBits(a.DWt, b.DWt) || !SameBits(a.Norm, b.Norm) || !SameBits(a.Moment, b.Moment)) {
+                    nbad++;
+                }
+            }
+        }
+    }
+    if (!SameBits(hid->Neurons[7].AvgL, hidNrn.AvgL) || !SameBits(hid->Neurons[7].ActAvg, hidNrn.ActAvg)) {
+        nbad++;
+    }
+    std::remove(fname.c_str());
+
+    // a checkpoint of the other float precision is rejected, not converted
+    weights::CkptTypes other = weights::CkptReal == weights::CkptFloat32 ? weights::CkptFloat64 : weights::CkptFloat32;
+    {
+        weights::CkptWriter ck(fname, 0);
+        std::vector<char> zeros(inp->Neurons.size() * weights::CkptTypeSize(other));
+        ck.Begin("Input/AvgL", inp->Neurons.size(), other);
+        ck.Write(zeros.data(), zeros.size());
+        ck.Close();
+    }
+    bool rejected = false;
+    try {
+        net.LoadCheckpoint(fname);
+    } catch (std::runtime_error &e) {
+        rejected = true;
+    }
+    if (!rejected) {
+        std::cout << "checkpoint of the other precision was loaded" << std::endl;
+        nbad++;
+    }
+    std::remove(fname.c_str());
+
+    std::cout << "Synapses: " << nsyn << ", mismatches: " << nbad << std::endl;
+    std::cout << "Save: " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, "
+        << "Load: " << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
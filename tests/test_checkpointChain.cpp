@@ -0,0 +1,117 @@
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include "ra25net.hpp"
+#include "weights.hpp"
+
+// Writes a chain of incremental checkpoints with a Checkpointer, one after
+// each training trial of a network learning in minibatches of 2, so that
+// every other checkpoint is taken with DWt still to be applied. Checks that
+// the rows with pending DWt stay dirty across a save, and that the deltas
+// only hold the rows DWt marked, then rebuilds every checkpoint in the
+// chain into a full one and checks that loading it restores the synapses
+// as they were when it was saved, bit-exactly.
+
+params::Sets ParamSets = ra25::Params();
+
+template <typename T>
+bool SameBits(T a, T b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+std::vector<std::vector<leabra::Synapse>> CopySyns(leabra::Network &net) {
+    std::vector<std::vector<leabra::Synapse>> syns;
+    for (leabra::Layer *ly: net.Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            syns.push_back(pt->Syns);
+        }
+    }
+    return syns;
+}
+
+// PendingClean returns the number of sending rows of the network's
+// pathways with DWt still to be applied that are not marked CkptDirty.
+int PendingClean(leabra::Network &net) {
+    int nbad = 0;
+    for (leabra::Layer *ly: net.Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            for (size_t si = 0; si < pt->SConN.size(); si++) {
+                for (int i = pt->SConIndexSt[si]; i < pt->SConIndexSt[si] + pt->SConN[si]; i++) {
+                    if (pt->Syns[i].DWt != 0 && !pt->CkptDirty[si]) {
+                        nbad++;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return nbad;
+}
+
+int main() {
+    leabra::Network *net = ra25::NewNet("CkptChainTest");
+    leabra::Sim &sim = *ra25::NewSim(net, &ParamSets, true);
+    sim.BatchSize = 2;
+    leabra::Layer *hid = (leabra::Layer*) net->LayerByName("Hidden1");
+    leabra::Path *inPath = hid->RecvPaths[0];
+
+    const int nCkpt = 9;
+    std::string prefix = "test_checkpointChain";
+    std::vector<std::vector<std::vector<leabra::Synapse>>> saved;
+    leabra::Checkpointer ckr(net, prefix, 4, true);
+    int nbad = 0;
+    int npend = 0; // saves taken with DWt pending
+    for (int ci = 0; ci < nCkpt; ci++) {
+        if (ci > 0) {
+            sim.StepTrial(true);
+        }
+        saved.push_back(CopySyns(*net));
+        ckr.Save();
+        npend += sim.BatchN > 0;
+        nbad += PendingClean(*net);
+    }
+    ckr.Wait();
+
+    // the input layer only has a few units active, so the deltas of its
+    // pathway must hold some but not all of its sending rows
+    int nsome = 0;
+    for (int ci = 0; ci < nCkpt; ci++) {
+        weights::CkptFile ck(weights::CkptFileName(prefix, ci + 1));
+        if (!ck.HasFlag(weights::CkptDelta)) {
+            continue;
+        }
+        size_t nrow;
+        ck.IntArray(hid->Name + "/" + inPath->Name + "/RowN", nrow);
+        nsome += nrow > 0 && nrow < inPath->SConN.size();
+    }
+    if (npend == 0 || nsome == 0) {
+        std::cout << "Saves with DWt pending: " << npend << ", deltas of some input rows: " << nsome << std::endl;
+        nbad++;
+    }
+
+    std::string rebuilt = prefix + "-rebuilt.wts";
+    for (int ci = 0; ci < nCkpt; ci++) {
+        weights::RebuildCheckpoint(prefix, ci + 1, rebuilt);
+        net->SetRandSeed(2);
+        net->InitWeights();
+        net->LoadCheckpoint(rebuilt);
+        std::vector<std::vector<leabra::Synapse>> syns = CopySyns(*net);
+        for (size_t pi = 0; pi < syns.size(); pi++) {
+            for (size_t si = 0; si < syns[pi].size(); si++) {
+                leabra::Synapse &a = saved[ci][pi][si];
+                leabra::Synapse &b = syns[pi][si];
+                if (!SameBits(a.Wt, b.Wt) || !SameBits(a.LWt, b.LWt) || !SameBits(a.Scale, b.Scale) ||
+                    !SameBits(a.DWt, b.DWt) || !SameBits(a.Norm, b.Norm) || !SameBits(a.Moment, b.Moment)) {
+                    nbad++;
+                }
+            }
+        }
+    }
+    std::remove(rebuilt.c_str());
+    for (int ci = 0; ci < nCkpt; ci++) {
+        std::remove(weights::CkptFileName(prefix, ci + 1).c_str());
+    }
+
+    std::cout << "Checkpoints: " << nCkpt << ", with DWt pending: " << npend << ", mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
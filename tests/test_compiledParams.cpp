@@ -0,0 +1,189 @@
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <map>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+#include "params.hpp"
+#include "minmax.hpp"
+
+// Compares re-applying a params Sheet with Network::ApplyParams against
+// replaying the same Sheet compiled with Network::CompileParams,
+// on a 200 layer network: the params of every layer and path are
+// snapshot after ApplyParams, reset to their Defaults, and must come out
+// the same, field by field, from the compiled sheet.
+
+params::Sets ParamSets =
+    {
+        {
+            "Base",
+            {
+                {
+                    Sel: "Path",
+                    Desc: "",
+                    ParamsSet: {
+                        {"Path.Learn.Norm.On",     "true"},
+                        {"Path.Learn.Momentum.On", "true"},
+                        {"Path.Learn.Lrate",       "0.02"},
+                    }
+                },
+                {
+                    Sel: "Layer",
+                    Desc: "",
+                    ParamsSet: {
+                        {"Layer.Inhib.Layer.Gi", "1.8"},
+                        {"Layer.Act.Init.Decay", "0.0"},
+                        {"Layer.Act.Gbar.L",     "0.1"},
+                    }
+                },
+                {
+                    Sel: ".Odd",
+                    Desc: "",
+                    ParamsSet: {
+                        {"Layer.Inhib.Layer.Gi", "2.0"},
+                    }
+                },
+                {
+                    Sel: "#Layer_100",
+                    Desc: "",
+                    ParamsSet: {
+                        {"Layer.Inhib.Layer.Gi", "1.4"},
+                    }
+                },
+            }
+        }
+    };
+
+// Bytes returns the bytes of v.
+template <typename T>
+std::string Bytes(const T &v) {
+    return std::string((const char *)&v, sizeof(v));
+}
+
+// Snapshot records the bytes of every param field of obj, under its path
+// from pfx, going into the param structs nested in it. MinMax ranges are
+// recorded whole, and the WtInit distribution (not a StylerObject) by field.
+void Snapshot(params::StylerObject *obj, std::string pfx, std::map<std::string, std::string> &vals) {
+    for (auto &[name, fld]: obj->ParamFields().Fields) {
+        const char *ptr = (const char *)obj + fld.Offset;
+        const std::type_info &typ = *fld.Type;
+        std::string key = pfx + name;
+        if (typ == typeid(float)) {
+            vals[key] = Bytes(*(const float *)ptr);
+        } else if (typ == typeid(double)) {
+            vals[key] = Bytes(*(const double *)ptr);
+        } else if (typ == typeid(int)) {
+            vals[key] = Bytes(*(const int *)ptr);
+        } else if (typ == typeid(bool)) {
+            vals[key] = Bytes(*(const bool *)ptr);
+        } else if (typ == typeid(leabra::ActNoiseType)) {
+            vals[key] = Bytes(*(const leabra::ActNoiseType *)ptr);
+        } else if (typ == typeid(minmax::MinMax<float>)) {
+            auto &mm = *(const minmax::MinMax<float> *)ptr;
+            vals[key] = Bytes(mm.Min) + Bytes(mm.Max);
+        } else if (typ == typeid(minmax::MinMax<double>)) {
+            auto &mm = *(const minmax::MinMax<double> *)ptr;
+            vals[key] = Bytes(mm.Min) + Bytes(mm.Max);
+        } else if (typ == typeid(leabra::WtInitParams)) {
+            auto &wi = *(const leabra::WtInitParams *)ptr;
+            vals[key + ".Mean"] = Bytes(wi.Mean);
+            vals[key + ".Var"] = Bytes(wi.Var);
+            vals[key + ".Par"] = Bytes(wi.Par);
+            vals[key + ".DistType"] = Bytes(wi.DistType);
+            vals[key + ".Sym"] = Bytes(wi.Sym);
+        } else {
+            Snapshot((params::StylerObject *)ptr, key + ".", vals);
+        }
+    }
+}
+
+std::map<std::string, std::string> SnapshotAll(leabra::Network &net) {
+    std::map<std::string, std::string> vals;
+    for (leabra::Layer *ly: net.Layers) {
+        Snapshot(ly, ly->Name + ".", vals);
+        for (leabra::Path *pt: ly->RecvPaths) {
+            Snapshot(pt, pt->Name + ".", vals);
+        }
+    }
+    return vals;
+}
+
+int main() {
+    const int nLayers = 200;
+    const int nReps = 100;
+
+    leabra::Network net("ParamsBench");
+    paths::Pattern *full = new paths::Full();
+    leabra::Layer *prev = nullptr;
+    for (int li = 0; li < nLayers; li++) {
+        leabra::Layer *ly = net.AddLayer2D("Layer_" + std::to_string(li), 5, 5, leabra::SuperLayer);
+        if (li % 2 == 1) {
+            ly->SetClass("Odd");
+        }
+        if (prev != nullptr) {
+            net.ConnectLayers(prev, ly, full, leabra::ForwardPath);
+        }
+        prev = ly;
+    }
+    net.Build();
+    net.Defaults();
+    std::map<std::string, std::string> defaults = SnapshotAll(net);
+
+    // ApplyParams logs each layer, so silence cout while timing
+    std::ostringstream devnull;
+    std::streambuf *coutBuf = std::cout.rdbuf(devnull.rdbuf());
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int ri = 0; ri < nReps; ri++) {
+        net.ApplyParams(ParamSets, false);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    std::map<std::string, std::string> applied = SnapshotAll(net);
+
+    emer::CompiledParams cp = net.CompileParams(ParamSets);
+    auto t2 = std::chrono::steady_clock::now();
+    net.Defaults();
+    for (int ri = 0; ri < nReps; ri++) {
+        cp.Apply();
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    std::cout.rdbuf(coutBuf);
+    std::map<std::string, std::string> compiled = SnapshotAll(net);
+
+    int nbad = 0;
+    for (auto &[key, val]: applied) {
+        if (compiled[key] != val) {
+            if (nbad < 10) {
+                std::cout << "Mismatch: " << key << std::endl;
+            }
+            nbad++;
+        }
+    }
+    int nset = 0; // fields the sheet changed from their defaults
+    for (auto &[key, val]: applied) {
+        nset += defaults[key] != val;
+    }
+    if (nset == 0 || compiled.size() != applied.size()) {
+        nbad++;
+    }
+
+    double applyMs = std::chrono::duration<double, std::milli>(t1 - t0).count() / nReps;
+    double compileMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    double compiledMs = std::chrono::duration<double, std::milli>(t3 - t2).count() / nReps;
+
+    std::cout << "Layers: " << nLayers << ", compiled writes: " << cp.Writes.size()
+        << ", targets: " << cp.Targets.size() << std::endl;
+    std::cout << "ApplyParams:     " << applyMs << " ms / apply" << std::endl;
+    std::cout << "CompileParams:   " << compileMs << " ms (once)" << std::endl;
+    std::cout << "Compiled Apply:  " << compiledMs << " ms / apply (" << applyMs / compiledMs << "x)" << std::endl;
+
+    leabra::Layer *l100 = (leabra::Layer *)net.LayerByName("Layer_100");
+    leabra::Layer *l101 = (leabra::Layer *)net.LayerByName("Layer_101");
+    std::cout << "Layer_100 Gi: " << l100->Inhib.Layer.Gi << " Layer_101 Gi: " << l101->Inhib.Layer.Gi << std::endl;
+    std::cout << "Fields: " << applied.size() << ", set by the sheet: " << nset << std::endl;
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <cstring>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+#include "weights.hpp"
+
+// Builds the same 200 pathway network with the connectivity cache off,
+// then from the in-process cache, then from cache files only, and checks
+// that all of them get the same connection indexes. Corrupt indexes must
+// not be saved, and cache files of the right sizes changed to hold them
+// must be rebuilt, and replaced.
+
+const int nLayers = 201;
+
+leabra::Network *NewNet(paths::Pattern *pat) {
+    leabra::Network *net = new leabra::Network("ConnCacheTest");
+    leabra::Layer *prev = nullptr;
+    for (int li = 0; li < nLayers; li++) {
+        leabra::Layer *ly = net->AddLayer2D("Layer_" + std::to_string(li), 12, 12, leabra::SuperLayer);
+        if (prev != nullptr) {
+            net->ConnectLayers(prev, ly, pat, leabra::ForwardPath);
+        }
+        prev = ly;
+    }
+    return net;
+}
+
+double BuildMs(leabra::Network *net) {
+    auto t0 = std::chrono::steady_clock::now();
+    net->Build();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// ConnMs times getting the connection indexes of all the paths from the cache,
+// which is the part of Build that the cache replaces.
+double ConnMs(leabra::Network *net) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (leabra::Layer *ly: net->Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            paths::DefaultConnCache.Get(*pt->Pattern, pt->Send->Shape, pt->Recv->Shape, pt->Send == pt->Recv);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// Overwrite replaces the lists in cache file fname with those of ci, of the
+// same sizes, and changes its checksum if badSum. The file is replaced by
+// renaming, as ConnCache.Save does, as the cache may still map it.
+void Overwrite(const std::string &fname, const paths::ConnIndexes &ci, bool badSum) {
+    std::vector<char> data;
+    {
+        weights::CkptFile cf(fname);
+        data.assign(cf.Data, cf.Data + cf.Size);
+        auto put = [&](const char *nm, std::span<const int> vals) {
+            std::memcpy(data.data() + cf.Entries.at(nm)->Off, vals.data(), vals.size_bytes());
+        };
+        put("SConN", ci.SConN);
+        put("SConIndexSt", ci.SConIndexSt);
+        put("SConIndex", ci.SConIndex);
+        put("RConN", ci.RConN);
+        put("RConIndexSt", ci.RConIndexSt);
+        put("RConIndex", ci.RConIndex);
+        put("RSynIndex", ci.RSynIndex);
+        if (badSum) {
+            data[cf.Entries.at("Sum")->Off] ^= 1;
+        }
+    }
+    std::string tmp = fname + ".tmp";
+    std::ofstream(tmp, std::ios::binary).write(data.data(), data.size());
+    std::filesystem::rename(tmp, fname);
+}
+
+bool Same(std::span<const int> a, std::span<const int> b) {
+    return std::ranges::equal(a, b);
+}
+
+int Mismatches(leabra::Network *a, leabra::Network *b) {
+    int nbad = 0;
+    for (size_t li = 0; li < a->Layers.size(); li++) {
+        for (size_t pi = 0; pi < a->Layers[li]->RecvPaths.size(); pi++) {
+            leabra::Path *pa = a->Layers[li]->RecvPaths[pi];
+            leabra::Path *pb = b->Layers[li]->RecvPaths[pi];
+            if (!Same(pa->SConN, pb->SConN) || !Same(pa->SConIndexSt, pb->SConIndexSt) || !Same(pa->SConIndex, pb->SConIndex) ||
+                !Same(pa->RConN, pb->RConN) || !Same(pa->RConIndexSt, pb->RConIndexSt) || !Same(pa->RConIndex, pb->RConIndex) ||
+                !Same(pa->RSynIndex, pb->RSynIndex) || pa->Syns.size() != pb->Syns.size() ||
+                pa->SConNAvgMax.Max != pb->SConNAvgMax.Max || pa->RConNAvgMax.Avg != pb->RConNAvgMax.Avg) {
+                nbad++;
+            }
+        }
+    }
+    return nbad;
+}
+
+int main() {
+    paths::Pattern *full = new paths::Full();
+    paths::ConnCache &cache = paths::DefaultConnCache;
+    std::string dir = "test_connCache.d";
+    std::filesystem::create_directory(dir);
+
+    cache.On = false;
+    leabra::Network *ref = NewNet(full);
+    double offMs = BuildMs(ref);
+
+    cache.On = true;
+    cache.Dir = dir;
+    leabra::Network *cold = NewNet(full);
+    double coldMs = BuildMs(cold);
+
+    leabra::Network *mem = NewNet(full);
+    double memMs = BuildMs(mem);
+    int misses = cache.Misses;
+
+    cache.Clear();
+    leabra::Network *file = NewNet(full);
+    double fileMs = BuildMs(file);
+    int fileHits = cache.FileHits;
+    int fileMisses = cache.Misses;
+
+    int nbad = Mismatches(ref, cold) + Mismatches(ref, mem) + Mismatches(ref, file);
+    // all of the paths have the same pattern and shapes, and view the
+    // lists in the file in place when loaded from it
+    if (misses != 1 || fileHits != 1 || fileMisses != 0 || file->Layers[1]->RecvPaths[0]->Conns->File == nullptr) {
+        nbad++;
+    }
+
+    // corrupt the indexes in ways that keep the array sizes
+    leabra::Path *pt = ref->Layers[1]->RecvPaths[0];
+    std::string key = paths::ConnKey(*full, pt->Send->Shape, pt->Recv->Shape, false);
+    std::string fname = dir + "/" + cache.FileName(key);
+    std::vector<std::function<void(paths::ConnIndexes::Lists&)>> corrupts = {
+        [](paths::ConnIndexes::Lists &ci) { ci.SConIndex[5] = ci.RConN.size() + 3; },
+        [](paths::ConnIndexes::Lists &ci) { ci.RConIndex[7] = -1; },
+        [](paths::ConnIndexes::Lists &ci) { ci.RSynIndex[9] = ci.RSynIndex[10]; },
+        [](paths::ConnIndexes::Lists &ci) { ci.SConIndexSt[2]++; },
+        [](paths::ConnIndexes::Lists &ci) { ci.RConN[0]--; ci.RConN[1]++; },
+    };
+    int nrebuilt = 0;
+    int nrefused = 0;
+    for (auto &corrupt: corrupts) {
+        std::shared_ptr<paths::ConnIndexes> bad = paths::NewConnIndexes(*full, pt->Send->Shape, pt->Recv->Shape, false);
+        corrupt(bad->Built);
+        bad->View();
+        try {
+            cache.Save(fname, key, *bad);
+        } catch (const std::runtime_error &e) {
+            nrefused++;
+        }
+        Overwrite(fname, *bad, false);
+        cache.Clear();
+        std::cerr.setstate(std::ios::failbit); // the rebuilding message
+        std::shared_ptr<const paths::ConnIndexes> ci = cache.Get(*full, pt->Send->Shape, pt->Recv->Shape, false);
+        std::cerr.clear();
+        nrebuilt += cache.Misses == 1 && cache.FileHits == 0 && Same(ci->SConIndex, pt->SConIndex) && Same(ci->RSynIndex, pt->RSynIndex);
+        cache.Clear();
+        ci = cache.Get(*full, pt->Send->Shape, pt->Recv->Shape, false); // from the replaced file
+        nrebuilt += cache.FileHits == 1 && ci->File != nullptr;
+    }
+    if (nrebuilt != 2 * int(corrupts.size()) || nrefused != int(corrupts.size())) {
+        std::cout << "Corrupt cache files rebuilt: " << nrebuilt / 2 << ", not saved: " << nrefused << " of " << corrupts.size() << std::endl;
+        nbad++;
+    }
+
+    // consistent indexes with a checksum that does not match are checked, and used
+    Overwrite(fname, *paths::NewConnIndexes(*full, pt->Send->Shape, pt->Recv->Shape, false), true);
+    cache.Clear();
+    std::shared_ptr<const paths::ConnIndexes> ci = cache.Get(*full, pt->Send->Shape, pt->Recv->Shape, false);
+    if (cache.FileHits != 1 || cache.Misses != 0 || !Same(ci->SConIndex, pt->SConIndex) || !Same(ci->RSynIndex, pt->RSynIndex)) {
+        std::cout << "Cache file with a bad checksum was not used" << std::endl;
+        nbad++;
+    }
+    ci = nullptr;
+
+    cache.On = false;
+    double offConnMs = ConnMs(ref);
+    cache.On = true;
+    double memConnMs = ConnMs(ref);
+    cache.Clear();
+    double fileConnMs = ConnMs(ref);
+
+    cache.Dir = "";
+    std::filesystem::remove_all(dir);
+
+    std::cout << "Paths: " << nLayers - 1 << ", mismatches: " << nbad << std::endl;
+    std::cout << "Build no cache: " << offMs << " ms, first: " << coldMs << " ms, "
+        << "in process: " << memMs << " ms, from file: " << fileMs << " ms" << std::endl;
+    std::cout << "Connection indexes only, no cache: " << offConnMs << " ms, in process: " << memConnMs
+        << " ms, from file: " << fileConnMs << " ms" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
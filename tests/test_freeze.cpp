@@ -0,0 +1,224 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include "ra25net.hpp"
+
+// Trains a network with a Tied pathway pair, then freezes it and checks
+// that it gives the same outputs, with and without GScale premultiplied,
+// using less memory, and that learning on it throws. Also checks that a
+// Shared pathway sends the same conductances once frozen, that a Build
+// unfreezes a network, and times Inference.Run before and after freezing.
+
+params::Sets ParamSets = ra25::Params();
+
+struct TestNet {
+    leabra::Network *Net;
+    leabra::Sim *Sim;
+
+    // TestNet trains a network for the given epochs, with the Hidden1 /
+    // Hidden2 pathways Tied, and sets it to start each trial from rest.
+    TestNet(int epochs) {
+        Net = ra25::NewNet("FreezeTest");
+        Sim = ra25::NewSim(Net, &ParamSets);
+        Net->Layers[1]->SendPaths[0]->Tied = true; // Hidden1 to Hidden2, and back
+        Net->Layers[2]->SendPaths[0]->Tied = true;
+        Sim->NewRun(); // InitWeights ties them
+        for (int ep = 0; ep < epochs; ep++) {
+            Sim->StepEpoch(true);
+        }
+        for (leabra::Layer *ly: Net->Layers) {
+            ly->Act.Init.Decay = 1;
+        }
+    }
+};
+
+// Outputs runs inf on each of the inputs, returning the outputs, and the
+// p50 latency over reps runs of each, in us.
+std::vector<std::vector<float>> Outputs(leabra::Inference &inf, std::vector<float> &in, std::vector<float> &out,
+    const std::vector<std::vector<float>> &inputs, int reps, double &p50) {
+    std::vector<std::vector<float>> outs;
+    std::vector<double> us;
+    for (const std::vector<float> &pat: inputs) {
+        std::copy(pat.begin(), pat.end(), in.begin());
+        for (int r = 0; r < reps; r++) {
+            auto t0 = std::chrono::steady_clock::now();
+            inf.Run();
+            auto t1 = std::chrono::steady_clock::now();
+            us.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+        }
+        outs.push_back(out);
+    }
+    std::sort(us.begin(), us.end());
+    p50 = us[us.size() / 2];
+    return outs;
+}
+
+// SendUs times sending conductances from all the sending units of pt, in us.
+double SendUs(leabra::Path *pt) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < 100; rep++) {
+        for (int si = 0; si < int(pt->SConN.size()); si++) {
+            pt->SendGDelta(si, 0.1);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / 100;
+}
+
+float MaxDiff(const std::vector<std::vector<float>> &a, const std::vector<std::vector<float>> &b) {
+    float mx = 0;
+    for (size_t t = 0; t < a.size(); t++) {
+        for (size_t i = 0; i < a[t].size(); i++) {
+            mx = std::max(mx, std::abs(a[t][i] - b[t][i]));
+        }
+    }
+    return mx;
+}
+
+// Throws returns true if fun throws a std::runtime_error.
+template <typename F>
+bool Throws(F fun) {
+    try {
+        fun();
+    } catch (std::runtime_error &e) {
+        return true;
+    }
+    return false;
+}
+
+// SharedNet returns a network with a Shared PoolTile pathway, pt.
+leabra::Network *SharedNet(leabra::Path *&pt) {
+    leabra::Network *net = new leabra::Network("FreezeShared");
+    leabra::Layer *inp = net->AddLayer4D("Input", 8, 8, 2, 2, leabra::InputLayer);
+    leabra::Layer *hid = net->AddLayer4D("Hidden", 4, 4, 3, 3, leabra::SuperLayer);
+    pt = net->ConnectLayers(inp, hid, new paths::PoolTile(), leabra::ForwardPath);
+    net->Build();
+    net->Defaults();
+    pt->Shared = true;
+    net->SetRandSeed(1);
+    net->InitWeights();
+    return net;
+}
+
+// SharedGInc returns the GInc of a Shared PoolTile pathway from a fixed
+// set of sending deltas, freezing it first if freeze.
+std::vector<Real> SharedGInc(bool freeze) {
+    leabra::Path *pt;
+    leabra::Network *net = SharedNet(pt);
+    pt->GScale = 0.7;
+    if (freeze) {
+        net->Freeze(true);
+    }
+    for (int si = 0; si < int(pt->SConN.size()); si++) {
+        pt->SendGDelta(si, 0.1 + 0.8 * std::fmod(si * 0.29, 1.0));
+    }
+    return pt->GInc;
+}
+
+int main() {
+    int nbad = 0;
+    TestNet a(10);
+    if (a.Net->Layers[2]->SendPaths[0]->TiedTo != a.Net->Layers[1]->SendPaths[0]) {
+        std::cout << "Hidden2 to Hidden1 is not tied" << std::endl;
+        nbad++;
+    }
+    leabra::Layer *inp = (leabra::Layer*) a.Net->LayerByName("Input");
+    std::vector<std::vector<float>> inputs;
+    for (int t = 0; t < a.Sim->Env->NumTrials(); t++) {
+        a.Sim->StepTrial(false);
+        std::vector<float> pat;
+        for (leabra::Neuron &nrn: inp->Neurons) {
+            pat.push_back(nrn.Ext);
+        }
+        inputs.push_back(pat);
+    }
+    a.Sim->Env->EndEpoch();
+
+    const int reps = 20;
+    std::vector<float> in(25), out(25);
+    leabra::Inference inf(a.Net);
+    inf.BindInput("Input", in.data(), in.size());
+    inf.BindOutput("Output", out.data(), out.size());
+    double fullUs, frozenUs, scaledUs;
+    auto ref = Outputs(inf, in, out, inputs, reps, fullUs);
+    leabra::MemReport full = a.Net->MemoryReport();
+    leabra::Layer *hid2 = (leabra::Layer*) a.Net->LayerByName("Hidden2");
+    leabra::Path *fwd = hid2->RecvPaths[0];
+    double fullSendUs = SendUs(fwd);
+    std::string fname = "test_freeze.wts";
+    a.Net->SaveCheckpoint(fname);
+    leabra::MemReport frozen = a.Net->Freeze();
+    auto outs = Outputs(inf, in, out, inputs, reps, frozenUs);
+    double frozenSendUs = SendUs(fwd);
+    float frozenDiff = MaxDiff(ref, outs);
+    if (frozenDiff != 0 || frozen.SynapseState >= full.SynapseState / 3 || !a.Net->Frozen) {
+        nbad++;
+    }
+
+    // learning fails
+    if (!Throws([&]() { a.Net->Dwt(); }) || !Throws([&]() { a.Net->WtFromDwt(); }) || !Throws([&]() { a.Sim->StepTrial(true); }) ||
+        !Throws([&]() { a.Net->Prune(0.1); }) || !Throws([&]() { a.Net->InitWeights(); }) || !Throws([&]() { a.Net->SaveCheckpoint(fname); }) ||
+        !Throws([&]() { fwd->DWt(); })) {
+        nbad++;
+    }
+    a.Sim->StepTrial(false); // testing still works
+
+    // premultiplied by GScale, on a copy of the network
+    TestNet b(0);
+    b.Net->LoadCheckpoint(fname);
+    std::remove(fname.c_str());
+    leabra::Inference infb(b.Net);
+    infb.BindInput("Input", in.data(), in.size());
+    infb.BindOutput("Output", out.data(), out.size());
+    double bUs;
+    if (MaxDiff(ref, Outputs(infb, in, out, inputs, 1, bUs)) != 0) {
+        nbad++;
+    }
+    b.Net->Freeze(true);
+    float scaledDiff = MaxDiff(ref, Outputs(infb, in, out, inputs, reps, scaledUs));
+    if (scaledDiff > 0.01) { // rounding differences, over 75 cycles
+        nbad++;
+    }
+
+    std::vector<Real> shared = SharedGInc(false), sharedFrozen = SharedGInc(true);
+    for (size_t ri = 0; ri < shared.size(); ri++) {
+        if (std::abs(shared[ri] - sharedFrozen[ri]) > 1e-5) {
+            nbad++;
+        }
+    }
+
+    // a Build unfreezes, with the full pattern of a pathway pruned before freezing
+    TestNet c(0);
+    leabra::Path *hout = ((leabra::Layer*) c.Net->LayerByName("Output"))->RecvPaths[0];
+    int nfull = hout->NumSyns();
+    hout->Prune(0, 0.5);
+    c.Net->Freeze();
+    c.Net->Build();
+    bool frozenLeft = c.Net->Frozen;
+    for (leabra::Layer *ly: c.Net->Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            frozenLeft = frozenLeft || pt->Frozen || !pt->FrozenWt.empty();
+        }
+    }
+    if (frozenLeft || hout->NumSyns() != nfull || int(hout->Syns.size()) != nfull ||
+        Throws([&]() { c.Net->InitWeights(); c.Sim->StepTrial(true); })) {
+        nbad++;
+    }
+    leabra::Path *spt;
+    leabra::Network *snet = SharedNet(spt);
+    snet->Freeze();
+    snet->Build();
+    snet->InitWeights();
+    if (spt->Frozen || spt->Kernel == nullptr || !spt->FrozenWt.empty()) {
+        nbad++;
+    }
+
+    std::cout << "Mismatches: " << nbad << ", max Output diff frozen: " << frozenDiff << ", with GScale: " << scaledDiff << std::endl;
+    std::cout << "Synapse state: " << full.SynapseState << " bytes, frozen: " << frozen.SynapseState << " bytes" << std::endl;
+    std::cout << "Network resident: " << full.Resident() << " bytes, frozen: " << frozen.Resident() << " bytes" << std::endl;
+    std::cout << "SendGDelta pass, " << fwd->NumSyns() << " synapses: " << fullSendUs << " us, frozen: " << frozenSendUs << " us" << std::endl;
+    std::cout << "Inference.Run p50: " << fullUs << " us, frozen: " << frozenUs << " us, with GScale: " << scaledUs << " us" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
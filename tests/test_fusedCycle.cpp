@@ -0,0 +1,185 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+#include <array>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+#include "sim.hpp"
+
+// Trains two copies of a network, with pooled inhibition in the hidden layer,
+// on the random 5x5 patterns: one with Network.Cycle, which uses the fused
+// Layer.Cycle, and one with the separate SendGDelta, AvgMaxGe,
+// InhibFromGeAct, ActFromG and AvgMaxAct steps, checking that their neuron
+// and pool state stays exactly the same. Then reports the time per cycle of
+// the separate steps and of Layer.Cycle for layers larger than the L2 cache.
+
+params::Sets ParamSets = {{"Base", {
+    {Sel: "Path", Desc: "", ParamsSet: {{"Path.Learn.Norm.On", "true"}, {"Path.Learn.Momentum.On", "true"}, {"Path.Learn.WtBal.On", "true"}}},
+    {Sel: "Layer", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "1.8"}, {"Layer.Act.Init.Decay", "0.0"}, {"Layer.Act.Gbar.L", "0.1"}}},
+    {Sel: "#Hidden", Desc: "", ParamsSet: {{"Layer.Inhib.Pool.On", "true"}, {"Layer.Inhib.Pool.Gi", "2.0"}, {"Layer.Inhib.Self.On", "true"}}},
+    {Sel: ".BackPath", Desc: "", ParamsSet: {{"Path.WtScale.Rel", "0.2"}}},
+    {Sel: "#Output", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "1.4"}}},
+}}};
+
+// AddLayers adds the layers and pathways to net, with the Hidden layer in
+// npy x npx pools of nny x nnx units, or nny x nnx without pools if npy is 0.
+void AddLayers(leabra::Network *net, int npy, int npx, int nny, int nnx) {
+    leabra::Layer *inp = net->AddLayer2D("Input", 5, 5, leabra::InputLayer);
+    leabra::Layer *hid = npy > 0 ? net->AddLayer4D("Hidden", npy, npx, nny, nnx, leabra::SuperLayer) :
+        net->AddLayer2D("Hidden", nny, nnx, leabra::SuperLayer); // no pools
+    leabra::Layer *out = net->AddLayer2D("Output", 5, 5, leabra::TargetLayer);
+    paths::Pattern *full = new paths::Full();
+    net->ConnectLayers(inp, hid, full, leabra::ForwardPath);
+    net->BidirConnectLayers(hid, out, full);
+}
+
+// StepCycle runs one cycle with Network.Cycle if fused, else step by step.
+void StepCycle(leabra::Network *net, leabra::Context *ctx, bool fused) {
+    if (fused) {
+        net->Cycle(ctx);
+        return;
+    }
+    net->SendGDelta(ctx);
+    net->AvgMaxGe(ctx);
+    net->InhibFromGeAct(ctx);
+    net->ActFromG(ctx);
+    net->AvgMaxAct(ctx);
+    for (leabra::Layer *ly: net->Layers) {
+        ly->CyclePost(ctx);
+    }
+}
+
+// Trial runs a training trial as Sim.AlphaCyc does, with StepCycle.
+void Trial(leabra::Sim &sim, bool fused) {
+    sim.ApplyInputs();
+    sim.Ctx->Mode = leabra::Train;
+    sim.Net->AlphaCycInit(true);
+    sim.Ctx->AlphaCycStart();
+    for (int qtr = 0; qtr < 4; qtr++) {
+        for (int cyc = 0; cyc < sim.Ctx->CycPerQtr; cyc++) {
+            StepCycle(sim.Net, sim.Ctx, fused);
+            sim.Ctx->CycleInc();
+        }
+        sim.Net->QuarterFinal(sim.Ctx);
+        sim.Ctx->QuarterInc();
+    }
+    sim.Net->Dwt();
+    sim.Net->WtFromDwt();
+    sim.Env->Step();
+}
+
+bool SameAvgMax(const minmax::AvgMax<Real> &a, const minmax::AvgMax<Real> &b) {
+    return a.Avg == b.Avg && a.Sum == b.Sum && a.Max == b.Max && a.N == b.N && a.MaxIndex == b.MaxIndex;
+}
+
+// Diffs returns the number of neurons and pools whose state differs.
+int Diffs(leabra::Network *a, leabra::Network *b) {
+    int nd = 0;
+    for (size_t li = 0; li < a->Layers.size(); li++) {
+        leabra::Layer *la = a->Layers[li], *lb = b->Layers[li];
+        for (size_t ni = 0; ni < la->Neurons.size(); ni++) {
+            leabra::Neuron &na = la->Neurons[ni], &nb = lb->Neurons[ni];
+            size_t nbytes = (&na.ISIAvg - &na.Act + 1) * sizeof(Real); // the contiguous Real state
+            if (na.Flags != nb.Flags || std::memcmp(&na.Act, &nb.Act, nbytes) != 0) {
+                nd++;
+            }
+        }
+        for (size_t pi = 0; pi < la->Pools.size(); pi++) {
+            fffb::Inhib &ia = la->Pools[pi].Inhib, &ib = lb->Pools[pi].Inhib;
+            if (ia.FFi != ib.FFi || ia.FBi != ib.FBi || ia.Gi != ib.Gi || ia.GiOrig != ib.GiOrig || ia.LayGi != ib.LayGi ||
+                !SameAvgMax(ia.Ge, ib.Ge) || !SameAvgMax(ia.Act, ib.Act)) {
+                nd++;
+            }
+        }
+        if (la->ActDelMax != lb->ActDelMax) {
+            nd++;
+        }
+    }
+    return nd;
+}
+
+// CycleUs returns the time per cycle of the steps after SendGDelta on the
+// Hidden layer of net, separately if !fused, else with Layer.Cycle.
+double CycleUs(leabra::Network *net, leabra::Context *ctx, bool fused, int ncyc) {
+    leabra::Layer *ly = net->Layers[1];
+    auto t0 = std::chrono::steady_clock::now();
+    for (int cyc = 0; cyc < ncyc; cyc++) {
+        if (fused) {
+            ly->Cycle(ctx);
+        } else {
+            ly->GFromInc(ctx);
+            ly->AvgMaxGe(ctx);
+            ly->InhibFromGeAct(ctx);
+            ly->ActFromG(ctx);
+            ly->AvgMaxAct(ctx);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / ncyc;
+}
+
+int main() {
+    int nbad = 0;
+    leabra::Network *nets[2];
+    leabra::TabulatedEnv *envs[2];
+    leabra::Sim *sims[2];
+    for (int i = 0; i < 2; i++) {
+        nets[i] = new leabra::Network(i == 0 ? "Fused" : "Steps");
+        AddLayers(nets[i], 3, 3, 4, 4);
+        envs[i] = new leabra::TabulatedEnv("random_5x5_25.tsv");
+        sims[i] = new leabra::Sim(nets[i], &ParamSets, envs[i]);
+        sims[i]->Init();
+        sims[i]->NewRun();
+        std::iota(envs[i]->permutation.begin(), envs[i]->permutation.end(), 0);
+    }
+    for (size_t li = 0; li < nets[0]->Layers.size(); li++) { // the same initial weights
+        for (size_t pi = 0; pi < nets[0]->Layers[li]->RecvPaths.size(); pi++) {
+            nets[1]->Layers[li]->RecvPaths[pi]->Syns = nets[0]->Layers[li]->RecvPaths[pi]->Syns;
+        }
+    }
+    int ntrl = 0, ndiff = 0;
+    for (int ep = 0; ep < 3; ep++) {
+        while (!envs[0]->EndEpoch()) {
+            envs[1]->EndEpoch();
+            Trial(*sims[0], true);
+            Trial(*sims[1], false);
+            ndiff += Diffs(nets[0], nets[1]) > 0;
+            ntrl++;
+        }
+    }
+    std::cout << "Trials with differences between fused and separate steps: " << ndiff << " of " << ntrl << std::endl;
+    nbad += ndiff;
+
+    // large layers: 25600 neurons, pooled and not
+    for (auto [npy, npx, nny, nnx]: std::vector<std::array<int, 4>>{{20, 20, 8, 8}, {0, 0, 160, 160}}) {
+        leabra::Network large("Large");
+        leabra::Network *net = &large;
+        AddLayers(net, npy, npx, nny, nnx);
+        leabra::TabulatedEnv *env = new leabra::TabulatedEnv("random_5x5_25.tsv");
+        leabra::Sim sim(net, &ParamSets, env);
+        sim.Init();
+        sim.NewRun();
+        sim.ApplyInputs();
+        net->AlphaCycInit(true);
+        sim.Ctx->AlphaCycStart();
+        for (int cyc = 0; cyc < 10; cyc++) { // some activity
+            net->Cycle(sim.Ctx);
+            sim.Ctx->CycleInc();
+        }
+        leabra::Layer *hid = net->Layers[1];
+        double mb = double(hid->Neurons.size() * sizeof(leabra::Neuron)) / (1 << 20);
+        CycleUs(net, sim.Ctx, false, 20); // warm up
+        double sepUs = 0, fusedUs = 0;
+        for (int rep = 0; rep < 10; rep++) { // alternating, as the activity changes
+            sepUs += CycleUs(net, sim.Ctx, false, 20) / 10;
+            fusedUs += CycleUs(net, sim.Ctx, true, 20) / 10;
+        }
+        std::cout << "Hidden " << hid->Neurons.size() << " neurons (" << mb << " MB) in " << hid->Pools.size() - 1
+            << " pools: separate steps " << sepUs << " us/cycle, Layer.Cycle " << fusedUs << " us/cycle" << std::endl;
+    }
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
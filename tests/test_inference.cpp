@@ -0,0 +1,155 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <new>
+#include <cstdlib>
+#include "ra25net.hpp"
+
+// Trains a network on the random 5x5 patterns, then checks that Inference
+// gives the same minus phase Output activations as a Sim test trial, with
+// no heap allocations in Run and no change to the learning averages.
+// Reports the p50 / p99 latency of Inference.Run and Sim.StepTrial.
+
+// counts the heap allocations made while counting is on
+static bool counting = false;
+static int nalloc = 0;
+
+// GCC warns about the free in the replacement deletes wherever they are
+// inlined into a delete of memory from new, which here is also malloc'd.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void *operator new(size_t sz) {
+    if (counting) {
+        nalloc++;
+    }
+    void *p = std::malloc(sz);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    std::free(p);
+}
+
+#pragma GCC diagnostic pop
+
+params::Sets ParamSets = ra25::Params();
+
+// Percentile returns the p'th percentile (0-1) of the times in us.
+double Percentile(std::vector<double> us, double p) {
+    std::sort(us.begin(), us.end());
+    return us[int(p * (us.size() - 1))];
+}
+
+int main() {
+    int nbad = 0;
+    leabra::Network *net = ra25::NewNet("InferenceTest", 7, 7);
+    leabra::Sim &sim = *ra25::NewSim(net, &ParamSets);
+    for (int ep = 0; ep < 20; ep++) {
+        sim.StepEpoch(true);
+    }
+    // each trial starts from rest, so that both give the same activations
+    for (leabra::Layer *ly: net->Layers) {
+        ly->Act.Init.Decay = 1;
+    }
+    leabra::Layer *inp = (leabra::Layer*) net->LayerByName("Input");
+    leabra::Layer *out = (leabra::Layer*) net->LayerByName("Output");
+    int ntrl = sim.Env->NumTrials();
+
+    // Sim test trials
+    std::vector<std::vector<float>> inputs, simOuts;
+    std::vector<double> simUs;
+    for (int t = 0; t < ntrl; t++) {
+        std::vector<float> in(inp->Neurons.size()), actm(out->Neurons.size());
+        auto t0 = std::chrono::steady_clock::now();
+        sim.StepTrial(false);
+        auto t1 = std::chrono::steady_clock::now();
+        simUs.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+        for (size_t i = 0; i < in.size(); i++) {
+            in[i] = inp->Neurons[i].Ext;
+        }
+        for (size_t i = 0; i < actm.size(); i++) {
+            actm[i] = out->Neurons[i].ActM;
+        }
+        inputs.push_back(in);
+        simOuts.push_back(actm);
+    }
+    std::vector<Real> avgS;
+    for (leabra::Layer *ly: net->Layers) {
+        for (leabra::Neuron &nrn: ly->Neurons) {
+            avgS.push_back(nrn.AvgS);
+        }
+    }
+
+    leabra::Inference inf(net);
+    std::vector<float> inBuf(inp->Neurons.size()), outBuf(out->Neurons.size());
+    if (!inf.BindInput("Input", inBuf.data(), inBuf.size()) || !inf.BindOutput("Output", outBuf.data(), outBuf.size())) {
+        nbad++;
+    }
+    if (inf.BindInput("Hidden1", inBuf.data(), inBuf.size()) || inf.BindOutput("NoLayer", outBuf.data(), outBuf.size())) {
+        nbad++;
+    }
+    float maxDiff = 0;
+    for (int t = 0; t < ntrl; t++) {
+        std::copy(inputs[t].begin(), inputs[t].end(), inBuf.begin());
+        if (inf.Run() != 3 * inf.Ctx.CycPerQtr) {
+            nbad++;
+        }
+        for (size_t i = 0; i < outBuf.size(); i++) {
+            maxDiff = std::max(maxDiff, std::abs(outBuf[i] - simOuts[t][i]));
+        }
+    }
+    if (maxDiff > 1e-5) {
+        nbad++;
+    }
+    size_t ai = 0;
+    for (leabra::Layer *ly: net->Layers) {
+        for (leabra::Neuron &nrn: ly->Neurons) {
+            if (nrn.AvgS != avgS[ai++]) {
+                nbad++;
+            }
+        }
+    }
+
+    // latency, with no allocations
+    const int nrun = 2000;
+    std::vector<double> infUs(nrun);
+    counting = true;
+    for (int r = 0; r < nrun; r++) {
+        const std::vector<float> &in = inputs[r % ntrl];
+        std::copy(in.begin(), in.end(), inBuf.begin());
+        auto t0 = std::chrono::steady_clock::now();
+        inf.Run();
+        auto t1 = std::chrono::steady_clock::now();
+        infUs[r] = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    }
+    counting = false;
+    if (nalloc != 0) {
+        nbad++;
+    }
+    inf.Ctx.Settle.On = true;
+    std::vector<double> settleUs(nrun);
+    for (int r = 0; r < nrun; r++) {
+        const std::vector<float> &in = inputs[r % ntrl];
+        std::copy(in.begin(), in.end(), inBuf.begin());
+        auto t0 = std::chrono::steady_clock::now();
+        inf.Run();
+        auto t1 = std::chrono::steady_clock::now();
+        settleUs[r] = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    }
+
+    std::cout << "Mismatches: " << nbad << ", max Output diff from Sim: " << maxDiff
+        << ", allocations in " << nrun << " runs: " << nalloc << std::endl;
+    std::cout << "Sim.StepTrial(false): p50 " << Percentile(simUs, 0.5) << " us, p99 " << Percentile(simUs, 0.99) << " us" << std::endl;
+    std::cout << "Inference.Run: p50 " << Percentile(infUs, 0.5) << " us, p99 " << Percentile(infUs, 0.99) << " us" << std::endl;
+    std::cout << "Inference.Run, Settle On: p50 " << Percentile(settleUs, 0.5) << " us, p99 " << Percentile(settleUs, 0.99) << " us" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <cmath>
+#include <tuple>
+#include "act.hpp"
+#include "learn.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+
+// Checks the GScale and learning-rule arithmetic against what the Go leabra
+// code computes: the 1 / (number active) scale of a full pathway, the AvgSS
+// running average moving toward the activation, NormFromAbsDWt clamping the
+// norm at NormMin, the low branch of WtBal, and a fractional Layer MSE.
+
+// Num is the scalar type the params use at this PRECISION.
+using Num = decltype(leabra::LrnActAvgParams().SSDt);
+
+// Check counts a mismatch when got is not want.
+int Check(std::string what, double got, double want) {
+    if (std::abs(got - want) > 1e-5 * std::max(1.0, std::abs(want))) {
+        std::cout << what << ": got " << got << ", want " << want << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    int nbad = 0;
+
+    // a full pathway from 100 units, 10 of them active
+    leabra::WtScaleParams ws;
+    nbad += Check("SLayActScale full", ws.SLayActScale(0.1, 100, 100), 0.1);
+
+    // AvgSS moves from 0 toward an activation of 1 by SSDt, and AvgS after it
+    leabra::LrnActAvgParams aa;
+    Num ss = 0, s = 0, m = 0, slrn = 0;
+    aa.AvgsFromAct(1, ss, s, m, slrn);
+    nbad += Check("AvgSS", ss, aa.SSDt);
+    nbad += Check("AvgS", s, aa.SDt * aa.SSDt);
+    nbad += Check("AvgM", m, aa.MDt * s);
+
+    // a norm below NormMin is clamped to it
+    leabra::DWtNormParams nm;
+    Num norm = 0;
+    nbad += Check("NormFromAbsDWt small", nm.NormFromAbsDWt(norm, 0.0001), nm.LrComp / nm.NormMin);
+    norm = 0;
+    nbad += Check("NormFromAbsDWt", nm.NormFromAbsDWt(norm, 0.5), nm.LrComp / 0.5);
+
+    // an average weight of .3 is below LoThr (.4) but above AvgThr (.25)
+    leabra::WtBalParams wb;
+    auto [fact, inc, dec] = wb.WtBal(0.3);
+    double want = wb.LoGain * (wb.LoThr - 0.3);
+    nbad += Check("WtBal fact", fact, want);
+    nbad += Check("WtBal dec", dec, 1 / (1 + want));
+    nbad += Check("WtBal inc", inc, 2 - 1 / (1 + want));
+
+    // a Full pathway gets the scale of its sender's expected activity
+    leabra::Network net("LearnRules");
+    leabra::Layer *in = net.AddLayer2D("Input", 10, 10, leabra::InputLayer);
+    leabra::Layer *out = net.AddLayer2D("Output", 2, 5, leabra::TargetLayer);
+    leabra::Path *pt = net.ConnectLayers(in, out, new paths::Full(), leabra::ForwardPath);
+    net.Build();
+    net.Defaults();
+    net.InitWeights();
+    net.GScaleFromAvgAct();
+    double savg = in->Pools[0].ActAvgs.ActPAvgEff;
+    nbad += Check("GScale", pt->GScale, pt->WtScale.Abs / std::max(std::round(savg * 100), 1.0));
+
+    // two of ten output units off by .6 and .7, one within the tolerance
+    out->Neurons[0].ActP = 1;
+    out->Neurons[0].ActM = 0.4;
+    out->Neurons[1].ActP = 0.9;
+    out->Neurons[1].ActM = 0.2;
+    out->Neurons[2].ActP = 0.3;
+    auto [sse, mse] = out->MSE(0.5);
+    nbad += Check("SSE", sse, 0.6 * 0.6 + 0.7 * 0.7);
+    nbad += Check("MSE", mse, (0.6 * 0.6 + 0.7 * 0.7) / 10);
+    nbad += Check("Layer SSE", out->SSE(0.5), 0.6 * 0.6 + 0.7 * 0.7);
+
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <algorithm>
+#include "ra25net.hpp"
+
+// Checks the network memory high-water marks: BuildMemHWM must be at or
+// above the memory once built, by at most the largest pattern table, and
+// by exactly the table of the last layer's pathway if that is the peak,
+// but not if that pathway's indexes came from the cache. InitWeightsMemHWM
+// must count the synapses that InitWeights copies while the old ones are
+// still held, when a pathway is Shared and Unshared, and nothing more when
+// one is Tied or Untied.
+
+params::Sets ParamSets = ra25::Params();
+
+int main() {
+    int nbad = 0;
+    leabra::Network *net = ra25::NewNet("MemHWMTest");
+    net->Build();
+    size_t mem = net->MemoryReport().Resident();
+    size_t patMax = 0;
+    for (leabra::Layer *ly: net->Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            patMax = std::max(patMax, pt->PatternBytes);
+        }
+    }
+    std::cout << "Build: " << mem << " bytes, BuildMemHWM " << net->BuildMemHWM << ", largest pattern table " << patMax << std::endl;
+    if (patMax == 0 || net->BuildMemHWM < mem || net->BuildMemHWM > mem + patMax) {
+        nbad++;
+    }
+
+    net->Defaults();
+    net->ApplyParams(ParamSets, false);
+    net->InitWeights();
+    mem = net->MemoryReport().Resident();
+    if (net->InitWeightsMemHWM != mem) {
+        std::cout << "InitWeights: " << mem << " bytes, InitWeightsMemHWM " << net->InitWeightsMemHWM << std::endl;
+        nbad++;
+    }
+
+    // tying frees the synapses of Hidden2 to Hidden1, and untying copies them
+    // from Hidden1 to Hidden2, which keeps its own
+    leabra::Path *fwd = net->Layers[1]->SendPaths[0], *back = net->Layers[2]->SendPaths[0];
+    fwd->Tied = back->Tied = true;
+    net->InitWeights();
+    size_t tied = net->MemoryReport().Resident();
+    fwd->Tied = back->Tied = false;
+    net->InitWeights();
+    size_t untied = net->MemoryReport().Resident();
+    std::cout << "Tied: " << tied << " bytes, InitWeightsMemHWM " << net->InitWeightsMemHWM << ", untied " << untied << std::endl;
+    if (tied >= mem || untied < mem || net->InitWeightsMemHWM != untied) {
+        nbad++;
+    }
+
+    leabra::Network *snet = new leabra::Network("MemHWMShared");
+    leabra::Layer *inp = snet->AddLayer4D("Input", 8, 8, 2, 2, leabra::InputLayer);
+    leabra::Layer *hid = snet->AddLayer4D("Hidden", 4, 4, 3, 3, leabra::SuperLayer);
+    leabra::Path *pt = snet->ConnectLayers(inp, hid, new paths::PoolTile(), leabra::ForwardPath);
+    snet->Build();
+    size_t built = snet->MemoryReport().Resident();
+    size_t pat = pt->PatternBytes, hwm = snet->BuildMemHWM;
+    snet->Build(); // from the cache
+    std::cout << "Build: " << built << " bytes, BuildMemHWM " << hwm << ", pattern table " << pat
+        << ", rebuilt from the cache: " << snet->BuildMemHWM << std::endl;
+    if (pat == 0 || hwm != built + pat || snet->BuildMemHWM != built || pt->PatternBytes != 0) {
+        nbad++;
+    }
+    snet->Defaults();
+    snet->InitWeights();
+
+    // Share copies the kernel out of the synapses, with a flag for each
+    size_t sep = snet->MemoryReport().Resident();
+    pt->Shared = true;
+    snet->InitWeights();
+    size_t shr = snet->MemoryReport().Resident();
+    size_t want = std::max(sep + pt->Syns.size() * (sizeof(leabra::Synapse) + 1), shr);
+    std::cout << "Share: " << sep << " to " << shr << " bytes, InitWeightsMemHWM " << snet->InitWeightsMemHWM << " of " << want << std::endl;
+    if (snet->InitWeightsMemHWM != want || want <= std::max(sep, shr)) {
+        nbad++;
+    }
+
+    // and Unshare copies the kernel back to each receiving pool
+    pt->Shared = false;
+    snet->InitWeights();
+    size_t unshr = snet->MemoryReport().Resident();
+    want = std::max(shr + pt->Syns.size() * sizeof(leabra::Synapse), unshr);
+    std::cout << "Unshare: " << shr << " to " << unshr << " bytes, InitWeightsMemHWM " << snet->InitWeightsMemHWM << " of " << want << std::endl;
+    if (snet->InitWeightsMemHWM != want || want <= std::max(shr, unshr)) {
+        nbad++;
+    }
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad > 0;
+}
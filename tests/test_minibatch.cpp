@@ -0,0 +1,90 @@
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include "ra25net.hpp"
+
+// Trains networks on the random 5x5 patterns with Sim.BatchSize 1, 5, 10
+// and 25, from the same initial weights and trial order, reporting their
+// learning curves and the time per epoch and per WtFromDwt. Checks that
+// the last partial batch of an epoch is applied, and that batches of up to
+// 10 trials learn (a full batch only updates the weights once per epoch).
+
+params::Sets ParamSets = ra25::Params();
+
+struct Result {
+    std::vector<float> SSE; // per epoch
+    double EpochMs = 0;
+    double WtUs = 0; // time of one WtFromDwt
+};
+
+Result Train(int batch, int epochs, int &nbad) {
+    leabra::Network net("BatchTest");
+    ra25::AddLayers(&net);
+    std::unique_ptr<leabra::Sim> psim(ra25::NewSim(&net, &ParamSets, true));
+    leabra::Sim &sim = *psim;
+    sim.BatchSize = batch;
+
+    Result res;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int ep = 0; ep < epochs; ep++) {
+        sim.StepEpoch(true);
+        if (sim.BatchN != 0) {
+            nbad++;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    res.EpochMs = std::chrono::duration<double, std::milli>(t1 - t0).count() / epochs;
+    res.SSE = sim.EpochSSE["Output"];
+
+    // WtFromDwt only visits the rows marked by Dwt, and empties the list,
+    // so all of them are marked before each call, as after a trial in which
+    // every sending unit learned
+    double us = 0;
+    for (int rep = 0; rep < 100; rep++) {
+        for (leabra::Layer *ly: net.Layers) {
+            for (leabra::Path *pt: ly->SendPaths) {
+                pt->DWtRowsAll();
+            }
+        }
+        t0 = std::chrono::steady_clock::now();
+        net.WtFromDwt();
+        t1 = std::chrono::steady_clock::now();
+        us += std::chrono::duration<double, std::micro>(t1 - t0).count();
+    }
+    res.WtUs = us / 100;
+    return res;
+}
+
+int main() {
+    int nbad = 0;
+    int epochs = 40;
+    std::vector<int> batches = {1, 5, 10, 25};
+    std::vector<Result> res;
+    for (int b: batches) {
+        res.push_back(Train(b, epochs, nbad));
+    }
+
+    std::cout << "Epoch SSE by BatchSize:" << std::endl;
+    std::cout << "epoch";
+    for (int b: batches) {
+        std::cout << "\t" << b;
+    }
+    std::cout << std::endl;
+    for (int ep = 0; ep < epochs; ep += 5) {
+        std::cout << ep;
+        for (Result &r: res) {
+            std::cout << "\t" << r.SSE[ep];
+        }
+        std::cout << std::endl;
+    }
+    for (size_t i = 0; i < batches.size(); i++) {
+        int nwt = (25 + batches[i] - 1) / batches[i];
+        std::cout << "BatchSize " << batches[i] << ": " << res[i].EpochMs << " ms/epoch, " << nwt << " WtFromDwt/epoch of "
+            << res[i].WtUs << " us (" << nwt * res[i].WtUs / 1000 << " ms/epoch), last SSE " << res[i].SSE.back() << std::endl;
+        if (batches[i] <= 10 && !(res[i].SSE.back() < res[i].SSE[0])) {
+            nbad++;
+        }
+    }
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
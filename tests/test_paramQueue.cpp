@@ -0,0 +1,238 @@
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "ra25net.hpp"
+
+// Trains a network with Sim.Run while a second thread queues param changes
+// with QueueParam: some handed to it at the start and the end of each trial,
+// and a stream of its own in the meantime. Checks that they only apply at
+// AlphaCycInit or at the end of an epoch, in the order they were queued,
+// and that UpdateParams ran on the layers and paths that they changed.
+
+params::Sets ParamSets = ra25::Params();
+
+// Queuer queues param changes from its own thread: those handed to it
+// with Queue, which waits until they have been queued, and otherwise a
+// stream of increasing Hidden2 AvgL.Tau, one every 100 us.
+struct Queuer {
+    leabra::Network *Net;
+    std::mutex Mu;
+    std::condition_variable Cv;
+    std::vector<std::array<std::string, 3>> Todo; // sel, path, value
+    bool Stop = false;
+    int NTau = 0; // number of AvgL.Tau changes queued
+    std::thread Thr;
+
+    Queuer(leabra::Network *net): Net(net) {
+        Thr = std::thread([this] { Loop(); });
+    }
+
+    static float Tau(int n) {
+        return 10 + 0.001f * n;
+    }
+
+    void Loop() {
+        std::unique_lock<std::mutex> lock(Mu);
+        while (!Stop) {
+            if (!Todo.empty()) {
+                for (auto &[sel, path, value]: Todo) {
+                    Net->QueueParam(sel, path, value);
+                }
+                Todo.clear();
+                Cv.notify_all();
+                continue;
+            }
+            Net->QueueParam("#Hidden2", "Layer.Learn.AvgL.Tau", std::to_string(Tau(NTau)));
+            NTau++;
+            Cv.wait_for(lock, std::chrono::microseconds(100));
+        }
+    }
+
+    void Queue(std::vector<std::array<std::string, 3>> chs) {
+        std::unique_lock<std::mutex> lock(Mu);
+        Todo = chs;
+        Cv.notify_all();
+        Cv.wait(lock, [this] { return Todo.empty(); });
+    }
+
+    void Join() {
+        {
+            std::lock_guard<std::mutex> lock(Mu);
+            Stop = true;
+        }
+        Cv.notify_all();
+        Thr.join();
+    }
+};
+
+bool differ(Real a, Real b) {
+    return std::abs(a - b) > 1e-5 * std::max(Real(1), std::abs(b));
+}
+
+// ProbeEnv checks the params of Net at the start of each trial, before
+// ApplyInputs, and at its end, after AlphaCyc, and hands Q the changes
+// for the next boundary: the Lrate of the trial at its start, all the
+// paths and then the BackPaths, and a Hidden1 VmTau at its end.
+struct ProbeEnv: leabra::TabulatedEnv {
+    leabra::Network *Net = nullptr;
+    Queuer *Q = nullptr;
+    leabra::Layer *Hid1 = nullptr, *Hid2 = nullptr;
+    int Trial = 0;
+    bool InTrial = false;
+    int EpochEnds = 0, EndsAtStep = 0;
+    Real VmTau = 0; // the Hidden1 VmTau that must have been applied
+    Real VmTauPending = 0; // queued at the end of the last trial, 0 if applied
+    Real TauAtStep = 0;
+    int TauAtInit = 0, TauAtEpoch = 0; // trials in which AvgL.Tau changed at each
+    int nbad = 0;
+
+    ProbeEnv(std::string fileName): leabra::TabulatedEnv(fileName) {}
+
+    static Real Lrate(int trial, bool back) {
+        return 0.01 + 0.0001 * trial + (back ? 0.005 : 0);
+    }
+
+    static Real VmTauOf(int trial) {
+        return 3.0 + 0.001 * trial;
+    }
+
+    void Bad(std::string what) {
+        if (nbad < 10) {
+            std::cout << "Trial " << Trial << ": " << what << std::endl;
+        }
+        nbad++;
+    }
+
+    // CheckUpdated checks the values that UpdateParams computes from the
+    // changed params.
+    void CheckUpdated() {
+        for (leabra::Layer *ly: Net->Layers) {
+            for (leabra::Path *pt: ly->RecvPaths) {
+                if (pt->Learn.LrateInit != pt->Learn.Lrate) {
+                    Bad(pt->Name + " LrateInit is not Lrate");
+                }
+            }
+        }
+        if (differ(Hid1->Act.Dt.VmDt, Hid1->Act.Dt.Integ / Hid1->Act.Dt.VmTau)) {
+            Bad("Hidden1 VmDt is not Integ / VmTau");
+        }
+        if (differ(Hid2->Learn.AvgL.Dt, 1 / Hid2->Learn.AvgL.Tau)) {
+            Bad("Hidden2 AvgL.Dt is not 1 / Tau");
+        }
+    }
+
+    void CheckLrate(int trial) {
+        for (leabra::Layer *ly: Net->Layers) {
+            for (leabra::Path *pt: ly->RecvPaths) {
+                if (differ(pt->Learn.Lrate, Lrate(trial, pt->Type == leabra::BackPath))) {
+                    Bad(pt->Name + " Lrate " + std::to_string(pt->Learn.Lrate));
+                }
+            }
+        }
+    }
+
+    void Start() {
+        bool epochEnd = EpochEnds != EndsAtStep;
+        if (Trial > 0) {
+            CheckLrate(Trial - 1);
+            if (epochEnd) {
+                VmTau = VmTauPending;
+                VmTauPending = 0;
+            }
+            if (differ(Hid1->Act.Dt.VmTau, VmTau)) {
+                Bad("VmTau changed outside a boundary, or not at the end of the epoch");
+            }
+            Real tau = Hid2->Learn.AvgL.Tau;
+            if (tau < TauAtStep || (!epochEnd && tau != TauAtStep)) {
+                Bad("AvgL.Tau changed out of order, or outside a boundary");
+            }
+            TauAtEpoch += tau != TauAtStep;
+            CheckUpdated();
+        } else {
+            VmTau = Hid1->Act.Dt.VmTau;
+        }
+        TauAtStep = Hid2->Learn.AvgL.Tau;
+        Q->Queue({
+            {"Path", "Path.Learn.Lrate", std::to_string(Lrate(Trial, false))},
+            {".BackPath", "Path.Learn.Lrate", std::to_string(Lrate(Trial, true))},
+        });
+    }
+
+    void End() {
+        CheckLrate(Trial);
+        if (VmTauPending != 0) {
+            VmTau = VmTauPending;
+            VmTauPending = 0;
+        }
+        if (differ(Hid1->Act.Dt.VmTau, VmTau)) {
+            Bad("VmTau was not applied at AlphaCycInit");
+        }
+        Real tau = Hid2->Learn.AvgL.Tau;
+        if (tau < TauAtStep) {
+            Bad("AvgL.Tau changed out of order");
+        }
+        TauAtInit += tau != TauAtStep;
+        TauAtStep = tau;
+        CheckUpdated();
+        VmTauPending = VmTauOf(Trial);
+        Q->Queue({{"#Hidden1", "Layer.Act.Dt.VmTau", std::to_string(VmTauPending)}});
+        EndsAtStep = EpochEnds;
+        Trial++;
+    }
+
+    tensor::Tensor<float> *GetLayerInput(std::string name) override {
+        if (!InTrial) {
+            InTrial = true;
+            Start();
+        }
+        return leabra::TabulatedEnv::GetLayerInput(name);
+    }
+
+    void Step() override {
+        End();
+        InTrial = false;
+        leabra::TabulatedEnv::Step();
+    }
+
+    bool EndEpoch() override {
+        bool end = leabra::TabulatedEnv::EndEpoch();
+        EpochEnds += end;
+        return end;
+    }
+};
+
+int main() {
+    leabra::Network *net = ra25::NewNet("ParamQueueTest");
+    ProbeEnv env("random_5x5_25.tsv");
+    leabra::Sim sim(net, &ParamSets, &env);
+    sim.Init();
+    env.Net = net;
+    env.Hid1 = (leabra::Layer*) net->LayerByName("Hidden1");
+    env.Hid2 = (leabra::Layer*) net->LayerByName("Hidden2");
+
+    Queuer q(net);
+    env.Q = &q;
+    int epochs = 4;
+    sim.Run(epochs);
+    q.Join();
+
+    // all that is left is applied in the order queued, the last one winning
+    net->ApplyQueuedParams();
+    if (differ(env.Hid1->Act.Dt.VmTau, ProbeEnv::VmTauOf(env.Trial - 1)) || differ(env.Hid2->Learn.AvgL.Tau, Queuer::Tau(q.NTau - 1))) {
+        env.Bad("the last changes queued were not the ones left applied");
+    }
+    env.CheckUpdated();
+    if (env.Trial != epochs * env.NumTrials() || env.TauAtInit == 0) {
+        env.Bad("AvgL.Tau changed at AlphaCycInit in " + std::to_string(env.TauAtInit) + " trials");
+    }
+    int nbad = env.nbad;
+    std::cout << "Queued " << q.NTau << " AvgL.Tau changes over " << env.Trial << " trials: applied at AlphaCycInit in "
+        << env.TauAtInit << ", at the end of an epoch in " << env.TauAtEpoch << std::endl;
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad > 0;
+}
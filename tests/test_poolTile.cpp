@@ -0,0 +1,149 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+
+// Checks PoolTile connectivity against the receptive fields computed
+// directly, and its Recip version against the transpose, then compares a
+// Shared pathway against the same pathway with a separate copy of the
+// kernel in each receiving pool: the same conductances must be sent, and
+// each kernel DWt must be the average of the DWt of its copies.
+
+const int sNp = 8, sNu = 2, rNp = 4, rNu = 3;
+
+struct TestNet {
+    leabra::Network *Net;
+    leabra::Path *Fwd;
+    leabra::Path *Back;
+
+    TestNet(bool shared) {
+        Net = new leabra::Network("PoolTileTest");
+        leabra::Layer *inp = Net->AddLayer4D("Input", sNp, sNp, sNu, sNu, leabra::InputLayer);
+        leabra::Layer *hid = Net->AddLayer4D("Hidden", rNp, rNp, rNu, rNu, leabra::SuperLayer);
+        paths::PoolTile *pat = new paths::PoolTile();
+        paths::PoolTile *recip = new paths::PoolTile();
+        recip->Recip = true;
+        Fwd = Net->ConnectLayers(inp, hid, pat, leabra::ForwardPath);
+        Back = Net->ConnectLayers(hid, inp, recip, leabra::BackPath);
+        Net->Build();
+        Net->Defaults();
+        Fwd->Shared = shared;
+        Fwd->Learn.Norm.On = false;
+        Fwd->Learn.Momentum.On = false;
+        Net->SetRandSeed(1);
+        Net->InitWeights();
+
+        for (leabra::Layer *ly: Net->Layers) {
+            for (size_t ni = 0; ni < ly->Neurons.size(); ni++) {
+                leabra::Neuron &nrn = ly->Neurons[ni];
+                nrn.AvgS = nrn.AvgSLrn = 0.2 + 0.6 * std::fmod(ni * 0.37, 1.0);
+                nrn.AvgM = 0.2 + 0.6 * std::fmod(ni * 0.53, 1.0);
+                nrn.AvgL = 0.3;
+                nrn.AvgLLrn = 0.5;
+            }
+        }
+    }
+};
+
+// RecvField returns the sending units of receiving unit ri, in order:
+// all the units of the 4x4 sending pools at 2 * pool - 1, wrapped.
+std::vector<int> RecvField(int ri) {
+    int rpi = ri / (rNu * rNu);
+    int rpy = rpi / rNp, rpx = rpi % rNp;
+    std::vector<int> sis;
+    for (int fy = 0; fy < 4; fy++) {
+        for (int fx = 0; fx < 4; fx++) {
+            int spy = (2 * rpy - 1 + fy + sNp) % sNp;
+            int spx = (2 * rpx - 1 + fx + sNp) % sNp;
+            for (int sui = 0; sui < sNu * sNu; sui++) {
+                sis.push_back((spy * sNp + spx) * sNu * sNu + sui);
+            }
+        }
+    }
+    std::sort(sis.begin(), sis.end());
+    return sis;
+}
+
+int main() {
+    TestNet sep(false);
+    TestNet shr(true);
+    int nbad = 0;
+
+    // connectivity
+    leabra::Path *fwd = sep.Fwd;
+    leabra::Path *back = sep.Back;
+    for (int ri = 0; ri < int(fwd->RConN.size()); ri++) {
+        std::vector<int> sis = RecvField(ri);
+        std::span<const int> cons = fwd->RConIndex.subspan(fwd->RConIndexSt[ri], fwd->RConN[ri]);
+        if (!std::ranges::equal(cons, sis)) {
+            nbad++;
+        }
+        for (int si: sis) {
+            if (back->SynIndex(ri, si) < 0) {
+                nbad++;
+            }
+        }
+    }
+    if (back->NumSyns() != fwd->NumSyns()) {
+        nbad++;
+    }
+    int ncons = fwd->NumSyns();
+
+    // shared kernel: copy its weights to every pool of the separate pathway
+    const paths::PoolKernel &kn = *shr.Fwd->Kernel;
+    if (int(shr.Fwd->Syns.size()) != 16 * sNu * sNu * rNu * rNu) {
+        nbad++;
+    }
+    for (int i = 0; i < ncons; i++) {
+        sep.Fwd->Syns[i] = shr.Fwd->Syn(i);
+    }
+    for (int si = 0; si < int(sep.Fwd->SConN.size()); si++) {
+        float delta = 0.1 + 0.8 * std::fmod(si * 0.29, 1.0);
+        sep.Fwd->SendGDelta(si, delta);
+        shr.Fwd->SendGDelta(si, delta);
+    }
+    for (size_t ri = 0; ri < sep.Fwd->GInc.size(); ri++) {
+        if (std::abs(sep.Fwd->GInc[ri] - shr.Fwd->GInc[ri]) > 1e-4) {
+            nbad++;
+        }
+    }
+
+    sep.Fwd->DWt();
+    shr.Fwd->DWt();
+    std::vector<double> sum(kn.Len()), sumAbs(kn.Len());
+    std::vector<int> n(kn.Len());
+    for (int i = 0; i < ncons; i++) {
+        sum[kn.SynIndex[i]] += sep.Fwd->Syns[i].DWt;
+        sumAbs[kn.SynIndex[i]] += std::abs(float(sep.Fwd->Syns[i].DWt));
+        n[kn.SynIndex[i]]++;
+    }
+    // with PRECISION=mixed, the DWt are stored as Half, to about 3 digits of
+    // each of the summed DWt
+    const double rel = sizeof(SynReal) < sizeof(float) ? 2e-3 : 0;
+    for (int ki = 0; ki < kn.Len(); ki++) {
+        if (n[ki] == 0 || std::abs(sum[ki] / n[ki] - shr.Fwd->Syns[ki].DWt) > 1e-6 + rel * sumAbs[ki] / n[ki]) {
+            nbad++;
+        }
+    }
+
+    // unsharing gives each pool a copy of the kernel
+    shr.Fwd->Shared = false;
+    shr.Fwd->Unshare();
+    for (int i = 0; i < ncons; i++) {
+        if (shr.Fwd->Syns[i].Wt != sep.Fwd->Syns[i].Wt) {
+            nbad++;
+        }
+    }
+
+    size_t sepBytes = sep.Fwd->MemoryReport().SynapseState;
+    shr.Fwd->Shared = true;
+    shr.Fwd->InitWeights();
+    size_t shrBytes = shr.Fwd->MemoryReport().SynapseState;
+
+    std::cout << "Connections: " << ncons << ", kernel synapses: " << kn.Len() << ", mismatches: " << nbad << std::endl;
+    std::cout << "Synapse state, separate: " << sepBytes << " bytes, shared: " << shrBytes << " bytes" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
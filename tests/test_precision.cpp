@@ -0,0 +1,101 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+#include "ra25net.hpp"
+
+// Tests a network on the random 5x5 patterns in the PRECISION this was
+// built with, and writes the minus phase Output activations to
+// precision_<PRECISION>.tsv. When built with a PRECISION other than double
+// and precision_double.tsv exists (make clean tests PRECISION=double and
+// run this first), checks their deviation from the double ones. This is
+// done before training, as learning amplifies any difference in units
+// near threshold. Then trains it, and checks the math::Half conversions.
+
+params::Sets ParamSets = ra25::Params();
+
+// HalfErrors returns the number of values that do not survive a
+// float -> Half -> float round trip within half of a Half ulp.
+int HalfErrors() {
+    int nbad = 0;
+    for (float f: {0.0f, 1.0f, -1.0f, 0.5f, 65504.0f, 6.1035156e-05f, 5.9604645e-08f}) {
+        if (float(math::Half(f)) != f) { // exactly representable
+            nbad++;
+        }
+    }
+    for (float f = 1e-4f; f < 1e4f; f *= 1.37f) {
+        float h = math::Half(f);
+        if (std::abs(h - f) > f * 0x1p-11f) {
+            nbad++;
+        }
+    }
+    if (!std::isinf(float(math::Half(1e6f))) || !std::isnan(float(math::Half(NAN)))) {
+        nbad++;
+    }
+    return nbad;
+}
+
+int main() {
+    int nbad = HalfErrors();
+    std::cout << "PRECISION " << PrecisionName << ": sizeof(Real) " << sizeof(Real) << ", sizeof(Neuron) "
+        << sizeof(leabra::Neuron) << ", sizeof(Synapse) " << sizeof(leabra::Synapse) << std::endl;
+
+    leabra::Network *net = ra25::NewNet("PrecisionTest");
+    leabra::Sim &sim = *ra25::NewSim(net, &ParamSets, true); // the same trial order in every build
+    leabra::Environment *env = sim.Env;
+    leabra::Layer *out = (leabra::Layer*) net->LayerByName("Output");
+
+    std::vector<float> acts;
+    for (int t = 0; t < env->NumTrials(); t++) {
+        sim.StepTrial(false);
+        for (leabra::Neuron &nrn: out->Neurons) {
+            acts.push_back(nrn.ActM);
+        }
+    }
+    env->EndEpoch();
+    std::ofstream fout(std::string("precision_") + PrecisionName + ".tsv");
+    for (float a: acts) {
+        fout << a << "\n";
+    }
+    fout.close();
+
+    std::ifstream fref("precision_double.tsv");
+    if (std::string(PrecisionName) != "double" && fref.good()) {
+        std::vector<float> ref;
+        float v;
+        while (fref >> v) {
+            ref.push_back(v);
+        }
+        if (ref.size() != acts.size()) {
+            nbad++;
+        } else {
+            float mx = 0, sum = 0;
+            for (size_t i = 0; i < acts.size(); i++) {
+                float d = std::abs(acts[i] - ref[i]);
+                mx = std::max(mx, d);
+                sum += d;
+            }
+            std::cout << "Output ActM deviation from double: max " << mx << ", mean " << sum / acts.size() << std::endl;
+            if (sum / acts.size() > 0.01) {
+                nbad++;
+            }
+        }
+    }
+
+    float sse0 = 0, sse = 0;
+    for (int ep = 0; ep < 20; ep++) {
+        sim.StepEpoch(true);
+        std::vector<float> &esse = sim.EpochSSE["Output"];
+        if (ep == 0) {
+            sse0 = esse.back();
+        }
+        sse = esse.back();
+    }
+    std::cout << "Train SSE: first epoch " << sse0 << ", last epoch " << sse << std::endl;
+    if (!(sse < sse0)) {
+        nbad++;
+    }
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
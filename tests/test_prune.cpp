@@ -0,0 +1,249 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include "ra25net.hpp"
+#include "weights.hpp"
+
+// Prunes a pathway by threshold and by percentile and checks that the
+// remaining synapses keep their weights and connect the same units, that
+// the send and recv indexes agree, and that RConNAvgMax and GScale follow,
+// leaving the reciprocal pathway alone, and that a Build restores the full
+// pattern on both pathways of a pruned pair. Checks that a Checkpointer
+// starts a new base after a Prune, that a rebuilt checkpoint of a pruned
+// network restores it after a fresh Build, and that a delta in the pruned
+// layout is not applied to an unpruned base. Then trains a network with a
+// PruneSchedule, and times the per-synapse passes before and after.
+
+params::Sets ParamSets = ra25::Params();
+
+// Check checks the pruned pathway pt against the weights of each sending
+// and receiving unit pair before pruning, in wts, given the threshold.
+int Check(leabra::Path *pt, std::map<std::pair<int, int>, float> &wts, float thr, int ties = 0) {
+    int nbad = 0;
+    int nkeep = 0;
+    for (auto &[sr, wt]: wts) {
+        int i = pt->SynIndex(sr.first, sr.second);
+        if (wt < thr || (wt == thr && ties-- > 0)) {
+            nbad += i >= 0;
+            continue;
+        }
+        nkeep++;
+        if (i < 0 || pt->Syns[i].Wt != wt) {
+            nbad++;
+        }
+    }
+    if (nkeep != pt->NumSyns() || int(pt->Syns.size()) != nkeep) {
+        nbad++;
+    }
+    for (int ri = 0; ri < int(pt->RConN.size()); ri++) {
+        for (int i = pt->RConIndexSt[ri]; i < pt->RConIndexSt[ri] + pt->RConN[ri]; i++) {
+            int si = pt->RConIndex[i];
+            if (pt->RSynIndex[i] != pt->SynIndex(si, ri)) {
+                nbad++;
+            }
+        }
+    }
+    return nbad;
+}
+
+std::map<std::pair<int, int>, float> Weights(leabra::Path *pt) {
+    std::map<std::pair<int, int>, float> wts;
+    for (int si = 0; si < int(pt->SConN.size()); si++) {
+        for (int i = pt->SConIndexSt[si]; i < pt->SConIndexSt[si] + pt->SConN[si]; i++) {
+            wts[{si, pt->SConIndex[i]}] = pt->Syns[i].Wt;
+        }
+    }
+    return wts;
+}
+
+// PassMs times the per-synapse passes over pt: sending conductances from
+// all of its sending units, then DWt.
+double PassMs(leabra::Path *pt) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < 100; rep++) {
+        for (int si = 0; si < int(pt->SConN.size()); si++) {
+            pt->SendGDelta(si, 0.1);
+        }
+        pt->DWt();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count() / 100;
+}
+
+int main() {
+    int nbad = 0;
+    leabra::Network *net = ra25::NewNet("PruneTest");
+    net->Build();
+    net->Defaults();
+    net->SetRandSeed(1);
+    net->InitWeights();
+    leabra::Layer *hid = net->Layers[1];
+    leabra::Layer *hid2 = net->Layers[2];
+    leabra::Path *fwd = hid2->RecvPaths[0];
+    leabra::Path *back = hid->RecvPaths[1];
+    int nback = back->NumSyns();
+    float gscale = fwd->GScale;
+
+    for (leabra::Neuron &nrn: hid->Neurons) {
+        nrn.AvgS = nrn.AvgSLrn = nrn.AvgM = 0.5;
+    }
+    double fullMs = PassMs(fwd);
+
+    float thr = 0.5;
+    auto wts = Weights(fwd);
+    leabra::PruneReport pr = fwd->Prune(thr);
+    nbad += Check(fwd, wts, thr);
+    if (pr.Pruned() <= 0 || pr.After != fwd->NumSyns() || pr.BytesSaved() <= 0 || back->NumSyns() != nback ||
+        fwd->Conns == back->Conns || std::abs(fwd->RConNAvgMax.Avg - float(pr.After) / fwd->RConN.size()) > 1e-3 ||
+        fwd->GScale == gscale) {
+        nbad++;
+    }
+
+    // the smallest 30% of the remaining synapses
+    wts = Weights(fwd);
+    std::vector<float> sorted;
+    for (auto &[sr, wt]: wts) {
+        sorted.push_back(wt);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    int npct = 0.3 * sorted.size();
+    int ties = npct - (std::lower_bound(sorted.begin(), sorted.end(), sorted[npct]) - sorted.begin());
+    pr = fwd->Prune(0, 0.3);
+    nbad += Check(fwd, wts, sorted[npct], ties);
+    if (pr.Pruned() != npct) {
+        nbad++;
+    }
+    double prunedMs = PassMs(fwd);
+    float synFrac = float(fwd->NumSyns()) / nback;
+
+    // tied pathways are not pruned
+    back->Tied = true;
+    if (back->Prune(1).Pruned() != 0) {
+        nbad++;
+    }
+    back->Tied = false;
+
+    // a proportion is pruned exactly, with many weights tied at the cut
+    for (int i = 0; i < nback; i += 2) {
+        back->Syns[i].Wt = 0;
+    }
+    if (back->Prune(0, 0.25).Pruned() != nback / 4) {
+        nbad++;
+    }
+
+    // a Build restores the full pattern on both pathways of a pruned pair
+    leabra::Network *rnet = ra25::NewNet("PruneTest");
+    rnet->Build();
+    leabra::Path *rfwd = rnet->Layers[2]->RecvPaths[0];
+    leabra::Path *rback = rnet->Layers[1]->RecvPaths[1];
+    int nfull = rfwd->NumSyns();
+    rfwd->Prune(0, 0.5);
+    rnet->Build();
+    std::cout << "Pruned by half, then Build: fwd " << rfwd->NumSyns() << " back " << rback->NumSyns() << " of " << nfull << std::endl;
+    if (rfwd->NumSyns() != nfull || rback->NumSyns() != nfull || !rfwd->ConnsBuilt || rfwd->Conns != rback->Conns) {
+        nbad++;
+    }
+
+    // checkpoints across a Prune
+    leabra::Network *cnet = ra25::NewNet("PruneTest");
+    cnet->Build();
+    cnet->Defaults();
+    cnet->SetRandSeed(2);
+    cnet->InitWeights();
+    leabra::Path *cfwd = cnet->Layers[2]->RecvPaths[0];
+    std::string prefix = "test_prune_ckpt";
+    leabra::Checkpointer ckr(cnet, prefix, 10);
+    ckr.Save(); // 1: base
+    cfwd->Prune(0, 0.3);
+    ckr.Save(); // 2: a new base, for the pruned layout
+    for (int i = cfwd->SConIndexSt[3]; i < cfwd->SConIndexSt[3] + cfwd->SConN[3]; i++) {
+        cfwd->Syns[i].Wt = 0.25;
+    }
+    cfwd->CkptDirty[3] = 1;
+    ckr.Save(); // 3: a delta of the pruned layout
+    ckr.Wait();
+    if (ckr.BaseSeq != 2 || weights::CkptFile(weights::CkptFileName(prefix, 2)).HasFlag(weights::CkptDelta) ||
+        !weights::CkptFile(weights::CkptFileName(prefix, 3)).HasFlag(weights::CkptDelta)) {
+        std::cout << "Checkpointer did not start a new base after Prune: base " << ckr.BaseSeq << std::endl;
+        nbad++;
+    }
+
+    // the pruned network is restored after a fresh Build
+    std::string rebuilt = prefix + "-rebuilt.wts";
+    weights::RebuildCheckpoint(prefix, 3, rebuilt);
+    leabra::Network *lnet = ra25::NewNet("PruneTest");
+    lnet->Build();
+    lnet->Defaults();
+    lnet->InitWeights();
+    uint64_t gen = lnet->StructGen;
+    lnet->LoadCheckpoint(rebuilt);
+    leabra::Path *lfwd = lnet->Layers[2]->RecvPaths[0];
+    if (lfwd->NumSyns() != cfwd->NumSyns() || lfwd->ConnsBuilt || Weights(lfwd) != Weights(cfwd) ||
+        lfwd->GScale != cfwd->GScale || lnet->StructGen == gen) {
+        std::cout << "Pruned checkpoint not restored after Build: " << lfwd->NumSyns() << " of " << cfwd->NumSyns() << " synapses" << std::endl;
+        nbad++;
+    }
+    // loading it again leaves the indexes as they are
+    auto conns = lfwd->Conns;
+    lnet->LoadCheckpoint(rebuilt);
+    nbad += lfwd->Conns != conns;
+
+    // the delta, relinked onto the unpruned base, does not apply to it
+    std::string mixed = prefix + "-mixed";
+    {
+        std::ifstream b(weights::CkptFileName(prefix, 1), std::ios::binary);
+        std::ofstream(weights::CkptFileName(mixed, 1), std::ios::binary) << b.rdbuf();
+        std::ifstream d(weights::CkptFileName(prefix, 3), std::ios::binary);
+        std::ofstream md(weights::CkptFileName(mixed, 2), std::ios::binary);
+        md << d.rdbuf();
+        uint64_t seq[2] = {2, 1}; // Seq, PrevSeq
+        md.seekp(offsetof(weights::CkptHeader, Seq));
+        md.write((const char*)seq, sizeof(seq));
+    }
+    bool threw = false;
+    try {
+        weights::RebuildCheckpoint(mixed, 2, rebuilt);
+    } catch (const std::runtime_error &e) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cout << "Delta of the pruned layout applied to the unpruned base" << std::endl;
+        nbad++;
+    }
+    std::remove(rebuilt.c_str());
+    for (int ci = 1; ci <= 3; ci++) {
+        std::remove(weights::CkptFileName(prefix, ci).c_str());
+        std::remove(weights::CkptFileName(mixed, ci).c_str());
+    }
+
+    // training with a schedule
+    leabra::Network *tnet = ra25::NewNet("PruneTest");
+    leabra::Sim &sim = *ra25::NewSim(tnet, &ParamSets);
+    sim.Prune.On = true;
+    sim.Prune.Start = 3;
+    sim.Prune.Interval = 3;
+    sim.Prune.Stop = 9;
+    sim.Prune.Pct = 0.3;
+    sim.StepEpoch(true);
+    size_t fullBytes = tnet->MemoryReport().Resident();
+    for (int ep = 1; ep < 12; ep++) {
+        sim.StepEpoch(true);
+    }
+    size_t prunedBytes = tnet->MemoryReport().Resident();
+    leabra::PruneReport &tot = sim.Prune.Total;
+    // prunes after epochs 3, 6 and 9, of all 5 pathways
+    if (tot.Paths != 15 || std::abs(sim.Prune.Last.SynFrac() - 0.7) > 0.01 || !std::isfinite(sim.EpochSSE["Output"].back())) {
+        nbad++;
+    }
+
+    std::cout << "Mismatches: " << nbad << std::endl;
+    std::cout << tot.String() << std::endl;
+    std::cout << "Network memory: " << fullBytes << " bytes, pruned: " << prunedBytes << " bytes" << std::endl;
+    std::cout << "SendGDelta + DWt pass, " << nback << " synapses: " << fullMs << " ms, " << synFrac
+        << " of them left: " << prunedMs << " ms" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
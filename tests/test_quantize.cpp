@@ -0,0 +1,156 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include "ra25net.hpp"
+
+// Trains a network on the random 5x5 patterns, then freezes copies of it
+// with fp32, bfloat16 and int8 (per receiver and per path) weights, and
+// compares their test Output activations and SSE against the fp32 ones,
+// with the weight memory and the time of a SendGDelta pass of each.
+
+params::Sets ParamSets = ra25::Params();
+
+struct TestNet {
+    leabra::Network *Net;
+    leabra::Sim *Sim;
+
+    // TestNet trains a network for the given epochs, and sets it to start
+    // each trial from rest.
+    TestNet(int epochs) {
+        Net = ra25::NewNet("QuantizeTest");
+        Sim = ra25::NewSim(Net, &ParamSets);
+        for (int ep = 0; ep < epochs; ep++) {
+            Sim->StepEpoch(true);
+        }
+        for (leabra::Layer *ly: Net->Layers) {
+            ly->Act.Init.Decay = 1;
+        }
+    }
+};
+
+struct Result {
+    std::vector<std::vector<float>> Outs;
+    float SSE = 0; // mean over the patterns, with a 0.5 tolerance
+    size_t Bytes = 0;
+    double SendUs = 0;
+};
+
+// Test runs net on each of the inputs, with Inference, returning its
+// Output activations and mean SSE against the targets.
+Result Test(leabra::Network *net, const std::vector<std::vector<float>> &inputs, const std::vector<std::vector<float>> &targs) {
+    Result res;
+    std::vector<float> in(25), out(25);
+    leabra::Inference inf(net);
+    inf.BindInput("Input", in.data(), in.size());
+    inf.BindOutput("Output", out.data(), out.size());
+    for (size_t t = 0; t < inputs.size(); t++) {
+        std::copy(inputs[t].begin(), inputs[t].end(), in.begin());
+        inf.Run();
+        for (size_t i = 0; i < out.size(); i++) {
+            float d = out[i] - targs[t][i];
+            if (std::abs(d) >= 0.5) {
+                res.SSE += d * d;
+            }
+        }
+        res.Outs.push_back(out);
+    }
+    res.SSE /= inputs.size();
+    return res;
+}
+
+// SendUs times sending conductances from all the sending units of pt, in us.
+double SendUs(leabra::Path *pt) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < 100; rep++) {
+        for (int si = 0; si < int(pt->SConN.size()); si++) {
+            pt->SendGDelta(si, 0.1);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / 100;
+}
+
+// Deviation returns the max and mean absolute difference of a from b.
+std::pair<float, float> Deviation(const std::vector<std::vector<float>> &a, const std::vector<std::vector<float>> &b) {
+    float mx = 0, sum = 0;
+    int n = 0;
+    for (size_t t = 0; t < a.size(); t++) {
+        for (size_t i = 0; i < a[t].size(); i++) {
+            float d = std::abs(a[t][i] - b[t][i]);
+            mx = std::max(mx, d);
+            sum += d;
+            n++;
+        }
+    }
+    return {mx, sum / n};
+}
+
+int main() {
+    int nbad = 0;
+    TestNet a(20);
+    leabra::Layer *inp = (leabra::Layer*) a.Net->LayerByName("Input");
+    leabra::Layer *out = (leabra::Layer*) a.Net->LayerByName("Output");
+    std::vector<std::vector<float>> inputs, targs;
+    for (int t = 0; t < a.Sim->Env->NumTrials(); t++) {
+        a.Sim->StepTrial(false);
+        std::vector<float> pat, targ;
+        for (leabra::Neuron &nrn: inp->Neurons) {
+            pat.push_back(nrn.Ext);
+        }
+        for (leabra::Neuron &nrn: out->Neurons) {
+            targ.push_back(nrn.Targ);
+        }
+        inputs.push_back(pat);
+        targs.push_back(targ);
+    }
+    a.Sim->Env->EndEpoch();
+    std::string fname = "test_quantize.wts";
+    a.Net->SaveCheckpoint(fname);
+
+    struct Mode {
+        std::string Name;
+        leabra::WtQuants Quant;
+        bool PathScale;
+        float MeanDev; // allowed mean Output deviation from fp32, as a unit
+                       // near threshold can flip
+    };
+    std::vector<Mode> modes = {
+        {"fp32", leabra::WtF32, false, 0},
+        {"bf16", leabra::WtBF16, false, 0.01},
+        {"int8 per recv", leabra::WtInt8, false, 0.02},
+        {"int8 per path", leabra::WtInt8, true, 0.02},
+    };
+    std::vector<Result> res;
+    for (Mode &md: modes) {
+        TestNet b(0);
+        b.Net->LoadCheckpoint(fname);
+        leabra::MemReport mr = b.Net->Freeze(false, md.Quant, md.PathScale);
+        Result r = Test(b.Net, inputs, targs);
+        r.Bytes = mr.SynapseState;
+        leabra::Layer *hid2 = (leabra::Layer*) b.Net->LayerByName("Hidden2");
+        leabra::Path *fwd = hid2->RecvPaths[0];
+        if (fwd->FrozenQuant != md.Quant || !fwd->FrozenDense) {
+            nbad++;
+        }
+        r.SendUs = SendUs(fwd);
+        res.push_back(r);
+    }
+    std::remove(fname.c_str());
+
+    std::cout << "Output deviation from fp32 and SSE change on " << inputs.size() << " patterns, fp32 SSE " << res[0].SSE << ":" << std::endl;
+    for (size_t m = 0; m < modes.size(); m++) {
+        auto [mx, mean] = Deviation(res[m].Outs, res[0].Outs);
+        if (mean > modes[m].MeanDev || std::abs(res[m].SSE - res[0].SSE) > 0.5 || res[m].Bytes > res[0].Bytes) {
+            nbad++;
+        }
+        std::cout << modes[m].Name << ": max " << mx << ", mean " << mean << ", SSE " << res[m].SSE - res[0].SSE
+            << ", synapse state " << res[m].Bytes << " bytes, Hidden2 SendGDelta pass " << res[m].SendUs << " us" << std::endl;
+    }
+    if (res[1].Bytes >= res[0].Bytes || res[2].Bytes >= res[1].Bytes) {
+        nbad++;
+    }
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
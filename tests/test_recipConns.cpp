@@ -0,0 +1,104 @@
+#include <iostream>
+#include <algorithm>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+
+// Checks that the Back pathways made by BidirConnectLayers share the
+// connection indexes of their Forward pathways, viewed transposed, and
+// that these views match indexes built for the Back pathways on their own,
+// along with the memory saved and the symmetric weights from InitWtSym.
+// Also checks that MemoryReport splits the bytes of shared indexes among
+// the pathways of the network viewing them, whoever else holds them: the
+// ConnCache, another network, or a copy, and after one of them is pruned.
+
+bool Same(std::span<const int> a, std::span<const int> b) {
+    return std::ranges::equal(a, b);
+}
+
+int main() {
+    paths::DefaultConnCache.On = false; // only share between reciprocals
+    leabra::Network net("RecipConnsTest");
+    leabra::Layer *inp = net.AddLayer2D("Input", 10, 10, leabra::InputLayer);
+    leabra::Layer *hid = net.AddLayer4D("Hidden", 2, 2, 5, 5, leabra::SuperLayer);
+    leabra::Layer *out = net.AddLayer2D("Output", 8, 8, leabra::TargetLayer);
+    paths::Pattern *full = new paths::Full();
+    net.ConnectLayers(inp, hid, full, leabra::ForwardPath);
+    auto [fwd, back] = net.BidirConnectLayers(hid, out, full);
+    net.Build();
+    net.Defaults();
+    net.SetRandSeed(1);
+    net.InitWeights();
+
+    int nbad = 0;
+    if (fwd->Conns != back->Conns || fwd->ConnsTransposed == back->ConnsTransposed) {
+        nbad++;
+    }
+    std::shared_ptr<paths::ConnIndexes> own = paths::NewConnIndexes(*full, back->Send->Shape, back->Recv->Shape, false);
+    if (!Same(back->SConN, own->SConN) || !Same(back->SConIndexSt, own->SConIndexSt) ||
+        !Same(back->SConIndex, own->SConIndex) || !Same(back->RConN, own->RConN) ||
+        !Same(back->RConIndexSt, own->RConIndexSt) || !Same(back->RConIndex, own->RConIndex) ||
+        !Same(back->RSynIndex, own->RSynIndex)) {
+        nbad++;
+    }
+
+    // weights are copied from the Forward to the Back pathway
+    int nasym = 0;
+    for (int si = 0; si < int(fwd->SConN.size()); si++) {
+        for (int ri = 0; ri < int(fwd->RConN.size()); ri++) {
+            int fi = fwd->SynIndex(si, ri);
+            int bi = back->SynIndex(ri, si);
+            if (fi < 0 || bi < 0 || fwd->Syns[fi].Wt != back->Syns[bi].Wt) {
+                nasym++;
+            }
+        }
+    }
+
+    size_t pairBytes = fwd->MemoryReport().ConIndexes + back->MemoryReport().ConIndexes;
+    std::shared_ptr<const paths::ConnIndexes> held = fwd->Conns; // not a view
+    if (fwd->ConnsViews != 2 || back->ConnsViews != 2 || pairBytes != 2 * (fwd->Conns->Bytes() / 2) ||
+        fwd->MemoryReport().ConIndexes + back->MemoryReport().ConIndexes != pairBytes) {
+        std::cout << "Reciprocal pair indexes not split between the two" << std::endl;
+        nbad++;
+    }
+    held.reset();
+
+    size_t ownBytes = 2 * own->Bytes();
+    // two networks with the same Input to Hidden A and B get one copy of the
+    // indexes from the ConnCache, split among the views of each
+    paths::DefaultConnCache.On = true;
+    leabra::Network *nets[2];
+    for (leabra::Network *&cn: nets) {
+        cn = new leabra::Network("RecipConnsCache");
+        leabra::Layer *cin = cn->AddLayer2D("Input", 10, 10, leabra::InputLayer);
+        cn->ConnectLayers(cin, cn->AddLayer2D("HiddenA", 6, 6, leabra::SuperLayer), full, leabra::ForwardPath);
+        cn->ConnectLayers(cin, cn->AddLayer2D("HiddenB", 6, 6, leabra::SuperLayer), full, leabra::ForwardPath);
+        cn->Build();
+        cn->Defaults();
+        cn->InitWeights();
+    }
+    leabra::Path *pa = nets[0]->Layers[1]->RecvPaths[0], *pb = nets[0]->Layers[2]->RecvPaths[0];
+    size_t cacheBytes = pa->Conns->Bytes();
+    if (pa->Conns != pb->Conns || pa->Conns != nets[1]->Layers[1]->RecvPaths[0]->Conns || pa->ConnsViews != 2 ||
+        nets[0]->MemoryReport().ConIndexes != 2 * (cacheBytes / 2)) {
+        std::cout << "Cached indexes not split between the views of each network" << std::endl;
+        nbad++;
+    }
+    pa->Prune(0, 0.5);
+    if (pa->ConnsViews != 1 || pb->ConnsViews != 1 || pb->MemoryReport().ConIndexes != cacheBytes ||
+        pa->MemoryReport().ConIndexes != pa->Conns->Bytes()) {
+        std::cout << "Indexes not counted again after Prune" << std::endl;
+        nbad++;
+    }
+    nets[0]->Build();
+    if (pa->ConnsViews != 2 || pb->ConnsViews != 2) {
+        std::cout << "Indexes not counted again after Build" << std::endl;
+        nbad++;
+    }
+
+    std::cout << "Index mismatches: " << nbad << ", asymmetric weights: " << nasym << std::endl;
+    std::cout << "Reciprocal pair indexes: " << pairBytes << " bytes, unshared: " << ownBytes
+        << " bytes (" << double(pairBytes) / ownBytes << ")" << std::endl;
+    return nbad == 0 && nasym == 0 && pairBytes < ownBytes ? 0 : 1;
+}
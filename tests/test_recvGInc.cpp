@@ -0,0 +1,139 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include "ra25net.hpp"
+
+// Trains a network with a 32x32 hidden layer, which also has a lateral
+// Circle inhibitory pathway, on the random 5x5 patterns. On every cycle,
+// checks that RecvGInc, which only visits the GIncBlks that SendGDelta
+// marked, gives exactly the GeRaw and GiRaw of a sweep over all of the
+// recv units, and reports the proportion of pathways and blocks visited
+// and the time of both.
+
+params::Sets ParamSets = ra25::Params({
+    {Sel: "Path", Desc: "", ParamsSet: {{"Path.Learn.WtBal.On", "false"}}},
+    {Sel: ".InhibPath", Desc: "", ParamsSet: {{"Path.WtScale.Abs", "0.2"}, {"Path.Learn.Learn", "false"}}},
+});
+
+// FullRecv is RecvGInc as it was, going through all of the recv units.
+void FullRecv(leabra::Path *pt) {
+    leabra::Layer &rlay = *pt->Recv;
+    for (size_t ri = 0; ri < rlay.Neurons.size(); ri++) {
+        leabra::Neuron &rn = rlay.Neurons[ri];
+        if (pt->Type == leabra::InhibPath) {
+            rn.GiRaw += pt->GInc[ri];
+        } else {
+            rn.GeRaw += pt->GInc[ri];
+        }
+        pt->GInc[ri] = 0;
+    }
+}
+
+int main() {
+    int nbad = 0;
+    leabra::Network *net = ra25::NewNet("RecvGIncTest", 32, 32, 1);
+    leabra::Layer *hid = (leabra::Layer*) net->LayerByName("Hidden");
+    paths::Circle *circ = new paths::Circle();
+    circ->Radius = 2;
+    leabra::Path *inh = net->ConnectLayers(hid, hid, circ, leabra::InhibPath);
+    leabra::Sim &sim = *ra25::NewSim(net, &ParamSets, true);
+    leabra::Environment *env = sim.Env;
+
+    std::vector<leabra::Path*> paths;
+    for (leabra::Layer *ly: net->Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            paths.push_back(pt);
+        }
+    }
+    long nrecv = 0, nsent = 0, nblks = 0, nmarked = 0;
+    double blkUs = 0, fullUs = 0;
+    int ncyc = 0, ndiff = 0;
+    for (int ep = 0; ep < 2; ep++) {
+        while (!env->EndEpoch()) {
+            sim.ApplyInputs();
+            sim.Ctx->Mode = leabra::Train;
+            net->AlphaCycInit(true);
+            sim.Ctx->AlphaCycStart();
+            for (int qtr = 0; qtr < 4; qtr++) {
+                for (int cyc = 0; cyc < sim.Ctx->CycPerQtr; cyc++) {
+                    for (leabra::Layer *ly: net->Layers) {
+                        ly->SendGDelta(sim.Ctx);
+                    }
+                    std::vector<std::vector<Real>> ginc, raw;
+                    for (leabra::Path *pt: paths) {
+                        ginc.push_back(pt->GInc);
+                        nrecv++;
+                        nsent += pt->GIncSent;
+                        nblks += pt->GIncBlks.size();
+                        nmarked += std::count(pt->GIncBlks.begin(), pt->GIncBlks.end(), 1);
+                    }
+                    for (leabra::Layer *ly: net->Layers) {
+                        for (leabra::Neuron &nrn: ly->Neurons) {
+                            raw.push_back({nrn.GeRaw, nrn.GiRaw});
+                        }
+                    }
+                    auto t0 = std::chrono::steady_clock::now();
+                    for (leabra::Layer *ly: net->Layers) {
+                        ly->RecvGInc(sim.Ctx);
+                    }
+                    auto t1 = std::chrono::steady_clock::now();
+                    std::vector<std::vector<Real>> blkRaw;
+                    size_t ni = 0;
+                    for (leabra::Layer *ly: net->Layers) {
+                        for (leabra::Neuron &nrn: ly->Neurons) {
+                            blkRaw.push_back({nrn.GeRaw, nrn.GiRaw});
+                            nrn.GeRaw = raw[ni][0];
+                            nrn.GiRaw = raw[ni][1];
+                            ni++;
+                        }
+                    }
+                    for (size_t i = 0; i < paths.size(); i++) {
+                        if (std::count(paths[i]->GInc.begin(), paths[i]->GInc.end(), 0) != int(paths[i]->GInc.size())) {
+                            ndiff++; // left some GInc behind
+                        }
+                        paths[i]->GInc = ginc[i];
+                    }
+                    auto t2 = std::chrono::steady_clock::now();
+                    for (leabra::Path *pt: paths) {
+                        FullRecv(pt);
+                    }
+                    auto t3 = std::chrono::steady_clock::now();
+                    ni = 0;
+                    for (leabra::Layer *ly: net->Layers) {
+                        for (leabra::Neuron &nrn: ly->Neurons) {
+                            if (std::memcmp(&nrn.GeRaw, &blkRaw[ni][0], sizeof(Real)) != 0 ||
+                                std::memcmp(&nrn.GiRaw, &blkRaw[ni][1], sizeof(Real)) != 0) {
+                                ndiff++;
+                            }
+                            ni++;
+                        }
+                    }
+                    blkUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+                    fullUs += std::chrono::duration<double, std::micro>(t3 - t2).count();
+                    for (leabra::Layer *ly: net->Layers) {
+                        ly->Cycle(sim.Ctx); // RecvGInc has nothing left to do
+                        ly->CyclePost(sim.Ctx);
+                    }
+                    sim.Ctx->CycleInc();
+                    ncyc++;
+                }
+                net->QuarterFinal(sim.Ctx);
+                sim.Ctx->QuarterInc();
+            }
+            net->Dwt();
+            net->WtFromDwt();
+            env->Step();
+        }
+    }
+    std::cout << "RecvGInc over " << ncyc << " cycles: " << 100.0 * nsent / nrecv << "% of the pathways had sends, "
+        << 100.0 * nmarked / nblks << "% of the GIncBlks" << std::endl;
+    std::cout << "RecvGInc: GIncBlks " << blkUs / ncyc << " us/cycle, all recv units " << fullUs / ncyc << " us/cycle" << std::endl;
+    std::cout << "Circle InhibPath SConSorted: " << inh->SConSorted << std::endl;
+    nbad += ndiff;
+    if (!inh->SConSorted) {
+        nbad++;
+    }
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
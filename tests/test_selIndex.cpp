@@ -0,0 +1,213 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ra25net.hpp"
+#include "params.hpp"
+
+// Checks the Network SelMatchIndex against matching each selector to each
+// layer and path with Sel.SelMatch: #Name, .Class and Type selectors must
+// match the same objects, including after a layer is renamed and the
+// classes of a layer and a path are changed, which must rebuild the index.
+// Also checks that ApplyParams and CompileParams leave the same NMatch
+// counts, and SelNoMatchWarn the same warnings, as applying the sheet to
+// each layer in turn with Layer.ApplyParams, that CompileParams has a write
+// for each param of each Sel that SelMatch applies to an object, and that a
+// Sel none of whose params compile is not counted as a match.
+
+std::vector<std::string> Selectors = {
+    "Layer", "Path", "SuperLayer", "", "#Input", "#Hidden1", "#Hidden2", "#HiddenB", "#Output",
+    "#InputToHidden1", "#Hidden1ToHidden2", "#Hidden2ToHidden1", "#Nope", ".Hid", ".Odd", ".Recur", ".Recur2",
+    ".SuperLayer", ".InputLayer", ".TargetLayer", ".ForwardPath", ".BackPath", ".Nope",
+};
+
+// objects returns the layers and their recv paths, in ApplyParams order.
+std::vector<params::StylerObject*> objects(leabra::Network *net) {
+    std::vector<params::StylerObject*> objs;
+    for (leabra::Layer *ly: net->Layers) {
+        objs.push_back(ly);
+        for (leabra::Path *pt: ly->RecvPaths) {
+            objs.push_back(pt);
+        }
+    }
+    return objs;
+}
+
+// MatchErrors returns the number of selectors, and sheet Sels for either
+// target type, that the SelMatchIndex does not match to the same objects
+// as SelMatch.
+int MatchErrors(leabra::Network *net) {
+    int nbad = 0;
+    emer::SelIndex &idx = net->SelMatchIndex();
+    std::vector<params::StylerObject*> objs = objects(net);
+    if (idx.Objs != objs) {
+        std::cout << "Index objects out of date" << std::endl;
+        return 1;
+    }
+    params::Sheet sheet;
+    for (std::string &sel: Selectors) {
+        std::vector<int> want;
+        for (int oi = 0; oi < int(objs.size()); oi++) {
+            if (params::SelMatch(sel, objs[oi]->StyleName(), objs[oi]->StyleClass(), objs[oi]->StyleType())) {
+                want.push_back(oi);
+            }
+        }
+        if (idx.Match(sel) != want) {
+            std::cout << "Selector '" << sel << "' matched " << idx.Match(sel).size() << " objects, not " << want.size() << std::endl;
+            nbad++;
+        }
+        sheet.sel.push_back({Sel: sel, Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "1.8"}}});
+        sheet.sel.push_back({Sel: sel, Desc: "", ParamsSet: {{"Path.WtScale.Rel", "0.2"}}});
+    }
+    std::vector<std::vector<int>> objSels = idx.SheetMatches(sheet);
+    for (int oi = 0; oi < int(objs.size()); oi++) {
+        std::any obj(objs[oi]);
+        std::vector<int> want;
+        for (int si = 0; si < int(sheet.sel.size()); si++) {
+            if (sheet.sel[si].TargetTypeMatch(obj) && sheet.sel[si].SelMatch(obj)) {
+                want.push_back(si);
+            }
+        }
+        if (objSels[oi] != want) {
+            std::cout << objs[oi]->StyleName() << " matched " << objSels[oi].size() << " Sels, not " << want.size() << std::endl;
+            nbad++;
+        }
+    }
+    return nbad;
+}
+
+// Counts is the NMatch of each Sel in a sheet and the SelNoMatchWarn message.
+struct Counts {
+    std::vector<int> NMatch;
+    std::string Warn;
+    int Writes = 0;
+
+    Counts(params::Sheet &sheet, int writes) {
+        for (params::Sel_ &sl: sheet.sel) {
+            NMatch.push_back(sl.NMatch);
+        }
+        std::ostringstream warn;
+        std::streambuf *cerrBuf = std::cerr.rdbuf(warn.rdbuf());
+        sheet.SelNoMatchWarn("Base", "SelIndexTest");
+        std::cerr.rdbuf(cerrBuf);
+        Warn = warn.str();
+        Writes = writes;
+    }
+
+    bool operator==(const Counts &o) const {
+        return NMatch == o.NMatch && Warn == o.Warn && Writes == o.Writes;
+    }
+};
+
+int main() {
+    int nbad = 0;
+    leabra::Network *net = ra25::NewNet("SelIndexTest");
+    leabra::Layer *hid1 = (leabra::Layer*) net->LayerByName("Hidden1");
+    leabra::Layer *hid2 = (leabra::Layer*) net->LayerByName("Hidden2");
+    leabra::Layer *out = (leabra::Layer*) net->LayerByName("Output");
+    hid1->SetClass("Hid Odd");
+    hid2->SetClass("Hid");
+    leabra::Path *recur = hid2->RecvPaths[0]; // Hidden1 to Hidden2
+    recur->SetClass("Recur");
+    net->Build();
+    net->Defaults();
+
+    nbad += MatchErrors(net);
+
+    // renaming a layer, or changing a class, rebuilds the index
+    emer::SelIndex *idx = &net->SelMatchIndex();
+    hid2->SetName("HiddenB");
+    recur->SetClass("Recur2");
+    out->SetClass("Hid");
+    if (idx->Valid()) {
+        std::cout << "Index still valid after renaming Hidden2" << std::endl;
+        nbad++;
+    }
+    nbad += MatchErrors(net);
+    if (!idx->Valid() || !idx->Match("#Hidden2").empty() || idx->Match("#HiddenB").size() != 1 || idx->Match(".Recur2").size() != 1 || idx->Match(".Hid").size() != 3) {
+        std::cout << "Index not rebuilt after renaming Hidden2" << std::endl;
+        nbad++;
+    }
+
+    params::Sheet sheet = {
+        {Sel: "Layer", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "1.8"}, {"Layer.Act.Gbar.L", "0.1"}}},
+        {Sel: "Path", Desc: "", ParamsSet: {{"Path.Learn.Norm.On", "true"}}},
+        {Sel: ".Hid", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "2.0"}}},
+        {Sel: ".BackPath", Desc: "", ParamsSet: {{"Path.WtScale.Rel", "0.2"}}},
+        {Sel: ".Recur2", Desc: "", ParamsSet: {{"Path.WtScale.Abs", "1.5"}}},
+        {Sel: "#HiddenB", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "2.2"}}},
+        {Sel: "#Output", Desc: "", ParamsSet: {{"Path.Learn.Lrate", "0.02"}}}, // a layer, with Path params
+        {Sel: "#Hidden2", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "2.2"}}}, // renamed
+        {Sel: ".Nope", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "2.2"}}},
+    };
+
+    // ApplyParams logs each layer
+    std::ostringstream devnull;
+    std::streambuf *coutBuf = std::cout.rdbuf(devnull.rdbuf());
+    params::Sheet each = sheet, indexed = sheet;
+    each.SelMatchReset("Base");
+    for (leabra::Layer *ly: net->Layers) {
+        if (!ly->ApplyParams(each, false)) {
+            break;
+        }
+    }
+    indexed.SelMatchReset("Base");
+    net->ApplyParams(indexed, false);
+    std::cout.rdbuf(coutBuf);
+    Counts applyEach(each, 0), applyIndexed(indexed, 0);
+    if (!(applyEach == applyIndexed)) {
+        std::cout << "ApplyParams NMatch differ from Layer.ApplyParams" << std::endl;
+        nbad++;
+    }
+
+    // every param in the sheet is valid, so each Sel that applies to an
+    // object compiles all of its params
+    int wantWrites = 0, wantTargets = 0;
+    for (params::StylerObject *obj: objects(net)) {
+        std::any aobj(obj);
+        bool any = false;
+        for (params::Sel_ &sl: sheet.sel) {
+            if (sl.TargetTypeMatch(aobj) && sl.SelMatch(aobj)) {
+                wantWrites += sl.ParamsSet.params.size();
+                any = true;
+            }
+        }
+        wantTargets += any;
+    }
+    Counts compileEach = applyEach;
+    compileEach.Writes = wantWrites;
+    indexed = sheet;
+    indexed.SelMatchReset("Base");
+    emer::CompiledParams cpIndexed = net->CompileParams(indexed);
+    if (!(Counts(indexed, cpIndexed.Writes.size()) == compileEach) || int(cpIndexed.Targets.size()) != wantTargets) {
+        std::cout << "CompileParams NMatch or writes differ from Layer.ApplyParams" << std::endl;
+        nbad++;
+    }
+    indexed = sheet;
+    net->SelMatchCount(indexed);
+    if (!(Counts(indexed, wantWrites) == compileEach)) {
+        std::cout << "SelMatchCount NMatch differ from Layer.ApplyParams" << std::endl;
+        nbad++;
+    }
+    // a Sel that matches, but with no valid params, matches nothing
+    params::Sheet invalid = {
+        {Sel: "#Input", Desc: "", ParamsSet: {{"Layer.Inhib.Nope.Gi", "1.8"}}},
+    };
+    std::ostringstream errs;
+    std::streambuf *cerrBuf = std::cerr.rdbuf(errs.rdbuf());
+    invalid.SelMatchReset("Base");
+    cpIndexed = net->CompileParams(invalid);
+    std::cerr.rdbuf(cerrBuf);
+    Counts compileInvalid(invalid, cpIndexed.Writes.size());
+    if (compileInvalid.NMatch[0] != 0 || compileInvalid.Warn == "" || !cpIndexed.Targets.empty()) {
+        std::cout << "CompileParams counted a Sel with no valid params as a match" << std::endl;
+        nbad++;
+    }
+    std::cout << "NMatch:";
+    for (int n: applyIndexed.NMatch) {
+        std::cout << " " << n;
+    }
+    std::cout << std::endl << applyIndexed.Warn;
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad > 0;
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "ra25net.hpp"
+
+// Trains a network on the random 5x5 patterns, presented in order so that
+// the run is repeatable, then tests it with the full quarters and with
+// quarters ending once Settled: the minus phase outputs and the SSE must
+// stay close on average, with fewer cycles run. A single unit can still be
+// near enough to the inhibition threshold that stopping a few cycles early
+// moves it a lot, so the largest difference is only reported. Also checks
+// that training is not affected when Settle.TestOnly.
+
+params::Sets ParamSets = ra25::Params();
+
+struct TestEpoch {
+    std::vector<float> SSE;
+    std::vector<std::vector<float>> ActM;
+    int Cycles = 0;
+    double Msec = 0;
+};
+
+// Test runs a test epoch over all the trials, recording the Output SSE
+// and ActM of each trial and the cycles run.
+TestEpoch Test(leabra::Sim &sim) {
+    TestEpoch te;
+    leabra::Layer *out = (leabra::Layer*) sim.Net->LayerByName("Output");
+    auto t0 = std::chrono::steady_clock::now();
+    for (int t = 0; t < sim.Env->NumTrials(); t++) {
+        sim.StepTrial(false);
+        for (int q = 0; q < 4; q++) {
+            te.Cycles += sim.Ctx->QuarterCycles[q];
+        }
+        te.SSE.push_back(sim.TrialSSE["Output"].back());
+        std::vector<float> actm;
+        for (leabra::Neuron &nrn: out->Neurons) {
+            actm.push_back(nrn.ActM);
+        }
+        te.ActM.push_back(actm);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    te.Msec = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    sim.Env->EndEpoch();
+    sim.TrialSSE["Output"].clear();
+    return te;
+}
+
+float Mean(const std::vector<float> &v) {
+    float sum = 0;
+    for (float x: v) {
+        sum += x;
+    }
+    return sum / v.size();
+}
+
+int main() {
+    int nbad = 0;
+    leabra::Network *net = ra25::NewNet("SettleTest", 7, 7);
+    leabra::Sim &sim = *ra25::NewSim(net, &ParamSets, true);
+    sim.Ctx->Settle.On = true;
+    for (int ep = 0; ep < 30; ep++) {
+        sim.StepEpoch(true);
+        // TestOnly: training always runs the full quarters
+        for (int q = 0; q < 4; q++) {
+            if (sim.Ctx->QuarterCycles[q] != sim.Ctx->CycPerQtr) {
+                nbad++;
+            }
+        }
+    }
+
+    sim.Ctx->Settle.On = false;
+    TestEpoch full = Test(sim);
+    sim.Ctx->Settle.On = true;
+    TestEpoch settled = Test(sim);
+
+    int ntrl = full.SSE.size();
+    if (full.Cycles != ntrl * 4 * sim.Ctx->CycPerQtr || settled.Cycles >= full.Cycles) {
+        nbad++;
+    }
+    float maxDiff = 0;
+    std::vector<float> diffs;
+    for (int t = 0; t < ntrl; t++) {
+        for (size_t i = 0; i < full.ActM[t].size(); i++) {
+            diffs.push_back(std::abs(full.ActM[t][i] - settled.ActM[t][i]));
+            maxDiff = std::max(maxDiff, diffs.back());
+        }
+    }
+    float meanDiff = Mean(diffs);
+    float fullSSE = Mean(full.SSE), settledSSE = Mean(settled.SSE);
+    if (meanDiff > 0.005 || std::abs(fullSSE - settledSSE) > 0.5) {
+        nbad++;
+    }
+
+    std::cout << "Mismatches: " << nbad << std::endl;
+    std::cout << "Test epoch, full quarters: " << float(full.Cycles) / ntrl << " cycles/trial, SSE " << fullSSE
+        << ", " << full.Msec << " ms" << std::endl;
+    std::cout << "Settled (Tol " << sim.Ctx->Settle.Tol << ", K " << sim.Ctx->Settle.K << "): "
+        << float(settled.Cycles) / ntrl << " cycles/trial, SSE " << settledSSE << ", " << settled.Msec
+        << " ms, Output ActM diff mean " << meanDiff << ", max " << maxDiff << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
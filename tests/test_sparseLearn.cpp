@@ -0,0 +1,112 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include "ra25net.hpp"
+
+// Trains a network with a large, sparsely active hidden layer on the random
+// 5x5 patterns, checking after each trial that WtFromDwt, which only visits
+// the DWtRows, gives exactly the weights of a sweep over all the synapses.
+// Reports the proportion of rows visited and the time of WtFromDwt versus
+// a full sweep (all the rows listed with DWtRowsAll).
+
+params::Sets ParamSets = ra25::Params({
+    {Sel: "#Hidden", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "2.6"}, {"Layer.Inhib.ActAvg.Init", "0.02"}}},
+});
+
+// FullSweep applies WtFromDWt to all of the synapses in syns, as the
+// pathway did before DWtRows.
+void FullSweep(leabra::Path *pt, std::vector<leabra::Synapse> &syns) {
+    for (size_t si = 0; si < syns.size(); si++) {
+        leabra::Synapse &sy = syns[si];
+        int ri = pt->Kernel != nullptr ? si % pt->Kernel->RNu : pt->SConIndex[si];
+        leabra::WtBalRecvPath &wb = pt->WbRecv[ri];
+        Real dwt = sy.DWt, wt = sy.Wt, lwt = sy.LWt; // Synapse may be Half
+        if (pt->Learn.WtBal.On) {
+            pt->Learn.WtFromDWt(wb.Inc, wb.Dec, dwt, wt, lwt, sy.Scale);
+        } else {
+            pt->Learn.WtFromDWt(1, 1, dwt, wt, lwt, sy.Scale);
+        }
+        sy.DWt = dwt;
+        sy.Wt = wt;
+        sy.LWt = lwt;
+    }
+}
+
+int main() {
+    int nbad = 0;
+    leabra::Network *net = ra25::NewNet("SparseLearnTest", 40, 40, 1);
+    leabra::Sim &sim = *ra25::NewSim(net, &ParamSets);
+    leabra::Environment *env = sim.Env;
+
+    std::vector<leabra::Path*> paths;
+    for (leabra::Layer *ly: net->Layers) {
+        for (leabra::Path *pt: ly->SendPaths) {
+            paths.push_back(pt);
+        }
+    }
+    double sparseUs = 0, fullUs = 0;
+    long rows = 0, allRows = 0, nsyn = 0, allSyn = 0;
+    int ntrl = 0;
+    for (int ep = 0; ep < 4; ep++) {
+        while (!env->EndEpoch()) {
+            sim.ApplyInputs();
+            sim.Ctx->Mode = leabra::Train;
+            net->AlphaCycInit(true);
+            sim.Ctx->AlphaCycStart();
+            for (int qtr = 0; qtr < 4; qtr++) {
+                for (int cyc = 0; cyc < sim.Ctx->CycPerQtr; cyc++) {
+                    net->Cycle(sim.Ctx);
+                    sim.Ctx->CycleInc();
+                }
+                net->QuarterFinal(sim.Ctx);
+                sim.Ctx->QuarterInc();
+            }
+            net->Dwt();
+
+            std::vector<std::vector<leabra::Synapse>> syns;
+            for (leabra::Path *pt: paths) {
+                syns.push_back(pt->Syns);
+                rows += pt->DWtRows.size();
+                allRows += pt->DWtRowMark.size();
+                for (int row: pt->DWtRows) {
+                    nsyn += pt->SConN[row];
+                }
+                allSyn += pt->Syns.size();
+            }
+            // time the full sweep on a copy, then the DWtRows on the network
+            std::vector<std::vector<leabra::Synapse>> full = syns;
+            auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < paths.size(); i++) {
+                FullSweep(paths[i], full[i]);
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            for (leabra::Layer *ly: net->Layers) {
+                ly->WtFromDWt();
+            }
+            auto t2 = std::chrono::steady_clock::now();
+            fullUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+            sparseUs += std::chrono::duration<double, std::micro>(t2 - t1).count();
+            for (size_t i = 0; i < paths.size(); i++) {
+                if (!paths[i]->DWtRows.empty() || std::memcmp(paths[i]->Syns.data(), full[i].data(), full[i].size() * sizeof(leabra::Synapse)) != 0) {
+                    nbad++;
+                }
+            }
+            // as in Network.WtFromDwt
+            if (++net->WtBalCtr >= net->WtBalInterval) {
+                net->WtBalCtr = 0;
+                for (leabra::Layer *ly: net->Layers) {
+                    ly->WtBalFromWt();
+                }
+            }
+            env->Step();
+            sim.RecordSSE();
+            ntrl++;
+        }
+        sim.TrialSSE["Output"].clear();
+    }
+    std::cout << "Visited by WtFromDwt over " << ntrl << " trials: " << 100.0 * rows / allRows << "% of the rows, "
+        << 100.0 * nsyn / allSyn << "% of the synapses" << std::endl;
+    std::cout << "WtFromDwt: DWtRows " << sparseUs / ntrl << " us/trial, full sweep " << fullUs / ntrl << " us/trial" << std::endl;
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include "path.hpp"
+
+// Checks the connection indexes that Circle and UniformRand build directly
+// from UnitCons: Circle against its receptive fields computed over all the
+// sending units, UniformRand for its fan-in, its Recip version and
+// independence from the number of threads, and both against the tables
+// from Connect. Also times a large sparse pathway.
+
+bool Same(std::span<const int> a, std::span<const int> b) {
+    return std::ranges::equal(a, b);
+}
+
+// Consistent checks that the send and recv lists of ci describe the same
+// connections, and match the tables from pat.Connect.
+int Consistent(paths::Pattern &pat, tensor::Shape &send, tensor::Shape &recv, bool same, const paths::ConnIndexes &ci) {
+    int nbad = 0;
+    int slen = send.Len();
+    for (size_t ri = 0; ri < ci.RConN.size(); ri++) {
+        for (int i = ci.RConIndexSt[ri]; i < ci.RConIndexSt[ri] + ci.RConN[ri]; i++) {
+            if (ci.SConIndex[ci.RSynIndex[i]] != int(ri)) {
+                nbad++;
+            }
+        }
+    }
+    auto [sn, rn, cn] = pat.Connect(send, recv, same);
+    std::unique_ptr<tensor::Int32> sendn(sn), recvn(rn);
+    std::unique_ptr<tensor::Bits> cons(cn);
+    if (!Same(sendn->Values, ci.SConN) || !Same(recvn->Values, ci.RConN)) {
+        nbad++;
+    }
+    size_t nbits = std::count(cons->Values.begin(), cons->Values.end(), true);
+    if (nbits != ci.RConIndex.size()) {
+        nbad++;
+    }
+    for (size_t ri = 0; ri < ci.RConN.size(); ri++) {
+        for (int i = ci.RConIndexSt[ri]; i < ci.RConIndexSt[ri] + ci.RConN[ri]; i++) {
+            if (!cons->Values[ri * slen + ci.RConIndex[i]]) {
+                nbad++;
+            }
+        }
+    }
+    return nbad;
+}
+
+// CircleField returns the sending units of receiving unit ri, checking all of them.
+std::vector<int> CircleField(paths::Circle &cr, tensor::Shape &send, tensor::Shape &recv, bool same, int ri) {
+    auto [sNy, sNx, sre, sce] = tensor::Projection2DShape(send, false);
+    auto [ry, rx] = tensor::Projection2DCoords(recv, false, ri);
+    math::Vector2 sc = cr.SendScale(send, recv);
+    math::Vector2 ctr;
+    ctr.X = rx * sc.X + cr.Start.X;
+    ctr.Y = ry * sc.Y + cr.Start.Y;
+    std::vector<int> sis;
+    for (int sy = 0; sy < sNy; sy++) {
+        for (int sx = 0; sx < sNx; sx++) {
+            math::Vector2 sp;
+            sp.X = sx;
+            sp.Y = sy;
+            if (cr.Wrap) {
+                sp.X = math::WrapMinDist(sp.X, sNx, ctr.X);
+                sp.Y = math::WrapMinDist(sp.Y, sNy, ctr.Y);
+            }
+            int si = tensor::Projection2DIndex(send, false, sy, sx);
+            if (std::round(std::sqrt(sp.DistanceToSquared(ctr))) <= cr.Radius && !(same && !cr.SelfCon && si == ri)) {
+                sis.push_back(si);
+            }
+        }
+    }
+    std::sort(sis.begin(), sis.end());
+    return sis;
+}
+
+int CheckCircle(paths::Circle &cr, tensor::Shape &send, tensor::Shape &recv, bool same) {
+    auto ci = paths::NewConnIndexes(cr, send, recv, same);
+    int nbad = Consistent(cr, send, recv, same, *ci);
+    for (size_t ri = 0; ri < ci->RConN.size(); ri++) {
+        auto st = ci->RConIndex.begin() + ci->RConIndexSt[ri];
+        std::vector<int> cons(st, st + ci->RConN[ri]);
+        if (cons != CircleField(cr, send, recv, same, ri)) {
+            nbad++;
+        }
+    }
+    return nbad;
+}
+
+int main() {
+    int nbad = 0;
+    std::vector<int> s2d = {20, 20}, s4d = {5, 5, 4, 4}, r2d = {10, 10}, big = {100, 100};
+    tensor::Shape send2D(s2d), send4D(s4d), recv2D(r2d), bigShape(big);
+
+    paths::Circle cr;
+    cr.Radius = 3;
+    cr.Scale.X = 2;
+    cr.Scale.Y = 2;
+    nbad += CheckCircle(cr, send2D, recv2D, false);
+    nbad += CheckCircle(cr, send4D, recv2D, false);
+    nbad += CheckCircle(cr, send4D, send4D, true);
+    cr.Wrap = false;
+    cr.AutoScale = true;
+    cr.Start.Set(1, 1);
+    nbad += CheckCircle(cr, send4D, recv2D, false);
+    cr.Radius = 12; // wider than the layers
+    cr.Wrap = true;
+    nbad += CheckCircle(cr, send2D, recv2D, false);
+
+    paths::UniformRand ur;
+    ur.PCon = 0.1;
+    auto ci = paths::NewConnIndexes(ur, send2D, recv2D, false, 1);
+    nbad += Consistent(ur, send2D, recv2D, false, *ci);
+    for (int n: ci->RConN) {
+        if (n != 40) {
+            nbad++;
+        }
+    }
+    auto ci4 = paths::NewConnIndexes(ur, bigShape, recv2D, false, 4);
+    auto ci1 = paths::NewConnIndexes(ur, bigShape, recv2D, false, 1);
+    if (!Same(ci4->RConIndex, ci1->RConIndex) || !Same(ci4->SConIndex, ci1->SConIndex) || !Same(ci4->RSynIndex, ci1->RSynIndex)) {
+        nbad++;
+    }
+    ur.PCon = 0.8; // draws the units left out
+    auto self = paths::NewConnIndexes(ur, send2D, send2D, true, 3);
+    nbad += Consistent(ur, send2D, send2D, true, *self);
+    for (size_t ri = 0; ri < self->RConN.size(); ri++) {
+        auto st = self->RConIndex.begin() + self->RConIndexSt[ri];
+        if (self->RConN[ri] != 319 || std::find(st, st + self->RConN[ri], int(ri)) != st + self->RConN[ri]) {
+            nbad++;
+        }
+    }
+    paths::UniformRand recip;
+    recip.PCon = 0.1;
+    recip.Recip = true;
+    ur.PCon = 0.1;
+    auto rci = paths::NewConnIndexes(recip, recv2D, send2D, false, 2);
+    nbad += Consistent(recip, recv2D, send2D, false, *rci);
+    if (!Same(rci->SConIndex, ci->RConIndex) || !Same(rci->RConIndex, ci->SConIndex)) {
+        nbad++;
+    }
+
+    // large sparse pathway
+    std::vector<int> huge = {100, 100};
+    tensor::Shape hugeShape(huge);
+    ur.PCon = 0.02;
+    auto t0 = std::chrono::steady_clock::now();
+    auto hci = paths::NewConnIndexes(ur, hugeShape, hugeShape, false, 1);
+    auto t1 = std::chrono::steady_clock::now();
+    auto hcin = paths::NewConnIndexes(ur, hugeShape, hugeShape, false, 0);
+    auto t2 = std::chrono::steady_clock::now();
+    if (!Same(hci->RConIndex, hcin->RConIndex)) {
+        nbad++;
+    }
+
+    std::cout << "Mismatches: " << nbad << std::endl;
+    std::cout << "UniformRand " << hugeShape.Len() << " x " << hugeShape.Len() << ", " << hci->RConIndex.size()
+        << " connections: " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms 1 thread, "
+        << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms all threads, index bytes: " << hci->Bytes()
+        << ", Connect tables would be: " << size_t(hugeShape.Len()) * hugeShape.Len() / 8 << " bytes" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
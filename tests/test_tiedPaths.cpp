@@ -0,0 +1,146 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+
+// Compares a network with a Tied Forward / Back pathway pair against the
+// same network with separate symmetric weights: the tied Back pathway
+// must use the Forward synapses, send the same conductances, and combine
+// the DWt of both directions into one, with half the synapse memory.
+// With Norm and Momentum on, both directions learning in the same trial
+// must make one combined update of each shared synapse: the owner's Norm,
+// Momentum and Lrate applied once to the sum of the raw changes.
+
+struct TestNet {
+    leabra::Network *Net;
+    leabra::Path *Fwd;
+    leabra::Path *Back;
+
+    TestNet(bool tied, bool normMom = false) {
+        Net = new leabra::Network("TiedTest");
+        leabra::Layer *inp = Net->AddLayer2D("Input", 5, 5, leabra::InputLayer);
+        leabra::Layer *hid = Net->AddLayer2D("Hidden", 6, 6, leabra::SuperLayer);
+        leabra::Layer *out = Net->AddLayer2D("Output", 4, 4, leabra::TargetLayer);
+        paths::Pattern *full = new paths::Full();
+        Net->ConnectLayers(inp, hid, full, leabra::ForwardPath);
+        std::tie(Fwd, Back) = Net->BidirConnectLayers(hid, out, full);
+        Net->Build();
+        Net->Defaults();
+        for (leabra::Path *pt: {Fwd, Back}) {
+            pt->Tied = tied;
+            pt->Learn.Norm.On = normMom;
+            pt->Learn.Momentum.On = normMom;
+            pt->Learn.WtBal.On = false;
+        }
+        Net->SetRandSeed(1);
+        Net->InitWeights();
+
+        // same learning state in both networks
+        for (leabra::Layer *ly: Net->Layers) {
+            for (size_t ni = 0; ni < ly->Neurons.size(); ni++) {
+                leabra::Neuron &nrn = ly->Neurons[ni];
+                nrn.AvgS = nrn.AvgSLrn = 0.2 + 0.6 * std::fmod(ni * 0.37, 1.0);
+                nrn.AvgM = 0.2 + 0.6 * std::fmod(ni * 0.53, 1.0);
+                nrn.AvgL = 0.3;
+                nrn.AvgLLrn = 0.5;
+            }
+        }
+    }
+};
+
+int main() {
+    TestNet sep(false);
+    TestNet tied(true);
+    int nbad = 0;
+    if (tied.Back->TiedTo != tied.Fwd || !tied.Back->Syns.empty() || sep.Back->TiedTo != nullptr) {
+        nbad++;
+    }
+
+    // same conductances sent on the Back pathway
+    for (int si = 0; si < int(sep.Back->SConN.size()); si++) {
+        sep.Back->SendGDelta(si, 0.5);
+        tied.Back->SendGDelta(si, 0.5);
+    }
+    for (size_t ri = 0; ri < sep.Back->GInc.size(); ri++) {
+        if (std::abs(sep.Back->GInc[ri] - tied.Back->GInc[ri]) > 1e-5) {
+            nbad++;
+        }
+    }
+
+    sep.Net->Dwt();
+    tied.Net->Dwt();
+    // with PRECISION=mixed, the raw DWt are summed as Half, to about 3 digits
+    // of each direction's DWt
+    const double rel = sizeof(SynReal) < sizeof(float) ? 2e-3 : 0;
+    int nsyn = 0;
+    for (int si = 0; si < int(sep.Fwd->SConN.size()); si++) {
+        for (int ri = 0; ri < int(sep.Fwd->RConN.size()); ri++, nsyn++) {
+            leabra::Synapse &fs = sep.Fwd->Syns[sep.Fwd->SynIndex(si, ri)];
+            leabra::Synapse &bs = sep.Back->Syns[sep.Back->SynIndex(ri, si)];
+            leabra::Synapse &ts = tied.Fwd->Syns[tied.Fwd->SynIndex(si, ri)];
+            leabra::Synapse &tbs = tied.Back->Syn(tied.Back->SynIndex(ri, si));
+            if (&ts != &tbs || ts.Wt != fs.Wt || std::abs(ts.DWt - (fs.DWt + bs.DWt)) > 1e-6 + rel * (std::abs(float(fs.DWt)) + std::abs(float(bs.DWt)))) {
+                nbad++;
+            }
+        }
+    }
+    tied.Net->WtFromDwt();
+
+    // one combined update: the raw changes of both directions, from a batch
+    // of one trial, with Norm and Momentum applied once by the Forward owner
+    TestNet rawNet(false, true);
+    TestNet comb(true, true);
+    comb.Back->Learn.Lrate = 0.5; // unused: the owner's Lrate applies
+    rawNet.Net->Dwt(true);
+    comb.Net->Dwt();
+    leabra::LearnSynParams &ls = comb.Fwd->Learn;
+    int ncomb = 0;
+    for (int si = 0; si < int(rawNet.Fwd->SConN.size()); si++) {
+        Real maxNorm = 0;
+        std::vector<Real> norms;
+        for (int ri = 0; ri < int(rawNet.Fwd->RConN.size()); ri++) {
+            leabra::Synapse &fs = rawNet.Fwd->Syns[rawNet.Fwd->SynIndex(si, ri)];
+            leabra::Synapse &bs = rawNet.Back->Syns[rawNet.Back->SynIndex(ri, si)];
+            leabra::Synapse &cs = comb.Fwd->Syns[comb.Fwd->SynIndex(si, ri)];
+            Real dwt = fs.DWt + bs.DWt;
+            Real norm = fs.Norm, moment = fs.Moment;
+            Real nf = ls.Norm.NormFromAbsDWt(norm, std::abs(dwt));
+            dwt = ls.Lrate * nf * ls.Momentum.MomentFromDWt(moment, dwt);
+            maxNorm = std::max(maxNorm, norm);
+            if (std::abs(cs.DWt - dwt) > 1e-6 || std::abs(cs.Moment - moment) > 1e-6) {
+                ncomb++;
+            }
+            norms.push_back(cs.Norm);
+        }
+        for (Real n: norms) {
+            if (std::abs(n - maxNorm) > 1e-6) {
+                ncomb++;
+            }
+        }
+    }
+    if (ncomb > 0) {
+        std::cout << "Combined updates that differ: " << ncomb << std::endl;
+        nbad++;
+    }
+
+    leabra::MemReport sepMem = sep.Fwd->MemoryReport();
+    sepMem.Add(sep.Back->MemoryReport());
+    leabra::MemReport tiedMem = tied.Fwd->MemoryReport();
+    tiedMem.Add(tied.Back->MemoryReport());
+
+    // untying gives the Back pathway its own copy of the tied weights
+    tied.Back->Tied = false;
+    tied.Back->Untie();
+    if (tied.Back->Syns[tied.Back->SynIndex(3, 7)].Wt != tied.Fwd->Syns[tied.Fwd->SynIndex(7, 3)].Wt) {
+        nbad++;
+    }
+
+    std::cout << "Tied synapses: " << nsyn << ", mismatches: " << nbad << std::endl;
+    std::cout << "Synapse state, separate: " << sepMem.SynapseState << " bytes, tied: "
+        << tiedMem.SynapseState << " bytes" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
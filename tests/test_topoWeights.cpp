@@ -0,0 +1,187 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+
+// Checks the PoolTile topographic weights against the Gaussian and sigmoid
+// weights computed for each element on their own, then builds a network
+// with many PoolTile pathways of the same shapes and checks that
+// InitTopoScales computes their weights once, and sets the same scales
+// with the cache on and off.
+
+// RefGauss returns the Gaussian weight of sending unit (sy, sx) of a full
+// field of fy x fx units, in pools of py x px, for recv unit (ruy, rux) of rNuY x rNuX.
+float RefGauss(paths::PoolTile &pt, int fy, int fx, int py, int px, int rNuY, int rNuX, int ruy, int rux, int sy, int sx) {
+    auto fsz = math::Vec2(float(fx - 1), float(fy - 1));
+    math::Vec2 hfsz = fsz.MulScalar(0.5);
+    float fsig = pt.GaussFull.Sigma * hfsz.X;
+    auto psz = math::Vec2(float(px > 1 ? px - 1 : px), float(py > 1 ? py - 1 : py));
+    math::Vec2 hpsz = psz.MulScalar(0.5);
+    float psig = pt.GaussInPool.Sigma * hpsz.X;
+    auto hrsz = math::Vec2(float(rNuX > 1 ? rNuX - 1 : rNuX), float(rNuY > 1 ? rNuY - 1 : rNuY)).MulScalar(0.5);
+    math::Vec2 rpos = math::Vec2(float(rux), float(ruy)).Sub(hrsz).Div(hrsz);
+    math::Vec2 sfctr = rpos.MulScalar(pt.GaussFull.CtrMove).Mul(hfsz).Add(hfsz);
+    math::Vec2 spctr = rpos.MulScalar(pt.GaussInPool.CtrMove).Mul(hpsz).Add(hpsz);
+    auto sf = math::Vec2(float(sx), float(sy));
+    if (pt.GaussFull.Wrap) {
+        sf.X = math::WrapMinDist(sf.X, fsz.X, sfctr.X);
+        sf.Y = math::WrapMinDist(sf.Y, fsz.Y, sfctr.Y);
+    }
+    auto sp = math::Vec2(float(sx % px), float(sy % py));
+    if (pt.GaussInPool.Wrap) {
+        sp.X = math::WrapMinDist(sp.X, psz.X, spctr.X);
+        sp.Y = math::WrapMinDist(sp.Y, psz.Y, spctr.Y);
+    }
+    float wt = math::GaussVecDistNoNorm(sf, sfctr, fsig) * math::GaussVecDistNoNorm(sp, spctr, psig);
+    return pt.TopoRange.ProjValue(wt);
+}
+
+// RefSigmoid returns the sigmoid weight, as RefGauss, flipping the
+// direction half-way through the recv units on both axes.
+float RefSigmoid(paths::PoolTile &pt, int fy, int fx, int py, int px, int rNuY, int rNuX, int ruy, int rux, int sy, int sx) {
+    auto fsz = math::Vec2(float(fx - 1), float(fy - 1));
+    float fgain = pt.SigFull.Gain * 0.5 * fsz.X;
+    auto psz = math::Vec2(float(px > 1 ? px - 1 : px), float(py > 1 ? py - 1 : py));
+    float pgain = pt.SigInPool.Gain * 0.5 * psz.X;
+    auto hrsz = math::Vec2(float(rNuX > 1 ? rNuX - 1 : rNuX), float(rNuY > 1 ? rNuY - 1 : rNuY)).MulScalar(0.5);
+    math::Vec2 rpos = math::Vec2(float(rux), float(ruy)).Div(hrsz);
+    auto sgn = math::Vec2(1, 1);
+    math::Vec2 rfpos = rpos.SubScalar(0.5).MulScalar(pt.SigFull.CtrMove).AddScalar(0.5);
+    math::Vec2 rppos = rpos.SubScalar(0.5).MulScalar(pt.SigInPool.CtrMove).AddScalar(0.5);
+    if (rpos.X >= 1) {
+        sgn.X = -1;
+        rpos.X = -rpos.X + 1;
+        rfpos.X = (rpos.X + 0.5) * pt.SigFull.CtrMove - 0.5;
+        rppos.X = (rpos.X + 0.5) * pt.SigInPool.CtrMove - 0.5;
+    }
+    if (rpos.Y >= 1) {
+        sgn.Y = -1;
+        rpos.Y = -rpos.Y + 1;
+        rfpos.Y = (rpos.Y + 0.5) * pt.SigFull.CtrMove - 0.5;
+        rppos.Y = (rpos.Y + 0.5) * pt.SigInPool.CtrMove - 0.5;
+    }
+    math::Vec2 sfctr = rfpos.Mul(fsz);
+    math::Vec2 spctr = rppos.Mul(psz);
+    float fwt = math::Logistic(sgn.X * sx, fgain, sfctr.X) * math::Logistic(sgn.Y * sy, fgain, sfctr.Y);
+    float pwt = math::Logistic(sgn.X * (sx % px), pgain, spctr.X) * math::Logistic(sgn.Y * (sy % py), pgain, spctr.Y);
+    return pt.TopoRange.ProjValue(fwt * pwt);
+}
+
+// Check compares the weights of pt.TopoWeights with the reference ones,
+// for 4D layers if pools, else 2D.
+int Check(paths::PoolTile &pt, bool sig, bool pools) {
+    std::vector<int> s4 = {8, 8, 3, 2}, s2 = {6, 5}, r4 = {4, 4, 5, 4};
+    tensor::Shape send(pools ? s4 : s2), recv(r4);
+    std::vector<int> shp;
+    tensor::Tensor<float> wts(shp);
+    pt.TopoWeights(send, recv, wts);
+    int nfY = pools ? pt.Size.Y : 1, nfX = pools ? pt.Size.X : 1;
+    int sNuY = pools ? 3 : 6, sNuX = pools ? 2 : 5;
+    int rNuY = 5, rNuX = 4;
+    int nbad = 0;
+    int i = 0;
+    for (int ruy = 0; ruy < rNuY; ruy++) {
+        for (int rux = 0; rux < rNuX; rux++) {
+            for (int fy = 0; fy < nfY; fy++) {
+                for (int fx = 0; fx < nfX; fx++) {
+                    for (int suy = 0; suy < sNuY; suy++) {
+                        for (int sux = 0; sux < sNuX; sux++, i++) {
+                            int sy = fy * sNuY + suy, sx = fx * sNuX + sux;
+                            float ref = sig ? RefSigmoid(pt, nfY * sNuY, nfX * sNuX, sNuY, sNuX, rNuY, rNuX, ruy, rux, sy, sx)
+                                : RefGauss(pt, nfY * sNuY, nfX * sNuX, sNuY, sNuX, rNuY, rNuX, ruy, rux, sy, sx);
+                            if (std::abs(wts.Values[i] - ref) > 1e-5) {
+                                nbad++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if (i != int(wts.Values.size())) {
+        nbad++;
+    }
+    return nbad;
+}
+
+const int nPaths = 100;
+
+leabra::Network *NewNet(paths::PoolTile *pat) {
+    leabra::Network *net = new leabra::Network("TopoWeightsTest");
+    leabra::Layer *inp = net->AddLayer4D("Input", 16, 16, 4, 4, leabra::InputLayer);
+    for (int li = 0; li < nPaths; li++) {
+        leabra::Layer *ly = net->AddLayer4D("Hidden_" + std::to_string(li), 8, 8, 4, 4, leabra::SuperLayer);
+        net->ConnectLayers(inp, ly, pat, leabra::ForwardPath);
+    }
+    net->Build();
+    return net;
+}
+
+// WtsMs times getting the topographic weights of all the paths, the part
+// of InitTopoScales that the cache replaces.
+double WtsMs(leabra::Network *net, paths::PoolTile *pat) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t li = 1; li < net->Layers.size(); li++) {
+        paths::DefaultTopoCache.Get(*pat, net->Layers[0]->Shape, net->Layers[li]->Shape);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+double TopoMs(leabra::Network *net) {
+    auto t0 = std::chrono::steady_clock::now();
+    net->InitTopoScales();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main() {
+    int nbad = 0;
+    paths::PoolTile pt;
+    nbad += Check(pt, false, true);
+    nbad += Check(pt, false, false);
+    pt.GaussFull.Wrap = false;
+    pt.GaussInPool.CtrMove = 0.5;
+    nbad += Check(pt, false, true);
+    pt.GaussFull.On = false;
+    pt.GaussInPool.On = false;
+    pt.SigFull.On = true;
+    pt.SigInPool.On = true;
+    nbad += Check(pt, true, true);
+    nbad += Check(pt, true, false);
+
+    paths::TopoCache &cache = paths::DefaultTopoCache;
+    paths::PoolTile *pat = new paths::PoolTile();
+    cache.On = false;
+    leabra::Network *off = NewNet(pat);
+    double offMs = TopoMs(off);
+    cache.On = true;
+    leabra::Network *on = NewNet(pat);
+    double onMs = TopoMs(on);
+    if (cache.Misses != 1 || cache.Hits != nPaths - 1) {
+        nbad++;
+    }
+    for (size_t li = 1; li < off->Layers.size(); li++) {
+        leabra::Path *po = off->Layers[li]->RecvPaths[0];
+        leabra::Path *pn = on->Layers[li]->RecvPaths[0];
+        for (int i = 0; i < po->NumSyns(); i++) {
+            if (po->Syns[i].Scale != pn->Syns[i].Scale || (li == 1 && i < 10 && po->Syns[i].Scale == 0)) {
+                nbad++;
+            }
+        }
+    }
+
+    cache.On = false;
+    double offWtsMs = WtsMs(on, pat);
+    cache.On = true;
+    double onWtsMs = WtsMs(on, pat);
+
+    std::cout << "Mismatches: " << nbad << std::endl;
+    std::cout << "InitTopoScales, " << nPaths << " paths, no cache: " << offMs << " ms, cache: " << onMs
+        << " ms (" << cache.Misses << " computed)" << std::endl;
+    std::cout << "Topographic weights only, no cache: " << offWtsMs << " ms, cache: " << onWtsMs << " ms" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
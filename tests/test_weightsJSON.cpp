@@ -0,0 +1,71 @@
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include "leabra.hpp"
+#include "network.hpp"
+#include "layer.hpp"
+#include "path.hpp"
+
+// Writes a network's weights in the Go emergent JSON format, re-initializes
+// them, then streams the JSON back in and checks that Wt round-trips exactly.
+
+int main() {
+    leabra::Network net("WeightsJSON");
+    leabra::Layer *inp = net.AddLayer2D("Input", 10, 10, leabra::InputLayer);
+    leabra::Layer *hid = net.AddLayer2D("Hidden", 10, 10, leabra::SuperLayer);
+    leabra::Layer *out = net.AddLayer2D("Output", 5, 5, leabra::TargetLayer);
+    paths::Pattern *full = new paths::Full();
+    net.ConnectLayers(inp, hid, full, leabra::ForwardPath);
+    net.BidirConnectLayers(hid, out, full);
+    net.Build();
+    net.Defaults();
+    net.SetRandSeed(1);
+    net.InitWeights();
+    net.MetaData["Epoch"] = "12";
+    hid->Pools[0].ActAvgs.ActPAvg = 0.123f;
+
+    std::vector<std::vector<leabra::Synapse>> syns;
+    for (leabra::Layer *ly: net.Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            syns.push_back(pt->Syns);
+        }
+    }
+
+    std::stringstream ss;
+    auto t0 = std::chrono::steady_clock::now();
+    net.WriteWeightsJSON(ss);
+    auto t1 = std::chrono::steady_clock::now();
+    size_t nbytes = ss.str().size();
+
+    net.SetRandSeed(2);
+    net.InitWeights();
+    hid->Pools[0].ActAvgs.ActPAvg = 0;
+    net.MetaData.clear();
+
+    auto t2 = std::chrono::steady_clock::now();
+    net.ReadWeightsJSON(ss);
+    auto t3 = std::chrono::steady_clock::now();
+
+    int nbad = 0;
+    size_t nsyn = 0;
+    int pi = 0;
+    for (leabra::Layer *ly: net.Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            std::vector<leabra::Synapse> &sv = syns[pi++];
+            for (size_t si = 0; si < sv.size(); si++, nsyn++) {
+                if (std::memcmp(&sv[si].Wt, &pt->Syns[si].Wt, sizeof(float)) != 0) {
+                    nbad++;
+                }
+            }
+        }
+    }
+    if (hid->Pools[0].ActAvgs.ActPAvg != 0.123f || net.MetaData["Epoch"] != "12") {
+        nbad++;
+    }
+
+    std::cout << "Synapses: " << nsyn << ", JSON bytes: " << nbytes << ", mismatches: " << nbad << std::endl;
+    std::cout << "Write: " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, "
+        << "Read: " << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms" << std::endl;
+    return nbad == 0 ? 0 : 1;
+}
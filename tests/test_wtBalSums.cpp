@@ -0,0 +1,109 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "ra25net.hpp"
+
+// Trains a network on the random 5x5 patterns with Net.WtBalCheck, and
+// WtBalFromWt after every trial, checking that the running WtBal sums kept
+// by WtFromDWt match a full recompute, including after SetWtsFunc and a
+// change of WtBal.AvgThr, and that the check catches a weight set directly
+// in Syns. Also checks the WbRecv Avg against the gather over RSynIndex that
+// WtBalFromWt used before, and reports the time of WtBalFromWt from the
+// running sums versus from all of the synapses.
+
+params::Sets ParamSets = ra25::Params({
+    {Sel: "#Hidden", Desc: "", ParamsSet: {{"Layer.Inhib.Layer.Gi", "2.6"}, {"Layer.Inhib.ActAvg.Init", "0.02"}}},
+});
+
+// AvgErrors returns the number of recv units of pt whose WbRecv Avg is not
+// that of a full gather of their weights, as WtBalFromWt computed it before.
+int AvgErrors(leabra::Path *pt) {
+    int nbad = 0;
+    for (int ri = 0; ri < int(pt->RConN.size()); ri++) {
+        int nc = pt->RConN[ri];
+        int st = pt->RConIndexSt[ri];
+        float sumWt = 0;
+        int sumN = 0;
+        for (int ci = 0; ci < nc; ci++) {
+            float wt = pt->Syns[pt->RSynIndex[st+ci]].Wt;
+            if (wt >= pt->Learn.WtBal.AvgThr) {
+                sumWt += wt;
+                sumN++;
+            }
+        }
+        float avg = sumN > 0 ? sumWt / sumN : 0;
+        if (nc > 0 && std::abs(avg - float(pt->WbRecv[ri].Avg)) > 1e-5f) {
+            nbad++;
+        }
+    }
+    return nbad;
+}
+
+int main() {
+    int nbad = 0;
+    leabra::Network *net = ra25::NewNet("WtBalSumsTest", 40, 40, 1);
+    leabra::Sim &sim = *ra25::NewSim(net, &ParamSets, true);
+    leabra::Layer *hid = (leabra::Layer*) net->LayerByName("Hidden");
+    net->WtBalInterval = 1;
+    net->WtBalCheck = true;
+
+    std::vector<leabra::Path*> paths; // those with WtBal (not to the Output, as WtBal.Targs is off)
+    for (leabra::Layer *ly: net->Layers) {
+        for (leabra::Path *pt: ly->RecvPaths) {
+            if (!ly->IsTarget()) {
+                paths.push_back(pt);
+            }
+        }
+    }
+    for (int ep = 0; ep < 6; ep++) {
+        if (ep == 2) { // weights set other than by WtFromDWt
+            hid->RecvPaths[0]->SetWtsFunc([](int si, int ri, tensor::Shape &send, tensor::Shape &recv) {
+                return 0.1f + 0.8f * float((si * 7 + ri * 3) % 11) / 10;
+            });
+        }
+        if (ep == 4) {
+            for (leabra::Path *pt: paths) {
+                pt->Learn.WtBal.AvgThr = 0.3;
+            }
+        }
+        sim.StepEpoch(true);
+        for (leabra::Path *pt: paths) {
+            nbad += AvgErrors(pt);
+        }
+    }
+    std::cout << "WtBalErrs: " << net->WtBalErrs << ", Train SSE: last epoch " << sim.EpochSSE["Output"].back() << std::endl;
+    nbad += net->WtBalErrs;
+    for (leabra::Path *pt: paths) {
+        nbad += !pt->WbSums;
+    }
+
+    // a weight set directly in Syns is caught by the check, which fixes the sums
+    leabra::Synapse &sy = hid->RecvPaths[0]->Syns[0];
+    sy.Wt = sy.Wt >= 0.3 ? 0 : 0.9;
+    int nchk = hid->WtBalFromWt(true);
+    int nchk2 = hid->WtBalFromWt(true);
+    std::cout << "Check after setting a weight directly: " << nchk << ", then " << nchk2 << std::endl;
+    if (nchk != 1 || nchk2 != 0) {
+        nbad++;
+    }
+
+    // the cost of WtBalFromWt with the running sums, and from all synapses
+    net->WtBalCheck = false;
+    int nrep = 200;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < nrep; rep++) {
+        hid->WtBalFromWt();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < nrep; rep++) {
+        for (leabra::Path *pt: hid->RecvPaths) {
+            pt->WbSums = false;
+        }
+        hid->WtBalFromWt();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    std::cout << "Hidden WtBalFromWt: running sums " << std::chrono::duration<double, std::micro>(t1 - t0).count() / nrep
+        << " us, full recompute " << std::chrono::duration<double, std::micro>(t2 - t1).count() / nrep << " us" << std::endl;
+    std::cout << "Mismatches: " << nbad << std::endl;
+    return nbad == 0 ? 0 : 1;
+}